@@ -135,6 +135,20 @@ Note: All current deprecated methods will be removed in the next version. So mak
 @subsection code_changes_4_12_to_4_13 VSTGUI 4.12 -> VSTGUI 4.13
 
 - the context argument of IFontPainter has changed to use the new platform graphics device context
+- CViewContainer::ViewList is now a std::vector<SharedPointer<CView>> instead of a std::list, so its
+iterators are invalidated when child views are added or removed. Use CViewContainer::forEachChild,
+VSTGUI::ViewIterator or VSTGUI::ReverseViewIterator if the child views may change while iterating.
+- VSTGUI::UIAttributes is no longer derived from VSTGUI::UIAttributesMap. Its iterators are read-only
+(UIAttributes::iterator is UIAttributes::const_iterator) and UIAttributes::value_type is
+std::pair<const std::string&, std::string>. Use UIAttributes::setAttribute to change a value, so that
+the cached typed value is reset.
+- the attribute name constants of the view creators (UIViewCreator::kAttrOrigin, ...) are
+VSTGUI::UIAttributeName objects instead of std::string. They convert to const std::string&, can be
+compared and concatenated with strings and forward the read-only std::string methods (c_str, size,
+...). Code which deduces the type of a constant (e.g. auto name = kAttrOrigin;) or passes a constant
+to a template expecting std::string gets a UIAttributeName and must convert it via getString ().
+- VSTGUI::UIAttributes caches the parsed values of its typed getters, reading one UIAttributes object
+on multiple threads at the same time is not supported.
 
 @subsection code_changes_4_11_to_4_12 VSTGUI 4.11 -> VSTGUI 4.12
 
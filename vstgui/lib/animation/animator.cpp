@@ -332,6 +332,15 @@ void Animator::removeAnimations (CView* view)
 	});
 }
 
+//-----------------------------------------------------------------------------
+void Animator::collectAnimatedViews (std::vector<CView*>& views)
+{
+	pImpl->animations.forEach ([&] (const SharedPointer<Detail::Animation>& animation) {
+		if (!animation->done)
+			views.emplace_back (animation->view);
+	});
+}
+
 //-----------------------------------------------------------------------------
 void Animator::onTimer ()
 {
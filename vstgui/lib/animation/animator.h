@@ -8,6 +8,7 @@
 #include <string>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace VSTGUI {
 namespace Animation {
@@ -49,6 +50,9 @@ public:
 
 	/** removes all animations for view */
 	void removeAnimations (CView* view);
+
+	/** adds the views which have a running animation to views */
+	void collectAnimatedViews (std::vector<CView*>& views);
 	//@}
 
 	/// @cond ignore
@@ -31,6 +31,8 @@ public:
 	/** Create an image with a given size and scale factor */
 	CBitmap (CPoint size, double scaleFactor = 1.);
 	explicit CBitmap (const PlatformBitmapPtr& platformBitmap);
+	/** Create an image from a resource identifier with an already loaded platform bitmap */
+	CBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap);
 	~CBitmap () noexcept override = default;
 
 	//-----------------------------------------------------------------------------
@@ -104,6 +106,8 @@ public:
 
 	CMultiFrameBitmap (const CResourceDescription& desc,
 					   CMultiFrameBitmapDescription multiFrameDesc);
+	CMultiFrameBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap,
+					   CMultiFrameBitmapDescription multiFrameDesc);
 
 	/** set the multi frame description
 	 *
@@ -210,6 +214,8 @@ class CNinePartTiledBitmap : public CBitmap
 public:
 	CNinePartTiledBitmap (const CResourceDescription& desc, const CNinePartTiledDescription& offsets);
 	CNinePartTiledBitmap (const PlatformBitmapPtr& platformBitmap, const CNinePartTiledDescription& offsets);
+	CNinePartTiledBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap,
+						  const CNinePartTiledDescription& offsets);
 	~CNinePartTiledBitmap () noexcept override = default;
 	
 	//-----------------------------------------------------------------------------
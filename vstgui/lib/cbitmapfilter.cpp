@@ -9,8 +9,12 @@
 #include "cgraphicspath.h"
 #include "cgraphicstransform.h"
 #include "malloc.h"
+#include "parallelfor.h"
+#include "detail/bitmapfiltersimd.h"
 #include <cassert>
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <climits>
 
@@ -279,6 +283,60 @@ bool Factory::unregisterFilter (IdStringPtr name, IFilter::CreateFunction create
 	return true;
 }
 
+//----------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------
+//----------------------------------------------------------------------------------------------------
+static std::atomic<Implementation>& implementationSetting ()
+{
+	static std::atomic<Implementation> gImplementation {getFastestImplementation ()};
+	return gImplementation;
+}
+
+//----------------------------------------------------------------------------------------------------
+Implementation getFastestImplementation ()
+{
+#if VSTGUI_BITMAPFILTER_SIMD
+	if (Detail::hasAVX2 ())
+		return Implementation::AVX2;
+	if (Detail::hasSSE2 ())
+		return Implementation::SSE2;
+#endif
+	return Implementation::Scalar;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool isSupported (Implementation impl)
+{
+	return static_cast<int> (impl) <= static_cast<int> (getFastestImplementation ());
+}
+
+//----------------------------------------------------------------------------------------------------
+void setImplementation (Implementation impl)
+{
+	implementationSetting ().store (isSupported (impl) ? impl : getFastestImplementation ());
+}
+
+//----------------------------------------------------------------------------------------------------
+Implementation getImplementation ()
+{
+	return implementationSetting ().load ();
+}
+
+//----------------------------------------------------------------------------------------------------
+static std::atomic<uint32_t> gMaxNumThreads {0};
+
+//----------------------------------------------------------------------------------------------------
+void setMaxNumThreads (uint32_t numThreads)
+{
+	gMaxNumThreads.store (numThreads);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t getMaxNumThreads ()
+{
+	return gMaxNumThreads.load ();
+}
+
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
@@ -389,6 +447,82 @@ CBitmap* FilterBase::getInputBitmap () const
 ///@cond ignore
 namespace Standard {
 
+//----------------------------------------------------------------------------------------------------
+/** Splits [0, count) into bands and calls proc (begin, end) for them via parallelFor.
+ *
+ *	Creates at most one band per thread and no bands smaller than minBandSize, the band size is a
+ *	multiple of alignment.
+ */
+static void forEachBand (uint32_t count, uint32_t minBandSize, uint32_t alignment,
+                         const std::function<void (uint32_t begin, uint32_t end)>& proc)
+{
+	auto numThreads = getMaxNumThreads ();
+	if (numThreads == 0)
+		numThreads = static_cast<uint32_t> (getParallelForConcurrency ());
+	auto bandSize = std::max ((count + numThreads - 1) / numThreads, std::max (minBandSize, 1u));
+	bandSize = (bandSize + alignment - 1) / alignment * alignment;
+	auto numBands = (count + bandSize - 1) / bandSize;
+	if (numBands <= 1)
+	{
+		proc (0, count);
+		return;
+	}
+	parallelFor (numBands, [&] (size_t band) {
+		auto begin = static_cast<uint32_t> (band) * bandSize;
+		proc (begin, std::min (begin + bandSize, count));
+	});
+}
+
+//----------------------------------------------------------------------------------------------------
+/** the minimum number of rows of a band, so that small bitmaps are not worth waking up threads */
+static uint32_t minBandSize (uint32_t rowLength)
+{
+	constexpr uint32_t kMinPixelsPerBand = 16384;
+	return std::max (kMinPixelsPerBand / std::max (rowLength, 1u), 1u);
+}
+
+#if VSTGUI_BITMAPFILTER_SIMD
+//----------------------------------------------------------------------------------------------------
+/** the bit positions of the color components in a native pixel read as uint32_t (little endian) */
+struct PixelLayout
+{
+	explicit PixelLayout (IPlatformBitmapPixelAccess::PixelFormat format)
+	{
+		switch (format)
+		{
+			case IPlatformBitmapPixelAccess::kARGB: setBytePositions (1, 2, 3, 0); break;
+			case IPlatformBitmapPixelAccess::kRGBA: setBytePositions (0, 1, 2, 3); break;
+			case IPlatformBitmapPixelAccess::kABGR: setBytePositions (3, 2, 1, 0); break;
+			case IPlatformBitmapPixelAccess::kBGRA: setBytePositions (2, 1, 0, 3); break;
+		}
+	}
+
+	uint32_t encode (const CColor& color) const
+	{
+		return (static_cast<uint32_t> (color.red) << redShift) |
+		       (static_cast<uint32_t> (color.green) << greenShift) |
+		       (static_cast<uint32_t> (color.blue) << blueShift) |
+		       (static_cast<uint32_t> (color.alpha) << alphaShift);
+	}
+
+	uint32_t getAlphaMask () const { return 0xffu << alphaShift; }
+
+	int32_t redShift {0};
+	int32_t greenShift {0};
+	int32_t blueShift {0};
+	int32_t alphaShift {0};
+
+private:
+	void setBytePositions (int32_t red, int32_t green, int32_t blue, int32_t alpha)
+	{
+		redShift = red * 8;
+		greenShift = green * 8;
+		blueShift = blue * 8;
+		alphaShift = alpha * 8;
+	}
+};
+#endif // VSTGUI_BITMAPFILTER_SIMD
+
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
@@ -462,6 +596,12 @@ private:
 		auto outputAddressPtr = outputPbpa->getAddress ();
 		auto width = inputPbpa->getBytesPerRow () / 4;
 		auto height = inputAccessor.getBitmapHeight ();
+#if VSTGUI_BITMAPFILTER_SIMD
+		if (runVectorized (*inputPbpa, *outputPbpa, static_cast<int32_t> (width),
+		                   static_cast<int32_t> (height), static_cast<int32_t> (radius / 2),
+		                   alphaChannelOnly))
+			return;
+#endif
 		if (alphaChannelOnly)
 		{
 			switch (inputPbpa->getPixelFormat ())
@@ -487,6 +627,41 @@ private:
 		}
 	}
 
+#if VSTGUI_BITMAPFILTER_SIMD
+	bool runVectorized (IPlatformBitmapPixelAccess& input, IPlatformBitmapPixelAccess& output,
+	                    int32_t width, int32_t height, int32_t radius, bool alphaChannelOnly)
+	{
+		using namespace Detail::BitmapFilterSIMD;
+
+		auto impl = getImplementation ();
+		if (impl == Implementation::Scalar || input.getPixelFormat () != output.getPixelFormat () ||
+		    input.getBytesPerRow () != output.getBytesPerRow ())
+			return false;
+		// the scalar version reads outside of the bitmap if the radius is not smaller than the
+		// height, and the kernels divide in float which is only exact for divisors below 65536
+		if (radius <= 0 || radius >= height || radius + radius + 1 >= 65536)
+			return false;
+		auto writeMask = alphaChannelOnly ? PixelLayout (input.getPixelFormat ()).getAlphaMask () :
+		                                    0xffffffffu;
+		auto inPixel = reinterpret_cast<const uint32_t*> (input.getAddress ());
+		auto outPixel = reinterpret_cast<uint32_t*> (output.getAddress ());
+		rows.allocate (static_cast<size_t> (width) * static_cast<size_t> (height));
+		forEachBand (height, minBandSize (width), 1, [&] (uint32_t begin, uint32_t end) {
+			boxBlurRowsSSE2 (inPixel, rows.get (), width, begin, end, radius);
+		});
+		// bands of 16 columns don't share cache lines of the output
+		forEachBand (width, minBandSize (height), 16, [&] (uint32_t begin, uint32_t end) {
+			if (impl == Implementation::AVX2)
+				boxBlurColumnsAVX2 (rows.get (), outPixel, width, height, begin, end, radius, writeMask);
+			else
+				boxBlurColumnsSSE2 (rows.get (), outPixel, width, height, begin, end, radius, writeMask);
+		});
+		return true;
+	}
+
+	Buffer<uint32_t> rows;
+#endif
+
 	Buffer<uint8_t> pc0;
 	Buffer<uint8_t> pc1;
 	Buffer<uint8_t> pc2;
@@ -500,12 +675,6 @@ private:
 	{
 		vstgui_assert (radius > 0);
 
-		constexpr int32_t pos0 = 0;
-		constexpr int32_t pos1 = 1;
-		constexpr int32_t pos2 = 2;
-		constexpr int32_t pos3 = 3;
-		constexpr int32_t numComponents = 4;
-
 		int32_t wm = width - 1;
 		int32_t hm = height - 1;
 		int32_t areaSize = width * height;
@@ -526,8 +695,42 @@ private:
 		for (auto i = 0u; i < dv.size (); ++i)
 			dv[i] = (i / div);
 
+		// the two passes are separable, the horizontal one is split into bands of rows and the
+		// vertical one into bands of columns
+		for (auto x = 0; x < width; ++x)
+		{
+			vMin[x] = std::min (x + radius + 1, wm);
+			vMax[x] = std::max (x - radius, 0);
+		}
+		forEachBand (height, minBandSize (width), 1, [&] (uint32_t begin, uint32_t end) {
+			horizontalPass<plane0, plane1, plane2, plane3> (inPixel, width, radius, begin, end);
+		});
+
+		for (auto y = 0; y < height; ++y)
+		{
+			vMin[y] = std::min (y + radius + 1, hm) * width;
+			vMax[y] = std::max (y - radius, 0) * width;
+		}
+		forEachBand (width, minBandSize (height), 16, [&] (uint32_t begin, uint32_t end) {
+			verticalPass<plane0, plane1, plane2, plane3> (outPixel, width, height, radius, begin, end);
+		});
+	}
+
+	template<bool plane0, bool plane1, bool plane2, bool plane3>
+	void horizontalPass (const uint8_t* inPixel, int32_t width, int32_t radius, int32_t rowBegin,
+	                     int32_t rowEnd)
+	{
+		constexpr int32_t pos0 = 0;
+		constexpr int32_t pos1 = 1;
+		constexpr int32_t pos2 = 2;
+		constexpr int32_t pos3 = 3;
+		constexpr int32_t numComponents = 4;
+
+		int32_t wm = width - 1;
+
 		int32_t sum0, sum1, sum2, sum3;
-		for (auto y = 0, yw = 0, yi = 0; y < height; ++y, yw += width)
+		for (auto y = rowBegin, yw = rowBegin * width, yi = rowBegin * width; y < rowEnd;
+		     ++y, yw += width)
 		{
 			sum0 = sum1 = sum2 = sum3 = 0;
 			for (auto i = -radius; i <= radius; i++)
@@ -542,97 +745,42 @@ private:
 				if (plane3)
 					sum3 += inPixel[p + pos3];
 			}
-			if (y == 0)
-			{
-				for (auto x = 0; x < width; ++x, ++yi)
-				{
-					if (plane0)
-						pc0[yi] = dv[sum0];
-					if (plane1)
-						pc1[yi] = dv[sum1];
-					if (plane2)
-						pc2[yi] = dv[sum2];
-					if (plane3)
-						pc3[yi] = dv[sum3];
-					vMin[x] = std::min (x + radius + 1, wm);
-					vMax[x] = std::max (x - radius, 0);
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
-					if (plane0)
-						sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
-					if (plane1)
-						sum1 += inPixel[p1 + pos1] - inPixel[p2 + pos1];
-					if (plane2)
-						sum2 += inPixel[p1 + pos2] - inPixel[p2 + pos2];
-					if (plane3)
-						sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
-				}
-			}
-			else
+			for (auto x = 0; x < width; ++x, ++yi)
 			{
-				for (auto x = 0; x < width; ++x, ++yi)
-				{
-					if (plane0)
-						pc0[yi] = dv[sum0];
-					if (plane1)
-						pc1[yi] = dv[sum1];
-					if (plane2)
-						pc2[yi] = dv[sum2];
-					if (plane3)
-						pc3[yi] = dv[sum3];
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
-					if (plane0)
-						sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
-					if (plane1)
-						sum1 += inPixel[p1 + pos1] - inPixel[p2 + pos1];
-					if (plane2)
-						sum2 += inPixel[p1 + pos2] - inPixel[p2 + pos2];
-					if (plane3)
-						sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
-				}
+				if (plane0)
+					pc0[yi] = dv[sum0];
+				if (plane1)
+					pc1[yi] = dv[sum1];
+				if (plane2)
+					pc2[yi] = dv[sum2];
+				if (plane3)
+					pc3[yi] = dv[sum3];
+				auto p1 = (yw + vMin[x]) * numComponents;
+				auto p2 = (yw + vMax[x]) * numComponents;
+				if (plane0)
+					sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
+				if (plane1)
+					sum1 += inPixel[p1 + pos1] - inPixel[p2 + pos1];
+				if (plane2)
+					sum2 += inPixel[p1 + pos2] - inPixel[p2 + pos2];
+				if (plane3)
+					sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
 			}
 		}
+	}
 
-		sum0 = sum1 = sum2 = sum3 = 0;
-		for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
-		{
-			auto yi = std::max (0, yp);
-			if (plane0)
-				sum0 += pc0[yi];
-			if (plane1)
-				sum1 += pc1[yi];
-			if (plane2)
-				sum2 += pc2[yi];
-			if (plane3)
-				sum3 += pc3[yi];
-		}
-		for (auto y = 0, yi = 0; y < height; ++y, yi += width)
-		{
-			auto pos = yi * numComponents;
-			if (plane0)
-				outPixel[pos + pos0] = dv[sum0];
-			if (plane1)
-				outPixel[pos + pos1] = dv[sum1];
-			if (plane2)
-				outPixel[pos + pos2] = dv[sum2];
-			if (plane3)
-				outPixel[pos + pos3] = dv[sum3];
-			vMin[y] = std::min (y + radius + 1, hm) * width;
-			vMax[y] = std::max (y - radius, 0) * width;
-			auto p1 = vMin[y];
-			auto p2 = vMax[y];
-			if (plane0)
-				sum0 += pc0[p1] - pc0[p2];
-			if (plane1)
-				sum1 += pc1[p1] - pc1[p2];
-			if (plane2)
-				sum2 += pc2[p1] - pc2[p2];
-			if (plane3)
-				sum3 += pc3[p1] - pc3[p2];
-		}
+	template<bool plane0, bool plane1, bool plane2, bool plane3>
+	void verticalPass (uint8_t* outPixel, int32_t width, int32_t height, int32_t radius,
+	                   int32_t columnBegin, int32_t columnEnd)
+	{
+		constexpr int32_t pos0 = 0;
+		constexpr int32_t pos1 = 1;
+		constexpr int32_t pos2 = 2;
+		constexpr int32_t pos3 = 3;
+		constexpr int32_t numComponents = 4;
 
-		for (auto x = 1; x < width; ++x)
+		int32_t sum0, sum1, sum2, sum3;
+		for (auto x = columnBegin; x < columnEnd; ++x)
 		{
 			sum0 = sum1 = sum2 = sum3 = 0;
 			for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
@@ -744,30 +892,38 @@ private:
 		uint32_t origBytesPerRow = originalBitmap.getPlatformBitmapPixelAccess ()->getBytesPerRow ();
 		uint32_t copyBytesPerRow = copyBitmap.getPlatformBitmapPixelAccess ()->getBytesPerRow ();
 
-		int32_t ix;
-		int32_t iy = -1;
-		int32_t* origPixel = nullptr;
+		// the source rows are accumulated like the columns, so they are collected before the rows
+		// are split into bands
+		origRows.allocate (newHeight);
 		float origY = 0;
-		float origX = 0;
 		for (uint32_t y = 0; y < newHeight; y++, origY += yRatio)
-		{
-			int32_t* copyPixel = (int32_t*)(copyAddress + y * copyBytesPerRow);
-			if (iy != (int32_t)origY)
-				iy = (int32_t)origY;
-			ix = -1;
-			origX = 0;
-			for (uint32_t x = 0; x < newWidth; x++, origX += xRatio, copyPixel++)
+			origRows[y] = (int32_t)origY;
+
+		forEachBand (newHeight, minBandSize (newWidth), 1, [&] (uint32_t begin, uint32_t end) {
+			int32_t ix;
+			int32_t* origPixel = nullptr;
+			float origX = 0;
+			for (uint32_t y = begin; y < end; y++)
 			{
-				if (ix != (int32_t)origX || origPixel == nullptr)
+				int32_t* copyPixel = (int32_t*)(copyAddress + y * copyBytesPerRow);
+				int32_t iy = origRows[y];
+				ix = -1;
+				origX = 0;
+				for (uint32_t x = 0; x < newWidth; x++, origX += xRatio, copyPixel++)
 				{
-					ix = (int32_t)origX;
-					vstgui_assert (iy >= 0);
-					origPixel = (int32_t*)(origAddress + static_cast<uint32_t> (iy) * origBytesPerRow + ix * 4);
+					if (ix != (int32_t)origX || origPixel == nullptr)
+					{
+						ix = (int32_t)origX;
+						vstgui_assert (iy >= 0);
+						origPixel = (int32_t*)(origAddress + static_cast<uint32_t> (iy) * origBytesPerRow + ix * 4);
+					}
+					*copyPixel = *origPixel;
 				}
-				*copyPixel = *origPixel;
 			}
-		}
+		});
 	}
+
+	Buffer<int32_t> origRows;
 };
 
 //----------------------------------------------------------------------------------------------------
@@ -782,8 +938,74 @@ public:
 private:
 	ScaleBiliniear () : ScaleBase ("A Biliniear Scale Filter") {}
 
+#if VSTGUI_BITMAPFILTER_SIMD
+	bool processVectorized (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap)
+	{
+		using namespace Detail::BitmapFilterSIMD;
+
+		auto impl = getImplementation ();
+		auto origPbpa = originalBitmap.getPlatformBitmapPixelAccess ();
+		auto copyPbpa = copyBitmap.getPlatformBitmapPixelAccess ();
+		if (impl == Implementation::Scalar || origPbpa->getPixelFormat () != copyPbpa->getPixelFormat ())
+			return false;
+
+		uint32_t origWidth = (uint32_t)originalBitmap.getBitmapWidth ();
+		uint32_t origHeight = (uint32_t)originalBitmap.getBitmapHeight ();
+		uint32_t newWidth = (uint32_t)copyBitmap.getBitmapWidth ();
+		uint32_t newHeight = (uint32_t)copyBitmap.getBitmapHeight ();
+
+		// same positions and weights as in the scalar version
+		float xRatio = ((float)(origWidth-1)) / (float)newWidth;
+		float yRatio = ((float)(origHeight-1)) / (float)newHeight;
+		// the kernels always interpolate with the next pixel and the next row, the scalar version
+		// handles the bitmaps where these are outside of the bitmap
+		if (static_cast<uint32_t> (yRatio * (newHeight - 1)) + 1 >= origHeight)
+			return false;
+		xIndex.allocate (newWidth);
+		xDiff.allocate (newWidth);
+		for (uint32_t j = 0; j < newWidth; j++)
+		{
+			auto x = static_cast<uint32_t> (xRatio * j);
+			if (x + 1 >= origWidth)
+				return false;
+			xIndex[j] = x;
+			xDiff[j] = (xRatio * j) - x;
+		}
+
+		auto origAddress = origPbpa->getAddress ();
+		auto copyAddress = copyPbpa->getAddress ();
+		auto origBytesPerRow = origPbpa->getBytesPerRow ();
+		auto copyBytesPerRow = copyPbpa->getBytesPerRow ();
+		forEachBand (newHeight, minBandSize (newWidth), 1, [&] (uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; i++)
+			{
+				auto y = static_cast<uint32_t> (yRatio * i);
+				float yDiff = (yRatio * i) - y;
+				auto row0 = reinterpret_cast<const uint32_t*> (origAddress + y * origBytesPerRow);
+				auto row1 =
+					reinterpret_cast<const uint32_t*> (origAddress + (y + 1) * origBytesPerRow);
+				auto output = reinterpret_cast<uint32_t*> (copyAddress + i * copyBytesPerRow);
+				if (impl == Implementation::AVX2)
+					scaleBilinearRowAVX2 (row0, row1, output, newWidth, xIndex.get (), xDiff.get (),
+					                      yDiff);
+				else
+					scaleBilinearRowSSE2 (row0, row1, output, newWidth, xIndex.get (), xDiff.get (),
+					                      yDiff);
+			}
+		});
+		return true;
+	}
+
+	Buffer<uint32_t> xIndex;
+	Buffer<float> xDiff;
+#endif
+
 	void process (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap) override
 	{
+#if VSTGUI_BITMAPFILTER_SIMD
+		if (processVectorized (originalBitmap, copyBitmap))
+			return;
+#endif
 		originalBitmap.setPosition (0, 0);
 		copyBitmap.setPosition (0, 0);
 
@@ -875,8 +1097,47 @@ protected:
 		return registerProperty (Property::kOutputBitmap, BitmapFilter::Property (outputBitmap));
 	}
 
+#if VSTGUI_BITMAPFILTER_SIMD
+	using PixelRowProc = std::function<void (const uint32_t* input, uint32_t* output, size_t numPixels)>;
+
+	/** the vectorized version of the process function for a row of native pixels, can be empty */
+	virtual PixelRowProc getPixelRowProc (const PixelLayout& layout, Implementation impl)
+	{
+		return {};
+	}
+
+	bool runVectorized (CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor)
+	{
+		auto impl = getImplementation ();
+		if (impl == Implementation::Scalar)
+			return false;
+		auto inputPbpa = inputAccessor.getPlatformBitmapPixelAccess ();
+		auto outputPbpa = outputAccessor.getPlatformBitmapPixelAccess ();
+		if (inputPbpa->getPixelFormat () != outputPbpa->getPixelFormat ())
+			return false;
+		auto proc = getPixelRowProc (PixelLayout (inputPbpa->getPixelFormat ()), impl);
+		if (!proc)
+			return false;
+		auto width = inputAccessor.getBitmapWidth ();
+		forEachBand (inputAccessor.getBitmapHeight (), minBandSize (width), 1,
+		             [&] (uint32_t begin, uint32_t end) {
+			for (auto y = begin; y < end; ++y)
+			{
+				proc (reinterpret_cast<const uint32_t*> (inputPbpa->getAddress () + y * inputPbpa->getBytesPerRow ()),
+				      reinterpret_cast<uint32_t*> (outputPbpa->getAddress () + y * outputPbpa->getBytesPerRow ()),
+				      width);
+			}
+		});
+		return true;
+	}
+#endif
+
 	void run (CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor)
 	{
+#if VSTGUI_BITMAPFILTER_SIMD
+		if (runVectorized (inputAccessor, outputAccessor))
+			return;
+#endif
 		inputAccessor.setPosition (0, 0);
 		outputAccessor.setPosition (0, 0);
 		CColor color;
@@ -933,6 +1194,21 @@ private:
 		color = filter->inputColor;
 	}
 
+#if VSTGUI_BITMAPFILTER_SIMD
+	PixelRowProc getPixelRowProc (const PixelLayout& layout, Implementation impl) override
+	{
+		auto keepMask = ignoreAlpha ? layout.getAlphaMask () : 0u;
+		auto color = layout.encode (inputColor) & ~keepMask;
+		if (impl == Implementation::AVX2)
+			return [=] (const uint32_t* input, uint32_t* output, size_t numPixels) {
+				Detail::BitmapFilterSIMD::setColorAVX2 (input, output, numPixels, color, keepMask);
+			};
+		return [=] (const uint32_t* input, uint32_t* output, size_t numPixels) {
+			Detail::BitmapFilterSIMD::setColorSSE2 (input, output, numPixels, color, keepMask);
+		};
+	}
+#endif
+
 	bool ignoreAlpha;
 	CColor inputColor;
 
@@ -971,6 +1247,22 @@ private:
 		color.red = color.green = color.blue = color.getLuma ();
 	}
 
+#if VSTGUI_BITMAPFILTER_SIMD
+	PixelRowProc getPixelRowProc (const PixelLayout& layout, Implementation impl) override
+	{
+		auto alphaMask = layout.getAlphaMask ();
+		if (impl == Implementation::AVX2)
+			return [=] (const uint32_t* input, uint32_t* output, size_t numPixels) {
+				Detail::BitmapFilterSIMD::grayscaleAVX2 (input, output, numPixels, layout.redShift,
+				                                         layout.greenShift, layout.blueShift, alphaMask);
+			};
+		return [=] (const uint32_t* input, uint32_t* output, size_t numPixels) {
+			Detail::BitmapFilterSIMD::grayscaleSSE2 (input, output, numPixels, layout.redShift,
+			                                         layout.greenShift, layout.blueShift, alphaMask);
+		};
+	}
+#endif
+
 };
 
 //----------------------------------------------------------------------------------------------------
@@ -999,6 +1291,21 @@ private:
 			color = filter->outputColor;
 	}
 
+#if VSTGUI_BITMAPFILTER_SIMD
+	PixelRowProc getPixelRowProc (const PixelLayout& layout, Implementation impl) override
+	{
+		auto from = layout.encode (inputColor);
+		auto to = layout.encode (outputColor);
+		if (impl == Implementation::AVX2)
+			return [=] (const uint32_t* input, uint32_t* output, size_t numPixels) {
+				Detail::BitmapFilterSIMD::replaceColorAVX2 (input, output, numPixels, from, to);
+			};
+		return [=] (const uint32_t* input, uint32_t* output, size_t numPixels) {
+			Detail::BitmapFilterSIMD::replaceColorSSE2 (input, output, numPixels, from, to);
+		};
+	}
+#endif
+
 	CColor inputColor;
 	CColor outputColor;
 
@@ -107,6 +107,37 @@ protected:
 	FilterMap filters;
 };
 
+//----------------------------------------------------------------------------------------------------
+/** Implementation of the pixel loops of the standard filters.
+
+	The SIMD implementations work directly on the pixel buffer of the platform bitmap and produce
+	the same pixels as the scalar implementation. By default the standard filters use the fastest
+	implementation the CPU supports.
+*/
+enum class Implementation
+{
+	Scalar,
+	SSE2,
+	AVX2
+};
+
+/** the fastest implementation supported by the CPU */
+Implementation getFastestImplementation ();
+/** returns true if the CPU supports the implementation */
+bool isSupported (Implementation impl);
+/** set the implementation the standard filters use. An unsupported implementation selects the fastest
+	supported one */
+void setImplementation (Implementation impl);
+/** the implementation the standard filters use */
+Implementation getImplementation ();
+
+/** set the maximum number of threads the standard filters split their work to. The filters process
+	bands of rows (or columns for the vertical pass of the box blur) via parallelFor. 0 (the default)
+	uses all threads of parallelFor, 1 runs the filters on the calling thread only */
+void setMaxNumThreads (uint32_t numThreads);
+/** the maximum number of threads the standard filters use, 0 means all threads of parallelFor */
+uint32_t getMaxNumThreads ();
+
 /** @brief Standard Bitmap Filter Names */
 namespace Standard {
 
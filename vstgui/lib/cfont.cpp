@@ -124,7 +124,6 @@ as long as it is available on the system. You should cache your own CFontDesc as
 CFontDesc::CFontDesc (const UTF8String& inName, const CCoord& inSize, const int32_t inStyle)
 : size (inSize)
 , style (inStyle)
-, platformFont (nullptr)
 {
 	setName (inName);
 }
@@ -133,7 +132,6 @@ CFontDesc::CFontDesc (const UTF8String& inName, const CCoord& inSize, const int3
 CFontDesc::CFontDesc (const CFontDesc& font)
 : size (0)
 , style (0)
-, platformFont (nullptr)
 {
 	*this = font;
 }
@@ -153,9 +151,9 @@ void CFontDesc::beforeDelete ()
 //-----------------------------------------------------------------------------
 auto CFontDesc::getPlatformFont () const -> const PlatformFontPtr
 {
-	if (platformFont == nullptr)
-		platformFont = getPlatformFactory ().createFont (name, size, style);
-	return platformFont;
+	// views drawn on multiple threads (see CFrame::setTiledDrawingEnabled) may share a font
+	return platformFont.getOrCreate (
+		[this] () { return getPlatformFactory ().createFont (name, size, style); });
 }
 
 //-----------------------------------------------------------------------------
@@ -170,7 +168,7 @@ const IFontPainter* CFontDesc::getFontPainter () const
 //-----------------------------------------------------------------------------
 void CFontDesc::freePlatformFont ()
 {
-	platformFont = nullptr;
+	platformFont.reset ();
 }
 
 //-----------------------------------------------------------------------------
@@ -58,7 +58,7 @@ protected:
 	UTF8String name;
 	CCoord size;
 	int32_t style;
-	mutable PlatformFontPtr platformFont;
+	Detail::LazySharedPointer<IPlatformFont> platformFont;
 };
 
 //-----------------------------------------------------------------------------
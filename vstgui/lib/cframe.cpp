@@ -8,6 +8,7 @@
 #include "coffscreencontext.h"
 #include "ctooltipsupport.h"
 #include "cinvalidrectlist.h"
+#include "parallelfor.h"
 #include "itouchevent.h"
 #include "iscalefactorchangedlistener.h"
 #include "idatapackage.h"
@@ -16,6 +17,7 @@
 #include "platform/platformfactory.h"
 #include "platform/iplatformframe.h"
 #include <cassert>
+#include <cmath>
 #include <vector>
 #include <queue>
 #include <stack>
@@ -89,6 +91,7 @@ struct CFrame::Impl
 	bool active {false};
 	bool windowActive {false};
 	bool inEventHandling {false};
+	bool tiledDrawing {false};
 	BitmapInterpolationQuality bitmapQuality {BitmapInterpolationQuality::kDefault};
 
 	struct PostEventHandler
@@ -234,8 +237,7 @@ bool CFrame::attached (CView* parent)
 	{
 		setParentView (nullptr);
 
-		for (const auto& pV : getChildren ())
-			pV->attached (this);
+		forEachChild ([this] (CView* pV) { pV->attached (this); });
 		
 		return true;
 	}
@@ -808,6 +810,12 @@ Animation::Animator* CFrame::getAnimator ()
 	return pImpl->animator;
 }
 
+//-----------------------------------------------------------------------------
+Animation::Animator* CFrame::getExistingAnimator () const
+{
+	return pImpl->animator;
+}
+
 //-----------------------------------------------------------------------------
 /**
  * @return tick count in milliseconds
@@ -1654,6 +1662,18 @@ VSTGUIEditorInterface* CFrame::getEditor () const
 	return pImpl->editor;
 }
 
+//-----------------------------------------------------------------------------
+void CFrame::setTiledDrawingEnabled (bool state)
+{
+	pImpl->tiledDrawing = state;
+}
+
+//-----------------------------------------------------------------------------
+bool CFrame::tiledDrawingEnabled () const
+{
+	return pImpl->tiledDrawing;
+}
+
 //-----------------------------------------------------------------------------
 IPlatformFrame* CFrame::getPlatformFrame () const
 {
@@ -1665,10 +1685,105 @@ void CFrame::platformDrawRects (const PlatformGraphicsDeviceContextPtr& context,
 								const std::vector<CRect>& rects)
 {
 	CDrawContext drawContext (context, getViewSize (), scaleFactor);
+	if (pImpl->tiledDrawing)
+	{
+		drawTiled (drawContext, scaleFactor, rects);
+		return;
+	}
 	for (auto rect : rects)
 		drawRect (&drawContext, rect);
 }
 
+//-----------------------------------------------------------------------------
+static bool prepareViewsForConcurrentDrawing (CView* view, const CRect& updateRect)
+{
+	// walks the views like CViewContainer::drawRect does and checks if all views which would be
+	// drawn can be drawn on a background thread. The dirty flag of those views is reset and the
+	// containers build their draw state here on the main thread, so that their draw methods don't
+	// change any state.
+	if (!view->getThreadSafeDrawing ())
+		return false;
+	view->setDirty (false);
+	auto container = view->asViewContainer ();
+	if (!container)
+		return true;
+	if (!container->prepareConcurrentDrawing ())
+		return false;
+	CRect clientRect (updateRect);
+	clientRect.bound (container->getViewSize ());
+	clientRect.offset (-container->getViewSize ().left, -container->getViewSize ().top);
+	container->getTransform ().inverse ().transform (clientRect);
+	bool result = true;
+	container->forEachChild ([&] (CView* child) {
+		if (result && child->isVisible () && child->checkUpdate (clientRect))
+			result = prepareViewsForConcurrentDrawing (child, clientRect);
+	});
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::drawTiled (CDrawContext& drawContext, double scaleFactor,
+						const std::vector<CRect>& rects)
+{
+	struct Tile
+	{
+		CRect rect;
+		SharedPointer<COffscreenContext> offscreen;
+	};
+	std::vector<Tile> tiles;
+
+	// a focus ring is drawn by the container of the focus view and changes its state
+	bool drawConcurrently = !(focusDrawingEnabled () && getFocusView ());
+	for (auto rect : rects)
+	{
+		// align to device pixels so that the composited tiles don't need to be interpolated
+		rect.bound (getViewSize ());
+		rect.left = std::floor (rect.left * scaleFactor) / scaleFactor;
+		rect.top = std::floor (rect.top * scaleFactor) / scaleFactor;
+		rect.right = std::ceil (rect.right * scaleFactor) / scaleFactor;
+		rect.bottom = std::ceil (rect.bottom * scaleFactor) / scaleFactor;
+		if (rect.isEmpty ())
+			continue;
+		for (auto y = std::floor (rect.top / kDrawTileSize) * kDrawTileSize; y < rect.bottom;
+			 y += kDrawTileSize)
+		{
+			for (auto x = std::floor (rect.left / kDrawTileSize) * kDrawTileSize; x < rect.right;
+				 x += kDrawTileSize)
+			{
+				CRect tile (x, y, x + kDrawTileSize, y + kDrawTileSize);
+				tile.bound (rect);
+				if (tile.isEmpty ())
+					continue;
+				Tile t {tile};
+				if (drawConcurrently && prepareViewsForConcurrentDrawing (this, tile))
+					t.offscreen = COffscreenContext::create (tile.getSize (), scaleFactor);
+				tiles.emplace_back (std::move (t));
+			}
+		}
+	}
+
+	parallelFor (tiles.size (), [&] (size_t index) {
+		auto& tile = tiles[index];
+		if (!tile.offscreen)
+			return;
+		tile.offscreen->beginDraw ();
+		{
+			CDrawContext::Transform transform (
+				*tile.offscreen, CGraphicsTransform ().translate (-tile.rect.left, -tile.rect.top));
+			drawRect (tile.offscreen, tile.rect);
+		}
+		tile.offscreen->endDraw ();
+	});
+
+	for (auto& tile : tiles)
+	{
+		if (tile.offscreen)
+			drawContext.drawBitmap (tile.offscreen->getBitmap (), tile.rect);
+		else
+			drawRect (&drawContext, tile.rect);
+	}
+}
+
 //-----------------------------------------------------------------------------
 void CFrame::platformOnEvent (Event& event)
 {
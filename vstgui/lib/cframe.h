@@ -124,6 +124,8 @@ public:
 
 	/** get animator for this frame */
 	Animation::Animator* getAnimator ();
+	/** get animator for this frame if it was already created, does not create one */
+	Animation::Animator* getExistingAnimator () const;
 
 	/** get the clipboard data. data is owned by the caller */
 	SharedPointer<IDataPackage> getClipboard ();
@@ -184,6 +186,24 @@ public:
 	CCoord getFocusWidth () const;
 	//@}
 
+	//-----------------------------------------------------------------------------
+	/// @name Tiled Drawing Methods
+	//! If tiled drawing is enabled, the dirty regions are split into tiles which are rendered on
+	//! multiple threads into offscreen bitmaps and then composited. A tile is only rendered on a
+	//! background thread if the frame and all views intersecting it draw thread safe (see
+	//! CView::setThreadSafeDrawing), no container intersecting it caches as bitmap and no focus
+	//! ring is drawn, all other tiles are drawn on the main thread as before. A tile covers the
+	//! same pixels as drawing its rect without tiling.
+	//-----------------------------------------------------------------------------
+	//@{
+	/** enable tiled drawing */
+	void setTiledDrawingEnabled (bool state);
+	/** is tiled drawing enabled */
+	bool tiledDrawingEnabled () const;
+	/** the edge length of the tiles in points */
+	static constexpr CCoord kDrawTileSize = 256.;
+	//@}
+
 	using EventProcessingFunction = std::function<void ()>;
 	/** Queue a function which will be executed after the current event was handled.
 	 *	Only allowed when inEventProcessing () is true
@@ -283,6 +303,7 @@ private:
 	void dispatchMouseUpEvent (MouseUpEvent& event);
 	void dispatchEvent (CView* view, Event& event);
 	void dispatchEventToChildren (Event& event);
+	void drawTiled (CDrawContext& drawContext, double scaleFactor, const std::vector<CRect>& rects);
 
 	struct Impl;
 	Impl* pImpl {nullptr};
@@ -5,14 +5,38 @@
 #pragma once
 
 #include "crect.h"
+#include <iterator>
 #include <vector>
 
 namespace VSTGUI {
 
 //-----------------------------------------------------------------------------
+/** Merge policy of a CInvalidRectList */
+struct CInvalidRectListMergePolicy
+{
+	/** the maximum number of rects in the list. When a new rect would exceed this number it is
+	 *	merged with the rect which results in the least additional area.
+	 */
+	size_t maxRects {32};
+	/** two rects are merged when the area of the united rect is not bigger than the sum of both
+	 *	areas multiplied by this ratio.
+	 */
+	double maxOverdrawRatio {1.};
+};
+
+//-----------------------------------------------------------------------------
+/** List of invalid rects
+ *
+ *	Rects added to the list are coalesced with the rects already in the list according to the
+ *	merge policy. As the number of rects is bounded, adding a rect is bounded, too.
+ */
 struct CInvalidRectList
 {
 	using RectList = std::vector<CRect>;
+	using MergePolicy = CInvalidRectListMergePolicy;
+
+	CInvalidRectList () = default;
+	explicit CInvalidRectList (const MergePolicy& policy) : policy (policy) {}
 
 	bool add (const CRect& r);
 
@@ -27,82 +51,132 @@ struct CInvalidRectList
 	const RectList& data () const { return list; }
 	bool empty () const { return list.empty (); }
 
+	void setMergePolicy (const MergePolicy& newPolicy) { policy = newPolicy; }
+	const MergePolicy& getMergePolicy () const { return policy; }
+
 private:
+	static CCoord area (const CRect& r) { return r.getWidth () * r.getHeight (); }
+
+	bool shouldMerge (const CRect& r1, const CRect& r2) const
+	{
+		CRect jr (r1);
+		jr.unite (r2);
+		return area (jr) <= (area (r1) + area (r2)) * policy.maxOverdrawRatio;
+	}
+
+	void removeAt (size_t index)
+	{
+		if (index != list.size () - 1)
+			list[index] = list.back ();
+		list.pop_back ();
+	}
+
+	void absorb (CRect& r);
+
 	RectList list;
+	MergePolicy policy;
 };
 
 //-----------------------------------------------------------------------------
 inline bool CInvalidRectList::add (const CRect& r)
 {
-	for (auto it = list.begin (), end = list.end (); it != end; ++it)
+	for (const auto& rect : list)
 	{
-		// the same rectangle is already in the list
-		if (*it == r)
-			return false;
 		// the new rectangle is part of one already in the list
-		if (it->rectInside (r))
+		if (rect.rectInside (r))
 			return false;
-		// if the new rectangle contains one of the previous rectangles
-		if (r.rectInside (*it))
-		{
-			list.erase (it);
-			return add (r);
-		}
-		// now check if the combined rect has the same or less area as both rects together
-		auto area1 = r.getWidth () * r.getHeight ();
-		auto area2 = it->getWidth () * it->getHeight ();
-		CRect jr (*it);
-		jr.unite (r);
-		auto joinedArea = jr.getWidth () * jr.getHeight ();
-		if (joinedArea <= (area1 + area2))
+	}
+	CRect newRect (r);
+	absorb (newRect);
+	while (list.size () >= policy.maxRects && !list.empty ())
+	{
+		// merge with the rect which adds the least area
+		size_t bestIndex = 0;
+		CCoord bestGrowth = 0.;
+		for (size_t i = 0; i < list.size (); ++i)
 		{
-			list.erase (it);
-			return add (jr);
+			CRect jr (list[i]);
+			jr.unite (newRect);
+			auto growth = area (jr) - area (list[i]);
+			if (i == 0 || growth < bestGrowth)
+			{
+				bestIndex = i;
+				bestGrowth = growth;
+			}
 		}
+		newRect.unite (list[bestIndex]);
+		removeAt (bestIndex);
+		absorb (newRect);
 	}
-	list.emplace_back (r);
+	list.emplace_back (newRect);
 	return true;
 }
 
 //-----------------------------------------------------------------------------
-inline void joinNearbyInvalidRects (CInvalidRectList& list, CCoord maxDistance)
+inline void CInvalidRectList::absorb (CRect& r)
 {
-	for (auto it = list.begin (); it != list.end (); ++it)
+	bool merged;
+	do
 	{
-		for (auto it2 = list.begin (); it2 != list.end (); ++it2)
+		merged = false;
+		for (size_t i = 0; i < list.size ();)
 		{
-			if (it2 == it)
+			// if the new rectangle contains one of the previous rectangles
+			if (r.rectInside (list[i]))
+			{
+				removeAt (i);
 				continue;
-			if (it->left == it2->left && it->right == it2->right)
+			}
+			// now check if the combined rect does not add too much area
+			if (shouldMerge (r, list[i]))
 			{
-				CCoord distance;
-				if (it->bottom < it2->top)
-					distance = it2->top - it->bottom;
-				else
-					distance = it->top - it2->bottom;
-				if (distance <= maxDistance)
-				{
-					it->unite (*it2);
-					list.erase (it2);
-					joinNearbyInvalidRects (list, maxDistance);
-					return;
-				}
+				r.unite (list[i]);
+				removeAt (i);
+				merged = true;
+				continue;
 			}
-			if (it->top == it2->top && it->bottom == it2->bottom)
+			++i;
+		}
+	} while (merged);
+}
+
+//-----------------------------------------------------------------------------
+inline void joinNearbyInvalidRects (CInvalidRectList& list, CCoord maxDistance)
+{
+	auto canJoin = [maxDistance] (const CRect& r1, const CRect& r2) {
+		if (r1.left == r2.left && r1.right == r2.right)
+		{
+			auto distance = r1.bottom < r2.top ? r2.top - r1.bottom : r1.top - r2.bottom;
+			if (distance <= maxDistance)
+				return true;
+		}
+		if (r1.top == r2.top && r1.bottom == r2.bottom)
+		{
+			auto distance = r1.right < r2.left ? r2.left - r1.right : r1.left - r2.right;
+			if (distance <= maxDistance)
+				return true;
+		}
+		return false;
+	};
+
+	for (auto it = list.begin (); it != list.end (); ++it)
+	{
+		// after a join the united rect may be joinable with a rect we already looked at, so
+		// we start again with the same rect instead of restarting the whole list
+		for (auto it2 = list.begin (); it2 != list.end ();)
+		{
+			if (it2 != it && canJoin (*it, *it2))
 			{
-				CCoord distance;
-				if (it->right < it2->left)
-					distance = it2->left - it->right;
-				else
-					distance = it->left - it2->right;
-				if (distance <= maxDistance)
-				{
-					it->unite (*it2);
-					list.erase (it2);
-					joinNearbyInvalidRects (list, maxDistance);
-					return;
-				}
+				it->unite (*it2);
+				auto index = std::distance (list.begin (), it);
+				if (it2 < it)
+					--index;
+				list.erase (it2);
+				it = list.begin () + index;
+				it2 = list.begin ();
+				continue;
 			}
+			++it2;
 		}
 	}
 }
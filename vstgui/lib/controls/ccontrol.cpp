@@ -270,7 +270,7 @@ void CControl::setDirty (bool val)
 		else
 			setOldValue (0.f);
 	}
-	else
+	else if (getOldValue () != value)
 		setOldValue (value);
 }
 
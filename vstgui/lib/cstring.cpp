@@ -57,7 +57,7 @@ UTF8String::UTF8String (StringType&& str) noexcept
 UTF8String& UTF8String::operator= (StringType&& str) noexcept
 {
 	string = std::move (str);
-	platformString = nullptr;
+	platformString.reset ();
 	return *this;
 }
 
@@ -96,7 +96,7 @@ UTF8String& UTF8String::operator=(const StringType& other)
 	if (string != other)
 	{
 		string = other;
-		platformString = nullptr;
+		platformString.reset ();
 	}
 	return *this;
 }
@@ -115,7 +115,7 @@ UTF8String& UTF8String::operator+= (const UTF8String& other)
 	if (!other.empty ())
 	{
 		string += other.getString ();
-		platformString = nullptr;
+		platformString.reset ();
 	}
 	return *this;
 }
@@ -124,7 +124,7 @@ UTF8String& UTF8String::operator+= (const UTF8String& other)
 UTF8String& UTF8String::operator+= (StringType::value_type ch)
 {
 	string += ch;
-	platformString = nullptr;
+	platformString.reset ();
 	return *this;
 }
 
@@ -132,7 +132,7 @@ UTF8String& UTF8String::operator+= (StringType::value_type ch)
 UTF8String& UTF8String::operator+= (const StringType::value_type* other)
 {
 	string += other;
-	platformString = nullptr;
+	platformString.reset ();
 	return *this;
 }
 
@@ -159,7 +159,7 @@ void UTF8String::assign (UTF8StringPtr str)
 {
 	if (str == nullptr || string != str)
 	{
-		platformString = nullptr;
+		platformString.reset ();
 		string = str ? str : "";
 	}
 }
@@ -168,7 +168,7 @@ void UTF8String::assign (UTF8StringPtr str)
 void UTF8String::clear () noexcept
 {
 	string.clear ();
-	platformString = nullptr;
+	platformString.reset ();
 }
 
 //-----------------------------------------------------------------------------
@@ -186,9 +186,10 @@ void UTF8String::copy (UTF8StringBuffer dst, SizeType dstSize) const noexcept
 //-----------------------------------------------------------------------------
 IPlatformString* UTF8String::getPlatformString () const noexcept
 {
-	if (platformString == nullptr)
-		platformString = getPlatformFactory ().createString (data ());
-	return platformString;
+	// a view drawn on multiple threads (see CFrame::setTiledDrawingEnabled) draws the same
+	// string on all of them
+	return platformString.getOrCreate (
+		[this] () { return getPlatformFactory ().createString (data ()); });
 }
 
 //-----------------------------------------------------------------------------
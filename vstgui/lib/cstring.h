@@ -7,6 +7,7 @@
 #include "vstguifwd.h"
 #include "optional.h"
 #include "platform/iplatformstring.h"
+#include "detail/lazysharedpointer.h"
 #include <string>
 #include <functional>
 #include <algorithm>
@@ -111,7 +112,7 @@ public:
 //-----------------------------------------------------------------------------
 private:
 	StringType string;
-	mutable PlatformStringPtr platformString;
+	Detail::LazySharedPointer<IPlatformString> platformString;
 };
 
 inline bool operator== (const UTF8String::StringType& lhs, const UTF8String& rhs) noexcept { return lhs == rhs.getString (); }
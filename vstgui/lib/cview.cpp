@@ -16,8 +16,9 @@
 #include "animation/animator.h"
 #include "../uidescription/icontroller.h"
 #include "platform/iplatformframe.h"
+#include <algorithm>
 #include <cassert>
-#include <unordered_map>
+#include <vector>
 #if DEBUG
 #include <list>
 #include <typeinfo>
@@ -56,10 +57,11 @@ public:
 #endif // VSTGUI_CHECK_VIEW_RELEASING
 
 //-----------------------------------------------------------------------------
+/** attribute data up to kInlineSize bytes (pointers, floats, points) is stored in the entry itself */
 class AttributeEntry
 {
 public:
-	AttributeEntry (uint32_t _size, const void* _data)
+	AttributeEntry (CViewAttributeID _id, uint32_t _size, const void* _data) : id (_id)
 	{
 		updateData (_size, _data);
 	}
@@ -73,23 +75,38 @@ public:
 	
 	AttributeEntry& operator=(AttributeEntry&& me) noexcept
 	{
+		id = me.id;
+		size = me.size;
+		std::memcpy (inlineData, me.inlineData, sizeof (inlineData));
 		data = std::move (me.data);
 		return *this;
 	}
 	
-	uint32_t getSize () const { return static_cast<uint32_t> (data.size ()); }
-	const void* getData () const { return data.get (); }
+	CViewAttributeID getID () const { return id; }
+	uint32_t getSize () const { return size; }
+	const void* getData () const { return size <= kInlineSize ? inlineData : data.get (); }
 	
 	void updateData (uint32_t _size, const void* _data)
 	{
-		data.allocate (_size);
-		if (!data.empty ())
+		size = _size;
+		if (size <= kInlineSize)
 		{
-			std::memcpy (data.get (), _data, data.size ());
+			data.deallocate ();
+			std::memcpy (inlineData, _data, size);
+		}
+		else
+		{
+			data.allocate (size);
+			std::memcpy (data.get (), _data, size);
 		}
 	}
 	
 protected:
+	static constexpr uint32_t kInlineSize = 16;
+
+	CViewAttributeID id {0};
+	uint32_t size {0};
+	int8_t inlineData[kInlineSize] {};
 	Buffer<int8_t> data;
 };
 
@@ -165,8 +182,6 @@ bool CView::kDirtyCallAlwaysOnMainThread = false;
 //-----------------------------------------------------------------------------
 static constexpr CViewAttributeID kCViewHitTestPathAttrID = 'cvht';
 static constexpr CViewAttributeID kCViewCustomDropTargetAttrID = 'cvdt';
-static constexpr CViewAttributeID kCViewAlphaValueAttrID = 'cvav';
-static constexpr CViewAttributeID kCViewMouseableAreaAttrID = 'cvma';
 static constexpr CViewAttributeID kCViewBackgroundBitmapAttrID = 'cvbb';
 static constexpr CViewAttributeID kCViewDisabledBackgroundBitmapAttrID = 'cvdb';
 
@@ -175,10 +190,21 @@ static constexpr CViewAttributeID kCViewDisabledBackgroundBitmapAttrID = 'cvdb';
 //-----------------------------------------------------------------------------
 struct CView::Impl
 {
-	using ViewAttributes = std::unordered_map<CViewAttributeID, std::unique_ptr<CViewInternal::AttributeEntry>>;
+	/** a view has only a few attributes, a linear search is faster than hashing */
+	using ViewAttributes = std::vector<CViewInternal::AttributeEntry>;
 	using ViewListenerDispatcher = DispatchList<IViewListener*>;
 	using ViewEventListenerDispatcher = DispatchList<IViewEventListener*>;
 
+	// the members every draw and hit test reads share the first cache line
+	CRect size;
+	int32_t viewFlags {0};
+	float alphaValue {1.f};
+	CView* parentView {nullptr};
+	CFrame* parentFrame {nullptr};
+	int32_t autosizeFlags {kAutosizeNone};
+	/** only valid with kHasMouseableArea */
+	CRect mouseableArea;
+
 	ViewAttributes attributes;
 	std::unique_ptr<ViewListenerDispatcher> viewListeners;
 	std::unique_ptr<ViewEventListenerDispatcher> viewEventListeners;
@@ -188,11 +214,12 @@ struct CView::Impl
 	std::unique_ptr<ViewMouseListenerDispatcher> viewMouseListener;
 #include "private/enabledeprecatedmessage.h"
 #endif
-	CRect size;
-	int32_t viewFlags {0};
-	int32_t autosizeFlags {kAutosizeNone};
-	CFrame* parentFrame {nullptr};
-	CView* parentView {nullptr};
+
+	ViewAttributes::iterator findAttribute (CViewAttributeID id)
+	{
+		return std::find_if (attributes.begin (), attributes.end (),
+							 [id] (const auto& entry) { return entry.getID () == id; });
+	}
 };
 
 //-----------------------------------------------------------------------------
@@ -223,8 +250,9 @@ CView::CView (const CView& v)
 	setBackground (v.getBackground ());
 	setDisabledBackground (v.getDisabledBackground ());
 
+	setAlphaValueNoInvalidate (v.getAlphaValue ());
 	for (auto& attribute : v.pImpl->attributes)
-		setAttribute (attribute.first, attribute.second->getSize (), attribute.second->getData ());
+		setAttribute (attribute.getID (), attribute.getSize (), attribute.getData ());
 }
 
 //-----------------------------------------------------------------------------
@@ -275,15 +303,12 @@ void CView::beforeDelete ()
 //-----------------------------------------------------------------------------
 void CView::setMouseableArea (const CRect& rect)
 {
-	if (pImpl->size == rect)
-	{
-		setViewFlag (kHasMouseableArea, false);
-		removeAttribute (kCViewMouseableAreaAttrID);
-	}
-	else
+	pImpl->mouseableArea = rect;
+	setViewFlag (kHasMouseableArea, pImpl->size != rect);
+	if (auto parent = getParentView ())
 	{
-		setViewFlag (kHasMouseableArea, true);
-		setAttribute (kCViewMouseableAreaAttrID, rect);
+		if (auto container = parent->asViewContainer ())
+			container->childViewGeometryChanged (this);
 	}
 }
 
@@ -300,11 +325,7 @@ CRect& CView::getMouseableArea (CRect& rect) const
 CRect CView::getMouseableArea () const
 {
 	if (hasViewFlag (kHasMouseableArea))
-	{
-		CRect r;
-		if (getAttribute (kCViewMouseableAreaAttrID, r))
-			return r;
-	}
+		return pImpl->mouseableArea;
 	return pImpl->size;
 }
 
@@ -344,7 +365,10 @@ bool CView::hasViewFlag (int32_t bit) const
 //-----------------------------------------------------------------------------
 void CView::setViewFlag (int32_t bit, bool state)
 {
-	setBit (pImpl->viewFlags, bit, state);
+	// don't write unchanged flags, views drawn concurrently call setDirty (false) from different
+	// threads
+	if ((pImpl->viewFlags & bit) != (state ? bit : 0))
+		setBit (pImpl->viewFlags, bit, state);
 }
 
 //-----------------------------------------------------------------------------
@@ -389,6 +413,12 @@ void CView::setWantsFocus (bool state)
 	setViewFlag (kWantsFocus, state);
 }
 
+//-----------------------------------------------------------------------------
+void CView::setThreadSafeDrawing (bool state)
+{
+	setViewFlag (kThreadSafeDrawing, state);
+}
+
 //-----------------------------------------------------------------------------
 void CView::setWantsIdle (bool state)
 {
@@ -865,7 +895,10 @@ void CView::invalidRect (const CRect& rect)
 	if (isAttached () && hasViewFlag (kVisible))
 	{
 		vstgui_assert (pImpl->parentView);
-		pImpl->parentView->invalidRect (rect);
+		if (auto container = pImpl->parentView->asViewContainer ())
+			container->invalidChildRect (this, rect);
+		else
+			pImpl->parentView->invalidRect (rect);
 	}
 }
 
@@ -998,8 +1031,12 @@ void CView::setViewSize (const CRect& newSize, bool doInvalid)
 		pImpl->size = newSize;
 		if (doInvalid)
 			setDirty ();
-		if (getParentView ())
-			getParentView ()->notify (this, kMsgViewSizeChanged);
+		if (auto parent = getParentView ())
+		{
+			if (auto container = parent->asViewContainer ())
+				container->childViewGeometryChanged (this);
+			parent->notify (this, kMsgViewSizeChanged);
+		}
 		if (pImpl->viewListeners)
 		{
 			pImpl->viewListeners->forEach (
@@ -1046,34 +1083,15 @@ void CView::setVisible (bool state)
 //-----------------------------------------------------------------------------
 void CView::setAlphaValueNoInvalidate (float value)
 {
-	if (value == 1.f)
-	{
-		removeAttribute (kCViewAlphaValueAttrID);
-		setViewFlag (kHasAlpha, false);
-	}
-	else
-	{
-		setAttribute (kCViewAlphaValueAttrID, value);
-		setViewFlag (kHasAlpha, true);
-	}
+	pImpl->alphaValue = value;
+	setViewFlag (kHasAlpha, value != 1.f);
 }
 
 //-----------------------------------------------------------------------------
 void CView::setAlphaValue (float alpha)
 {
-	float oldAlpha = 1.f;
-	if (hasViewFlag (kHasAlpha))
-		getAttribute (kCViewAlphaValueAttrID, oldAlpha);
-	if (alpha == 1.f)
-	{
-		removeAttribute (kCViewAlphaValueAttrID);
-		setViewFlag (kHasAlpha, false);
-	}
-	else
-	{
-		setAttribute (kCViewAlphaValueAttrID, alpha);
-		setViewFlag (kHasAlpha, true);
-	}
+	float oldAlpha = pImpl->alphaValue;
+	setAlphaValueNoInvalidate (alpha);
 	if (oldAlpha != alpha)
 	{
 		// we invalidate the parent to make sure that when alpha == 0 that a redraw occurs
@@ -1085,10 +1103,7 @@ void CView::setAlphaValue (float alpha)
 //-----------------------------------------------------------------------------
 float CView::getAlphaValue () const
 {
-	float a = 1.f;
-	if (hasViewFlag (kHasAlpha))
-		getAttribute (kCViewAlphaValueAttrID, a);
-	return a;
+	return pImpl->alphaValue;
 }
 
 //-----------------------------------------------------------------------------
@@ -1219,10 +1234,10 @@ void CView::setDisabledBackground (CBitmap* background)
  */
 bool CView::getAttributeSize (const CViewAttributeID aId, uint32_t& outSize) const
 {
-	auto it = pImpl->attributes.find (aId);
+	auto it = pImpl->findAttribute (aId);
 	if (it != pImpl->attributes.end ())
 	{
-		outSize = it->second->getSize ();
+		outSize = it->getSize ();
 		return true;
 	}
 	return false;
@@ -1238,14 +1253,14 @@ bool CView::getAttributeSize (const CViewAttributeID aId, uint32_t& outSize) con
  */
 bool CView::getAttribute (const CViewAttributeID aId, const uint32_t inSize, void* outData, uint32_t& outSize) const
 {
-	auto it = pImpl->attributes.find (aId);
+	auto it = pImpl->findAttribute (aId);
 	if (it != pImpl->attributes.end ())
 	{
-		if (inSize >= it->second->getSize ())
+		if (inSize >= it->getSize ())
 		{
-			outSize = it->second->getSize ();
+			outSize = it->getSize ();
 			if (outSize > 0)
-				std::memcpy (outData, it->second->getData (), static_cast<size_t> (outSize));
+				std::memcpy (outData, it->getData (), static_cast<size_t> (outSize));
 			return true;
 		}
 	}
@@ -1264,21 +1279,21 @@ bool CView::setAttribute (const CViewAttributeID aId, const uint32_t inSize, con
 {
 	if (inData == nullptr || inSize <= 0)
 		return false;
-	auto it = pImpl->attributes.find (aId);
+	auto it = pImpl->findAttribute (aId);
 	if (it != pImpl->attributes.end ())
-		it->second->updateData (inSize, inData);
+		it->updateData (inSize, inData);
 	else
-		pImpl->attributes.emplace (aId, std::unique_ptr<CViewInternal::AttributeEntry> (new CViewInternal::AttributeEntry (inSize, inData)));
+		pImpl->attributes.emplace_back (aId, inSize, inData);
 	return true;
 }
 
 //-----------------------------------------------------------------------------
 bool CView::removeAttribute (const CViewAttributeID aId)
 {
-	auto it = pImpl->attributes.find (aId);
+	auto it = pImpl->findAttribute (aId);
 	if (it != pImpl->attributes.end ())
 	{
-		pImpl->attributes.erase (aId);
+		pImpl->attributes.erase (it);
 		return true;
 	}
 	return false;
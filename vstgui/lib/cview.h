@@ -266,6 +266,28 @@ public:
 	virtual void setWantsFocus (bool state);
 	//@}
 
+	//-----------------------------------------------------------------------------
+	/// @name Concurrent Drawing Methods
+	//-----------------------------------------------------------------------------
+	//@{
+	/** declare that this view can be drawn on a background thread
+	 *
+	 *	When tiled drawing is enabled on the frame (see CFrame::setTiledDrawingEnabled) the view may
+	 *	be drawn for different update rects on different threads at the same time. The view must
+	 *	not change any state while drawing and must only draw via the draw context. Before the
+	 *	concurrent drawing starts, the frame calls setDirty (false) on the main thread.
+	 *
+	 *	For a container this only declares its own drawing thread safe. The frame also checks its
+	 *	children and lets the container build its draw state first (see
+	 *	CViewContainer::prepareConcurrentDrawing). A container caching as bitmap is always drawn
+	 *	on the main thread. The platform fonts and strings are created thread safe, the Cairo backend
+	 *	serializes drawing text.
+	 */
+	void setThreadSafeDrawing (bool state);
+	/** check if this view can be drawn on a background thread */
+	bool getThreadSafeDrawing () const { return hasViewFlag (kThreadSafeDrawing); }
+	//@}
+
 	//-----------------------------------------------------------------------------
 	/// @name Attribute Methods
 	//-----------------------------------------------------------------------------
@@ -463,7 +485,8 @@ protected:
 		kHasBackground			= 1 << 9,
 		kHasDisabledBackground	= 1 << 10,
 		kHasMouseableArea		= 1 << 11,
-		kLastCViewFlag			= 11
+		kThreadSafeDrawing		= 1 << 12,
+		kLastCViewFlag			= 12
 	};
 
 	~CView () noexcept override;
@@ -12,6 +12,7 @@
 #include "iviewlistener.h"
 #include "controls/icontrollistener.h"
 #include "cgraphicspath.h"
+#include "animation/animator.h"
 #include "controls/ccontrol.h"
 #include "dragging.h"
 #include "dispatchlist.h"
@@ -20,6 +21,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <unordered_map>
+#include <utility>
 
 namespace VSTGUI {
 
@@ -30,11 +34,188 @@ const CViewAttributeID kCViewContainerMouseDownViewAttribute = 'vcmd';
 const CViewAttributeID kCViewContainerLastDrawnFocusAttribute = 'vclf';
 const CViewAttributeID kCViewContainerBackgroundOffsetAttribute = 'vcbo';
 
+namespace Detail {
+
+//-----------------------------------------------------------------------------
+/** uniform grid over an area of the child views, the mouseable area or the view size
+ *
+ *	Every cell holds the z order indices of the views overlapping it in ascending order, so a
+ *	point query only tests the views of one cell. Areas outside of the grid are clamped to the
+ *	border cells, which keeps the results correct when views move outside of the initial bounds.
+ */
+class ViewSpatialIndex
+{
+public:
+	using GetAreaFunc = CRect (*) (const CView* view);
+
+	ViewSpatialIndex (const CViewContainer::ViewList& children, GetAreaFunc getArea)
+	: getArea (getArea)
+	{
+		views.reserve (children.size ());
+		areas.reserve (children.size ());
+		for (const auto& child : children)
+		{
+			zIndex.emplace (child.get (), static_cast<uint32_t> (views.size ()));
+			views.emplace_back (child);
+			areas.emplace_back (getArea (child));
+			if (areas.back ().isEmpty ())
+				continue;
+			if (bounds.isEmpty ())
+				bounds = areas.back ();
+			else
+				bounds.unite (areas.back ());
+		}
+		if (bounds.isEmpty ())
+			bounds = CRect (0, 0, 1, 1);
+
+		// about one cell per view with roughly square cells
+		auto numCells = std::min<size_t> (std::max<size_t> (views.size (), 1), kMaxCells);
+		auto aspect = bounds.getWidth () / bounds.getHeight ();
+		columns = static_cast<uint32_t> (
+			std::max (1., std::min (std::round (std::sqrt (numCells * aspect)),
+									static_cast<double> (numCells))));
+		rows = static_cast<uint32_t> ((numCells + columns - 1) / columns);
+		cellWidth = bounds.getWidth () / columns;
+		cellHeight = bounds.getHeight () / rows;
+		cells.resize (columns * rows);
+		for (uint32_t i = 0; i < areas.size (); ++i)
+		{
+			forEachCell (areas[i], [i] (std::vector<uint32_t>& cell) { cell.emplace_back (i); });
+		}
+	}
+
+	void update (CView* view)
+	{
+		auto it = zIndex.find (view);
+		if (it == zIndex.end ())
+			return;
+		auto index = it->second;
+		auto newArea = getArea (view);
+		if (newArea == areas[index])
+			return;
+		forEachCell (areas[index], [index] (std::vector<uint32_t>& cell) {
+			cell.erase (std::lower_bound (cell.begin (), cell.end (), index));
+		});
+		areas[index] = newArea;
+		forEachCell (areas[index], [index] (std::vector<uint32_t>& cell) {
+			cell.insert (std::lower_bound (cell.begin (), cell.end (), index), index);
+		});
+	}
+
+	/** calls proc with the views whose area contains where, top->down, until it returns false */
+	template<typename Proc>
+	void forEachViewAt (const CPoint& where, Proc proc) const
+	{
+		const auto& cell = cells[getRow (where.y) * columns + getColumn (where.x)];
+		for (auto it = cell.rbegin (), end = cell.rend (); it != end; ++it)
+		{
+			if (areas[*it].pointInside (where) && !proc (views[*it]))
+				return;
+		}
+	}
+
+	/** collects the views whose area may intersect rect and include if it is one of the views,
+	 *	bottom->top. Does not change the index, so it may be called from multiple threads */
+	void collectViewsIn (const CRect& rect, const CView* include, std::vector<CView*>& result) const
+	{
+		result.clear ();
+		if (rect.isEmpty ())
+			return;
+		auto right = getColumn (rect.right);
+		auto bottom = getRow (rect.bottom);
+		auto left = getColumn (rect.left);
+		auto top = getRow (rect.top);
+		if ((right - left + 1) * (bottom - top + 1) * 2 > cells.size ())
+		{
+			// most of the grid, the caller checks the views anyway
+			result.assign (views.begin (), views.end ());
+			return;
+		}
+		std::vector<uint32_t> candidates;
+		for (auto row = top; row <= bottom; ++row)
+		{
+			for (auto column = left; column <= right; ++column)
+			{
+				const auto& cell = cells[row * columns + column];
+				candidates.insert (candidates.end (), cell.begin (), cell.end ());
+			}
+		}
+		if (include)
+		{
+			auto it = zIndex.find (include);
+			if (it != zIndex.end ())
+				candidates.emplace_back (it->second);
+		}
+		std::sort (candidates.begin (), candidates.end ());
+		candidates.erase (std::unique (candidates.begin (), candidates.end ()), candidates.end ());
+		for (auto index : candidates)
+			result.emplace_back (views[index]);
+	}
+
+private:
+	static constexpr size_t kMaxCells = 256 * 256;
+
+	uint32_t getColumn (CCoord x) const
+	{
+		auto column = std::floor ((x - bounds.left) / cellWidth);
+		return static_cast<uint32_t> (std::max (0., std::min (column, columns - 1.)));
+	}
+
+	uint32_t getRow (CCoord y) const
+	{
+		auto row = std::floor ((y - bounds.top) / cellHeight);
+		return static_cast<uint32_t> (std::max (0., std::min (row, rows - 1.)));
+	}
+
+	template<typename Proc>
+	void forEachCell (const CRect& area, Proc proc)
+	{
+		if (area.isEmpty ())
+			return;
+		auto right = getColumn (area.right);
+		auto bottom = getRow (area.bottom);
+		for (auto row = getRow (area.top); row <= bottom; ++row)
+		{
+			for (auto column = getColumn (area.left); column <= right; ++column)
+				proc (cells[row * columns + column]);
+		}
+	}
+
+	GetAreaFunc getArea;
+	std::vector<CView*> views;
+	std::vector<CRect> areas;
+	std::unordered_map<const CView*, uint32_t> zIndex;
+	std::vector<std::vector<uint32_t>> cells;
+	CRect bounds;
+	CCoord cellWidth {1.};
+	CCoord cellHeight {1.};
+	uint32_t columns {1};
+	uint32_t rows {1};
+};
+
+//-----------------------------------------------------------------------------
+} // Detail
+
 //-----------------------------------------------------------------------------
 // CViewContainer Implementation
 //-----------------------------------------------------------------------------
 struct CViewContainer::Impl
 {
+	struct BitmapCache
+	{
+		bool isLive (CView* view) const
+		{
+			return std::find (liveViews.begin (), liveViews.end (), view) != liveViews.end ();
+		}
+
+		SharedPointer<COffscreenContext> offscreen;
+		/** the children drawn on every update instead of into the cache, in z order */
+		std::vector<CView*> liveViews;
+		CPoint size;
+		CRect dirtyRect;
+		double scaleFactor {0.};
+	};
+
 	using ViewContainerListenerDispatcher = DispatchList<IViewContainerListener*>;
 	
 	ViewContainerListenerDispatcher viewContainerListeners;
@@ -44,6 +225,110 @@ struct CViewContainer::Impl
 	
 	CDrawStyle backgroundColorDrawStyle {kDrawFilledAndStroked};
 	CColor backgroundColor {kBlackCColor};
+
+	std::unique_ptr<BitmapCache> bitmapCache;
+	/** the child whose invalidation invalidRect is handling, see invalidChildRect */
+	CView* invalidatingChild {nullptr};
+	/** built on the first query, reset when the children or their z order change */
+	std::unique_ptr<Detail::ViewSpatialIndex> spatialIndex;
+	std::unique_ptr<Detail::ViewSpatialIndex> drawIndex;
+
+	/** the cursors of the running iterations over the children */
+	std::vector<ChildCursor*> childCursors;
+
+	/** calls proc with the children bottom->top until it returns false. Via a cursor, so proc
+	 *	may add or remove children */
+	template<typename Proc>
+	void forEachChild (const CViewContainer* container, Proc proc)
+	{
+		for (ChildCursor cursor (container, 0, false);
+			 cursor.index < static_cast<int64_t> (children.size ()); ++cursor.index)
+		{
+			if (!proc (children[static_cast<size_t> (cursor.index)].get ()))
+				return;
+		}
+	}
+
+	/** same as forEachChild, top->down */
+	template<typename Proc>
+	void forEachChildReverse (const CViewContainer* container, Proc proc)
+	{
+		for (ChildCursor cursor (container, static_cast<int64_t> (children.size ()) - 1, true);
+			 cursor.index >= 0; --cursor.index)
+		{
+			if (!proc (children[static_cast<size_t> (cursor.index)].get ()))
+				return;
+		}
+	}
+
+	/** keeps the cursors on their current child after a child was inserted at index */
+	void childInserted (size_t index)
+	{
+		auto position = static_cast<int64_t> (index);
+		for (auto cursor : childCursors)
+		{
+			// a child inserted at the current position is below it
+			if (position <= cursor->index)
+				++cursor->index;
+		}
+	}
+
+	/** keeps the cursors on their current child after the child at index was removed. If it was
+	 *	the current child, the next step of the cursor yields the child which followed it */
+	void childRemoved (size_t index)
+	{
+		auto position = static_cast<int64_t> (index);
+		for (auto cursor : childCursors)
+		{
+			if (position < cursor->index || (position == cursor->index && !cursor->reverse))
+				--cursor->index;
+		}
+	}
+
+	void resetSpatialIndices ()
+	{
+		spatialIndex = nullptr;
+		drawIndex = nullptr;
+	}
+
+	/** calls proc with the children whose mouseable area contains where, top->down, until it
+	 *	returns false */
+	template<typename Proc>
+	void forEachChildAt (const CPoint& where, bool useSpatialIndex, Proc proc)
+	{
+		if (useSpatialIndex)
+		{
+			if (!spatialIndex)
+			{
+				spatialIndex = std::unique_ptr<Detail::ViewSpatialIndex> (new Detail::ViewSpatialIndex (
+					children, [] (const CView* view) { return view->getMouseableArea (); }));
+			}
+			spatialIndex->forEachViewAt (where, proc);
+			return;
+		}
+		for (auto it = children.rbegin (), end = children.rend (); it != end; ++it)
+		{
+			const auto& pV = *it;
+			if (pV && pV->getMouseableArea ().pointInside (where) && !proc (pV))
+				return;
+		}
+	}
+
+	/** builds the draw index if needed. Must be called on the main thread */
+	void prepareDrawIndex ()
+	{
+		if (drawIndex)
+			return;
+		drawIndex = std::unique_ptr<Detail::ViewSpatialIndex> (new Detail::ViewSpatialIndex (
+			children, [] (const CView* view) { return view->getViewSize (); }));
+	}
+
+	/** collects the children whose view size may intersect rect and include, bottom->top */
+	void collectChildrenIn (const CRect& rect, const CView* include, std::vector<CView*>& result)
+	{
+		prepareDrawIndex ();
+		drawIndex->collectViewsIn (rect, include, result);
+	}
 };
 
 //------------------------------------------------------------------------
@@ -191,8 +476,11 @@ void CViewContainer::unregisterViewContainerListener (IViewContainerListener* li
 //-----------------------------------------------------------------------------
 void CViewContainer::parentSizeChanged ()
 {
-	for (const auto& pV : pImpl->children)
-		pV->parentSizeChanged ();	// notify children that the size of the parent or this container has changed
+	// notify children that the size of the parent or this container has changed
+	pImpl->forEachChild (this, [] (CView* pV) {
+		pV->parentSizeChanged ();
+		return true;
+	});
 }
 
 //-----------------------------------------------------------------------------
@@ -264,6 +552,7 @@ void CViewContainer::setTransform (const CGraphicsTransform& t)
 	if (getTransform () != t)
 	{
 		pImpl->transform = t;
+		invalidateBitmapCache ();
 		pImpl->viewContainerListeners.forEach ([this] (IViewContainerListener* listener) {
 			listener->viewContainerTransformChanged (this);
 		});
@@ -433,6 +722,7 @@ void CViewContainer::setBackgroundColor (const CColor& color)
 	if (color != pImpl->backgroundColor)
 	{
 		pImpl->backgroundColor = color;
+		invalidateBitmapCache ();
 		setDirty (true);
 	}
 }
@@ -446,6 +736,7 @@ CColor CViewContainer::getBackgroundColor () const
 //------------------------------------------------------------------------------
 void CViewContainer::setBackgroundOffset (const CPoint& p)
 {
+	invalidateBitmapCache ();
 	if (p == CPoint (0, 0))
 		removeAttribute (kCViewContainerBackgroundOffsetAttribute);
 	else
@@ -467,6 +758,7 @@ void CViewContainer::setBackgroundColorDrawStyle (CDrawStyle style)
 	if (pImpl->backgroundColorDrawStyle != style)
 	{
 		pImpl->backgroundColorDrawStyle = style;
+		invalidateBitmapCache ();
 		setDirty (true);
 	}
 }
@@ -477,6 +769,116 @@ CDrawStyle CViewContainer::getBackgroundColorDrawStyle () const
 	return pImpl->backgroundColorDrawStyle;
 }
 
+//------------------------------------------------------------------------------
+void CViewContainer::setBackground (CBitmap* background)
+{
+	invalidateBitmapCache ();
+	CView::setBackground (background);
+}
+
+//------------------------------------------------------------------------------
+void CViewContainer::setCacheAsBitmap (bool state)
+{
+	if (getCacheAsBitmap () == state)
+		return;
+	setViewFlag (kCacheAsBitmap, state);
+	pImpl->bitmapCache = nullptr;
+	invalid ();
+}
+
+//------------------------------------------------------------------------------
+void CViewContainer::invalidateBitmapCache ()
+{
+	if (pImpl->bitmapCache)
+		pImpl->bitmapCache->offscreen = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void CViewContainer::collectLiveViewsOnBitmapCache (std::vector<CView*>& liveViews) const
+{
+	CView* focusView = nullptr;
+	std::vector<CView*> animatedViews;
+	if (auto frame = getFrame ())
+	{
+		if (frame->focusDrawingEnabled ())
+			focusView = frame->getFocusView ();
+		if (auto animator = frame->getExistingAnimator ())
+			animator->collectAnimatedViews (animatedViews);
+	}
+	for (const auto& pV : pImpl->children)
+	{
+		auto isLive = pV->wantsIdle () || pV == focusView ||
+					  std::find (animatedViews.begin (), animatedViews.end (), pV) !=
+						  animatedViews.end ();
+		// the cache is drawn below the live views, so a view above a live view must be live, too
+		if (!isLive)
+		{
+			auto viewSize = pV->getViewSize ();
+			isLive = std::any_of (liveViews.begin (), liveViews.end (), [&] (CView* liveView) {
+				return liveView->getViewSize ().rectOverlap (viewSize);
+			});
+		}
+		if (isLive)
+			liveViews.emplace_back (pV);
+	}
+}
+
+//------------------------------------------------------------------------------
+bool CViewContainer::updateBitmapCache (CDrawContext* pContext)
+{
+	if (!pImpl->bitmapCache)
+		pImpl->bitmapCache = std::unique_ptr<Impl::BitmapCache> (new Impl::BitmapCache ());
+	auto& cache = *pImpl->bitmapCache;
+
+	std::vector<CView*> liveViews;
+	collectLiveViewsOnBitmapCache (liveViews);
+	const auto& tm = pContext->getCurrentTransform ();
+	auto scaleFactor = pContext->getScaleFactor () * std::max (std::abs (tm.m11), std::abs (tm.m22));
+	CRect cacheRect (getViewSize ());
+	cacheRect.originize ();
+	if (!cache.offscreen || cache.scaleFactor != scaleFactor || cache.liveViews != liveViews ||
+		cache.size != cacheRect.getSize () || CView::isDirty ())
+	{
+		cache.offscreen = COffscreenContext::create (cacheRect.getSize (), scaleFactor);
+		if (!cache.offscreen)
+			return false;
+		cache.scaleFactor = scaleFactor;
+		cache.size = cacheRect.getSize ();
+		cache.liveViews = std::move (liveViews);
+		cache.dirtyRect = cacheRect;
+	}
+	if (cache.dirtyRect.isEmpty ())
+		return true;
+
+	auto offscreen = cache.offscreen;
+	CRect updateRect (cache.dirtyRect);
+	updateRect.bound (cacheRect);
+	cache.dirtyRect = {};
+
+	offscreen->beginDraw ();
+	offscreen->setClipRect (updateRect);
+	offscreen->clearRect (updateRect);
+	drawBackgroundRect (offscreen, updateRect);
+	{
+		CDrawContext::Transform tr (*offscreen, getTransform ());
+		getTransform ().inverse ().transform (updateRect);
+		for (const auto& pV : pImpl->children)
+		{
+			if (!pV->isVisible () || cache.isLive (pV) || !checkUpdateRect (pV, updateRect))
+				continue;
+			CRect viewSize = pV->getViewSize ();
+			viewSize.bound (updateRect);
+			if (viewSize.getWidth () == 0 || viewSize.getHeight () == 0)
+				continue;
+			offscreen->setClipRect (viewSize);
+			offscreen->setGlobalAlpha (pV->getAlphaValue ());
+			pV->drawRect (offscreen, viewSize);
+		}
+	}
+	offscreen->endDraw ();
+	return true;
+}
+
 //------------------------------------------------------------------------------
 CMessageResult CViewContainer::notify (CBaseObject* sender, IdStringPtr message)
 {
@@ -503,6 +905,32 @@ CMessageResult CViewContainer::notify (CBaseObject* sender, IdStringPtr message)
 	return kMessageUnknown;
 }
 
+//-----------------------------------------------------------------------------
+CViewContainer::ChildCursor::ChildCursor (const CViewContainer* container, int64_t index,
+										  bool reverse)
+: container (container), index (index), reverse (reverse)
+{
+	container->pImpl->childCursors.emplace_back (this);
+}
+
+//-----------------------------------------------------------------------------
+CViewContainer::ChildCursor::~ChildCursor () noexcept
+{
+	auto& cursors = container->pImpl->childCursors;
+	auto it = std::find (cursors.rbegin (), cursors.rend (), this);
+	if (it != cursors.rend ())
+		cursors.erase (std::next (it).base ());
+}
+
+//-----------------------------------------------------------------------------
+CView* CViewContainer::ChildCursor::getView () const
+{
+	const auto& children = container->pImpl->children;
+	if (index < 0 || index >= static_cast<int64_t> (children.size ()))
+		return nullptr;
+	return children[static_cast<size_t> (index)];
+}
+
 //-----------------------------------------------------------------------------
 /**
  * @param pView the view object to add to this container
@@ -520,12 +948,15 @@ bool CViewContainer::addView (CView *pView, CView* pBefore)
 	{
 		auto it = std::find (pImpl->children.begin (), pImpl->children.end (), pBefore);
 		vstgui_assert (it != pImpl->children.end ());
+		pImpl->childInserted (static_cast<size_t> (it - pImpl->children.begin ()));
 		pImpl->children.insert (it, pView);
 	}
 	else
 	{
+		pImpl->childInserted (pImpl->children.size ());
 		pImpl->children.emplace_back (pView);
 	}
+	pImpl->resetSpatialIndices ();
 
 	pView->setSubviewState (true);
 
@@ -568,20 +999,27 @@ bool CViewContainer::removeAll (bool withForget)
 {
 	clearMouseDownView ();
 	
-	auto it = pImpl->children.begin ();
-	while (it != pImpl->children.end ())
+	// bottom to top, every view is removed from the children before the listeners are notified,
+	// like in removeView
+	while (!pImpl->children.empty ())
 	{
-		auto view = *it;
+		auto view = pImpl->children.front ();
 		if (isAttached ())
 			view->removed (this);
-		pImpl->children.erase (it);
+		// removed () may have changed the children
+		auto it = std::find (pImpl->children.begin (), pImpl->children.end (), view);
+		if (it != pImpl->children.end ())
+		{
+			pImpl->childRemoved (static_cast<size_t> (it - pImpl->children.begin ()));
+			pImpl->children.erase (it);
+		}
+		pImpl->resetSpatialIndices ();
 		view->setSubviewState (false);
 		pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 			listener->viewContainerViewRemoved (this, view);
 		});
 		if (withForget)
 			view->forget ();
-		it = pImpl->children.begin ();
 	}
 	return true;
 }
@@ -608,7 +1046,14 @@ bool CViewContainer::removeView (CView *pView, bool withForget)
 		});
 		if (withForget)
 			pView->forget ();
-		pImpl->children.erase (it);
+		// the callbacks above may have changed the children
+		it = std::find (pImpl->children.begin (), pImpl->children.end (), pView);
+		if (it != pImpl->children.end ())
+		{
+			pImpl->childRemoved (static_cast<size_t> (it - pImpl->children.begin ()));
+			pImpl->children.erase (it);
+		}
+		pImpl->resetSpatialIndices ();
 		return true;
 	}
 	return false;
@@ -674,10 +1119,8 @@ uint32_t CViewContainer::getNbViews () const
  */
 CView* CViewContainer::getView (uint32_t index) const
 {
-	auto it = pImpl->children.begin ();
-	std::advance (it, index);
-	if (it != pImpl->children.end ())
-		return *it;
+	if (index < pImpl->children.size ())
+		return pImpl->children[index];
 	return nullptr;
 }
 
@@ -691,21 +1134,22 @@ bool CViewContainer::changeViewZOrder (CView* view, uint32_t newIndex)
 {
 	if (newIndex < getNbViews ())
 	{
-		uint32_t oldIndex = 0;
-		auto src = pImpl->children.begin ();
-		for (;src != pImpl->children.end () && *src != view; ++src, ++oldIndex);
-		if (src != pImpl->children.end ())
+		auto& children = pImpl->children;
+		auto src = std::find (children.begin (), children.end (), view);
+		if (src != children.end ())
 		{
-			if (newIndex == oldIndex)
+			auto dest = children.begin () + newIndex;
+			if (dest == src)
 				return true;
-			if (newIndex > oldIndex)
-				++newIndex;
-
-			auto dest = pImpl->children.begin ();
-			std::advance (dest, newIndex);
-
-			pImpl->children.insert (dest, view);
-			pImpl->children.erase (src);
+			// the cursors see the move as a removal and an insertion
+			pImpl->childRemoved (static_cast<size_t> (src - children.begin ()));
+			pImpl->childInserted (newIndex);
+			if (dest > src)
+				std::rotate (src, src + 1, dest + 1);
+			else
+				std::rotate (dest, src, src + 1);
+			pImpl->resetSpatialIndices ();
+			invalidateBitmapCache ();
 
 			pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 				listener->viewContainerViewZOrderChanged (this, view);
@@ -716,6 +1160,40 @@ bool CViewContainer::changeViewZOrder (CView* view, uint32_t newIndex)
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+void CViewContainer::setSpatialIndexEnabled (bool state)
+{
+	setViewFlag (kSpatialIndex, state);
+	pImpl->resetSpatialIndices ();
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::childViewGeometryChanged (CView* view)
+{
+	if (pImpl->spatialIndex)
+		pImpl->spatialIndex->update (view);
+	if (pImpl->drawIndex)
+		pImpl->drawIndex->update (view);
+}
+
+//-----------------------------------------------------------------------------
+bool CViewContainer::prepareConcurrentDrawing ()
+{
+	// the bitmap cache is rendered while drawing
+	if (getCacheAsBitmap ())
+		return false;
+	if (useSpatialIndex ())
+		pImpl->prepareDrawIndex ();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool CViewContainer::useSpatialIndex () const
+{
+	// the children only report geometry changes while they are attached
+	return getSpatialIndexEnabled () && isAttached ();
+}
+
 //-----------------------------------------------------------------------------
 bool CViewContainer::invalidateDirtyViews ()
 {
@@ -723,6 +1201,7 @@ bool CViewContainer::invalidateDirtyViews ()
 		return true;
 	if (CView::isDirty ())
 	{
+		invalidateBitmapCache ();
 		if (auto parent = getParentView ())
 			parent->invalidRect (getViewSize ());
 		return true;
@@ -745,6 +1224,7 @@ void CViewContainer::invalid ()
 {
 	if (!isVisible ())
 		return;
+	invalidateBitmapCache ();
 	CRect _rect (getViewSize ());
 	if (auto parent = getParentView ())
 		parent->invalidRect (_rect);
@@ -755,14 +1235,41 @@ void CViewContainer::invalidRect (const CRect& rect)
 {
 	if (!isVisible ())
 		return;
+	auto invalidatingChild = std::exchange (pImpl->invalidatingChild, nullptr);
 	CRect _rect (rect);
 	getTransform ().transform (_rect);
+	if (pImpl->bitmapCache && pImpl->bitmapCache->offscreen)
+	{
+		// invalidations of views drawn on top of the cached bitmap or of their children don't
+		// affect it
+		auto& cache = *pImpl->bitmapCache;
+		if (!invalidatingChild || !cache.isLive (invalidatingChild))
+		{
+			if (cache.dirtyRect.isEmpty ())
+				cache.dirtyRect = _rect;
+			else
+				cache.dirtyRect.unite (_rect);
+		}
+	}
 	_rect.offset (getViewSize ().left, getViewSize ().top);
 	_rect.bound (getViewSize ());
 	if (_rect.isEmpty ())
 		return;
 	if (auto parent = getParentView ())
-		parent->invalidRect (_rect);
+	{
+		if (auto container = parent->asViewContainer ())
+			container->invalidChildRect (this, _rect);
+		else
+			parent->invalidRect (_rect);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::invalidChildRect (CView* child, const CRect& rect)
+{
+	auto previous = std::exchange (pImpl->invalidatingChild, child);
+	invalidRect (rect);
+	pImpl->invalidatingChild = previous;
 }
 
 //-----------------------------------------------------------------------------
@@ -834,16 +1341,31 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 	newClip.bound (oldClip);
 	pContext->setClipRect (newClip);
 	
-	// draw the background
-	drawBackgroundRect (pContext, clientRect);
+	// draw the background and the static children from the cache if enabled
+	bool drawFromCache = getCacheAsBitmap () && updateBitmapCache (pContext);
+	if (drawFromCache)
+	{
+		CRect cacheRect (getViewSize ());
+		cacheRect.originize ();
+		pContext->drawBitmap (pImpl->bitmapCache->offscreen->getBitmap (), cacheRect);
+	}
+	else
+		drawBackgroundRect (pContext, clientRect);
 	
 	CView* _focusView = nullptr;
 	IFocusDrawing* _focusDrawing = nullptr;
 	auto frame = getFrame ();
-	if (frame && frame->focusDrawingEnabled () && isChild (frame->getFocusView (), false) && frame->getFocusView ()->isVisible () && frame->getFocusView ()->wantsFocus ())
+	if (frame && frame->focusDrawingEnabled ())
 	{
-		_focusView = frame->getFocusView ();
-		_focusDrawing = dynamic_cast<IFocusDrawing*> (_focusView);
+		// the children of an attached container have it as parent, so the children do not need
+		// to be searched for the focus view
+		auto focusView = frame->getFocusView ();
+		if (focusView && focusView->getParentView () == this && focusView->isVisible () &&
+			focusView->wantsFocus ())
+		{
+			_focusView = focusView;
+			_focusDrawing = dynamic_cast<IFocusDrawing*> (_focusView);
+		}
 	}
 
 	{
@@ -852,11 +1374,11 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 		getTransform ().inverse ().transform (clientRect);
 		getTransform ().transform (oldClip2);
 		
-		// draw each view
-		for (const auto& pV : pImpl->children)
-		{
+		auto drawChild = [&] (CView* pV) {
 			if (pV->isVisible ())
 			{
+				if (drawFromCache && !pImpl->bitmapCache->isLive (pV))
+					return;
 				if (frame && _focusDrawing && _focusView == pV && !_focusDrawing->drawFocusOnTop ())
 				{
 					SharedPointer<CGraphicsPath> focusPath = owned (pContext->createGraphicsPath ());
@@ -885,7 +1407,7 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 					CRect viewSize = pV->getViewSize ();
 					viewSize.bound (newClip);
 					if (viewSize.getWidth () == 0 || viewSize.getHeight () == 0)
-						continue;
+						return;
 					pContext->setClipRect (viewSize);
 					float globalContextAlpha = pContext->getGlobalAlpha ();
 					pContext->setGlobalAlpha (globalContextAlpha * pV->getAlphaValue ());
@@ -893,6 +1415,23 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 					pContext->setGlobalAlpha (globalContextAlpha);
 				}
 			}
+		};
+
+		// draw each view
+		if (useSpatialIndex ())
+		{
+			// only the children intersecting the clip rect, the focus view may draw its focus
+			// outside of it. The list is local, as the container may be drawn on multiple threads
+			// and a child may change this container.
+			std::vector<CView*> drawList;
+			pImpl->collectChildrenIn (newClip, _focusDrawing ? _focusView : nullptr, drawList);
+			for (auto pV : drawList)
+				drawChild (pV);
+		}
+		else
+		{
+			for (const auto& pV : pImpl->children)
+				drawChild (pV);
 		}
 	}
 	
@@ -900,13 +1439,19 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 
 	if (frame && _focusView)
 	{
+		// the path belongs to the context, so it is created for every draw
 		SharedPointer<CGraphicsPath> focusPath = owned (pContext->createGraphicsPath ());
 		if (focusPath)
 		{
+			CRect lastDrawnFocus;
 			if (_focusDrawing)
+			{
 				_focusDrawing->getFocusPath (*focusPath);
+				lastDrawnFocus = focusPath->getBoundingBox ();
+			}
 			else
 			{
+				// the bounding box of the default path is known without asking the path
 				CCoord focusWidth = frame->getFocusWidth ();
 				CRect r (_focusView->getVisibleViewSize ());
 				if (!r.isEmpty ())
@@ -914,9 +1459,9 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 					focusPath->addRect (r);
 					r.extend (focusWidth, focusWidth);
 					focusPath->addRect (r);
+					lastDrawnFocus = r;
 				}
 			}
-			auto lastDrawnFocus = focusPath->getBoundingBox ();
 			if (!lastDrawnFocus.isEmpty ())
 			{
 				pContext->setDrawMode (kAntiAliasing|kNonIntegralMode);
@@ -990,18 +1535,16 @@ void CViewContainer::dispatchEventToSubViews (Event& event)
 		auto f = finally ([&] () { mouseEvent->mousePosition = mousePos; });
 		mouseEvent->mousePosition.offset (-getViewSize ().left, -getViewSize ().top);
 		getTransform ().inverse ().transform (mouseEvent->mousePosition);
-		for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end;
-			 ++it)
-		{
-			const auto& pV = *it;
+		pImpl->forEachChildReverse (this, [&] (CView* pV) {
 			if (pV && pV->isVisible () && pV->getMouseEnabled () &&
 				pV->getMouseableArea ().pointInside (mouseEvent->mousePosition))
 			{
 				pV->dispatchEvent (event);
 				if (!pV->getTransparency () || event.consumed)
-					return;
+					return false;
 			}
-		}
+			return true;
+		});
 	}
 }
 
@@ -1033,22 +1576,20 @@ void CViewContainer::onMouseDownEvent (MouseDownEvent& event)
 	auto f = finally ([&, pos = event.mousePosition] () { event.mousePosition = pos; });
 	event.mousePosition.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (event.mousePosition);
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
+	pImpl->forEachChildReverse (this, [&] (CView* pV) {
 		if (pV && pV->isVisible () && pV->getMouseEnabled () &&
 		    pV->hitTest (event.mousePosition, event))
 		{
 			if (!event.modifiers.empty ())
 			{
-				if (auto control = pV.cast<CControl> ())
+				if (auto control = dynamic_cast<CControl*> (pV))
 				{
 					if (auto listener = control->getListener ())
 					{
 						if (listener->controlModifierClicked (control, buttonState) != 0)
 						{
 							event.consumed = true;
-							return;
+							return false;
 						}
 					}
 				}
@@ -1062,7 +1603,7 @@ void CViewContainer::onMouseDownEvent (MouseDownEvent& event)
 				event.consumed = true;
 				if (mouseResult == kMouseMoveEventHandledButDontNeedMoreEvents)
 					event.ignoreFollowUpMoveAndUpEvents (true);
-				return;
+				return false;
 			}
 #endif
 			pV->dispatchEvent (event);
@@ -1071,19 +1612,20 @@ void CViewContainer::onMouseDownEvent (MouseDownEvent& event)
 				if (pV->getNbReference () >1)
 				{
 					if (pV->wantsFocus () && frame && frame->getFocusView () == previousFocusView &&
-					    dynamic_cast<CControl*> (pV.get ()))
+					    dynamic_cast<CControl*> (pV))
 					{
 						getFrame ()->setFocusView (pV);
 					}
 					if (!event.ignoreFollowUpMoveAndUpEvents ())
 						setMouseDownView (pV);
 				}
-				return;
+				return false;
 			}
 			if (!pV->getTransparency ())
-				return;
+				return false;
 		}
-	}
+		return true;
+	});
 }
 
 //------------------------------------------------------------------------
@@ -1357,33 +1899,30 @@ CView* CViewContainer::getViewAt (const CPoint& p, const GetViewOptions& options
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+	CView* result = nullptr;
+	pImpl->forEachChildAt (where, useSpatialIndex (), [&] (CView* pV) {
+		if (!options.getIncludeInvisible () && pV->isVisible () == false)
+			return true;
+		if (options.getMouseEnabled ())
 		{
-			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
-			if (options.getMouseEnabled ())
-			{
-				if (pV->getMouseEnabled () == false)
-					continue;
-			}
-			if (options.getDeep ())
+			if (pV->getMouseEnabled () == false)
+				return true;
+		}
+		if (options.getDeep ())
+		{
+			if (auto container = pV->asViewContainer ())
 			{
-				if (auto container = pV->asViewContainer ())
-				{
-					CView* view = container->getViewAt (where, options);
-					return options.getIncludeViewContainer () ? (view ? view : container) : view;
-				}
+				CView* view = container->getViewAt (where, options);
+				result = options.getIncludeViewContainer () ? (view ? view : container) : view;
+				return false;
 			}
-			if (!options.getIncludeViewContainer () && pV->asViewContainer ())
-				continue;
-			return pV;
 		}
-	}
-
-	return nullptr;
+		if (!options.getIncludeViewContainer () && pV->asViewContainer ())
+			return true;
+		result = pV;
+		return false;
+	});
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1401,32 +1940,28 @@ bool CViewContainer::getViewsAt (const CPoint& p, ViewList& views, const GetView
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+	pImpl->forEachChildAt (where, useSpatialIndex (), [&] (CView* pV) {
+		if (!options.getIncludeInvisible () && pV->isVisible () == false)
+			return true;
+		if (options.getMouseEnabled ())
 		{
-			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
-			if (options.getMouseEnabled ())
-			{
-				if (pV->getMouseEnabled () == false)
-					continue;
-			}
-			if (options.getDeep ())
-			{
-				if (CViewContainer* container = pV->asViewContainer ())
-					result |= container->getViewsAt (where, views, options);
-			}
-			if (options.getIncludeViewContainer () == false)
-			{
-				if (pV->asViewContainer ())
-					continue;
-			}
-			views.emplace_back (pV);
-			result = true;
+			if (pV->getMouseEnabled () == false)
+				return true;
 		}
-	}
+		if (options.getDeep ())
+		{
+			if (CViewContainer* container = pV->asViewContainer ())
+				result |= container->getViewsAt (where, views, options);
+		}
+		if (options.getIncludeViewContainer () == false)
+		{
+			if (pV->asViewContainer ())
+				return true;
+		}
+		views.emplace_back (pV);
+		result = true;
+		return true;
+	});
 
 	return result;
 }
@@ -1443,28 +1978,24 @@ CViewContainer* CViewContainer::getContainerAt (const CPoint& p, const GetViewOp
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+	CViewContainer* result = const_cast<CViewContainer*>(this);
+	pImpl->forEachChildAt (where, useSpatialIndex (), [&] (CView* pV) {
+		if (!options.getIncludeInvisible () && pV->isVisible () == false)
+			return true;
+		if (options.getMouseEnabled ())
 		{
-			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
-			if (options.getMouseEnabled ())
-			{
-				if (pV->getMouseEnabled() == false)
-					continue;
-			}
-			if (options.getDeep ())
-			{
-				if (CViewContainer* container = pV->asViewContainer ())
-					return container->getContainerAt (where, options);
-			}
-			break;
+			if (pV->getMouseEnabled() == false)
+				return true;
 		}
-	}
+		if (options.getDeep ())
+		{
+			if (CViewContainer* container = pV->asViewContainer ())
+				result = container->getContainerAt (where, options);
+		}
+		return false;
+	});
 
-	return const_cast<CViewContainer*>(this);
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1491,9 +2022,13 @@ bool CViewContainer::removed (CView* parent)
 	if (!isAttached ())
 		return false;
 
-	for (const auto& pV : pImpl->children)
+	pImpl->forEachChild (this, [this] (CView* pV) {
 		pV->removed (this);
-	
+		return true;
+	});
+	pImpl->bitmapCache = nullptr;
+	pImpl->resetSpatialIndices ();
+
 	return CView::removed (parent);
 }
 
@@ -1508,8 +2043,10 @@ bool CViewContainer::attached (CView* parent)
 	bool result = CView::attached (parent);
 	if (result)
 	{
-		for (const auto& pV : pImpl->children)
+		pImpl->forEachChild (this, [this] (CView* pV) {
 			pV->attached (this);
+			return true;
+		});
 	}
 	return result;
 }
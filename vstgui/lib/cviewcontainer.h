@@ -12,6 +12,7 @@
 #endif
 #include <list>
 #include <memory>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -52,7 +53,7 @@ private:
 class CViewContainer : public CView
 {
 public:
-	using ViewList = std::list<SharedPointer<CView>>;
+	using ViewList = std::vector<SharedPointer<CView>>;
 
 	explicit CViewContainer (const CRect& size);
 	CViewContainer (const CViewContainer& viewContainer);
@@ -88,6 +89,23 @@ public:
 	/** change view z order position */
 	virtual bool changeViewZOrder (CView* view, uint32_t newIndex);
 
+	/** enable or disable the spatial index of the child views
+	 *
+	 *	While the container is attached, getViewAt, getViewsAt and getContainerAt look up the
+	 *	children at a point in a grid over their mouseable areas instead of testing all of them,
+	 *	and drawRect only visits the children in the grid cells of the update rect. Worth it for
+	 *	containers with many children.
+	 */
+	void setSpatialIndexEnabled (bool state);
+	bool getSpatialIndexEnabled () const { return hasViewFlag (kSpatialIndex); }
+	/** called by the child views when their size or mouseable area changed */
+	void childViewGeometryChanged (CView* view);
+	/** build the state drawRect otherwise builds on demand, so that drawRect does not change the
+	 *	container. Called by the frame on the main thread before the container is drawn on
+	 *	background threads (see CFrame::setTiledDrawingEnabled). Returns false if the container
+	 *	must be drawn on the main thread */
+	bool prepareConcurrentDrawing ();
+
 	virtual bool hitTestSubViews (const CPoint& where, const Event& event);
 
 	/** enable or disable autosizing subviews. Per default this is enabled. */
@@ -121,6 +139,24 @@ public:
 	
 	virtual void setBackgroundColorDrawStyle (CDrawStyle style);
 	CDrawStyle getBackgroundColorDrawStyle () const;
+	void setBackground (CBitmap* background) override;
+	//@}
+
+	//-----------------------------------------------------------------------------
+	/// @name Bitmap Cache Methods
+	//! If caching as bitmap is enabled, the background and all static children are rendered once
+	//! into an offscreen bitmap at the current scale factor, which is drawn instead of them
+	//! afterwards. The parts of the bitmap covered by invalidated children are rendered again on
+	//! the next draw. Children which want idle, are animated or have the focus with focus drawing
+	//! enabled are not cached and are drawn on top of the bitmap. As the bitmap is rendered while
+	//! drawing, the container is always drawn on the main thread (see CFrame::setTiledDrawingEnabled).
+	//-----------------------------------------------------------------------------
+	//@{
+	/** enable or disable caching the static content as bitmap */
+	void setCacheAsBitmap (bool state);
+	bool getCacheAsBitmap () const { return hasViewFlag (kCacheAsBitmap); }
+	/** throw away the cached bitmap, it is rendered again on the next draw */
+	void invalidateBitmapCache ();
 	//@}
 
 	virtual bool advanceNextFocusView (CView* oldFocus, bool reverse = false);
@@ -163,6 +199,9 @@ public:
 
 	void invalid () override;
 	void invalidRect (const CRect& rect) override;
+	/** called by the child views instead of invalidRect, so that the bitmap cache is not
+	 *	invalidated by children drawn on top of it */
+	void invalidChildRect (CView* child, const CRect& rect);
 	
 	void setViewSize (const CRect& rect, bool invalid = true) override;
 	void parentSizeChanged () override;
@@ -178,61 +217,79 @@ public:
 	using ChildViewConstIterator = ViewList::const_iterator;
 	using ChildViewConstReverseIterator = ViewList::const_reverse_iterator;
 
+private:
+	//-----------------------------------------------------------------------------
+	/** the position of a running iteration over the children. The container adjusts it when
+	 *	children are added or removed, so that the iteration neither skips nor repeats a child */
+	struct ChildCursor
+	{
+		ChildCursor (const CViewContainer* container, int64_t index, bool reverse);
+		ChildCursor (const ChildCursor&) = delete;
+		ChildCursor& operator= (const ChildCursor&) = delete;
+		~ChildCursor () noexcept;
+
+		CView* getView () const;
+
+		const CViewContainer* container;
+		/** index of the current child, outside of the children when the iteration ended */
+		int64_t index;
+		bool reverse;
+	};
+
+public:
 	//-----------------------------------------------------------------------------
+	/** iterates the children by position. Children may be added or removed while iterating,
+	 *	including the current one */
 	template<bool reverse>
 	class Iterator
 	{
 	public:
-		using IteratorType = typename std::conditional<reverse, ChildViewConstReverseIterator,
-													   ChildViewConstIterator>::type;
-
-		explicit Iterator (const CViewContainer* container) : children (container->getChildren ())
+		explicit Iterator (const CViewContainer* container)
+		: cursor (container, reverse ? static_cast<int64_t> (container->getChildren ().size ()) - 1 : 0,
+				  reverse)
 		{
-			if constexpr (reverse)
-				iterator = children.rbegin ();
-			else
-				iterator = children.begin ();
 		}
 
 		explicit Iterator (const Iterator<reverse>& vi)
-		: children (vi.children), iterator (vi.iterator)
+		: cursor (vi.cursor.container, vi.cursor.index, reverse)
 		{
 		}
 
-		Iterator (Iterator<reverse>&& o) : children (o.children), iterator (std::move (o.iterator))
+		Iterator (Iterator<reverse>&& o) : cursor (o.cursor.container, o.cursor.index, reverse)
 		{
 		}
 
+		Iterator<reverse>& operator= (const Iterator<reverse>&) = delete;
+
 		Iterator<reverse>& operator++ ()
 		{
-			++iterator;
+			if constexpr (reverse)
+				--cursor.index;
+			else
+				++cursor.index;
 			return *this;
 		}
 
 		Iterator<reverse> operator++ (int)
 		{
 			Iterator<reverse> old (*this);
-			++iterator;
+			++(*this);
 			return old;
 		}
 		
 		Iterator<reverse>& operator-- ()
-		{
-			--iterator;
-			return *this;
-		}
-		
-		CView* operator* () const
 		{
 			if constexpr (reverse)
-				return (iterator == children.rend ()) ? nullptr : *iterator;
+				++cursor.index;
 			else
-				return (iterator == children.end ()) ? nullptr : *iterator;
+				--cursor.index;
+			return *this;
 		}
 		
+		CView* operator* () const { return cursor.getView (); }
+		
 	protected:
-		const ViewList& children;
-		IteratorType iterator;
+		ChildCursor cursor;
 	};
 
 	//-------------------------------------------
@@ -248,7 +305,9 @@ public:
 
 protected:
 	enum {
-		kAutosizeSubviews = 1 << (CView::kLastCViewFlag + 1)
+		kAutosizeSubviews = 1 << (CView::kLastCViewFlag + 1),
+		kCacheAsBitmap = 1 << (CView::kLastCViewFlag + 2),
+		kSpatialIndex = 1 << (CView::kLastCViewFlag + 3)
 	};
 	
 	~CViewContainer () noexcept override;
@@ -266,6 +325,9 @@ private:
 	void clearMouseDownView ();
 	CRect getLastDrawnFocus () const;
 	void setLastDrawnFocus (CRect r);
+	void collectLiveViewsOnBitmapCache (std::vector<CView*>& liveViews) const;
+	bool useSpatialIndex () const;
+	bool updateBitmapCache (CDrawContext* pContext);
 
 	struct Impl;
 	std::unique_ptr<Impl> pImpl;
@@ -300,9 +362,12 @@ inline uint32_t CViewContainer::getChildViewsOfType (ContainerClass& result, boo
 template <typename Proc>
 inline void CViewContainer::forEachChild (Proc proc) const
 {
-	for (auto& child : getChildren ())
+	// via a cursor, proc may add or remove children
+	const auto& children = getChildren ();
+	for (ChildCursor cursor (this, 0, false);
+		 cursor.index < static_cast<int64_t> (children.size ()); ++cursor.index)
 	{
-		proc (child);
+		proc (children[static_cast<size_t> (cursor.index)]);
 	}
 }
 
@@ -0,0 +1,465 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "cpufeatures.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(VSTGUI_BITMAPFILTER_SIMD)
+#define VSTGUI_BITMAPFILTER_SIMD VSTGUI_X86_SIMD
+#endif
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+namespace BitmapFilterSIMD {
+
+//------------------------------------------------------------------------
+/** SSE2 and AVX2 kernels for the standard bitmap filters
+ *
+ *	The kernels work on rows of native 32 bit pixels and treat the four bytes of a pixel alike, so
+ *	the caller only has to translate colors and masks into the pixel format of the bitmap.
+ *	All kernels produce exactly the same pixels as the scalar filter code: the float math is done in
+ *	the same order and integer averages are divided in float, which is exact for divisors below
+ *	65536.
+ */
+#if VSTGUI_BITMAPFILTER_SIMD
+
+//------------------------------------------------------------------------
+/** the four bytes of a pixel as four 32 bit integers */
+VSTGUI_SIMD_TARGET ("sse2")
+inline __m128i widenPixel (uint32_t pixel)
+{
+	const auto zero = _mm_setzero_si128 ();
+	auto value = _mm_unpacklo_epi8 (_mm_cvtsi32_si128 (static_cast<int> (pixel)), zero);
+	return _mm_unpacklo_epi16 (value, zero);
+}
+
+//------------------------------------------------------------------------
+/** four 32 bit integers in the range of 0..255 to a pixel */
+VSTGUI_SIMD_TARGET ("sse2")
+inline uint32_t narrowPixel (__m128i value)
+{
+	value = _mm_packs_epi32 (value, value);
+	return static_cast<uint32_t> (_mm_cvtsi128_si32 (_mm_packus_epi16 (value, value)));
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("sse2")
+inline __m128i divide (__m128i sum, __m128 divisor)
+{
+	return _mm_cvttps_epi32 (_mm_div_ps (_mm_cvtepi32_ps (sum), divisor));
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+inline __m256i divide (__m256i sum, __m256 divisor)
+{
+	return _mm256_cvttps_epi32 (_mm256_div_ps (_mm256_cvtepi32_ps (sum), divisor));
+}
+
+//------------------------------------------------------------------------
+/** output = (input & keepMask) | color */
+VSTGUI_SIMD_TARGET ("sse2")
+inline void setColorSSE2 (const uint32_t* input, uint32_t* output, size_t count, uint32_t color,
+						  uint32_t keepMask)
+{
+	const auto colorV = _mm_set1_epi32 (static_cast<int> (color));
+	const auto keepV = _mm_set1_epi32 (static_cast<int> (keepMask));
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		auto pixels = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + i));
+		pixels = _mm_or_si128 (_mm_and_si128 (pixels, keepV), colorV);
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (output + i), pixels);
+	}
+	for (; i < count; ++i)
+		output[i] = (input[i] & keepMask) | color;
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+inline void setColorAVX2 (const uint32_t* input, uint32_t* output, size_t count, uint32_t color,
+						  uint32_t keepMask)
+{
+	const auto colorV = _mm256_set1_epi32 (static_cast<int> (color));
+	const auto keepV = _mm256_set1_epi32 (static_cast<int> (keepMask));
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		auto pixels = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (input + i));
+		pixels = _mm256_or_si256 (_mm256_and_si256 (pixels, keepV), colorV);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (output + i), pixels);
+	}
+	setColorSSE2 (input + i, output + i, count - i, color, keepMask);
+}
+
+//------------------------------------------------------------------------
+/** output = input == from ? to : input */
+VSTGUI_SIMD_TARGET ("sse2")
+inline void replaceColorSSE2 (const uint32_t* input, uint32_t* output, size_t count, uint32_t from,
+							  uint32_t to)
+{
+	const auto fromV = _mm_set1_epi32 (static_cast<int> (from));
+	const auto toV = _mm_set1_epi32 (static_cast<int> (to));
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		auto pixels = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + i));
+		auto equal = _mm_cmpeq_epi32 (pixels, fromV);
+		pixels = _mm_or_si128 (_mm_and_si128 (equal, toV), _mm_andnot_si128 (equal, pixels));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (output + i), pixels);
+	}
+	for (; i < count; ++i)
+		output[i] = input[i] == from ? to : input[i];
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+inline void replaceColorAVX2 (const uint32_t* input, uint32_t* output, size_t count, uint32_t from,
+							  uint32_t to)
+{
+	const auto fromV = _mm256_set1_epi32 (static_cast<int> (from));
+	const auto toV = _mm256_set1_epi32 (static_cast<int> (to));
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		auto pixels = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (input + i));
+		auto equal = _mm256_cmpeq_epi32 (pixels, fromV);
+		pixels = _mm256_blendv_epi8 (pixels, toV, equal);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (output + i), pixels);
+	}
+	replaceColorSSE2 (input + i, output + i, count - i, from, to);
+}
+
+//------------------------------------------------------------------------
+/** the luma of CColor::getLuma in all color bytes, the alpha byte is kept */
+VSTGUI_SIMD_TARGET ("sse2")
+inline __m128i grayscale (__m128i pixels, __m128i redShift, __m128i greenShift, __m128i blueShift,
+						  __m128i alphaMask)
+{
+	const auto byteMask = _mm_set1_epi32 (0xff);
+	auto red = _mm_cvtepi32_ps (_mm_and_si128 (_mm_srl_epi32 (pixels, redShift), byteMask));
+	auto green = _mm_cvtepi32_ps (_mm_and_si128 (_mm_srl_epi32 (pixels, greenShift), byteMask));
+	auto blue = _mm_cvtepi32_ps (_mm_and_si128 (_mm_srl_epi32 (pixels, blueShift), byteMask));
+	auto luma = _mm_add_ps (_mm_mul_ps (red, _mm_set1_ps (0.3f)),
+							_mm_mul_ps (green, _mm_set1_ps (0.59f)));
+	luma = _mm_add_ps (luma, _mm_mul_ps (blue, _mm_set1_ps (0.11f)));
+	auto result = _mm_cvttps_epi32 (luma);
+	result = _mm_or_si128 (result, _mm_slli_epi32 (result, 8));
+	result = _mm_or_si128 (result, _mm_slli_epi32 (result, 16));
+	return _mm_or_si128 (_mm_andnot_si128 (alphaMask, result), _mm_and_si128 (alphaMask, pixels));
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+inline __m256i grayscale (__m256i pixels, __m128i redShift, __m128i greenShift, __m128i blueShift,
+						  __m256i alphaMask)
+{
+	const auto byteMask = _mm256_set1_epi32 (0xff);
+	auto red = _mm256_cvtepi32_ps (_mm256_and_si256 (_mm256_srl_epi32 (pixels, redShift), byteMask));
+	auto green =
+		_mm256_cvtepi32_ps (_mm256_and_si256 (_mm256_srl_epi32 (pixels, greenShift), byteMask));
+	auto blue =
+		_mm256_cvtepi32_ps (_mm256_and_si256 (_mm256_srl_epi32 (pixels, blueShift), byteMask));
+	auto luma = _mm256_add_ps (_mm256_mul_ps (red, _mm256_set1_ps (0.3f)),
+							   _mm256_mul_ps (green, _mm256_set1_ps (0.59f)));
+	luma = _mm256_add_ps (luma, _mm256_mul_ps (blue, _mm256_set1_ps (0.11f)));
+	auto result = _mm256_cvttps_epi32 (luma);
+	result = _mm256_or_si256 (result, _mm256_slli_epi32 (result, 8));
+	result = _mm256_or_si256 (result, _mm256_slli_epi32 (result, 16));
+	return _mm256_or_si256 (_mm256_andnot_si256 (alphaMask, result),
+							_mm256_and_si256 (alphaMask, pixels));
+}
+
+//------------------------------------------------------------------------
+/** the shifts are the bit positions of the color bytes in a pixel */
+VSTGUI_SIMD_TARGET ("sse2")
+inline void grayscaleSSE2 (const uint32_t* input, uint32_t* output, size_t count, int redShift,
+						   int greenShift, int blueShift, uint32_t alphaMask)
+{
+	const auto redV = _mm_cvtsi32_si128 (redShift);
+	const auto greenV = _mm_cvtsi32_si128 (greenShift);
+	const auto blueV = _mm_cvtsi32_si128 (blueShift);
+	const auto alphaV = _mm_set1_epi32 (static_cast<int> (alphaMask));
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		auto pixels = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + i));
+		pixels = grayscale (pixels, redV, greenV, blueV, alphaV);
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (output + i), pixels);
+	}
+	for (; i < count; ++i)
+	{
+		auto pixel = _mm_cvtsi32_si128 (static_cast<int> (input[i]));
+		pixel = grayscale (pixel, redV, greenV, blueV, alphaV);
+		output[i] = static_cast<uint32_t> (_mm_cvtsi128_si32 (pixel));
+	}
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+inline void grayscaleAVX2 (const uint32_t* input, uint32_t* output, size_t count, int redShift,
+						   int greenShift, int blueShift, uint32_t alphaMask)
+{
+	const auto redV = _mm_cvtsi32_si128 (redShift);
+	const auto greenV = _mm_cvtsi32_si128 (greenShift);
+	const auto blueV = _mm_cvtsi32_si128 (blueShift);
+	const auto alphaV = _mm256_set1_epi32 (static_cast<int> (alphaMask));
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		auto pixels = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (input + i));
+		pixels = grayscale (pixels, redV, greenV, blueV, alphaV);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (output + i), pixels);
+	}
+	grayscaleSSE2 (input + i, output + i, count - i, redShift, greenShift, blueShift, alphaMask);
+}
+
+//------------------------------------------------------------------------
+/** one output row of the bilinear scale filter
+ *
+ *	output pixel i is interpolated between the pixels xIndex[i] and xIndex[i] + 1 of row0 and row1,
+ *	the caller has to make sure that xIndex[i] + 1 is inside of the rows.
+ */
+VSTGUI_SIMD_TARGET ("sse2")
+inline void scaleBilinearRowSSE2 (const uint32_t* row0, const uint32_t* row1, uint32_t* output,
+								  size_t count, const uint32_t* xIndex, const float* xDiff,
+								  float yDiff)
+{
+	const auto zero = _mm_setzero_si128 ();
+	const auto yd = _mm_set1_ps (yDiff);
+	const auto yInv = _mm_set1_ps (1.f - yDiff);
+	for (size_t i = 0; i < count; ++i)
+	{
+		auto x = xIndex[i];
+		auto top = _mm_loadl_epi64 (reinterpret_cast<const __m128i*> (row0 + x));
+		auto bottom = _mm_loadl_epi64 (reinterpret_cast<const __m128i*> (row1 + x));
+		top = _mm_unpacklo_epi8 (top, zero);
+		bottom = _mm_unpacklo_epi8 (bottom, zero);
+		auto c0 = _mm_cvtepi32_ps (_mm_unpacklo_epi16 (top, zero));
+		auto c1 = _mm_cvtepi32_ps (_mm_unpackhi_epi16 (top, zero));
+		auto c2 = _mm_cvtepi32_ps (_mm_unpacklo_epi16 (bottom, zero));
+		auto c3 = _mm_cvtepi32_ps (_mm_unpackhi_epi16 (bottom, zero));
+		auto xd = _mm_set1_ps (xDiff[i]);
+		auto xInv = _mm_set1_ps (1.f - xDiff[i]);
+		auto result = _mm_mul_ps (_mm_mul_ps (c0, xInv), yInv);
+		result = _mm_add_ps (result, _mm_mul_ps (_mm_mul_ps (c1, xd), yInv));
+		result = _mm_add_ps (result, _mm_mul_ps (_mm_mul_ps (c2, yd), xInv));
+		result = _mm_add_ps (result, _mm_mul_ps (_mm_mul_ps (c3, xd), yd));
+		output[i] = narrowPixel (_mm_cvttps_epi32 (result));
+	}
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+inline void scaleBilinearRowAVX2 (const uint32_t* row0, const uint32_t* row1, uint32_t* output,
+								  size_t count, const uint32_t* xIndex, const float* xDiff,
+								  float yDiff)
+{
+	const auto yd = _mm256_set1_ps (yDiff);
+	const auto yInv = _mm256_set1_ps (1.f - yDiff);
+	size_t i = 0;
+	// two output pixels per iteration, one in each 128 bit lane
+	for (; i + 2 <= count; i += 2)
+	{
+		auto x0 = xIndex[i];
+		auto x1 = xIndex[i + 1];
+		auto top = _mm_unpacklo_epi32 (
+			_mm_loadl_epi64 (reinterpret_cast<const __m128i*> (row0 + x0)),
+			_mm_loadl_epi64 (reinterpret_cast<const __m128i*> (row0 + x1)));
+		auto bottom = _mm_unpacklo_epi32 (
+			_mm_loadl_epi64 (reinterpret_cast<const __m128i*> (row1 + x0)),
+			_mm_loadl_epi64 (reinterpret_cast<const __m128i*> (row1 + x1)));
+		auto c0 = _mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (top));
+		auto c1 = _mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (_mm_srli_si128 (top, 8)));
+		auto c2 = _mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (bottom));
+		auto c3 = _mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (_mm_srli_si128 (bottom, 8)));
+		auto xd = _mm256_insertf128_ps (_mm256_castps128_ps256 (_mm_set1_ps (xDiff[i])),
+										_mm_set1_ps (xDiff[i + 1]), 1);
+		auto xInv = _mm256_insertf128_ps (_mm256_castps128_ps256 (_mm_set1_ps (1.f - xDiff[i])),
+										  _mm_set1_ps (1.f - xDiff[i + 1]), 1);
+		auto result = _mm256_mul_ps (_mm256_mul_ps (c0, xInv), yInv);
+		result = _mm256_add_ps (result, _mm256_mul_ps (_mm256_mul_ps (c1, xd), yInv));
+		result = _mm256_add_ps (result, _mm256_mul_ps (_mm256_mul_ps (c2, yd), xInv));
+		result = _mm256_add_ps (result, _mm256_mul_ps (_mm256_mul_ps (c3, xd), yd));
+		auto pixels = _mm256_cvttps_epi32 (result);
+		pixels = _mm256_packs_epi32 (pixels, pixels);
+		pixels = _mm256_packus_epi16 (pixels, pixels);
+		output[i] = static_cast<uint32_t> (_mm_cvtsi128_si32 (_mm256_castsi256_si128 (pixels)));
+		output[i + 1] =
+			static_cast<uint32_t> (_mm_cvtsi128_si32 (_mm256_extracti128_si256 (pixels, 1)));
+	}
+	scaleBilinearRowSSE2 (row0, row1, output + i, count - i, xIndex + i, xDiff + i, yDiff);
+}
+
+//------------------------------------------------------------------------
+/** horizontal pass of the box blur for the rows [rowBegin, rowEnd)
+ *
+ *	writes the averages of all four bytes of the pixels in the box to output, the pixels outside of
+ *	the row are clamped to the first and the last pixel of the row.
+ */
+VSTGUI_SIMD_TARGET ("sse2")
+inline void boxBlurRowsSSE2 (const uint32_t* input, uint32_t* output, int32_t width,
+							 int32_t rowBegin, int32_t rowEnd, int32_t radius)
+{
+	const auto divisor = _mm_set1_ps (static_cast<float> (radius + radius + 1));
+	const auto wm = width - 1;
+	for (auto y = rowBegin; y < rowEnd; ++y)
+	{
+		auto in = input + static_cast<size_t> (y) * width;
+		auto out = output + static_cast<size_t> (y) * width;
+		auto sum = _mm_setzero_si128 ();
+		for (auto i = -radius; i <= radius; ++i)
+			sum = _mm_add_epi32 (sum, widenPixel (in[std::min (wm, std::max (i, 0))]));
+		for (auto x = 0; x < width; ++x)
+		{
+			out[x] = narrowPixel (divide (sum, divisor));
+			sum = _mm_add_epi32 (sum, widenPixel (in[std::min (x + radius + 1, wm)]));
+			sum = _mm_sub_epi32 (sum, widenPixel (in[std::max (x - radius, 0)]));
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("sse2")
+inline void widenPixels (const uint32_t* pixels, __m128i (&result)[4])
+{
+	const auto zero = _mm_setzero_si128 ();
+	auto value = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (pixels));
+	auto low = _mm_unpacklo_epi8 (value, zero);
+	auto high = _mm_unpackhi_epi8 (value, zero);
+	result[0] = _mm_unpacklo_epi16 (low, zero);
+	result[1] = _mm_unpackhi_epi16 (low, zero);
+	result[2] = _mm_unpacklo_epi16 (high, zero);
+	result[3] = _mm_unpackhi_epi16 (high, zero);
+}
+
+//------------------------------------------------------------------------
+/** vertical pass of the box blur for the columns [columnBegin, columnEnd)
+ *
+ *	input is the output of boxBlurRowsSSE2, the pixels outside of the column are clamped to the first
+ *	and the last pixel of the column. Only the bits in writeMask are written to output. The radius
+ *	must be smaller than the height.
+ */
+VSTGUI_SIMD_TARGET ("sse2")
+inline void boxBlurColumnsSSE2 (const uint32_t* input, uint32_t* output, int32_t width,
+								int32_t height, int32_t columnBegin, int32_t columnEnd,
+								int32_t radius, uint32_t writeMask)
+{
+	const auto divisor = _mm_set1_ps (static_cast<float> (radius + radius + 1));
+	const auto writeV = _mm_set1_epi32 (static_cast<int> (writeMask));
+	const auto hm = height - 1;
+	const auto stride = static_cast<size_t> (width);
+	auto x = columnBegin;
+	for (; x + 4 <= columnEnd; x += 4)
+	{
+		__m128i sum[4] = {_mm_setzero_si128 (), _mm_setzero_si128 (), _mm_setzero_si128 (),
+						  _mm_setzero_si128 ()};
+		__m128i add[4];
+		__m128i sub[4];
+		for (auto i = -radius; i <= radius; ++i)
+		{
+			widenPixels (input + std::max (0, i) * stride + x, add);
+			for (auto c = 0; c < 4; ++c)
+				sum[c] = _mm_add_epi32 (sum[c], add[c]);
+		}
+		for (auto y = 0; y < height; ++y)
+		{
+			auto out = reinterpret_cast<__m128i*> (output + y * stride + x);
+			auto pixels = _mm_packus_epi16 (
+				_mm_packs_epi32 (divide (sum[0], divisor), divide (sum[1], divisor)),
+				_mm_packs_epi32 (divide (sum[2], divisor), divide (sum[3], divisor)));
+			if (writeMask != 0xffffffff)
+				pixels = _mm_or_si128 (_mm_and_si128 (pixels, writeV),
+									   _mm_andnot_si128 (writeV, _mm_loadu_si128 (out)));
+			_mm_storeu_si128 (out, pixels);
+			widenPixels (input + std::min (y + radius + 1, hm) * stride + x, add);
+			widenPixels (input + std::max (y - radius, 0) * stride + x, sub);
+			for (auto c = 0; c < 4; ++c)
+				sum[c] = _mm_sub_epi32 (_mm_add_epi32 (sum[c], add[c]), sub[c]);
+		}
+	}
+	for (; x < columnEnd; ++x)
+	{
+		auto sum = _mm_setzero_si128 ();
+		for (auto i = -radius; i <= radius; ++i)
+			sum = _mm_add_epi32 (sum, widenPixel (input[std::max (0, i) * stride + x]));
+		for (auto y = 0; y < height; ++y)
+		{
+			auto& out = output[y * stride + x];
+			out = (narrowPixel (divide (sum, divisor)) & writeMask) | (out & ~writeMask);
+			sum = _mm_add_epi32 (sum, widenPixel (input[std::min (y + radius + 1, hm) * stride + x]));
+			sum = _mm_sub_epi32 (sum, widenPixel (input[std::max (y - radius, 0) * stride + x]));
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+inline void widenPixels (const uint32_t* pixels, __m256i (&result)[4])
+{
+	auto bytes = reinterpret_cast<const __m128i*> (pixels);
+	auto low = _mm_loadu_si128 (bytes);
+	auto high = _mm_loadu_si128 (bytes + 1);
+	result[0] = _mm256_cvtepu8_epi32 (low);
+	result[1] = _mm256_cvtepu8_epi32 (_mm_srli_si128 (low, 8));
+	result[2] = _mm256_cvtepu8_epi32 (high);
+	result[3] = _mm256_cvtepu8_epi32 (_mm_srli_si128 (high, 8));
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+inline void boxBlurColumnsAVX2 (const uint32_t* input, uint32_t* output, int32_t width,
+								int32_t height, int32_t columnBegin, int32_t columnEnd,
+								int32_t radius, uint32_t writeMask)
+{
+	const auto divisor = _mm256_set1_ps (static_cast<float> (radius + radius + 1));
+	const auto writeV = _mm256_set1_epi32 (static_cast<int> (writeMask));
+	// the packs work per 128 bit lane and leave the pixels in the order 0, 2, 4, 6, 1, 3, 5, 7
+	const auto pixelOrder = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+	const auto hm = height - 1;
+	const auto stride = static_cast<size_t> (width);
+	auto x = columnBegin;
+	for (; x + 8 <= columnEnd; x += 8)
+	{
+		__m256i sum[4] = {_mm256_setzero_si256 (), _mm256_setzero_si256 (),
+						  _mm256_setzero_si256 (), _mm256_setzero_si256 ()};
+		__m256i add[4];
+		__m256i sub[4];
+		for (auto i = -radius; i <= radius; ++i)
+		{
+			widenPixels (input + std::max (0, i) * stride + x, add);
+			for (auto c = 0; c < 4; ++c)
+				sum[c] = _mm256_add_epi32 (sum[c], add[c]);
+		}
+		for (auto y = 0; y < height; ++y)
+		{
+			auto out = reinterpret_cast<__m256i*> (output + y * stride + x);
+			auto pixels = _mm256_packus_epi16 (
+				_mm256_packs_epi32 (divide (sum[0], divisor), divide (sum[1], divisor)),
+				_mm256_packs_epi32 (divide (sum[2], divisor), divide (sum[3], divisor)));
+			pixels = _mm256_permutevar8x32_epi32 (pixels, pixelOrder);
+			if (writeMask != 0xffffffff)
+				pixels = _mm256_or_si256 (_mm256_and_si256 (pixels, writeV),
+										  _mm256_andnot_si256 (writeV, _mm256_loadu_si256 (out)));
+			_mm256_storeu_si256 (out, pixels);
+			widenPixels (input + std::min (y + radius + 1, hm) * stride + x, add);
+			widenPixels (input + std::max (y - radius, 0) * stride + x, sub);
+			for (auto c = 0; c < 4; ++c)
+				sum[c] = _mm256_sub_epi32 (_mm256_add_epi32 (sum[c], add[c]), sub[c]);
+		}
+	}
+	boxBlurColumnsSSE2 (input, output, width, height, x, columnEnd, radius, writeMask);
+}
+
+#endif // VSTGUI_BITMAPFILTER_SIMD
+
+//------------------------------------------------------------------------
+} // BitmapFilterSIMD
+} // Detail
+} // VSTGUI
@@ -0,0 +1,91 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#if !defined(VSTGUI_X86_SIMD)
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VSTGUI_X86_SIMD 1
+#else
+#define VSTGUI_X86_SIMD 0
+#endif
+#endif
+
+#if VSTGUI_X86_SIMD
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define VSTGUI_SIMD_TARGET(x)
+#else
+#define VSTGUI_SIMD_TARGET(x) __attribute__ ((target (x)))
+#endif
+#include <immintrin.h>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+/** the instruction set extensions of the CPU the SIMD kernels use, detected once at runtime
+ *
+ *	The kernels are compiled for their extension with VSTGUI_SIMD_TARGET and must only be called if
+ *	the CPU supports it.
+ */
+struct CPUFeatures
+{
+	bool sse2 {false};
+	bool ssse3 {false};
+	bool avx2 {false};
+
+	static const CPUFeatures& get ()
+	{
+		static const CPUFeatures features = detect ();
+		return features;
+	}
+
+private:
+	static CPUFeatures detect ()
+	{
+		CPUFeatures features;
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid (info, 1);
+		features.sse2 = (info[3] & (1 << 26)) != 0;
+		features.ssse3 = (info[2] & (1 << 9)) != 0;
+		// AVX registers are only usable if the OS saves them on context switches
+		bool osSavesYMM = (info[2] & (1 << 27)) != 0 && (_xgetbv (0) & 6) == 6;
+		if (osSavesYMM)
+		{
+			__cpuidex (info, 7, 0);
+			features.avx2 = (info[1] & (1 << 5)) != 0;
+		}
+#else
+		features.sse2 = __builtin_cpu_supports ("sse2");
+		features.ssse3 = __builtin_cpu_supports ("ssse3");
+		features.avx2 = __builtin_cpu_supports ("avx2");
+#endif
+		return features;
+	}
+};
+
+//------------------------------------------------------------------------
+inline bool hasSSE2 ()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+	return true;
+#else
+	return CPUFeatures::get ().sse2;
+#endif
+}
+
+//------------------------------------------------------------------------
+inline bool hasSSSE3 () { return CPUFeatures::get ().ssse3; }
+
+//------------------------------------------------------------------------
+inline bool hasAVX2 () { return CPUFeatures::get ().avx2; }
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
+
+#endif // VSTGUI_X86_SIMD
@@ -0,0 +1,76 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../vstguibase.h"
+#include <atomic>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+/** holds a reference counted object which is created on first use
+ *
+ *	getOrCreate may be called on multiple threads at the same time without locking. If the
+ *	object is created concurrently, only one of them is kept. Assigning and resetting must not be
+ *	done while other threads use the pointer.
+ */
+template<typename T>
+class LazySharedPointer
+{
+public:
+	LazySharedPointer () noexcept = default;
+	LazySharedPointer (const LazySharedPointer& other) noexcept { *this = other; }
+	~LazySharedPointer () noexcept { reset (); }
+
+	LazySharedPointer& operator= (const LazySharedPointer& other) noexcept
+	{
+		auto p = other.get ();
+		if (p)
+			p->remember ();
+		reset ();
+		ptr.store (p, std::memory_order_release);
+		return *this;
+	}
+
+	LazySharedPointer& operator= (LazySharedPointer&& other) noexcept
+	{
+		auto p = other.ptr.exchange (nullptr, std::memory_order_acq_rel);
+		reset ();
+		ptr.store (p, std::memory_order_release);
+		return *this;
+	}
+
+	T* get () const noexcept { return ptr.load (std::memory_order_acquire); }
+
+	template<typename CreateProc>
+	T* getOrCreate (CreateProc&& proc) const
+	{
+		if (auto p = get ())
+			return p;
+		SharedPointer<T> obj = proc ();
+		if (!obj)
+			return nullptr;
+		T* expected = nullptr;
+		if (!ptr.compare_exchange_strong (expected, obj.get (), std::memory_order_acq_rel))
+			return expected;
+		obj->remember ();
+		return obj.get ();
+	}
+
+	void reset () noexcept
+	{
+		if (auto p = ptr.exchange (nullptr, std::memory_order_acq_rel))
+			p->forget ();
+	}
+
+private:
+	mutable std::atomic<T*> ptr {nullptr};
+};
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
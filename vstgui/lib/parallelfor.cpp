@@ -0,0 +1,219 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "parallelfor.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace ParallelForDetail {
+
+//------------------------------------------------------------------------
+static thread_local bool gInsideParallelFor = false;
+
+//------------------------------------------------------------------------
+struct WorkerPool
+{
+	using Proc = std::function<void (size_t index)>;
+	using Task = std::function<void ()>;
+
+	static WorkerPool& instance ()
+	{
+		if (auto pool = gInstance.load (std::memory_order_acquire))
+			return *pool;
+		std::lock_guard<std::mutex> guard (instanceMutex ());
+		auto pool = gInstance.load (std::memory_order_relaxed);
+		if (!pool)
+		{
+			pool = new WorkerPool;
+			gInstance.store (pool, std::memory_order_release);
+		}
+		return *pool;
+	}
+
+	/** joins the threads. The pool is not destroyed with the static objects, because this may
+	 *	happen under the loader lock of a plug-in library on Windows, where joining deadlocks */
+	static void shutdown ()
+	{
+		std::lock_guard<std::mutex> guard (instanceMutex ());
+		delete gInstance.exchange (nullptr, std::memory_order_acq_rel);
+	}
+
+	size_t getConcurrency () const { return threads.size () + 1; }
+
+	bool perform (size_t count, const Proc& proc)
+	{
+		std::unique_lock<std::mutex> jobLock (jobMutex, std::try_to_lock);
+		if (!jobLock.owns_lock ())
+			return false;
+		Job job {&proc, count};
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			currentJob = &job;
+			++generation;
+		}
+		wakeUpCondition.notify_all ();
+		work (job);
+		std::unique_lock<std::mutex> lock (mutex);
+		doneCondition.wait (lock, [&] () { return job.done == count && numActiveWorkers == 0; });
+		// workers waking up late must not see the job anymore
+		currentJob = nullptr;
+		return true;
+	}
+
+	void schedule (Task&& task)
+	{
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			tasks.emplace_back (std::move (task));
+		}
+		wakeUpCondition.notify_one ();
+	}
+
+private:
+	struct Job
+	{
+		const Proc* proc;
+		size_t count;
+		std::atomic<size_t> next {0};
+		std::atomic<size_t> done {0};
+	};
+
+	static std::mutex& instanceMutex ()
+	{
+		static std::mutex gMutex;
+		return gMutex;
+	}
+
+	static std::atomic<WorkerPool*> gInstance;
+
+	WorkerPool ()
+	{
+		// at least one worker thread is needed for the background tasks
+		auto numThreads = std::max (2u, std::thread::hardware_concurrency ()) - 1;
+		for (auto i = 0u; i < numThreads; ++i)
+			threads.emplace_back ([this] () { run (); });
+	}
+
+	~WorkerPool () noexcept
+	{
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			stop = true;
+		}
+		wakeUpCondition.notify_all ();
+		for (auto& thread : threads)
+			thread.join ();
+	}
+
+	void work (Job& job)
+	{
+		size_t index;
+		while ((index = job.next++) < job.count)
+		{
+			(*job.proc) (index);
+			if (++job.done == job.count)
+			{
+				std::lock_guard<std::mutex> guard (mutex);
+				doneCondition.notify_all ();
+			}
+		}
+	}
+
+	void run ()
+	{
+		gInsideParallelFor = true;
+		uint64_t lastGeneration = 0;
+		while (true)
+		{
+			Job* job = nullptr;
+			{
+				std::unique_lock<std::mutex> lock (mutex);
+				wakeUpCondition.wait (lock, [&] () {
+					return stop || !tasks.empty () || (currentJob && generation != lastGeneration);
+				});
+				// the caller of parallelFor waits for the job, so it goes before the tasks
+				if (!currentJob || generation == lastGeneration)
+				{
+					if (tasks.empty ())
+						break; // stopped and all tasks are done
+					auto task = std::move (tasks.front ());
+					tasks.pop_front ();
+					lock.unlock ();
+					task ();
+					continue;
+				}
+				lastGeneration = generation;
+				job = currentJob;
+				++numActiveWorkers;
+			}
+			work (*job);
+			{
+				std::lock_guard<std::mutex> guard (mutex);
+				--numActiveWorkers;
+			}
+			doneCondition.notify_all ();
+		}
+	}
+
+	std::vector<std::thread> threads;
+	std::mutex jobMutex;
+	std::mutex mutex;
+	std::condition_variable wakeUpCondition;
+	std::condition_variable doneCondition;
+	std::deque<Task> tasks;
+	Job* currentJob {nullptr};
+	uint64_t generation {0};
+	uint32_t numActiveWorkers {0};
+	bool stop {false};
+};
+
+//------------------------------------------------------------------------
+std::atomic<WorkerPool*> WorkerPool::gInstance {nullptr};
+
+//------------------------------------------------------------------------
+} // ParallelForDetail
+
+//------------------------------------------------------------------------
+void parallelFor (size_t count, const std::function<void (size_t index)>& proc)
+{
+	using namespace ParallelForDetail;
+	if (count > 1 && !gInsideParallelFor)
+	{
+		gInsideParallelFor = true;
+		auto done = WorkerPool::instance ().perform (count, proc);
+		gInsideParallelFor = false;
+		if (done)
+			return;
+	}
+	for (size_t index = 0; index < count; ++index)
+		proc (index);
+}
+
+//------------------------------------------------------------------------
+size_t getParallelForConcurrency ()
+{
+	return ParallelForDetail::WorkerPool::instance ().getConcurrency ();
+}
+
+//------------------------------------------------------------------------
+void scheduleBackgroundTask (std::function<void ()>&& task)
+{
+	ParallelForDetail::WorkerPool::instance ().schedule (std::move (task));
+}
+
+//------------------------------------------------------------------------
+void shutdownParallelFor ()
+{
+	ParallelForDetail::WorkerPool::shutdown ();
+}
+
+//------------------------------------------------------------------------
+} // VSTGUI
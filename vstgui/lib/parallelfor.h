@@ -0,0 +1,40 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "vstguifwd.h"
+#include <functional>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+/** Calls proc for every index in [0, count) distributed over a shared pool of worker threads
+ *
+ *	The calling thread takes part in the work and the function returns after all calls are done.
+ *	Calls from within proc or while another thread is using the pool are performed serially on
+ *	the calling thread.
+ */
+void parallelFor (size_t count, const std::function<void (size_t index)>& proc);
+
+/** Returns the number of threads parallelFor uses including the calling thread */
+size_t getParallelForConcurrency ();
+
+/** Performs task on one of the worker threads of parallelFor and returns immediately
+ *
+ *	The tasks are started in the order they were scheduled. A parallelFor call goes before the
+ *	pending tasks, calls to parallelFor from within a task are performed serially.
+ */
+void scheduleBackgroundTask (std::function<void ()>&& task);
+
+/** Joins the worker threads of parallelFor after all scheduled background tasks are done
+ *
+ *	Called by VSTGUI::exit, parallelFor must not be in use on any thread. A later call to
+ *	parallelFor or scheduleBackgroundTask starts new worker threads.
+ */
+void shutdownParallelFor ();
+
+//------------------------------------------------------------------------
+} // VSTGUI
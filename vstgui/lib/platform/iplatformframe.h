@@ -16,6 +16,21 @@ namespace VSTGUI {
 
 struct GenericOptionMenuTheme;
 
+//-----------------------------------------------------------------------------
+struct PlatformFrameStatistics
+{
+	/** number of rendered frames */
+	uint64_t numFrames {0};
+	/** number of frames skipped because drawing took longer than the frame interval */
+	uint64_t numSkippedFrames {0};
+	/** durations of drawing and presenting a frame in milliseconds */
+	double lastFrameDuration {0.};
+	double averageFrameDuration {0.};
+	double maxFrameDuration {0.};
+	/** true if the frames are paced by the vertical blank of the display */
+	bool vsyncPaced {false};
+};
+
 //-----------------------------------------------------------------------------
 class IPlatformFrame : public AtomicReferenceCounted
 {
@@ -86,6 +101,9 @@ public:
 	/** setup to use (or not) the generic option menu and optionally set the theme to use */
 	virtual bool setupGenericOptionMenu (bool use, GenericOptionMenuTheme* theme = nullptr) = 0;
 
+	/** get the frame time statistics, return false if not supported */
+	virtual bool getFrameStatistics (PlatformFrameStatistics& statistics) const { return false; }
+
 	//-----------------------------------------------------------------------------
 protected:
 	explicit IPlatformFrame (IPlatformFrameCallback* frame) : frame (frame) {}
@@ -14,6 +14,11 @@
 #include <pango/pango-features.h>
 #include <pango/pangofc-fontmap.h>
 #include <fontconfig/fontconfig.h>
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -23,6 +28,9 @@ namespace {
 using PangoFontHandle = Handle<PangoFont*, decltype (&g_object_ref), g_object_ref,
 							   decltype (&g_object_unref), g_object_unref>;
 
+using PangoLayoutHandle = Handle<PangoLayout*, decltype (&g_object_ref), g_object_ref,
+								 decltype (&g_object_unref), g_object_unref>;
+
 //------------------------------------------------------------------------
 class FontList
 {
@@ -39,6 +47,9 @@ public:
 
 	PangoContext* getFontContext () { return fontContext; }
 
+	/** pango and fontconfig are not thread safe, lock this while using any of their objects */
+	std::mutex& getMutex () { return mutex; }
+
 	bool queryFont (UTF8StringPtr name, CCoord size, int32_t style, PangoFontHandle& fontHandle)
 	{
 		PangoFontDescription* desc = pango_font_description_new ();
@@ -111,6 +122,7 @@ private:
 	FcConfig* fcConfig = nullptr;
 	PangoFontMap* fontMap = nullptr;
 	PangoContext* fontContext = nullptr;
+	std::mutex mutex;
 
 	static int slantFromStyle (int32_t style)
 	{
@@ -123,6 +135,267 @@ private:
 	}
 };
 
+//------------------------------------------------------------------------
+/** least recently used cache of shaped pango layouts
+ *
+ *	keyed by font, style and text, so that drawing and measuring the same string again does not
+ *	need to create and shape a new layout. Views may draw on multiple threads (see
+ *	CFrame::setTiledDrawingEnabled), every thread has its own cache so that the threads don't
+ *	share the layouts. The layouts share the pango context, the font map and the fonts, so all
+ *	uses of them, including drawing, are serialized with the font list mutex.
+ */
+class LayoutCache
+{
+public:
+	struct Layout
+	{
+		PangoLayoutHandle layout;
+		PangoRectangle extents {};
+		CCoord baseline {0.};
+		int width {0};
+	};
+
+	/** the cache of the calling thread */
+	static LayoutCache& forThisThread ()
+	{
+		thread_local LayoutCache gInstance;
+		return gInstance;
+	}
+
+	/** calls proc with the layout of the text, returns false if the layout could not be created */
+	template<typename Proc>
+	bool withLayout (PangoFont* font, int32_t style, const std::string& text, Proc proc)
+	{
+		// the cache mutex is only contended by the functions below, which change the caches of
+		// all threads
+		std::lock_guard<std::mutex> guard (mutex);
+		std::lock_guard<std::mutex> fontListGuard (FontList::instance ().getMutex ());
+		auto layout = get (font, style, text);
+		if (!layout)
+			return false;
+		proc (*layout);
+		return true;
+	}
+
+	/** set the capacity of the caches of all threads */
+	static void setCapacity (size_t numEntries)
+	{
+		auto& r = registry ();
+		std::lock_guard<std::mutex> guard (r.mutex);
+		r.capacity = numEntries;
+		for (auto cache : r.caches)
+		{
+			std::lock_guard<std::mutex> cacheGuard (cache->mutex);
+			std::lock_guard<std::mutex> fontListGuard (FontList::instance ().getMutex ());
+			cache->statistics.capacity = numEntries;
+			while (cache->entries.size () > numEntries)
+				cache->removeLast ();
+		}
+	}
+
+	static void clear ()
+	{
+		forEachCache ([] (LayoutCache& cache) {
+			std::lock_guard<std::mutex> fontListGuard (FontList::instance ().getMutex ());
+			cache.map.clear ();
+			cache.entries.clear ();
+		});
+	}
+
+	/** the sum of the statistics of the caches of all threads, the capacity is per thread */
+	static Font::LayoutCacheStatistics getStatistics ()
+	{
+		Font::LayoutCacheStatistics result;
+		auto& r = registry ();
+		std::lock_guard<std::mutex> guard (r.mutex);
+		result.capacity = r.capacity;
+		for (auto cache : r.caches)
+		{
+			std::lock_guard<std::mutex> cacheGuard (cache->mutex);
+			result.hits += cache->statistics.hits;
+			result.misses += cache->statistics.misses;
+			result.size += cache->entries.size ();
+		}
+		return result;
+	}
+
+	static void resetStatistics ()
+	{
+		forEachCache (
+			[] (LayoutCache& cache) { cache.statistics.hits = cache.statistics.misses = 0; });
+	}
+
+private:
+	struct Registry
+	{
+		std::mutex mutex;
+		std::vector<LayoutCache*> caches;
+		size_t capacity {Font::LayoutCacheStatistics {}.capacity};
+	};
+
+	static Registry& registry ()
+	{
+		// never destroyed, the threads may end after the static objects were destroyed
+		static auto gInstance = new Registry;
+		return *gInstance;
+	}
+
+	template<typename Proc>
+	static void forEachCache (Proc proc)
+	{
+		auto& r = registry ();
+		std::lock_guard<std::mutex> guard (r.mutex);
+		for (auto cache : r.caches)
+		{
+			std::lock_guard<std::mutex> cacheGuard (cache->mutex);
+			proc (*cache);
+		}
+	}
+
+	const Layout* get (PangoFont* font, int32_t style, const std::string& text)
+	{
+		auto it = map.find ({font, style, text});
+		if (it != map.end ())
+		{
+			++statistics.hits;
+			entries.splice (entries.begin (), entries, it->second);
+			return &it->second->layout;
+		}
+		++statistics.misses;
+		auto layout = createLayout (font, style, text);
+		if (!layout.layout)
+			return nullptr;
+		while (entries.size () >= statistics.capacity && !entries.empty ())
+			removeLast ();
+		if (statistics.capacity == 0)
+		{
+			tmpLayout = std::move (layout);
+			return &tmpLayout;
+		}
+		entries.emplace_front (font, style, text, std::move (layout));
+		auto& entry = entries.front ();
+		map.emplace (Key {entry.font, entry.style, entry.text}, entries.begin ());
+		return &entry.layout;
+	}
+
+	struct Entry
+	{
+		Entry (PangoFont* pangoFont, int32_t style, const std::string& text, Layout&& layout)
+		: style (style), text (text), layout (std::move (layout))
+		{
+			// keep the font alive, so that its address stays unique while it is used as key
+			if (pangoFont)
+				font.assign (static_cast<PangoFont*> (g_object_ref (pangoFont)));
+		}
+
+		PangoFontHandle font;
+		int32_t style;
+		std::string text;
+		Layout layout;
+	};
+	using EntryList = std::list<Entry>;
+
+	struct Key
+	{
+		PangoFont* font;
+		int32_t style;
+		std::string_view text;
+
+		bool operator== (const Key& k) const
+		{
+			return font == k.font && style == k.style && text == k.text;
+		}
+	};
+
+	struct KeyHash
+	{
+		size_t operator() (const Key& k) const
+		{
+			auto h = std::hash<std::string_view> {}(k.text);
+			h ^= std::hash<PangoFont*> {}(k.font) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			h ^= std::hash<int32_t> {}(k.style) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			return h;
+		}
+	};
+
+	static Layout createLayout (PangoFont* font, int32_t style, const std::string& text)
+	{
+		Layout result;
+		PangoContext* pangoContext = FontList::instance ().getFontContext ();
+		if (!pangoContext)
+			return result;
+		result.layout.assign (pango_layout_new (pangoContext));
+		if (!result.layout)
+			return result;
+
+		if (font)
+		{
+			PangoFontDescription* desc = pango_font_describe (font);
+			if (desc)
+			{
+				pango_layout_set_font_description (result.layout, desc);
+				pango_font_description_free (desc);
+			}
+		}
+
+		PangoAttrList* attrs = pango_attr_list_new ();
+		if (attrs)
+		{
+			if (style & kUnderlineFace)
+				pango_attr_list_insert (attrs, pango_attr_underline_new (PANGO_UNDERLINE_SINGLE));
+			if (style & kStrikethroughFace)
+				pango_attr_list_insert (attrs, pango_attr_strikethrough_new (true));
+			pango_layout_set_attributes (result.layout, attrs);
+			pango_attr_list_unref (attrs);
+		}
+
+		pango_layout_set_text (result.layout, text.data (), static_cast<int> (text.size ()));
+
+		pango_layout_get_pixel_extents (result.layout, nullptr, &result.extents);
+		pango_layout_get_pixel_size (result.layout, &result.width, nullptr);
+
+		PangoLayoutIter* iter = pango_layout_get_iter (result.layout);
+		if (iter)
+		{
+			result.baseline = pango_units_to_double (pango_layout_iter_get_baseline (iter));
+			pango_layout_iter_free (iter);
+		}
+		return result;
+	}
+
+	void removeLast ()
+	{
+		auto& entry = entries.back ();
+		map.erase ({entry.font, entry.style, entry.text});
+		entries.pop_back ();
+	}
+
+	LayoutCache ()
+	{
+		auto& r = registry ();
+		std::lock_guard<std::mutex> guard (r.mutex);
+		statistics.capacity = r.capacity;
+		r.caches.emplace_back (this);
+	}
+
+	~LayoutCache () noexcept
+	{
+		auto& r = registry ();
+		std::lock_guard<std::mutex> guard (r.mutex);
+		r.caches.erase (std::find (r.caches.begin (), r.caches.end (), this));
+		std::lock_guard<std::mutex> fontListGuard (FontList::instance ().getMutex ());
+		map.clear ();
+		entries.clear ();
+		tmpLayout = {};
+	}
+
+	std::mutex mutex;
+	EntryList entries;
+	std::unordered_map<Key, EntryList::iterator, KeyHash> map;
+	Layout tmpLayout;
+	Font::LayoutCacheStatistics statistics;
+};
+
 //------------------------------------------------------------------------
 } // anonymous
 
@@ -143,6 +416,7 @@ Font::Font (UTF8StringPtr name, const CCoord& size, const int32_t& style)
 	impl = std::unique_ptr<Impl> (new Impl);
 
 	auto& fontList = FontList::instance ();
+	std::lock_guard<std::mutex> guard (fontList.getMutex ());
 
 	if (fontList.queryFont (name, size, style, impl->font))
 	{
@@ -188,7 +462,11 @@ Font::Font (UTF8StringPtr name, const CCoord& size, const int32_t& style)
 }
 
 //------------------------------------------------------------------------
-Font::~Font () {}
+Font::~Font ()
+{
+	std::lock_guard<std::mutex> guard (FontList::instance ().getMutex ());
+	impl->font = {};
+}
 
 //------------------------------------------------------------------------
 bool Font::valid () const { return impl->font; }
@@ -218,89 +496,66 @@ void Font::drawString (const PlatformGraphicsDeviceContextPtr& context, IPlatfor
 	auto linuxString = dynamic_cast<LinuxString*> (string);
 	if (!linuxString)
 		return;
-	PangoContext* pangoContext = FontList::instance ().getFontContext ();
-	if (!pangoContext)
-		return;
-	PangoLayout* layout = pango_layout_new (pangoContext);
-	if (!layout)
-		return;
-
-	if (impl->font)
-	{
-		PangoFontDescription* desc = pango_font_describe (impl->font);
-		if (desc)
-		{
-			pango_layout_set_font_description (layout, desc);
-			pango_font_description_free (desc);
-		}
-	}
-
-	PangoAttrList* attrs = pango_attr_list_new ();
-	if (attrs)
-	{
-		if (impl->style & kUnderlineFace)
-			pango_attr_list_insert (attrs, pango_attr_underline_new (PANGO_UNDERLINE_SINGLE));
-		if (impl->style & kStrikethroughFace)
-			pango_attr_list_insert (attrs, pango_attr_strikethrough_new (true));
-		pango_layout_set_attributes (layout, attrs);
-		pango_attr_list_unref (attrs);
-	}
-
-	pango_layout_set_text (layout, linuxString->get ().c_str (), -1);
-
-	PangoRectangle extents {};
-	pango_layout_get_pixel_extents (layout, nullptr, &extents);
-
-	PangoLayoutIter* iter = pango_layout_get_iter (layout);
-	CCoord baseline = 0.0;
-	if (iter)
-	{
-		baseline = pango_units_to_double (pango_layout_iter_get_baseline (iter));
-		pango_layout_iter_free (iter);
-	}
-
-	cairoContext->drawPangoLayout (layout, {p.x + extents.x, p.y + extents.y - baseline}, color);
-
-	g_object_unref (layout);
+	LayoutCache::forThisThread ().withLayout (
+		impl->font, impl->style, linuxString->get (), [&] (const LayoutCache::Layout& layout) {
+			cairoContext->drawPangoLayout (
+				layout.layout, {p.x + layout.extents.x, p.y + layout.extents.y - layout.baseline},
+				color);
+		});
 }
 
 //------------------------------------------------------------------------
 CCoord Font::getStringWidth (const PlatformGraphicsDeviceContextPtr&, IPlatformString* string,
 							 bool antialias) const
 {
+	CCoord width = 0;
 	if (auto linuxString = dynamic_cast<LinuxString*> (string))
 	{
-		int pangoWidth = 0;
-		PangoContext* context = FontList::instance ().getFontContext ();
-		if (context)
-		{
-			PangoLayout* layout = pango_layout_new (context);
-			if (layout)
-			{
-				if (impl->font)
-				{
-					PangoFontDescription* desc = pango_font_describe (impl->font);
-					if (desc)
-					{
-						pango_layout_set_font_description (layout, desc);
-						pango_font_description_free (desc);
-					}
-				}
-				pango_layout_set_text (layout, linuxString->get ().c_str (), -1);
-				pango_layout_get_pixel_size (layout, &pangoWidth, nullptr);
-				g_object_unref (layout);
-			}
-		}
-
-		return pangoWidth;
+		LayoutCache::forThisThread ().withLayout (
+			impl->font, impl->style, linuxString->get (),
+			[&] (const LayoutCache::Layout& layout) { width = layout.width; });
 	}
-	return 0;
+	return width;
 }
 
+//------------------------------------------------------------------------
+Font::LayoutCacheStatistics Font::getLayoutCacheStatistics ()
+{
+	return LayoutCache::getStatistics ();
+}
+
+//------------------------------------------------------------------------
+void Font::resetLayoutCacheStatistics () { LayoutCache::resetStatistics (); }
+
+//------------------------------------------------------------------------
+void Font::setLayoutCacheCapacity (size_t numEntries)
+{
+	LayoutCache::setCapacity (numEntries);
+}
+
+//------------------------------------------------------------------------
+void Font::clearLayoutCache () { LayoutCache::clear (); }
+
 //------------------------------------------------------------------------
 bool Font::getAllFamilies (const FontFamilyCallback& callback)
 {
-	return Cairo::FontList::instance ().getAllFontFamilies (callback);
+	// the callback is called without holding the font list mutex
+	std::vector<std::string> families;
+	{
+		auto& fontList = FontList::instance ();
+		std::lock_guard<std::mutex> guard (fontList.getMutex ());
+		if (!fontList.getAllFontFamilies ([&] (const std::string& name) {
+				families.emplace_back (name);
+				return true;
+			}))
+			return false;
+	}
+	for (const auto& name : families)
+	{
+		if (!callback (name))
+			break;
+	}
+	return true;
 }
 
 //------------------------------------------------------------------------
@@ -36,6 +36,20 @@ public:
 
 	static bool getAllFamilies (const FontFamilyCallback& callback);
 
+	/** statistics of the caches of shaped text layouts used for drawing and measuring. Every thread
+	 *	has its own cache, the statistics are the sum of them and the capacity is per thread */
+	struct LayoutCacheStatistics
+	{
+		uint64_t hits {0};
+		uint64_t misses {0};
+		size_t size {0};
+		size_t capacity {256};
+	};
+	static LayoutCacheStatistics getLayoutCacheStatistics ();
+	static void resetLayoutCacheStatistics ();
+	static void setLayoutCacheCapacity (size_t numEntries);
+	static void clearLayoutCache ();
+
 private:
 	struct Impl;
 	std::unique_ptr<Impl> impl;
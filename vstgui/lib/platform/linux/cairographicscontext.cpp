@@ -154,24 +154,49 @@ struct CairoGraphicsDeviceContext::Impl
 	template<typename Proc>
 	void doInContext (Proc p)
 	{
-		auto ct = state.tm;
-		CRect clip = state.clip;
-		if (clip.isEmpty ())
+		if (state.clip.isEmpty ())
 			return;
+		applyState ();
 		cairo_save (context);
-		cairo_rectangle (context, clip.left, clip.top, clip.getWidth (), clip.getHeight ());
-		cairo_clip (context);
-		auto matrix = convert (ct);
-		cairo_set_matrix (context, &matrix);
-		auto antialiasMode = state.drawMode.modeIgnoringIntegralMode () == kAntiAliasing
-								 ? CAIRO_ANTIALIAS_BEST
-								 : CAIRO_ANTIALIAS_NONE;
-		cairo_set_antialias (context, antialiasMode);
 		p ();
 		checkCairoStatus (context);
 		cairo_restore (context);
 	}
 
+	// The clip, the transform matrix and the antialias mode are only set on the cairo context
+	// when they differ from the ones already applied, as rebuilding the clip for every
+	// primitive is expensive
+	void applyState ()
+	{
+		if (!applied.valid || applied.clip != state.clip)
+		{
+			const auto& clip = state.clip;
+			cairo_identity_matrix (context);
+			cairo_reset_clip (context);
+			cairo_rectangle (context, clip.left, clip.top, clip.getWidth (), clip.getHeight ());
+			cairo_clip (context);
+			applied.clip = clip;
+			applied.tm = {};
+		}
+		if (!applied.valid || applied.tm != state.tm)
+		{
+			auto matrix = convert (state.tm);
+			cairo_set_matrix (context, &matrix);
+			applied.tm = state.tm;
+		}
+		auto antialiasMode = state.drawMode.modeIgnoringIntegralMode () == kAntiAliasing
+								 ? CAIRO_ANTIALIAS_BEST
+								 : CAIRO_ANTIALIAS_NONE;
+		if (!applied.valid || applied.antialiasMode != antialiasMode)
+		{
+			cairo_set_antialias (context, antialiasMode);
+			applied.antialiasMode = antialiasMode;
+		}
+		applied.valid = true;
+	}
+
+	void invalidateAppliedState () { applied.valid = false; }
+
 	void applyLineWidthCTM ()
 	{
 		auto p = calcLineTranslate ();
@@ -296,7 +321,17 @@ struct CairoGraphicsDeviceContext::Impl
 		TransformMatrix tm {};
 	};
 	State state;
-	std::stack<State> stateStack;
+
+	struct AppliedState
+	{
+		CRect clip {};
+		TransformMatrix tm {};
+		cairo_antialias_t antialiasMode {CAIRO_ANTIALIAS_DEFAULT};
+		bool valid {false};
+	};
+	AppliedState applied;
+
+	std::stack<std::pair<State, AppliedState>> stateStack;
 	double scaleFactor {1.};
 
 	PlatformGraphicsPathFactoryPtr pathFactory;
@@ -331,6 +366,7 @@ bool CairoGraphicsDeviceContext::beginDraw () const
 {
 	if (impl->context)
 		cairo_save (impl->context);
+	impl->invalidateAppliedState ();
 	return true;
 }
 
@@ -339,6 +375,7 @@ bool CairoGraphicsDeviceContext::endDraw () const
 {
 	if (impl->context)
 		cairo_restore (impl->context);
+	impl->invalidateAppliedState ();
 	if (impl->surface)
 		cairo_surface_flush (impl->surface);
 	return true;
@@ -632,7 +669,7 @@ bool CairoGraphicsDeviceContext::fillRadialGradient (IPlatformGraphicsPath& path
 void CairoGraphicsDeviceContext::saveGlobalState () const
 {
 	cairo_save (impl->context);
-	impl->stateStack.push (impl->state);
+	impl->stateStack.push ({impl->state, impl->applied});
 }
 
 //------------------------------------------------------------------------
@@ -645,7 +682,9 @@ void CairoGraphicsDeviceContext::restoreGlobalState () const
 		return;
 #endif
 	cairo_restore (impl->context);
-	impl->state = impl->stateStack.top ();
+	// cairo_restore also reverts the clip, matrix and antialias mode applied in the meantime
+	impl->state = impl->stateStack.top ().first;
+	impl->applied = impl->stateStack.top ().second;
 	impl->stateStack.pop ();
 }
 
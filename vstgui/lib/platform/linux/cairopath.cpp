@@ -31,6 +31,7 @@ PlatformGraphicsPathPtr GraphicsPathFactory::createTextPath (const PlatformFontP
 GraphicsPath::GraphicsPath (const ContextHandle& c) : context (c)
 {
 	cairo_save (context);
+	cairo_identity_matrix (context);
 	cairo_new_path (context);
 }
 
@@ -165,6 +166,8 @@ bool GraphicsPath::hitTest (const CPoint& p, bool evenOddFilled,
 	if (transform)
 		transform->transform (tp);
 	cairo_save (context);
+	cairo_identity_matrix (context);
+	cairo_reset_clip (context);
 	cairo_new_path (context);
 	cairo_append_path (context, path);
 	cairo_set_fill_rule (context,
@@ -180,6 +183,7 @@ CRect GraphicsPath::getBoundingBox () const
 {
 	CRect r;
 	cairo_save (context);
+	cairo_identity_matrix (context);
 	cairo_new_path (context);
 	cairo_append_path (context, path);
 	CPoint p1, p2;
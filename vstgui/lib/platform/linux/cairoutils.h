@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../../crect.h"
 #include <cairo/cairo.h>
 #include <utility>
 
@@ -76,6 +77,55 @@ using ScaledFontHandle = Handle<cairo_scaled_font_t*, decltype (&cairo_scaled_fo
 								cairo_scaled_font_reference, decltype (&cairo_scaled_font_destroy),
 								cairo_scaled_font_destroy>;
 
+//-----------------------------------------------------------------------------
+/** move the content of rect src in surface by distance
+ *
+ *	src and the destination rect may overlap. The content of the surface outside of the
+ *	destination rect is not modified.
+ */
+inline void scrollSurfaceRect (cairo_surface_t* surface, CRect src, CPoint distance)
+{
+	CRect dest (src);
+	dest.offset (distance);
+	if (src.isEmpty () || dest.isEmpty ())
+		return;
+	ContextHandle context (cairo_create (surface));
+	cairo_rectangle (context, dest.left, dest.top, dest.getWidth (), dest.getHeight ());
+	cairo_clip (context);
+	// cairo does not support a surface as source and destination at the same time, so we have
+	// to take the detour via a group
+	cairo_push_group (context);
+	cairo_set_source_surface (context, surface, distance.x, distance.y);
+	cairo_paint (context);
+	cairo_pop_group_to_source (context);
+	cairo_set_operator (context, CAIRO_OPERATOR_SOURCE);
+	cairo_paint (context);
+	cairo_surface_flush (surface);
+}
+
+//-----------------------------------------------------------------------------
+/** calculate the rects which are uncovered when the content of src is moved by distance
+ *
+ *	calls proc for every rect inside the union of the source and the destination rect which is
+ *	not covered by the destination rect.
+ */
+template<typename Proc>
+inline void forEachScrollExposedRect (const CRect& src, const CPoint& distance, Proc proc)
+{
+	CRect dest (src);
+	dest.offset (distance);
+	CRect r (src);
+	r.unite (dest);
+	if (distance.x > 0)
+		proc (CRect (r.left, r.top, dest.left, r.bottom));
+	else if (distance.x < 0)
+		proc (CRect (dest.right, r.top, r.right, r.bottom));
+	if (distance.y > 0)
+		proc (CRect (r.left, r.top, r.right, dest.top));
+	else if (distance.y < 0)
+		proc (CRect (r.left, dest.bottom, r.right, r.bottom));
+}
+
 //-----------------------------------------------------------------------------
 } // Cairo
 } // VSTGUI
@@ -22,15 +22,27 @@
 #include "linuxfactory.h"
 #include "cairographicscontext.h"
 #include "x11platform.h"
+#include "x11framescheduler.h"
 #include "x11utils.h"
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <unordered_map>
+#include <vector>
 #include <X11/Xlib.h>
 #include <xcb/xcb.h>
 #include <xcb/xcb_util.h>
 #include <cairo/cairo-xcb.h>
 
+#if VSTGUI_X11_PRESENT_SUPPORT
+#include <xcb/present.h>
+#endif
+#if VSTGUI_X11_SHM_SUPPORT
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <xcb/shm.h>
+#endif
+
 #ifdef None
 #undef None
 #endif
@@ -166,58 +178,263 @@ struct RedrawTimerHandler
 //------------------------------------------------------------------------
 struct DrawHandler
 {
-	DrawHandler (const ChildWindow& window)
+	DrawHandler (const ChildWindow& window, bool useSharedMemory)
+	: window (window), useSharedMemory (useSharedMemory)
 	{
-		auto s = cairo_xcb_surface_create (RunLoop::instance ().getXcbConnection (),
-										   window.getID (), window.getVisual (),
-										   window.getSize ().x, window.getSize ().y);
-		windowSurface.assign (s);
-		device =
-			getPlatformFactory ().asLinuxFactory ()->getCairoGraphicsDeviceFactory ().addDevice (
-				cairo_surface_get_device (s));
+		auto xcb = RunLoop::instance ().getXcbConnection ();
+		gc = xcb_generate_id (xcb);
+		uint32_t noExposures = 0;
+		xcb_create_gc (xcb, gc, window.getID (), XCB_GC_GRAPHICS_EXPOSURES, &noExposures);
 		onSizeChanged (window.getSize ());
 	}
 
+	~DrawHandler () noexcept
+	{
+		freeBackBuffer ();
+		xcb_free_gc (RunLoop::instance ().getXcbConnection (), gc);
+	}
+
 	void onSizeChanged (const CPoint& size)
 	{
-		cairo_xcb_surface_set_size (windowSurface, size.x, size.y);
-		backBuffer = Cairo::SurfaceHandle (cairo_surface_create_similar (
-			windowSurface, CAIRO_CONTENT_COLOR_ALPHA, size.x, size.y));
+		freeBackBuffer ();
+		auto width = static_cast<uint16_t> (std::max (1., size.x));
+		auto height = static_cast<uint16_t> (std::max (1., size.y));
+		if (!(useSharedMemory && createSharedMemoryBackBuffer (width, height)))
+			createPixmapBackBuffer (width, height);
 		backBufferSize.setSize (size);
-		auto cairoDevice = std::static_pointer_cast<CairoGraphicsDevice> (device);
-		drawContext = std::make_shared<CairoGraphicsDeviceContext> (*cairoDevice, backBuffer);
+		createDrawContext ();
 	}
 
 	void draw (const CInvalidRectList& dirtyRects, IPlatformFrameCallback* frame)
 	{
-		drawContext->beginDraw ();
-		frame->platformDrawRects (drawContext, 1, dirtyRects.data ());
-		drawContext->endDraw ();
+		// the X server still reads the segment of the last present, we must not draw into it
+		if (presentPending)
+			replaceInFlightBackBuffer ();
+		if (!dirtyRects.empty ())
+		{
+			drawContext->beginDraw ();
+			frame->platformDrawRects (drawContext, 1, dirtyRects.data ());
+			drawContext->endDraw ();
+		}
 
-		blitBackbufferToWindow (dirtyRects);
+		for (const auto& r : dirtyRects)
+			scrolledRects.add (r);
+		blitBackbufferToWindow (scrolledRects);
+		scrolledRects.clear ();
 		xcb_flush (RunLoop::instance ().getXcbConnection ());
 	}
 
+	bool scroll (const CRect& src, const CPoint& distance)
+	{
+		// the X server may still read the back buffer, the caller invalidates the rect instead
+		if (presentPending)
+			return false;
+		CRect dest (src);
+		dest.offset (distance);
+		dest.bound (backBufferSize);
+		if (dest.isEmpty ())
+			return false;
+		Cairo::scrollSurfaceRect (backBuffer, src, distance);
+		scrolledRects.add (dest);
+		return true;
+	}
+
+	bool needsBlit () const { return !scrolledRects.empty (); }
+
+	/** the X server may still read the shared memory back buffer of the last present */
+	bool isPresentPending () const { return presentPending; }
+#if VSTGUI_X11_SHM_SUPPORT
+	void onPresentCompleted (xcb_shm_seg_t segment)
+	{
+		// completions of replaced segments don't affect the current one
+		if (segment == shmSegment)
+			presentPending = false;
+	}
+#endif
+
 private:
-	Cairo::SurfaceHandle windowSurface;
+	const ChildWindow& window;
+	bool useSharedMemory;
+	xcb_gcontext_t gc {0};
+	xcb_pixmap_t backBufferPixmap {0};
+#if VSTGUI_X11_SHM_SUPPORT
+	xcb_shm_seg_t shmSegment {0};
+	void* shmAddress {nullptr};
+#endif
+	bool presentPending {false};
 	Cairo::SurfaceHandle backBuffer;
 	CRect backBufferSize;
+	CInvalidRectList scrolledRects;
+	std::vector<xcb_rectangle_t> presentRects;
 	std::shared_ptr<CairoGraphicsDeviceContext> drawContext;
 	PlatformGraphicsDevicePtr device;
 
+	void createDrawContext ()
+	{
+		if (!device)
+		{
+			device = getPlatformFactory ()
+						 .asLinuxFactory ()
+						 ->getCairoGraphicsDeviceFactory ()
+						 .addDevice (cairo_surface_get_device (backBuffer));
+		}
+		auto cairoDevice = std::static_pointer_cast<CairoGraphicsDevice> (device);
+		drawContext = std::make_shared<CairoGraphicsDeviceContext> (*cairoDevice, backBuffer);
+	}
+
+	void createPixmapBackBuffer (uint16_t width, uint16_t height)
+	{
+		// the back buffer is a pixmap with the depth of the window, so that it can be copied to
+		// the window with a plain copy area request
+		auto xcb = RunLoop::instance ().getXcbConnection ();
+		backBufferPixmap = xcb_generate_id (xcb);
+		xcb_create_pixmap (xcb, window.getDepth (), backBufferPixmap, window.getID (), width,
+						   height);
+		backBuffer.assign (cairo_xcb_surface_create (xcb, backBufferPixmap, window.getVisual (),
+													 width, height));
+	}
+
+	bool createSharedMemoryBackBuffer (uint16_t width, uint16_t height)
+	{
+#if VSTGUI_X11_SHM_SUPPORT
+		// the back buffer is rendered by cairo in process and only the damaged rects are
+		// transferred to the X server via a shared memory segment
+		if (!RunLoop::instance ().hasShmExtension ())
+			return false;
+		cairo_format_t format;
+		if (window.getDepth () == 24)
+			format = CAIRO_FORMAT_RGB24;
+		else if (window.getDepth () == 32)
+			format = CAIRO_FORMAT_ARGB32;
+		else
+			return false;
+		auto stride = cairo_format_stride_for_width (format, width);
+		auto shmID = shmget (IPC_PRIVATE, static_cast<size_t> (stride) * height, IPC_CREAT | 0600);
+		if (shmID == -1)
+			return false;
+		auto address = shmat (shmID, nullptr, 0);
+		if (address == reinterpret_cast<void*> (-1))
+		{
+			shmctl (shmID, IPC_RMID, nullptr);
+			return false;
+		}
+		// the run loop has already checked that the X server can attach our segments
+		auto xcb = RunLoop::instance ().getXcbConnection ();
+		auto segment = xcb_generate_id (xcb);
+		xcb_shm_attach (xcb, segment, shmID, false);
+		// the segment is removed as soon as the X server and we have detached it
+		shmctl (shmID, IPC_RMID, nullptr);
+		shmSegment = segment;
+		shmAddress = address;
+		backBuffer.assign (cairo_image_surface_create_for_data (
+			static_cast<unsigned char*> (address), format, width, height, stride));
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void replaceInFlightBackBuffer ()
+	{
+#if VSTGUI_X11_SHM_SUPPORT
+		// the completion event did not arrive in time. The content is moved to a fresh back
+		// buffer instead of reusing the segment, the X server detaches the old one after the
+		// pending put image request
+		auto oldBackBuffer = backBuffer;
+		auto oldSegment = shmSegment;
+		auto oldAddress = shmAddress;
+		drawContext = nullptr;
+		backBuffer = {};
+		shmSegment = 0;
+		shmAddress = nullptr;
+		presentPending = false;
+		auto width = static_cast<uint16_t> (cairo_image_surface_get_width (oldBackBuffer));
+		auto height = static_cast<uint16_t> (cairo_image_surface_get_height (oldBackBuffer));
+		if (!createSharedMemoryBackBuffer (width, height))
+			createPixmapBackBuffer (width, height);
+		auto context = cairo_create (backBuffer);
+		cairo_set_operator (context, CAIRO_OPERATOR_SOURCE);
+		cairo_set_source_surface (context, oldBackBuffer, 0, 0);
+		cairo_paint (context);
+		cairo_destroy (context);
+		cairo_surface_finish (oldBackBuffer);
+		xcb_shm_detach (RunLoop::instance ().getXcbConnection (), oldSegment);
+		shmdt (oldAddress);
+		createDrawContext ();
+#endif
+	}
+
+	void freeBackBuffer ()
+	{
+		if (!backBuffer)
+			return;
+		drawContext = nullptr;
+		cairo_surface_finish (backBuffer);
+		backBuffer = {};
+		auto xcb = RunLoop::instance ().getXcbConnection ();
+		if (backBufferPixmap)
+		{
+			xcb_free_pixmap (xcb, backBufferPixmap);
+			backBufferPixmap = 0;
+		}
+#if VSTGUI_X11_SHM_SUPPORT
+		if (shmAddress)
+		{
+			// the X server handles the detach after all pending put image requests
+			xcb_shm_detach (xcb, shmSegment);
+			shmdt (shmAddress);
+			shmAddress = nullptr;
+			shmSegment = 0;
+			presentPending = false;
+		}
+#endif
+	}
+
 	void blitBackbufferToWindow (const CInvalidRectList& rects)
 	{
-		Cairo::ContextHandle windowContext (cairo_create (windowSurface));
-		cairo_set_source_surface (windowContext, backBuffer, 0, 0);
+		// all rects are copied with one request using them as the clip region
+		presentRects.clear ();
+		CRect bounds;
 		for (auto rect : rects)
 		{
-			cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (),
-							 rect.getHeight ());
-			cairo_clip_preserve (windowContext);
-			cairo_fill (windowContext);
-			cairo_reset_clip (windowContext);
+			rect.makeIntegral ();
+			rect.bound (backBufferSize);
+			if (rect.isEmpty ())
+				continue;
+			if (presentRects.empty ())
+				bounds = rect;
+			else
+				bounds.unite (rect);
+			presentRects.push_back ({static_cast<int16_t> (rect.left),
+									 static_cast<int16_t> (rect.top),
+									 static_cast<uint16_t> (rect.getWidth ()),
+									 static_cast<uint16_t> (rect.getHeight ())});
 		}
-		cairo_surface_flush (windowSurface);
+		if (presentRects.empty ())
+			return;
+		cairo_surface_flush (backBuffer);
+		auto xcb = RunLoop::instance ().getXcbConnection ();
+		xcb_set_clip_rectangles (xcb, XCB_CLIP_ORDERING_UNSORTED, gc, 0, 0,
+								 static_cast<uint32_t> (presentRects.size ()),
+								 presentRects.data ());
+		auto x = static_cast<int16_t> (bounds.left);
+		auto y = static_cast<int16_t> (bounds.top);
+		auto width = static_cast<uint16_t> (bounds.getWidth ());
+		auto height = static_cast<uint16_t> (bounds.getHeight ());
+#if VSTGUI_X11_SHM_SUPPORT
+		if (shmAddress)
+		{
+			// ask for a completion event, we must not draw into the segment before
+			xcb_shm_put_image (xcb, window.getID (), gc,
+							   static_cast<uint16_t> (cairo_image_surface_get_width (backBuffer)),
+							   static_cast<uint16_t> (cairo_image_surface_get_height (backBuffer)),
+							   x, y, width, height, x, y, window.getDepth (),
+							   XCB_IMAGE_FORMAT_Z_PIXMAP, true, shmSegment, 0);
+			presentPending = true;
+			return;
+		}
+#endif
+		xcb_copy_area (xcb, backBufferPixmap, window.getID (), gc, x, y, x, y, width, height);
 	}
 };
 
@@ -317,20 +534,45 @@ struct Frame::Impl : IFrameEventHandler
 	IPlatformFrameCallback* frame;
 	std::unique_ptr<GenericOptionMenuTheme> genericOptionMenuTheme;
 	SharedPointer<RedrawTimerHandler> redrawTimer;
+	FrameScheduler frameScheduler;
+	uint32_t presentSerial {0};
+	uint32_t presentEventID {0};
 	RectList dirtyRects;
 	CCursorType currentCursor {kCursorDefault};
 	uint32_t pointerGrabed {0};
 	XdndHandler dndHandler;
 
 	//------------------------------------------------------------------------
-	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame)
-	: window (parent, size), drawHandler (window), frame (frame), dndHandler (&window, frame)
+	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame, const FrameConfig& config)
+	: window (parent, size)
+	, drawHandler (window, config.useSharedMemoryBackBuffer)
+	, frame (frame)
+	, frameScheduler (config.maxFrameRate)
+	, dndHandler (&window, frame)
 	{
 		RunLoop::instance ().registerWindowEventHandler (window.getID (), this);
+#if VSTGUI_X11_PRESENT_SUPPORT
+		if (RunLoop::instance ().hasPresentExtension ())
+		{
+			auto xcb = RunLoop::instance ().getXcbConnection ();
+			presentEventID = xcb_generate_id (xcb);
+			xcb_present_select_input (xcb, presentEventID, window.getID (),
+									  XCB_PRESENT_EVENT_MASK_COMPLETE_NOTIFY);
+		}
+#endif
 	}
 
 	//------------------------------------------------------------------------
-	~Impl () noexcept { RunLoop::instance ().unregisterWindowEventHandler (window.getID ()); }
+	~Impl () noexcept
+	{
+#if VSTGUI_X11_PRESENT_SUPPORT
+		// an empty event mask removes the selection and frees its event id
+		if (presentEventID)
+			xcb_present_select_input (RunLoop::instance ().getXcbConnection (), presentEventID,
+									  window.getID (), 0);
+#endif
+		RunLoop::instance ().unregisterWindowEventHandler (window.getID ());
+	}
 
 	//------------------------------------------------------------------------
 	void setSize (const CRect& size)
@@ -357,30 +599,108 @@ struct Frame::Impl : IFrameEventHandler
 		xcb_params_cw_t params;
 		params.cursor = RunLoop::instance ().getCursorID (cursor);
 		xcb_aux_change_window_attributes (xcb, window.getID (), XCB_CW_CURSOR, &params);
-		xcb_aux_sync (xcb);
 		xcb_flush (xcb);
 	}
 
+	//------------------------------------------------------------------------
+	bool needsRedraw () const { return !dirtyRects.empty () || drawHandler.needsBlit (); }
+
 	//------------------------------------------------------------------------
 	void redraw ()
 	{
+		auto start = FrameScheduler::Clock::now ();
 		drawHandler.draw (dirtyRects, frame);
 		dirtyRects.clear ();
+		frameScheduler.onFrameRendered (start, FrameScheduler::Clock::now (), requestVSync ());
 	}
 
 	//------------------------------------------------------------------------
-	void invalidRect (CRect r)
+	bool requestVSync ()
+	{
+#if VSTGUI_X11_PRESENT_SUPPORT
+		if (RunLoop::instance ().hasPresentExtension ())
+		{
+			// the server sends a complete notify event on the next vertical blank
+			xcb_present_notify_msc (RunLoop::instance ().getXcbConnection (), window.getID (),
+									++presentSerial, 0, 1, 0);
+			return true;
+		}
+#endif
+		return false;
+	}
+
+	//------------------------------------------------------------------------
+	void scheduleRedraw ()
 	{
-		dirtyRects.add (r);
 		if (redrawTimer)
 			return;
-		redrawTimer = makeOwned<RedrawTimerHandler> (16, [this] () {
-			if (dirtyRects.data ().empty ())
+		auto waitForNotification =
+			frameScheduler.isWaitingForVSync () || drawHandler.isPresentPending ();
+		auto delay = waitForNotification
+						 ? frameScheduler.getVSyncTimeout ()
+						 : frameScheduler.getDelayUntilNextFrame (FrameScheduler::Clock::now ());
+		// the run loop timer resolution is one millisecond
+		auto delayMs = std::max<int64_t> (
+			1, std::chrono::ceil<std::chrono::milliseconds> (delay).count ());
+		redrawTimer = makeOwned<RedrawTimerHandler> (delayMs, [this] () {
+			redrawTimer = nullptr;
+			// the vertical blank notification may get lost, e.g. when the window is not visible
+			if (frameScheduler.isWaitingForVSync ())
+				frameScheduler.onVSync ();
+			if (!needsRedraw ())
 				return;
 			redraw ();
+			// views may have been invalidated while drawing
+			if (needsRedraw ())
+				scheduleRedraw ();
 		});
 	}
 
+	//------------------------------------------------------------------------
+	void invalidRect (CRect r)
+	{
+		dirtyRects.add (r);
+		scheduleRedraw ();
+	}
+
+	//------------------------------------------------------------------------
+	bool scrollRect (CRect src, CPoint distance)
+	{
+		// we can only move whole pixels in the back buffer
+		CRect integralSrc (src);
+		integralSrc.makeIntegral ();
+		if (integralSrc != src || distance.x != std::round (distance.x) ||
+			distance.y != std::round (distance.y))
+			return false;
+		src.bound (CRect (CPoint (), window.getSize ()));
+		if (src.isEmpty ())
+			return false;
+
+		// content which was not drawn yet moves together with the scrolled content
+		std::vector<CRect> movedDirtyRects;
+		for (const auto& r : dirtyRects)
+		{
+			if (!r.rectOverlap (src))
+				continue;
+			CRect moved (r);
+			moved.bound (src);
+			moved.offset (distance);
+			movedDirtyRects.emplace_back (moved);
+		}
+
+		if (!drawHandler.scroll (src, distance))
+			return false;
+
+		for (const auto& r : movedDirtyRects)
+			dirtyRects.add (r);
+		Cairo::forEachScrollExposedRect (src, distance, [this] (const CRect& r) {
+			if (!r.isEmpty ())
+				dirtyRects.add (r);
+		});
+		scheduleRedraw ();
+		return true;
+	}
+
 	//------------------------------------------------------------------------
 	void grabPointer ()
 	{
@@ -541,6 +861,32 @@ struct Frame::Impl : IFrameEventHandler
 		invalidRect (r);
 	}
 
+	//------------------------------------------------------------------------
+	void onEvent (xcb_present_complete_notify_event_t& event) override
+	{
+		frameScheduler.onVSync ();
+		onPresentNotification ();
+	}
+
+	//------------------------------------------------------------------------
+	void onEvent (xcb_shm_completion_event_t& event) override
+	{
+#if VSTGUI_X11_SHM_SUPPORT
+		drawHandler.onPresentCompleted (event.shmseg);
+#endif
+		onPresentNotification ();
+	}
+
+	//------------------------------------------------------------------------
+	void onPresentNotification ()
+	{
+		if (!needsRedraw () || frameScheduler.isWaitingForVSync () ||
+			drawHandler.isPresentPending ())
+			return;
+		redrawTimer = nullptr;
+		scheduleRedraw ();
+	}
+
 	//------------------------------------------------------------------------
 	void onEvent (xcb_property_notify_event_t& event) override
 	{
@@ -640,7 +986,8 @@ Frame::Frame (IPlatformFrameCallback* frame, const CRect& size, uint32_t parent,
 		RunLoop::init (cfg->runLoop);
 	}
 
-	impl = std::unique_ptr<Impl> (new Impl (parent, {size.getWidth (), size.getHeight ()}, frame));
+	impl = std::unique_ptr<Impl> (new Impl (parent, {size.getWidth (), size.getHeight ()}, frame,
+											cfg ? *cfg : FrameConfig ()));
 
 	frame->platformOnActivate (true);
 }
@@ -729,9 +1076,14 @@ bool Frame::invalidRect (const CRect& rect)
 //------------------------------------------------------------------------
 bool Frame::scrollRect (const CRect& src, const CPoint& distance)
 {
-	(void)src;
-	(void)distance;
-	return false;
+	return impl->scrollRect (src, distance);
+}
+
+//------------------------------------------------------------------------
+bool Frame::getFrameStatistics (PlatformFrameStatistics& statistics) const
+{
+	statistics = impl->frameScheduler.getStatistics ();
+	return true;
 }
 
 //------------------------------------------------------------------------
@@ -0,0 +1,82 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../iplatformframe.h"
+#include <algorithm>
+#include <chrono>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace X11 {
+
+//------------------------------------------------------------------------
+/** Decides when the next frame of a window is rendered
+ *
+ *	The first frame after an idle period is rendered immediately, following frames are rendered
+ *	not faster than the maximum frame rate. When drawing a frame takes longer than the frame
+ *	interval, the frames which would have been started while drawing are skipped. When the
+ *	window system signals vertical blanks, no frame is rendered until the last one was shown.
+ */
+struct FrameScheduler
+{
+	using Clock = std::chrono::steady_clock;
+	using Duration = Clock::duration;
+	using TimePoint = Clock::time_point;
+
+	explicit FrameScheduler (uint32_t maxFrameRate = 60) { setMaxFrameRate (maxFrameRate); }
+
+	void setMaxFrameRate (uint32_t maxFrameRate)
+	{
+		frameInterval = std::chrono::duration_cast<Duration> (
+			std::chrono::duration<double> (1. / std::max<uint32_t> (1, maxFrameRate)));
+	}
+	Duration getFrameInterval () const { return frameInterval; }
+	/** time after which a missing vertical blank notification is considered lost */
+	Duration getVSyncTimeout () const { return frameInterval * 4; }
+
+	/** returns the time to wait before the next frame can be rendered */
+	Duration getDelayUntilNextFrame (TimePoint now) const
+	{
+		if (now >= nextFrameTime)
+			return Duration::zero ();
+		return nextFrameTime - now;
+	}
+
+	bool isWaitingForVSync () const { return waitingForVSync; }
+
+	void onFrameRendered (TimePoint start, TimePoint end, bool waitForVSync = false)
+	{
+		auto duration = end - start;
+		auto numIntervals = std::max<Duration::rep> (
+			1, (duration.count () + frameInterval.count () - 1) / frameInterval.count ());
+		nextFrameTime = start + frameInterval * numIntervals;
+		waitingForVSync = waitForVSync;
+
+		using Ms = std::chrono::duration<double, std::milli>;
+		auto ms = std::chrono::duration_cast<Ms> (duration).count ();
+		++statistics.numFrames;
+		statistics.numSkippedFrames += static_cast<uint64_t> (numIntervals - 1);
+		statistics.lastFrameDuration = ms;
+		statistics.maxFrameDuration = std::max (statistics.maxFrameDuration, ms);
+		statistics.averageFrameDuration +=
+			(ms - statistics.averageFrameDuration) / static_cast<double> (statistics.numFrames);
+		statistics.vsyncPaced = waitForVSync;
+	}
+
+	void onVSync () { waitingForVSync = false; }
+
+	const PlatformFrameStatistics& getStatistics () const { return statistics; }
+
+private:
+	Duration frameInterval;
+	TimePoint nextFrameTime {};
+	bool waitingForVSync {false};
+	PlatformFrameStatistics statistics;
+};
+
+//------------------------------------------------------------------------
+} // X11
+} // VSTGUI
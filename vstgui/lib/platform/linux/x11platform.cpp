@@ -28,6 +28,15 @@
 #include <xkbcommon/xkbcommon-x11.h>
 #include <X11/Xlib.h>
 
+#if VSTGUI_X11_PRESENT_SUPPORT
+#include <xcb/present.h>
+#endif
+#if VSTGUI_X11_SHM_SUPPORT
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <xcb/shm.h>
+#endif
+
 // c++11 compile error workaround
 #define explicit _explicit
 #include <xcb/xkb.h>
@@ -123,6 +132,8 @@ struct RunLoop::Impl : IEventHandler
 	KeyboardEvent lastUnprocessedKeyEvent;
 	uint32_t lastUtf32KeyEventChar {0};
 	cairo_device_t* device {nullptr};
+	uint8_t presentOpcode {0};
+	uint8_t shmCompletionEvent {0};
 
 	void init (const SharedPointer<IRunLoop>& inRunLoop)
 	{
@@ -137,6 +148,29 @@ struct RunLoop::Impl : IEventHandler
 
 		xcb_xkb_use_extension (xcbConnection, XKB_X11_MIN_MAJOR_XKB_VERSION,
 							   XKB_X11_MIN_MINOR_XKB_VERSION);
+#if VSTGUI_X11_PRESENT_SUPPORT
+		if (auto presentData = xcb_get_extension_data (xcbConnection, &xcb_present_id))
+		{
+			if (presentData->present)
+			{
+				// the client must announce the version it uses before sending any other request
+				auto cookie = xcb_present_query_version (xcbConnection, XCB_PRESENT_MAJOR_VERSION,
+														 XCB_PRESENT_MINOR_VERSION);
+				if (auto reply = xcb_present_query_version_reply (xcbConnection, cookie, nullptr))
+				{
+					presentOpcode = presentData->major_opcode;
+					free (reply);
+				}
+			}
+		}
+#endif
+#if VSTGUI_X11_SHM_SUPPORT
+		if (auto shmData = xcb_get_extension_data (xcbConnection, &xcb_shm_id))
+		{
+			if (shmData->present && canAttachSharedMemory ())
+				shmCompletionEvent = shmData->first_event + XCB_SHM_COMPLETION;
+		}
+#endif
 		xkbContext = xkb_context_new (XKB_CONTEXT_NO_FLAGS);
 
 		int32_t deviceId = xkb_x11_get_core_keyboard_device_id (xcbConnection);
@@ -163,6 +197,28 @@ struct RunLoop::Impl : IEventHandler
 		}
 	}
 
+#if VSTGUI_X11_SHM_SUPPORT
+	bool canAttachSharedMemory ()
+	{
+		// attaching fails if the X server does not run on this machine. This is checked once
+		// here, so that the frames can attach their back buffers without a round trip
+		auto shmID = shmget (IPC_PRIVATE, 1, IPC_CREAT | 0600);
+		if (shmID == -1)
+			return false;
+		auto segment = xcb_generate_id (xcbConnection);
+		auto error = xcb_request_check (xcbConnection, xcb_shm_attach_checked (
+														   xcbConnection, segment, shmID, false));
+		shmctl (shmID, IPC_RMID, nullptr);
+		if (error)
+		{
+			std::free (error);
+			return false;
+		}
+		xcb_shm_detach (xcbConnection, segment);
+		return true;
+	}
+#endif
+
 	void exit ()
 	{
 		if (--useCount != 0)
@@ -375,10 +431,33 @@ struct RunLoop::Impl : IEventHandler
 					dispatchEvent (*ev, ev->event);
 					break;
 				}
+#if VSTGUI_X11_PRESENT_SUPPORT
+				case XCB_GE_GENERIC:
+				{
+					auto ev = reinterpret_cast<xcb_ge_generic_event_t*> (event);
+					if (presentOpcode && ev->extension == presentOpcode &&
+						ev->event_type == XCB_PRESENT_EVENT_COMPLETE_NOTIFY)
+					{
+						auto cev = reinterpret_cast<xcb_present_complete_notify_event_t*> (event);
+						dispatchEvent (*cev, cev->window);
+					}
+					break;
+				}
+#endif
+				default:
+				{
+#if VSTGUI_X11_SHM_SUPPORT
+					if (shmCompletionEvent && type == shmCompletionEvent)
+					{
+						auto ev = reinterpret_cast<xcb_shm_completion_event_t*> (event);
+						dispatchEvent (*ev, ev->drawable);
+					}
+#endif
+					break;
+				}
 			}
 			std::free (event);
 		}
-		xcb_aux_sync (xcbConnection);
 		xcb_flush (xcbConnection);
 	}
 };
@@ -438,6 +517,18 @@ xcb_connection_t* RunLoop::getXcbConnection () const
 	return impl->xcbConnection;
 }
 
+//------------------------------------------------------------------------
+bool RunLoop::hasPresentExtension () const
+{
+	return impl->presentOpcode != 0;
+}
+
+//------------------------------------------------------------------------
+bool RunLoop::hasShmExtension () const
+{
+	return impl->shmCompletionEvent != 0;
+}
+
 //------------------------------------------------------------------------
 namespace {
 
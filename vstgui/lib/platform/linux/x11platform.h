@@ -21,6 +21,8 @@ struct xcb_map_notify_event_t;
 struct xcb_property_notify_event_t;
 struct xcb_selection_notify_event_t;
 struct xcb_client_message_event_t;
+struct xcb_present_complete_notify_event_t;
+struct xcb_shm_completion_event_t;
 using xcb_window_t = uint32_t;
 
 //------------------------------------------------------------------------
@@ -45,6 +47,8 @@ struct IFrameEventHandler
 	virtual void onEvent (xcb_property_notify_event_t& event) = 0;
 	virtual void onEvent (xcb_selection_notify_event_t& event) = 0;
 	virtual void onEvent (xcb_client_message_event_t& event, xcb_window_t proxyId = 0) = 0;
+	virtual void onEvent (xcb_present_complete_notify_event_t& event) = 0;
+	virtual void onEvent (xcb_shm_completion_event_t& event) = 0;
 };
 
 //------------------------------------------------------------------------
@@ -55,6 +59,8 @@ struct RunLoop
 	static const SharedPointer<IRunLoop> get ();
 
 	xcb_connection_t* getXcbConnection () const;
+	bool hasPresentExtension () const;
+	bool hasShmExtension () const;
 
 	void registerWindowEventHandler (uint32_t windowId, IFrameEventHandler* handler);
 	void unregisterWindowEventHandler (uint32_t windowId);
@@ -9,7 +9,8 @@ namespace X11 {
 namespace {
 
 //------------------------------------------------------------------------
-static xcb_visualtype_t* getVisualType (const xcb_screen_t* screen)
+static xcb_visualtype_t* getVisualType (const xcb_screen_t* screen, xcb_visualid_t visualID,
+										uint8_t& depth)
 {
 	auto depth_iter = xcb_screen_allowed_depths_iterator (screen);
 	for (; depth_iter.rem; xcb_depth_next (&depth_iter))
@@ -19,8 +20,9 @@ static xcb_visualtype_t* getVisualType (const xcb_screen_t* screen)
 		visual_iter = xcb_depth_visuals_iterator (depth_iter.data);
 		for (; visual_iter.rem; xcb_visualtype_next (&visual_iter))
 		{
-			if (screen->root_visual == visual_iter.data->visual_id)
+			if (visualID == visual_iter.data->visual_id)
 			{
+				depth = depth_iter.data->depth;
 				return visual_iter.data;
 			}
 		}
@@ -40,7 +42,6 @@ ChildWindow::ChildWindow (::Window parentId, CPoint size)
 	auto setup = xcb_get_setup (connection);
 	auto iter = xcb_setup_roots_iterator (setup);
 	auto screen = iter.data;
-	visual = getVisualType (screen);
 #if 0
 		parentId = screen->root;
 #endif
@@ -59,6 +60,23 @@ ChildWindow::ChildWindow (::Window parentId, CPoint size)
 						   size.y, 0, XCB_WINDOW_CLASS_INPUT_OUTPUT, XCB_COPY_FROM_PARENT,
 						   paramMask, &params);
 
+	// the window inherits the depth and the visual of the parent, which may differ from the ones of
+	// the root window. The back buffer must use the same ones to be copied to the window.
+	auto geometryCookie = xcb_get_geometry (connection, getID ());
+	auto attributesCookie = xcb_get_window_attributes (connection, getID ());
+	auto visualID = screen->root_visual;
+	if (auto attributes = xcb_get_window_attributes_reply (connection, attributesCookie, nullptr))
+	{
+		visualID = attributes->visual;
+		free (attributes);
+	}
+	visual = getVisualType (screen, visualID, depth);
+	if (auto geometry = xcb_get_geometry_reply (connection, geometryCookie, nullptr))
+	{
+		depth = geometry->depth;
+		free (geometry);
+	}
+
 	// setup XEMBED
 	if (Atoms::xEmbedInfo.valid ())
 	{
@@ -99,6 +117,12 @@ xcb_visualtype_t* ChildWindow::getVisual () const
 	return visual;
 }
 
+//------------------------------------------------------------------------
+uint8_t ChildWindow::getDepth () const
+{
+	return depth;
+}
+
 //------------------------------------------------------------------------
 void ChildWindow::setSize (const CRect& rect)
 {
@@ -26,6 +26,7 @@ struct ChildWindow
 
 	xcb_window_t getID () const;
 	xcb_visualtype_t* getVisual () const;
+	uint8_t getDepth () const;
 
 	void setSize (const CRect& rect);
 
@@ -35,6 +36,7 @@ private:
 	xcb_window_t id;
 	CPoint size;
 	xcb_visualtype_t* visual{nullptr};
+	uint8_t depth {0};
 };
 
 //------------------------------------------------------------------------
@@ -40,6 +40,12 @@ class FrameConfig : public IPlatformFrameConfig
 {
 public:
 	SharedPointer<IRunLoop> runLoop;
+	/** the maximum number of frames rendered per second */
+	uint32_t maxFrameRate {60};
+	/** render into a client side back buffer which is presented via MIT-SHM.
+	 *	Falls back to a server side back buffer if the X server does not support it.
+	 */
+	bool useSharedMemoryBackBuffer {false};
 };
 
 //------------------------------------------------------------------------
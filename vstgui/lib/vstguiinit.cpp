@@ -3,6 +3,7 @@
 
 #include "platform/platformfactory.h"
 #include "cfont.h"
+#include "parallelfor.h"
 
 //-----------------------------------------------------------------------------
 namespace VSTGUI {
@@ -18,6 +19,7 @@ void init (PlatformInstanceHandle instance)
 void exit ()
 {
 	CFontDesc::cleanup ();
+	shutdownParallelFor ();
 	exitPlatform ();
 }
 
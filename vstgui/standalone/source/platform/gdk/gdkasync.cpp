@@ -2,7 +2,10 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
-#include "../../../include/iasync.h"
+#include "gdkasync.h"
+#include "../../../../lib/parallelfor.h"
+#include <atomic>
+#include <glib.h>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -10,6 +13,8 @@ namespace Standalone {
 namespace Platform {
 namespace GDK {
 
+static std::atomic<uint32_t> gBackgroundTaskCount {};
+
 //------------------------------------------------------------------------
 } // GDK
 } // Platform
@@ -17,34 +22,101 @@ namespace GDK {
 //------------------------------------------------------------------------
 namespace Async {
 
+//------------------------------------------------------------------------
+void waitAllTasksDone ()
+{
+	while (Platform::GDK::gBackgroundTaskCount != 0)
+		g_main_context_iteration (nullptr, true);
+	while (g_main_context_pending (nullptr))
+		g_main_context_iteration (nullptr, false);
+}
+
 //------------------------------------------------------------------------
 struct Queue
 {
-	void schedule (Task&& task)
-	{
-		// TODO: scheduling not implemented yet
+	virtual ~Queue () noexcept = default;
+	virtual void schedule (Task&& task) = 0;
+};
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+Task makeBackgroundTask (Task&& task)
+{
+	++Platform::GDK::gBackgroundTaskCount;
+	return [task = std::move (task)] () {
 		task ();
+		--Platform::GDK::gBackgroundTaskCount;
+		// wake up the main loop in case it waits for all tasks to be done
+		g_main_context_wakeup (nullptr);
+	};
+}
+
+//------------------------------------------------------------------------
+struct MainQueue final : Queue
+{
+	void schedule (Task&& task) override
+	{
+		// attaching a source is thread safe and wakes up the main loop
+		auto source = g_idle_source_new ();
+		g_source_set_priority (source, G_PRIORITY_DEFAULT);
+		g_source_set_callback (source,
+							   [] (gpointer userData) -> gboolean {
+								   (*static_cast<Task*> (userData)) ();
+								   return G_SOURCE_REMOVE;
+							   },
+							   new Task (std::move (task)),
+							   [] (gpointer userData) { delete static_cast<Task*> (userData); });
+		g_source_attach (source, nullptr);
+		g_source_unref (source);
 	}
 };
 
+//------------------------------------------------------------------------
+struct BackgroundQueue final : Queue
+{
+	void schedule (Task&& task) override
+	{
+		scheduleBackgroundTask (makeBackgroundTask (std::move (task)));
+	}
+};
+
+//------------------------------------------------------------------------
+struct SerialQueue final : Queue
+{
+	SerialQueue (const char* name) : thread (name) {}
+
+	void schedule (Task&& task) override
+	{
+		thread.schedule (makeBackgroundTask (std::move (task)));
+	}
+
+private:
+	Platform::GDK::SerialTaskThread thread;
+};
+
+//------------------------------------------------------------------------
+} // anonymous
+
 //------------------------------------------------------------------------
 const QueuePtr& mainQueue ()
 {
-	static QueuePtr q = std::make_shared<Queue> ();
+	static QueuePtr q = std::make_shared<MainQueue> ();
 	return q;
 }
 
 //------------------------------------------------------------------------
 const QueuePtr& backgroundQueue ()
 {
-	static QueuePtr q = std::make_shared<Queue> ();
+	static QueuePtr q = std::make_shared<BackgroundQueue> ();
 	return q;
 }
 
 //------------------------------------------------------------------------
 QueuePtr makeSerialQueue (const char* name)
 {
-	return std::make_shared<Queue> ();
+	return std::make_shared<SerialQueue> (name);
 }
 
 //------------------------------------------------------------------------
@@ -0,0 +1,114 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../../include/iasync.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <pthread.h>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Standalone {
+namespace Async {
+
+void waitAllTasksDone ();
+
+//------------------------------------------------------------------------
+} // Async
+
+namespace Platform {
+namespace GDK {
+
+//------------------------------------------------------------------------
+/** Performs tasks serially in the order they were scheduled on a dedicated thread
+ *
+ *	On destruction the thread is detached and finishes the pending tasks.
+ */
+class SerialTaskThread
+{
+public:
+	explicit SerialTaskThread (const char* name = nullptr);
+	~SerialTaskThread () noexcept;
+
+	void schedule (Async::Task&& task);
+
+private:
+	struct State
+	{
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<Async::Task> tasks;
+		bool stop {false};
+	};
+
+	static void run (std::shared_ptr<State> state);
+
+	std::shared_ptr<State> state;
+	std::thread thread;
+};
+
+//------------------------------------------------------------------------
+inline SerialTaskThread::SerialTaskThread (const char* name)
+{
+	state = std::make_shared<State> ();
+	thread = std::thread ([state = state] () { run (state); });
+	if (name)
+	{
+		// thread names are limited to 16 characters including the terminating zero
+		std::string threadName (name);
+		if (threadName.size () > 15)
+			threadName.resize (15);
+		pthread_setname_np (thread.native_handle (), threadName.data ());
+	}
+}
+
+//------------------------------------------------------------------------
+inline SerialTaskThread::~SerialTaskThread () noexcept
+{
+	{
+		std::lock_guard<std::mutex> guard (state->mutex);
+		state->stop = true;
+	}
+	state->condition.notify_one ();
+	thread.detach ();
+}
+
+//------------------------------------------------------------------------
+inline void SerialTaskThread::schedule (Async::Task&& task)
+{
+	{
+		std::lock_guard<std::mutex> guard (state->mutex);
+		state->tasks.emplace_back (std::move (task));
+	}
+	state->condition.notify_one ();
+}
+
+//------------------------------------------------------------------------
+inline void SerialTaskThread::run (std::shared_ptr<State> state)
+{
+	std::unique_lock<std::mutex> lock (state->mutex);
+	while (true)
+	{
+		state->condition.wait (lock, [&] () { return state->stop || !state->tasks.empty (); });
+		if (state->tasks.empty ())
+			break;
+		auto task = std::move (state->tasks.front ());
+		state->tasks.pop_front ();
+		lock.unlock ();
+		task ();
+		lock.lock ();
+	}
+}
+
+//------------------------------------------------------------------------
+} // GDK
+} // Platform
+} // Standalone
+} // VSTGUI
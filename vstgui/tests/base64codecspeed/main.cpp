@@ -1,29 +1,132 @@
-// This file is part of VSTGUI. It is subject to the license terms 
+// This file is part of VSTGUI. It is subject to the license terms
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "vstgui/uidescription/base64codec.h"
 #include "vstgui/lib/malloc.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <random>
 
 using namespace VSTGUI;
 
+namespace {
+
+//------------------------------------------------------------------------
+const char* implementationName (Base64Codec::Implementation impl)
+{
+	switch (impl)
+	{
+		case Base64Codec::Implementation::Scalar: return "scalar";
+		case Base64Codec::Implementation::SSSE3: return "ssse3";
+		case Base64Codec::Implementation::AVX2: return "avx2";
+	}
+	return "";
+}
+
+//------------------------------------------------------------------------
+/** best of numRuns in MB/s */
+template <typename Proc>
+double measureThroughput (size_t numBytes, size_t numRuns, Proc proc)
+{
+	using namespace std::chrono;
+
+	double best = 0.;
+	for (size_t i = 0; i < numRuns; ++i)
+	{
+		auto start = high_resolution_clock::now ();
+		proc ();
+		auto seconds = duration<double> (high_resolution_clock::now () - start).count ();
+		best = std::max (best, numBytes / (1024. * 1024.) / seconds);
+	}
+	return best;
+}
+
+//------------------------------------------------------------------------
+/** encodes and decodes dataSize bytes numIterations times with every supported implementation */
+bool runBenchmark (const Buffer<uint8_t>& origData, size_t dataSize, size_t numIterations)
+{
+	constexpr size_t numRuns = 5;
+
+	auto reference =
+		Base64Codec::encode (origData.get (), dataSize, Base64Codec::Implementation::Scalar);
+
+	printf ("%zu KB x %zu, throughput of the binary side, best of %zu runs\n", dataSize / 1024,
+			numIterations, numRuns);
+	for (auto impl : {Base64Codec::Implementation::Scalar, Base64Codec::Implementation::SSSE3,
+					  Base64Codec::Implementation::AVX2})
+	{
+		if (!Base64Codec::isSupported (impl))
+		{
+			printf ("%-8s not available\n", implementationName (impl));
+			continue;
+		}
+		auto numBytes = dataSize * numIterations;
+		Base64Codec::Result encoderResult;
+		auto encodeSpeed = measureThroughput (numBytes, numRuns, [&] () {
+			for (size_t i = 0; i < numIterations; ++i)
+				encoderResult = Base64Codec::encode (origData.get (), dataSize, impl);
+		});
+		if (encoderResult.dataSize != reference.dataSize ||
+			memcmp (encoderResult.data.get (), reference.data.get (), reference.dataSize) != 0)
+			return false;
+
+		Base64Codec::Result decoderResult;
+		auto decodeSpeed = measureThroughput (numBytes, numRuns, [&] () {
+			for (size_t i = 0; i < numIterations; ++i)
+				decoderResult =
+					Base64Codec::decode (encoderResult.data.get (), encoderResult.dataSize, impl);
+		});
+		if (dataSize != decoderResult.dataSize ||
+			memcmp (origData.get (), decoderResult.data.get (), dataSize) != 0)
+			return false;
+
+		// the stream decoder gets the input in pieces of 4000 bytes
+		size_t streamOffset = 0;
+		bool streamMatches = true;
+		auto streamSpeed = measureThroughput (numBytes, numRuns, [&] () {
+			for (size_t i = 0; i < numIterations; ++i)
+			{
+				streamOffset = 0;
+				Base64Codec::StreamDecoder decoder (
+					[&] (const uint8_t* data, size_t size) {
+						streamMatches &= memcmp (origData.get () + streamOffset, data, size) == 0;
+						streamOffset += size;
+					},
+					16 * 1024, impl);
+				for (size_t pos = 0; pos < encoderResult.dataSize; pos += 4000)
+					decoder.decode (encoderResult.data.get () + pos,
+									std::min<size_t> (4000, encoderResult.dataSize - pos));
+				decoder.finish ();
+			}
+		});
+		if (!streamMatches || streamOffset != dataSize)
+			return false;
+
+		printf ("%-8s encode %8.1f MB/s, decode %8.1f MB/s, stream decode %8.1f MB/s\n",
+				implementationName (impl), encodeSpeed, decodeSpeed, streamSpeed);
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
 int main ()
 {
 	Buffer<uint8_t> origData;
-	origData.allocate (1024*1024*500);
+	origData.allocate (1024*1024*64);
 
 	std::independent_bits_engine<std::default_random_engine, sizeof (uint16_t) * 8, uint16_t> rbe;
 	std::generate (origData.get (), origData.get () + origData.size (), std::ref (rbe));
 
-	auto encoderResult = Base64Codec::encode (origData.get (), origData.size ());
-	auto decoderResult = Base64Codec::decode (encoderResult.data.get (), encoderResult.dataSize);
-
-	if (origData.size () != decoderResult.dataSize)
+	// a typical embedded bitmap and a large block of data
+	if (!runBenchmark (origData, 256 * 1024, 256))
 		return -1;
-
-	if (memcmp (origData.get (), decoderResult.data.get (), origData.size ()) != 0)
+	if (!runBenchmark (origData, origData.size (), 1))
 		return -1;
 	return 0;
 }
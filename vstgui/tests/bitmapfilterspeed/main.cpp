@@ -0,0 +1,278 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cbitmapfilter.h"
+#include "vstgui/lib/ccolor.h"
+#include "vstgui/lib/crect.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/parallelfor.h"
+#include "vstgui/lib/vstguiinit.h"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+using namespace VSTGUI::BitmapFilter;
+
+namespace {
+
+//------------------------------------------------------------------------
+const char* implementationName (Implementation impl)
+{
+	switch (impl)
+	{
+		case Implementation::Scalar: return "scalar";
+		case Implementation::SSE2: return "sse2";
+		case Implementation::AVX2: return "avx2";
+	}
+	return "";
+}
+
+//------------------------------------------------------------------------
+struct FilterSetup
+{
+	const char* name;
+	IdStringPtr filterName;
+	std::function<void (IFilter* filter, const CPoint& inputSize)> setProperties;
+};
+
+//------------------------------------------------------------------------
+/** noise with large areas of a single color, so that replace color has something to replace */
+SharedPointer<CBitmap> createInputBitmap (uint32_t width, uint32_t height)
+{
+	auto bitmap = makeOwned<CBitmap> (width, height);
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	if (!accessor)
+		return nullptr;
+	std::default_random_engine engine;
+	std::uniform_int_distribution<uint32_t> dist;
+	do
+	{
+		if ((accessor->getX () / 16 + accessor->getY () / 16) % 2)
+			accessor->setColor (CColor (200, 100, 50, 255));
+		else
+			accessor->setValue (dist (engine));
+	} while (++(*accessor));
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+std::vector<uint32_t> getPixels (CBitmap* bitmap)
+{
+	std::vector<uint32_t> result;
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	if (!accessor)
+		return result;
+	uint32_t value;
+	do
+	{
+		accessor->getValue (value);
+		result.emplace_back (value);
+	} while (++(*accessor));
+	return result;
+}
+
+//------------------------------------------------------------------------
+/** runs the filter numRuns times and returns the best time in ms and the output pixels */
+double runFilter (const FilterSetup& setup, CBitmap* input, size_t numRuns,
+				  std::vector<uint32_t>& pixels)
+{
+	using namespace std::chrono;
+
+	double best = 0.;
+	for (size_t run = 0; run < numRuns; ++run)
+	{
+		// a filter registers the output bitmap only once, so every run needs a new one
+		auto filter = owned (Factory::getInstance ().createFilter (setup.filterName));
+		filter->setProperty (Standard::Property::kInputBitmap, input);
+		setup.setProperties (filter, input->getSize ());
+		auto start = high_resolution_clock::now ();
+		if (!filter->run ())
+			return -1.;
+		auto ms = duration<double, std::milli> (high_resolution_clock::now () - start).count ();
+		if (run == 0 || ms < best)
+			best = ms;
+		if (run == 0)
+		{
+			auto output = filter->getProperty (Standard::Property::kOutputBitmap).getObject ();
+			pixels = getPixels (dynamic_cast<CBitmap*> (output));
+		}
+	}
+	return best;
+}
+
+//------------------------------------------------------------------------
+/** compares the implementations on a single thread */
+bool runBenchmark (const std::vector<FilterSetup>& setups, CBitmap* input)
+{
+	constexpr size_t numRuns = 10;
+
+	setMaxNumThreads (1);
+	printf ("%u x %u pixels, single thread, best of %zu runs\n",
+			static_cast<uint32_t> (input->getWidth ()), static_cast<uint32_t> (input->getHeight ()),
+			numRuns);
+	for (const auto& setup : setups)
+	{
+		printf ("%-22s", setup.name);
+		std::vector<uint32_t> reference;
+		std::vector<uint32_t> pixels;
+		double scalarTime = 0.;
+		for (auto impl : {Implementation::Scalar, Implementation::SSE2, Implementation::AVX2})
+		{
+			if (!isSupported (impl))
+			{
+				printf (" %s n/a", implementationName (impl));
+				continue;
+			}
+			setImplementation (impl);
+			auto& output = impl == Implementation::Scalar ? reference : pixels;
+			auto ms = runFilter (setup, input, numRuns, output);
+			if (ms < 0.)
+			{
+				printf ("\n%s failed\n", setup.name);
+				return false;
+			}
+			if (impl == Implementation::Scalar)
+			{
+				scalarTime = ms;
+				printf (" %s %8.3f ms", implementationName (impl), ms);
+				continue;
+			}
+			if (pixels != reference)
+			{
+				printf ("\n%s: the %s output differs from the scalar output\n", setup.name,
+						implementationName (impl));
+				return false;
+			}
+			printf (" %s %8.3f ms (%5.1fx)", implementationName (impl), ms, scalarTime / ms);
+		}
+		printf ("\n");
+	}
+	setImplementation (getFastestImplementation ());
+	setMaxNumThreads (0);
+	return true;
+}
+
+//------------------------------------------------------------------------
+/** runs the fastest implementation with 1, 2, 4, ... threads */
+bool runScalingBenchmark (const std::vector<FilterSetup>& setups, CBitmap* input)
+{
+	constexpr size_t numRuns = 10;
+
+	std::vector<uint32_t> threadCounts;
+	auto concurrency = static_cast<uint32_t> (getParallelForConcurrency ());
+	for (uint32_t numThreads = 1; numThreads < concurrency; numThreads *= 2)
+		threadCounts.emplace_back (numThreads);
+	threadCounts.emplace_back (concurrency);
+
+	printf ("%u x %u pixels, %s, best of %zu runs\n", static_cast<uint32_t> (input->getWidth ()),
+			static_cast<uint32_t> (input->getHeight ()),
+			implementationName (getFastestImplementation ()), numRuns);
+	bool result = true;
+	for (const auto& setup : setups)
+	{
+		printf ("%-22s", setup.name);
+		std::vector<uint32_t> reference;
+		std::vector<uint32_t> pixels;
+		double singleThreadTime = 0.;
+		for (auto numThreads : threadCounts)
+		{
+			setMaxNumThreads (numThreads);
+			auto& output = numThreads == 1 ? reference : pixels;
+			auto ms = runFilter (setup, input, numRuns, output);
+			if (ms < 0.)
+			{
+				printf ("\n%s failed\n", setup.name);
+				result = false;
+				break;
+			}
+			if (numThreads == 1)
+			{
+				singleThreadTime = ms;
+				printf (" 1 thread %8.3f ms", ms);
+				continue;
+			}
+			if (pixels != reference)
+			{
+				printf ("\n%s: the output with %u threads differs from the single thread output\n",
+						setup.name, numThreads);
+				result = false;
+				break;
+			}
+			printf (" %2u threads %8.3f ms (%4.1fx)", numThreads, ms, singleThreadTime / ms);
+		}
+		printf ("\n");
+	}
+	setMaxNumThreads (0);
+	return result;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#elif LINUX
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	auto scaleProperties = [] (IFilter* filter, const CPoint& inputSize) {
+		filter->setProperty (Standard::Property::kOutputRect,
+							 CRect (0, 0, inputSize.x * 1.5, inputSize.y * 1.5));
+	};
+	std::vector<FilterSetup> setups = {
+		{"box blur", Standard::kBoxBlur,
+		 [] (IFilter* filter, const CPoint&) {
+			 filter->setProperty (Standard::Property::kRadius, 12);
+		 }},
+		{"box blur alpha only", Standard::kBoxBlur,
+		 [] (IFilter* filter, const CPoint&) {
+			 filter->setProperty (Standard::Property::kRadius, 12);
+			 filter->setProperty (Standard::Property::kAlphaChannelOnly, 1);
+		 }},
+		{"scale bilinear 1.5x", Standard::kScaleBilinear, scaleProperties},
+		{"scale linear 1.5x", Standard::kScaleLinear, scaleProperties},
+		{"grayscale", Standard::kGrayscale, [] (IFilter*, const CPoint&) {}},
+		{"set color", Standard::kSetColor,
+		 [] (IFilter* filter, const CPoint&) {
+			 filter->setProperty (Standard::Property::kInputColor, CColor (10, 20, 30, 255));
+		 }},
+		{"replace color", Standard::kReplaceColor,
+		 [] (IFilter* filter, const CPoint&) {
+			 filter->setProperty (Standard::Property::kInputColor, CColor (200, 100, 50, 255));
+			 filter->setProperty (Standard::Property::kOutputColor, CColor (0, 0, 255, 128));
+		 }},
+	};
+
+	// a control strip and a full background at a scale factor of 2
+	for (auto size : {CPoint (200, 1200), CPoint (2048, 1536)})
+	{
+		auto input = createInputBitmap (static_cast<uint32_t> (size.x), static_cast<uint32_t> (size.y));
+		if (!input)
+		{
+			printf ("the platform does not support pixel access\n");
+			return -1;
+		}
+		if (!runBenchmark (setups, input) || !runScalingBenchmark (setups, input))
+			return -1;
+	}
+	return 0;
+}
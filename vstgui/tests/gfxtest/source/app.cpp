@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "drawdevicetests.h"
+#include "throughputbenchmark.h"
 #include "vstgui/standalone/include/helpers/appdelegate.h"
 #include "vstgui/standalone/include/helpers/uidesc/modelbinding.h"
 #include "vstgui/standalone/include/helpers/value.h"
@@ -30,6 +31,11 @@ public:
 			                        makeDrawDeviceTestsWindow ();
 			                        value.performEdit (0.);
 			                    }));
+		modelBinding->addValue (Value::make ("RunThroughputBenchmark"),
+		                        UIDesc::ValueCalls::onAction ([] (auto& value) {
+			                        runThroughputBenchmark ();
+			                        value.performEdit (0.);
+		                        }));
 
 		UIDesc::Config config;
 		config.uiDescFileName = "Window.uidesc";
@@ -0,0 +1,215 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "throughputbenchmark.h"
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cdrawcontext.h"
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/coffscreencontext.h"
+#include "vstgui/lib/cvstguitimer.h"
+#include "vstgui/lib/platform/iplatformframe.h"
+#include "vstgui/standalone/include/helpers/windowcontroller.h"
+#include "vstgui/standalone/include/iapplication.h"
+#include "vstgui/standalone/include/iasync.h"
+#include "vstgui/standalone/include/iwindow.h"
+#if LINUX
+#include "vstgui/lib/platform/platform_x11.h"
+#endif
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Standalone {
+namespace {
+
+//------------------------------------------------------------------------
+struct BenchmarkVariant
+{
+	const char* name;
+	bool useSharedMemoryBackBuffer;
+};
+
+#if LINUX
+static const std::vector<BenchmarkVariant> gVariants = {{"X11 Pixmap Back Buffer", false},
+														{"MIT-SHM Back Buffer", true}};
+#else
+static const std::vector<BenchmarkVariant> gVariants = {{"Default", false}};
+#endif
+
+static constexpr CCoord kViewWidth = 1024;
+static constexpr CCoord kViewHeight = 768;
+static constexpr uint32_t kNumFrames = 300;
+
+//------------------------------------------------------------------------
+struct BenchmarkResult
+{
+	double framesPerSecond {0.};
+	/** client side time of drawing and submitting a frame, the window system may still be busy with it */
+	double averageFrameDuration {0.};
+	/** bytes of a frame per client side frame duration */
+	double megaBytesPerSecond {0.};
+};
+
+//------------------------------------------------------------------------
+/** Redraws itself as fast as the frame lets it, drawing a bitmap tiled over the whole view */
+class ThroughputBenchmarkView : public CView
+{
+public:
+	using DoneCallback = std::function<void (const BenchmarkResult&)>;
+
+	ThroughputBenchmarkView (DoneCallback&& callback)
+	: CView (CRect (0, 0, kViewWidth, kViewHeight)), doneCallback (std::move (callback))
+	{
+	}
+
+	bool attached (CView* parent) override
+	{
+		if (!CView::attached (parent))
+			return false;
+		timer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { invalid (); }, 1);
+		return true;
+	}
+
+	bool removed (CView* parent) override
+	{
+		timer = nullptr;
+		return CView::removed (parent);
+	}
+
+	void draw (CDrawContext* context) override
+	{
+		if (!tile)
+			createTile ();
+		if (numFrames == 0)
+			startTime = Clock::now ();
+
+		// move the tiles every frame, so that every pixel changes
+		auto offset = static_cast<CCoord> (numFrames % 64);
+		auto tileSize = tile->getSize ();
+		for (auto y = -offset; y < kViewHeight; y += tileSize.y)
+		{
+			for (auto x = -offset; x < kViewWidth; x += tileSize.x)
+				context->drawBitmap (tile, CRect (x, y, x + tileSize.x, y + tileSize.y));
+		}
+		setDirty (false);
+
+		if (++numFrames == kNumFrames)
+			finish ();
+	}
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	void createTile ()
+	{
+		auto offscreen = COffscreenContext::create ({64, 64});
+		offscreen->beginDraw ();
+		for (auto i = 0; i < 8; ++i)
+		{
+			CColor color;
+			color.fromHSV (i * 45., 0.8, 1.);
+			offscreen->setFillColor (color);
+			offscreen->drawRect (CRect (i * 8, 0, i * 8 + 8, 64), kDrawFilled);
+		}
+		offscreen->setFillColor (MakeCColor (0, 0, 0, 128));
+		offscreen->drawEllipse (CRect (8, 8, 56, 56), kDrawFilled);
+		offscreen->endDraw ();
+		tile = offscreen->getBitmap ();
+	}
+
+	void finish ()
+	{
+		timer = nullptr;
+		std::chrono::duration<double> elapsed = Clock::now () - startTime;
+		BenchmarkResult result;
+		result.framesPerSecond = (numFrames - 1) / elapsed.count ();
+		PlatformFrameStatistics statistics;
+		if (getFrame ()->getPlatformFrame ()->getFrameStatistics (statistics))
+			result.averageFrameDuration = statistics.averageFrameDuration;
+		else
+			result.averageFrameDuration = 1000. / result.framesPerSecond;
+		auto bytesPerFrame = kViewWidth * kViewHeight * 4.;
+		result.megaBytesPerSecond =
+			bytesPerFrame / (result.averageFrameDuration / 1000.) / (1024. * 1024.);
+		if (doneCallback)
+			doneCallback (result);
+	}
+
+	SharedPointer<CBitmap> tile;
+	SharedPointer<CVSTGUITimer> timer;
+	DoneCallback doneCallback;
+	uint32_t numFrames {0};
+	Clock::time_point startTime;
+};
+
+//------------------------------------------------------------------------
+class ThroughputBenchmarkController : public WindowControllerAdapter
+{
+public:
+	ThroughputBenchmarkController (const BenchmarkVariant& variant) : variant (variant) {}
+
+	PlatformFrameConfigPtr createPlatformFrameConfig (PlatformType platformType) override
+	{
+#if LINUX
+		auto config = std::make_shared<X11::FrameConfig> ();
+		// measure the drawing and not the refresh rate of the display
+		config->maxFrameRate = 1000;
+		config->useSharedMemoryBackBuffer = variant.useSharedMemoryBackBuffer;
+		return config;
+#else
+		return nullptr;
+#endif
+	}
+
+private:
+	BenchmarkVariant variant;
+};
+
+//------------------------------------------------------------------------
+void runVariant (size_t index)
+{
+	if (index >= gVariants.size ())
+		return;
+	const auto& variant = gVariants[index];
+
+	WindowConfiguration config;
+	config.title = variant.name;
+	config.size = {kViewWidth, kViewHeight};
+	config.style.border ().close ();
+	auto window = IApplication::instance ().createWindow (
+		config, std::make_shared<ThroughputBenchmarkController> (variant));
+	if (!window)
+		return;
+
+	IWindow* windowPtr = window.get ();
+	auto view = new ThroughputBenchmarkView ([windowPtr, index] (const BenchmarkResult& result) {
+		char text[256];
+		snprintf (text, sizeof (text), "%s: %.1f fps, %.2f ms per frame, %.1f MB/s (client side)",
+				  gVariants[index].name, result.framesPerSecond, result.averageFrameDuration,
+				  result.megaBytesPerSecond);
+		printf ("%s\n", text);
+		windowPtr->setTitle (text);
+		Async::schedule (Async::mainQueue (), [index] () { runVariant (index + 1); });
+	});
+	auto frame = makeOwned<CFrame> (CRect (0, 0, kViewWidth, kViewHeight), nullptr);
+	frame->addView (view);
+	window->setContentView (frame);
+	window->show ();
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+void runThroughputBenchmark ()
+{
+	runVariant (0);
+}
+
+//------------------------------------------------------------------------
+} // Standalone
+} // VSTGUI
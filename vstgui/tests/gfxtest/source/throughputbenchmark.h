@@ -0,0 +1,15 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Standalone {
+
+void runThroughputBenchmark ();
+
+//------------------------------------------------------------------------
+} // Standalone
+} // VSTGUI
@@ -0,0 +1,136 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cinvalidrectlist.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace VSTGUI;
+
+namespace {
+
+//------------------------------------------------------------------------
+/** the unbounded implementation of CInvalidRectList before the merge policy was introduced */
+struct LegacyInvalidRectList
+{
+	bool add (const CRect& r)
+	{
+		for (auto it = list.begin (), end = list.end (); it != end; ++it)
+		{
+			if (*it == r)
+				return false;
+			if (it->rectInside (r))
+				return false;
+			if (r.rectInside (*it))
+			{
+				list.erase (it);
+				return add (r);
+			}
+			auto area1 = r.getWidth () * r.getHeight ();
+			auto area2 = it->getWidth () * it->getHeight ();
+			CRect jr (*it);
+			jr.unite (r);
+			auto joinedArea = jr.getWidth () * jr.getHeight ();
+			if (joinedArea <= (area1 + area2))
+			{
+				list.erase (it);
+				return add (jr);
+			}
+		}
+		list.emplace_back (r);
+		return true;
+	}
+
+	const std::vector<CRect>& data () const { return list; }
+	void clear () { list.clear (); }
+
+	std::vector<CRect> list;
+};
+
+//------------------------------------------------------------------------
+/** a grid of meters like in a mixer view, a random subset is invalidated on every tick */
+std::vector<std::vector<CRect>> makeTicks (size_t numTicks, size_t numMeters)
+{
+	constexpr CCoord meterWidth = 8.;
+	constexpr CCoord meterHeight = 120.;
+	constexpr CCoord meterSpacing = 14.;
+	constexpr size_t metersPerRow = 64;
+
+	std::default_random_engine engine;
+	std::uniform_int_distribution<size_t> meterDist (0, numMeters - 1);
+	std::uniform_real_distribution<CCoord> levelDist (0., meterHeight);
+
+	std::vector<std::vector<CRect>> ticks (numTicks);
+	for (auto& tick : ticks)
+	{
+		auto numInvalid = numMeters / 2 + meterDist (engine) / 2;
+		for (size_t i = 0; i < numInvalid; ++i)
+		{
+			auto meter = meterDist (engine);
+			auto x = (meter % metersPerRow) * meterSpacing;
+			auto y = (meter / metersPerRow) * (meterHeight + meterSpacing);
+			auto level = std::floor (levelDist (engine));
+			tick.emplace_back (x, y + level, x + meterWidth, y + meterHeight);
+		}
+	}
+	return ticks;
+}
+
+//------------------------------------------------------------------------
+template<typename List>
+void run (const char* name, List& list, const std::vector<std::vector<CRect>>& ticks)
+{
+	using namespace std::chrono;
+
+	size_t numRects = 0;
+	CCoord area = 0.;
+	auto start = high_resolution_clock::now ();
+	for (const auto& tick : ticks)
+	{
+		list.clear ();
+		for (const auto& r : tick)
+			list.add (r);
+		numRects += list.data ().size ();
+		for (const auto& r : list.data ())
+			area += r.getWidth () * r.getHeight ();
+	}
+	auto duration = duration_cast<microseconds> (high_resolution_clock::now () - start);
+	printf ("%-28s %10.2f us/tick %8.1f rects/tick %12.0f px/tick\n", name,
+			static_cast<double> (duration.count ()) / ticks.size (),
+			static_cast<double> (numRects) / ticks.size (), area / ticks.size ());
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+	constexpr size_t numTicks = 200;
+
+	for (auto numMeters : {64u, 256u, 1024u})
+	{
+		printf ("%u meters:\n", numMeters);
+		auto ticks = makeTicks (numTicks, numMeters);
+
+		LegacyInvalidRectList legacy;
+		run ("legacy", legacy, ticks);
+
+		CInvalidRectList defaultPolicy;
+		run ("default policy", defaultPolicy, ticks);
+
+		CInvalidRectList::MergePolicy policy;
+		policy.maxRects = 64;
+		CInvalidRectList maxRects64 (policy);
+		run ("maxRects 64", maxRects64, ticks);
+
+		policy.maxRects = 128;
+		policy.maxOverdrawRatio = 1.25;
+		CInvalidRectList maxRects128 (policy);
+		run ("maxRects 128, overdraw 1.25", maxRects128, ticks);
+	}
+	return 0;
+}
@@ -0,0 +1,227 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cresourcedescription.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/vstguiinit.h"
+#include "vstgui/uidescription/base64codec.h"
+#include "vstgui/uidescription/compresseduidescription.h"
+#include "vstgui/uidescription/uicontentprovider.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+namespace {
+
+//------------------------------------------------------------------------
+/** a description with embedded bitmaps and templates, bitmaps are noise with a few repetitions */
+std::string makeDescription (size_t numTemplates, size_t viewsPerTemplate, size_t numBitmaps)
+{
+	std::default_random_engine engine;
+	std::uniform_int_distribution<int> byteDist (0, 255);
+
+	std::string str = "{\n\"vstgui-ui-description\": {\n\"version\": \"1\",\n\"bitmaps\": {\n";
+	for (size_t i = 0; i < numBitmaps; ++i)
+	{
+		std::vector<uint8_t> data (32 * 1024);
+		for (size_t pos = 0; pos < data.size (); ++pos)
+			data[pos] = (pos / 64) % 4 ? data[pos % 64] : static_cast<uint8_t> (byteDist (engine));
+		auto base64 = Base64Codec::encode (data.data (), static_cast<uint32_t> (data.size ()));
+		str += "\"bitmap" + std::to_string (i) + "\": {\"path\": \"bitmap" + std::to_string (i) +
+			   ".png\", \"data\": {\"encoding\": \"base64\", \"data\": \"";
+		str.append (reinterpret_cast<const char*> (base64.data.get ()), base64.dataSize);
+		str += i + 1 < numBitmaps ? "\"}},\n" : "\"}}\n";
+	}
+	str += "},\n\"templates\": {\n";
+	for (size_t t = 0; t < numTemplates; ++t)
+	{
+		str += "\"template" + std::to_string (t) +
+			   "\": {\"attributes\": {\"class\": \"CViewContainer\", \"origin\": \"0, 0\", "
+			   "\"size\": \"800, 600\"},\n\"children\": {\n";
+		for (size_t v = 0; v < viewsPerTemplate; ++v)
+		{
+			auto x = std::to_string ((v % 20) * 40);
+			auto y = std::to_string ((v / 20) * 40);
+			str += "\"CKnob\": {\"attributes\": {\"class\": \"CKnob\", \"origin\": \"" + x + ", " +
+				   y + "\", \"size\": \"32, 32\", \"default-value\": \"0.5\", \"min-value\": "
+				   "\"0\", \"max-value\": \"1\", \"bitmap\": \"bitmap" +
+				   std::to_string (v % numBitmaps) + "\"}}";
+			str += v + 1 < viewsPerTemplate ? ",\n" : "\n";
+		}
+		str += t + 1 < numTemplates ? "}},\n" : "}}\n";
+	}
+	str += "}\n}\n}\n";
+	return str;
+}
+
+//------------------------------------------------------------------------
+/** best of numRuns in MB/s */
+template <typename Proc>
+double measureThroughput (size_t numBytes, size_t numRuns, Proc proc)
+{
+	using namespace std::chrono;
+
+	double best = 0.;
+	for (size_t i = 0; i < numRuns; ++i)
+	{
+		auto start = high_resolution_clock::now ();
+		proc ();
+		auto seconds = duration<double> (high_resolution_clock::now () - start).count ();
+		best = std::max (best, numBytes / (1024. * 1024.) / seconds);
+	}
+	return best;
+}
+
+//------------------------------------------------------------------------
+/** raw codec throughput on 1 MB blocks, like CompressedUIDescription uses them */
+bool runCodec (const char* name, uint32_t codecID, const std::string& content)
+{
+	constexpr size_t blockSize = 1024 * 1024;
+	constexpr size_t numRuns = 5;
+
+	auto codec = CompressedUIDescription::findCodec (codecID);
+	if (!codec)
+		return false;
+	std::vector<std::vector<uint8_t>> blocks;
+	auto input = reinterpret_cast<const uint8_t*> (content.data ());
+	size_t compressedSize = 0;
+	auto compressSpeed = measureThroughput (content.size (), numRuns, [&] () {
+		blocks.clear ();
+		compressedSize = 0;
+		for (size_t pos = 0; pos < content.size (); pos += blockSize)
+		{
+			auto size = std::min (blockSize, content.size () - pos);
+			std::vector<uint8_t> block (codec->getMaxCompressedSize (size));
+			block.resize (codec->compress (input + pos, size, block.data (), block.size (), 1));
+			compressedSize += block.size ();
+			blocks.emplace_back (std::move (block));
+		}
+	});
+	std::vector<uint8_t> output (content.size ());
+	bool result = true;
+	auto decompressSpeed = measureThroughput (content.size (), numRuns, [&] () {
+		for (size_t i = 0, pos = 0; i < blocks.size (); ++i, pos += blockSize)
+		{
+			auto size = std::min (blockSize, content.size () - pos);
+			result &= codec->decompress (blocks[i].data (), blocks[i].size (), output.data () + pos,
+										 size);
+		}
+	});
+	if (!result || memcmp (output.data (), input, content.size ()) != 0)
+		return false;
+	printf ("%-8s compress %8.1f MB/s, decompress %8.1f MB/s, ratio %5.2f\n", name, compressSpeed,
+			decompressSpeed, static_cast<double> (content.size ()) / compressedSize);
+	return true;
+}
+
+//------------------------------------------------------------------------
+/** time to parse the file at startup */
+bool runLoad (const char* name, const std::string& path, size_t numIterations, double& reference)
+{
+	using namespace std::chrono;
+
+	auto fileSize = std::filesystem::file_size (path);
+	auto start = high_resolution_clock::now ();
+	for (size_t i = 0; i < numIterations; ++i)
+	{
+		auto desc = makeOwned<CompressedUIDescription> (CResourceDescription (path.data ()));
+		if (!desc->parse ())
+		{
+			printf ("%-8s parsing failed\n", name);
+			return false;
+		}
+	}
+	auto duration = duration_cast<microseconds> (high_resolution_clock::now () - start);
+	auto ms = static_cast<double> (duration.count ()) / 1000. / numIterations;
+	if (reference == 0.)
+		reference = ms;
+	printf ("%-8s %10.2f ms/load %10.1f kB %8.2fx\n", name, ms, fileSize / 1024., reference / ms);
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#elif LINUX
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	constexpr size_t numIterations = 10;
+	constexpr int32_t flags =
+		UIDescription::kWriteImagesIntoUIDescFile | UIDescription::kDoNotVerifyImageData;
+	constexpr int32_t compressedFlags = flags | CompressedUIDescription::kForceWriteCompressedDesc |
+										CompressedUIDescription::kNoPlainUIDescFileBackup;
+
+	auto tempDir = std::filesystem::temp_directory_path ();
+	auto plainPath = (tempDir / "uidesccodecspeed.uidesc").string ();
+	auto zlibPath = (tempDir / "uidesccodecspeed.zlib.uidesc").string ();
+	auto lz4Path = (tempDir / "uidesccodecspeed.lz4.uidesc").string ();
+	auto removeFiles = finally ([&] () {
+		std::filesystem::remove (plainPath);
+		std::filesystem::remove (zlibPath);
+		std::filesystem::remove (lz4Path);
+	});
+
+	auto str = makeDescription (20, 200, 100);
+	{
+		MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+		auto desc = makeOwned<UIDescription> (&provider);
+		auto compressedDesc =
+			makeOwned<CompressedUIDescription> (CResourceDescription (plainPath.data ()));
+		auto saveWithCodec = [&] (uint32_t codec, const std::string& path) {
+			compressedDesc->setCodec (codec);
+			return compressedDesc->save (path.data (), compressedFlags);
+		};
+		if (!desc->parse () || !desc->save (plainPath.data (), flags) ||
+			!compressedDesc->parse () ||
+			!saveWithCodec (CompressedUIDescription::kZLibCodec, zlibPath) ||
+			!saveWithCodec (CompressedUIDescription::kLZ4Codec, lz4Path))
+		{
+			printf ("creating the description files failed\n");
+			return -1;
+		}
+	}
+
+	std::ifstream stream (plainPath, std::ios::binary);
+	std::string content {std::istreambuf_iterator<char> (stream), std::istreambuf_iterator<char> ()};
+	printf ("%zu kB description, codec throughput, best of 5 runs:\n", content.size () / 1024);
+	if (!runCodec ("zlib", CompressedUIDescription::kZLibCodec, content) ||
+		!runCodec ("lz4", CompressedUIDescription::kLZ4Codec, content))
+	{
+		printf ("codec round trip failed\n");
+		return -1;
+	}
+
+	printf ("startup load:\n");
+	double reference = 0.;
+	if (!runLoad ("plain", plainPath, numIterations, reference) ||
+		!runLoad ("zlib", zlibPath, numIterations, reference) ||
+		!runLoad ("lz4", lz4Path, numIterations, reference))
+		return -1;
+	return 0;
+}
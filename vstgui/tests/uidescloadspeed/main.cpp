@@ -0,0 +1,198 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cresourcedescription.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/vstguiinit.h"
+#include "vstgui/uidescription/base64codec.h"
+#include "vstgui/uidescription/detail/uixmlpersistence.h"
+#include "vstgui/uidescription/uicontentprovider.h"
+#include "vstgui/uidescription/uidescription.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+namespace {
+
+//------------------------------------------------------------------------
+/** a description with bitmaps, colors, tags and templates of a medium sized plug-in editor */
+std::string makeDescription (size_t numTemplates, size_t viewsPerTemplate, size_t numBitmaps)
+{
+	std::default_random_engine engine;
+	std::uniform_int_distribution<int> byteDist (0, 255);
+
+	std::string str = "{\n\"vstgui-ui-description\": {\n\"version\": \"1\",\n\"bitmaps\": {\n";
+	for (size_t i = 0; i < numBitmaps; ++i)
+	{
+		std::vector<uint8_t> data (8 * 1024);
+		for (auto& byte : data)
+			byte = static_cast<uint8_t> (byteDist (engine));
+		auto base64 = Base64Codec::encode (data.data (), static_cast<uint32_t> (data.size ()));
+		str += "\"bitmap" + std::to_string (i) + "\": {\"path\": \"bitmap" + std::to_string (i) +
+			   ".png\", \"data\": {\"encoding\": \"base64\", \"data\": \"";
+		str.append (reinterpret_cast<const char*> (base64.data.get ()), base64.dataSize);
+		str += i + 1 < numBitmaps ? "\"}},\n" : "\"}}\n";
+	}
+	str += "},\n\"colors\": {\n";
+	for (size_t i = 0; i < 100; ++i)
+	{
+		char color[16];
+		snprintf (color, sizeof (color), "#%02x%02x%02xff", byteDist (engine), byteDist (engine),
+				  byteDist (engine));
+		str += "\"color" + std::to_string (i) + "\": \"" + color + (i < 99 ? "\",\n" : "\"\n");
+	}
+	str += "},\n\"control-tags\": {\n";
+	for (size_t i = 0; i < 500; ++i)
+		str += "\"tag" + std::to_string (i) + "\": \"" + std::to_string (i) +
+			   (i < 499 ? "\",\n" : "\"\n");
+	str += "},\n\"templates\": {\n";
+	for (size_t t = 0; t < numTemplates; ++t)
+	{
+		str += "\"template" + std::to_string (t) +
+			   "\": {\"attributes\": {\"class\": \"CViewContainer\", \"origin\": \"0, 0\", "
+			   "\"size\": \"800, 600\", \"background-color\": \"color1\"},\n\"children\": {\n";
+		for (size_t v = 0; v < viewsPerTemplate; ++v)
+		{
+			auto x = std::to_string ((v % 20) * 40);
+			auto y = std::to_string ((v / 20) * 40);
+			str += "\"CKnob\": {\"attributes\": {\"class\": \"CKnob\", \"origin\": \"" + x + ", " +
+				   y + "\", \"size\": \"32, 32\", \"control-tag\": \"tag" +
+				   std::to_string (v % 500) + "\", \"default-value\": \"0.5\", \"min-value\": "
+				   "\"0\", \"max-value\": \"1\", \"handle-color\": \"color" +
+				   std::to_string (v % 100) + "\", \"background-offset\": \"0, 0\", "
+				   "\"bitmap\": \"bitmap" + std::to_string (v % numBitmaps) + "\"}}";
+			str += v + 1 < viewsPerTemplate ? ",\n" : "\n";
+		}
+		str += t + 1 < numTemplates ? "}},\n" : "}}\n";
+	}
+	str += "}\n}\n}\n";
+	return str;
+}
+
+//------------------------------------------------------------------------
+void run (const char* name, const std::string& path, size_t numIterations, double& reference)
+{
+	using namespace std::chrono;
+
+	auto fileSize = std::filesystem::file_size (path);
+	auto start = high_resolution_clock::now ();
+	for (size_t i = 0; i < numIterations; ++i)
+	{
+		auto desc = makeOwned<UIDescription> (CResourceDescription (path.data ()));
+		if (!desc->parse ())
+		{
+			printf ("%-8s parsing failed\n", name);
+			return;
+		}
+	}
+	auto duration = duration_cast<microseconds> (high_resolution_clock::now () - start);
+	auto ms = static_cast<double> (duration.count ()) / 1000. / numIterations;
+	if (reference == 0.)
+		reference = ms;
+	printf ("%-8s %10.2f ms/load %10.1f kB %8.2fx\n", name, ms, fileSize / 1024., reference / ms);
+}
+
+#if VSTGUI_ENABLE_XML_PARSER
+//------------------------------------------------------------------------
+void runXMLParser (const std::string& path, size_t numIterations)
+{
+	std::ifstream stream (path, std::ios::binary);
+	std::string content {std::istreambuf_iterator<char> (stream), std::istreambuf_iterator<char> ()};
+
+	for (auto bufferCharData : {false, true})
+	{
+		Detail::UIXMLParseStatistics statistics;
+		double parseTime = 0.;
+		for (size_t i = 0; i < numIterations; ++i)
+		{
+			MemoryContentProvider provider (content.data (), static_cast<uint32_t> (content.size ()));
+			Detail::UIXMLParser parser (bufferCharData);
+			if (!parser.parse (&provider))
+			{
+				printf ("xml parsing failed\n");
+				return;
+			}
+			statistics = parser.getStatistics ();
+			parseTime += statistics.parseTime;
+		}
+		printf ("  %-8s %8.2f ms/parse, %llu nodes, %llu attributes, %llu kB char data in %llu "
+				"allocations\n",
+				bufferCharData ? "buffered" : "direct", parseTime / numIterations,
+				static_cast<unsigned long long> (statistics.numNodes),
+				static_cast<unsigned long long> (statistics.numAttributes),
+				static_cast<unsigned long long> (statistics.numCharDataBytes / 1024),
+				static_cast<unsigned long long> (statistics.numCharDataAllocations));
+	}
+}
+#endif
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#elif LINUX
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	constexpr size_t numIterations = 20;
+	constexpr int32_t flags =
+		UIDescription::kWriteImagesIntoUIDescFile | UIDescription::kDoNotVerifyImageData;
+
+	auto tempDir = std::filesystem::temp_directory_path ();
+	auto jsonPath = (tempDir / "uidescloadspeed.uidesc").string ();
+	auto xmlPath = (tempDir / "uidescloadspeed.xml.uidesc").string ();
+	auto binaryPath = (tempDir / "uidescloadspeed.bin.uidesc").string ();
+	auto removeFiles = finally ([&] () {
+		std::filesystem::remove (jsonPath);
+		std::filesystem::remove (xmlPath);
+		std::filesystem::remove (binaryPath);
+	});
+
+	for (auto numViews : {10u, 100u, 400u})
+	{
+		auto str = makeDescription (20, numViews, 50);
+		{
+			MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+			auto desc = makeOwned<UIDescription> (&provider);
+			if (!desc->parse () || !desc->save (jsonPath.data (), flags) ||
+				!desc->save (xmlPath.data (), flags | UIDescription::kWriteAsXML) ||
+				!desc->save (binaryPath.data (), flags | UIDescription::kWriteAsBinary))
+			{
+				printf ("creating the description files failed\n");
+				return -1;
+			}
+		}
+		printf ("20 templates with %u views each:\n", numViews);
+		double reference = 0.;
+		run ("json", jsonPath, numIterations, reference);
+		run ("xml", xmlPath, numIterations, reference);
+		run ("binary", binaryPath, numIterations, reference);
+#if VSTGUI_ENABLE_XML_PARSER
+		printf ("xml node tree creation:\n");
+		runXMLParser (xmlPath, numIterations);
+#endif
+	}
+	return 0;
+}
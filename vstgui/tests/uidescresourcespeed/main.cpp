@@ -0,0 +1,150 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/ccolor.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/vstguiinit.h"
+#include "vstgui/uidescription/uicontentprovider.h"
+#include "vstgui/uidescription/uidescription.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+namespace {
+
+//------------------------------------------------------------------------
+/** the colors of the description, other blue values give colors which are not in it */
+CColor makeColor (size_t index, uint8_t blue = 17)
+{
+	return CColor (static_cast<uint8_t> (index & 0xff), static_cast<uint8_t> (index >> 8), blue,
+	               255);
+}
+
+//------------------------------------------------------------------------
+/** a description with numTags control tags and numColors colors */
+std::string makeDescription (size_t numTags, size_t numColors)
+{
+	std::string str = "{\n\"vstgui-ui-description\": {\n\"version\": \"1\",\n\"colors\": {\n";
+	char colorStr[16];
+	for (size_t i = 0; i < numColors; ++i)
+	{
+		auto color = makeColor (i);
+		snprintf (colorStr, sizeof (colorStr), "#%02x%02x%02x%02x", color.red, color.green,
+		          color.blue, color.alpha);
+		str += "\"color" + std::to_string (i) + "\": \"" + colorStr +
+		       (i + 1 < numColors ? "\",\n" : "\"\n");
+	}
+	str += "},\n\"control-tags\": {\n";
+	for (size_t i = 0; i < numTags; ++i)
+		str += "\"tag" + std::to_string (i) + "\": \"" + std::to_string (i + 1000) +
+		       (i + 1 < numTags ? "\",\n" : "\"\n");
+	str += "}\n}\n}\n";
+	return str;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (size_t numIterations, Proc proc)
+{
+	using namespace std::chrono;
+
+	auto start = high_resolution_clock::now ();
+	for (size_t i = 0; i < numIterations; ++i)
+		proc (i);
+	auto duration = duration_cast<nanoseconds> (high_resolution_clock::now () - start);
+	return static_cast<double> (duration.count ()) / numIterations;
+}
+
+//------------------------------------------------------------------------
+void runResourceLookup (size_t numTags, size_t numColors, size_t numIterations)
+{
+	constexpr size_t numUnknownTags = 2000;
+	auto str = makeDescription (numTags, numColors);
+	MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+	auto desc = makeOwned<UIDescription> (&provider);
+	if (!desc->parse ())
+	{
+		printf ("parsing failed\n");
+		return;
+	}
+	std::vector<std::string> tagNames;
+	std::vector<std::string> colorNames;
+	for (size_t i = 0; i < numTags; ++i)
+		tagNames.emplace_back ("tag" + std::to_string (i));
+	for (size_t i = 0; i < numColors; ++i)
+		colorNames.emplace_back ("color" + std::to_string (i));
+
+	size_t found = 0;
+	auto tagForName = measure (numIterations, [&] (size_t i) {
+		if (desc->getTagForName (tagNames[i % numTags].data ()) != -1)
+			++found;
+	});
+	auto colorForName = measure (numIterations, [&] (size_t i) {
+		CColor color;
+		if (desc->getColor (colorNames[i % numColors].data (), color))
+			++found;
+	});
+	auto nameForTag = measure (numIterations, [&] (size_t i) {
+		if (desc->lookupControlTagName (static_cast<int32_t> (i % numTags + 1000)))
+			++found;
+	});
+	auto nameForColor = measure (numIterations, [&] (size_t i) {
+		if (desc->lookupColorName (makeColor (i % numColors)))
+			++found;
+	});
+	// the reverse lookups of the editor mostly miss, e.g. for unnamed tags and literal colors
+	auto nameForUnknownTag = measure (numIterations, [&] (size_t i) {
+		if (desc->lookupControlTagName (static_cast<int32_t> (i % numUnknownTags + 100000)))
+			++found;
+	});
+	auto nameForUnknownColor = measure (numIterations, [&] (size_t i) {
+		if (desc->lookupColorName (makeColor (i % numColors, 18)))
+			++found;
+	});
+	// changeColor updates the reverse table of the colors instead of rebuilding it
+	auto changeAndLookup = measure (numIterations / 100, [&] (size_t i) {
+		desc->changeColor (colorNames[i % numColors].data (), makeColor (i % numColors));
+		if (desc->lookupColorName (makeColor ((i + 1) % numColors)))
+			++found;
+	});
+	printf ("%zu tags, %zu colors: getTagForName %6.1f ns, getColor %6.1f ns, "
+	        "lookupControlTagName %6.1f ns, lookupColorName %6.1f ns, changeColor + "
+	        "lookupColorName %8.1f ns (%zu found)\n",
+	        numTags, numColors, tagForName, colorForName, nameForTag, nameForColor,
+	        changeAndLookup, found);
+	printf ("%zu tags, %zu colors, not found: lookupControlTagName %6.1f ns (%zu unnamed tags), "
+	        "lookupColorName %6.1f ns\n",
+	        numTags, numColors, nameForUnknownTag, numUnknownTags, nameForUnknownColor);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#elif LINUX
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	runResourceLookup (200, 50, 1000000);
+	runResourceLookup (2000, 500, 1000000);
+	return 0;
+}
@@ -0,0 +1,223 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cview.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/vstguiinit.h"
+#include "vstgui/uidescription/uiattributes.h"
+#include "vstgui/uidescription/uicontentprovider.h"
+#include "vstgui/uidescription/uidescription.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+namespace {
+
+//------------------------------------------------------------------------
+/** a description with one template of numViews knobs, labels and plain views */
+std::string makeDescription (size_t numViews)
+{
+	std::string str = "{\n\"vstgui-ui-description\": {\n\"version\": \"1\",\n\"colors\": {\n";
+	for (size_t i = 0; i < 100; ++i)
+		str += "\"color" + std::to_string (i) + "\": \"#" + (i % 2 ? "ff8040ff" : "4080ffff") +
+			   (i < 99 ? "\",\n" : "\"\n");
+	str += "},\n\"control-tags\": {\n";
+	for (size_t i = 0; i < 500; ++i)
+		str += "\"tag" + std::to_string (i) + "\": \"" + std::to_string (i) +
+			   (i < 499 ? "\",\n" : "\"\n");
+	str += "},\n\"templates\": {\n\"main\": {\"attributes\": {\"class\": \"CViewContainer\", "
+		   "\"origin\": \"0, 0\", \"size\": \"4000, 4000\", \"background-color\": "
+		   "\"color1\"},\n\"children\": {\n";
+	for (size_t v = 0; v < numViews; ++v)
+	{
+		auto origin = std::to_string ((v % 100) * 40) + ", " + std::to_string ((v / 100) * 40);
+		switch (v % 3)
+		{
+			case 0:
+			{
+				str += "\"CKnob\": {\"attributes\": {\"class\": \"CKnob\", \"origin\": \"" + origin +
+					   "\", \"size\": \"32, 32\", \"control-tag\": \"tag" +
+					   std::to_string (v % 500) +
+					   "\", \"default-value\": \"0.5\", \"min-value\": \"0\", \"max-value\": "
+					   "\"1\", \"angle-start\": \"135\", \"angle-range\": \"270\", "
+					   "\"handle-color\": \"color" +
+					   std::to_string (v % 100) + "\", \"circle-drawing\": \"true\"}}";
+				break;
+			}
+			case 1:
+			{
+				str += "\"CTextLabel\": {\"attributes\": {\"class\": \"CTextLabel\", \"origin\": "
+					   "\"" +
+					   origin +
+					   "\", \"size\": \"32, 16\", \"title\": \"Label\", \"font-color\": "
+					   "\"color" +
+					   std::to_string (v % 100) +
+					   "\", \"text-inset\": \"2, 2\", \"transparent\": \"true\"}}";
+				break;
+			}
+			default:
+			{
+				str += "\"CView\": {\"attributes\": {\"class\": \"CView\", \"origin\": \"" +
+					   origin + "\", \"size\": \"32, 32\", \"mouse-enabled\": \"false\"}}";
+				break;
+			}
+		}
+		str += v + 1 < numViews ? ",\n" : "\n";
+	}
+	str += "}}\n}\n}\n}\n";
+	return str;
+}
+
+//------------------------------------------------------------------------
+/** a description with numTemplates row templates of a few views each, like list rows or channel
+ *	strips */
+std::string makeRowDescription (size_t numTemplates)
+{
+	std::string str = "{\n\"vstgui-ui-description\": {\n\"version\": \"1\",\n\"templates\": {\n";
+	for (size_t t = 0; t < numTemplates; ++t)
+	{
+		str += "\"row" + std::to_string (t) +
+			   "\": {\"attributes\": {\"class\": \"CViewContainer\", \"origin\": \"0, 0\", "
+			   "\"size\": \"400, 20\", \"transparent\": \"true\"},\n\"children\": {\n"
+			   "\"CTextLabel\": {\"attributes\": {\"class\": \"CTextLabel\", \"origin\": \"0, "
+			   "0\", \"size\": \"200, 20\", \"title\": \"Row\"}},\n"
+			   "\"CSlider\": {\"attributes\": {\"class\": \"CSlider\", \"origin\": \"200, "
+			   "0\", \"size\": \"160, 20\", \"orientation\": \"horizontal\"}},\n"
+			   "\"CCheckBox\": {\"attributes\": {\"class\": \"CCheckBox\", \"origin\": \"380, "
+			   "0\", \"size\": \"20, 20\", \"title\": \"\"}}\n";
+		str += t + 1 < numTemplates ? "}},\n" : "}}\n";
+	}
+	str += "}\n}\n}\n";
+	return str;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+double measure (size_t numIterations, Proc proc)
+{
+	using namespace std::chrono;
+
+	auto start = high_resolution_clock::now ();
+	for (size_t i = 0; i < numIterations; ++i)
+		proc ();
+	auto duration = duration_cast<microseconds> (high_resolution_clock::now () - start);
+	return static_cast<double> (duration.count ()) / 1000. / numIterations;
+}
+
+//------------------------------------------------------------------------
+void runCreateView (size_t numViews, size_t numIterations)
+{
+	auto str = makeDescription (numViews);
+	MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+	auto desc = makeOwned<UIDescription> (&provider);
+	if (!desc->parse ())
+	{
+		printf ("parsing failed\n");
+		return;
+	}
+	// the first creation evaluates all attribute values once, following creations use the
+	// cached typed values
+	double first = measure (1, [&] () {
+		if (auto view = desc->createView ("main", nullptr))
+			view->forget ();
+	});
+	double cached = measure (numIterations, [&] () {
+		if (auto view = desc->createView ("main", nullptr))
+			view->forget ();
+	});
+	printf ("createView with %zu views: first %8.2f ms, following %8.2f ms\n", numViews, first,
+			cached);
+}
+
+//------------------------------------------------------------------------
+void runRowInstantiation (size_t numTemplates, size_t numRows)
+{
+	auto str = makeRowDescription (numTemplates);
+	MemoryContentProvider provider (str.data (), static_cast<uint32_t> (str.size ()));
+	auto desc = makeOwned<UIDescription> (&provider);
+	if (!desc->parse ())
+	{
+		printf ("parsing failed\n");
+		return;
+	}
+	auto name = "row" + std::to_string (numTemplates - 1);
+	double ms = measure (1, [&] () {
+		for (size_t i = 0; i < numRows; ++i)
+		{
+			if (auto view = desc->createView (name.data (), nullptr))
+				view->forget ();
+		}
+	});
+	printf ("%zu rows of the last of %zu templates: %8.2f ms, %6.2f us/row\n", numRows,
+			numTemplates, ms, ms * 1000. / numRows);
+}
+
+//------------------------------------------------------------------------
+void runAttributeLookup (size_t numIterations)
+{
+	static const char* names[] = {"class",		   "origin",	  "size",
+								  "control-tag",   "min-value",	  "max-value",
+								  "default-value", "angle-start", "angle-range",
+								  "handle-color",  "transparent", "mouse-enabled"};
+	UIAttributes attributes;
+	for (auto name : names)
+		attributes.setAttribute (name, "1");
+	attributes.setAttribute ("origin", "10, 20");
+	attributes.setAttribute ("size", "32, 32, 64, 64");
+
+	const std::string sizeName ("size");
+	const UIAttributeName internedSizeName (sizeName);
+	double sum = 0.;
+	auto legacy = measure (numIterations, [&] () {
+		CRect r;
+		if (auto value = attributes.getAttributeValue (sizeName))
+			if (UIAttributes::stringToRect (*value, r))
+				sum += r.left;
+	});
+	auto byString = measure (numIterations, [&] () {
+		CRect r;
+		if (attributes.getRectAttribute (sizeName, r))
+			sum += r.left;
+	});
+	auto byName = measure (numIterations, [&] () {
+		CRect r;
+		if (attributes.getRectAttribute (internedSizeName, r))
+			sum += r.left;
+	});
+	auto toNs = [] (double ms) { return ms * 1000000.; };
+	printf ("rect attribute lookup: parse %6.1f ns, cached %6.1f ns, interned %6.1f ns (%g)\n",
+			toNs (legacy), toNs (byString), toNs (byName), sum > 0. ? 1. : 0.);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#elif LINUX
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	for (auto numViews : {500u, 5000u})
+		runCreateView (numViews, 10);
+	runRowInstantiation (300, 1000);
+	runAttributeLookup (1000000);
+	return 0;
+}
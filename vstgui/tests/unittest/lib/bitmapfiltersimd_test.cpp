@@ -0,0 +1,233 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/ccolor.h"
+#include "../../../lib/detail/bitmapfiltersimd.h"
+#include "../unittests.h"
+#include <vector>
+
+#if VSTGUI_BITMAPFILTER_SIMD
+
+namespace VSTGUI {
+using namespace Detail::BitmapFilterSIMD;
+
+namespace {
+
+//------------------------------------------------------------------------
+std::vector<uint32_t> makePixels (size_t count, uint32_t seed = 1)
+{
+	std::vector<uint32_t> pixels (count);
+	for (auto& pixel : pixels)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		pixel = seed;
+	}
+	return pixels;
+}
+
+//------------------------------------------------------------------------
+uint32_t getByte (uint32_t pixel, int32_t index) { return (pixel >> (index * 8)) & 0xff; }
+
+//------------------------------------------------------------------------
+template<typename Proc>
+void forEachImplementation (Proc proc)
+{
+	if (Detail::hasSSE2 ())
+		proc (false);
+	if (Detail::hasAVX2 ())
+		proc (true);
+}
+
+// the counts include the pixels left over after the vector loops
+constexpr size_t kCounts[] = {1, 3, 4, 7, 8, 9, 15, 16, 17, 33, 100};
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (BitmapFilterSIMDTest, SetColor)
+{
+	forEachImplementation ([] (bool avx2) {
+		for (auto count : kCounts)
+		{
+			auto input = makePixels (count);
+			std::vector<uint32_t> output (count);
+			if (avx2)
+				setColorAVX2 (input.data (), output.data (), count, 0x00336699, 0xff000000);
+			else
+				setColorSSE2 (input.data (), output.data (), count, 0x00336699, 0xff000000);
+			for (auto i = 0u; i < count; ++i)
+				EXPECT_EQ (output[i], (input[i] & 0xff000000) | 0x00336699);
+		}
+	});
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BitmapFilterSIMDTest, ReplaceColor)
+{
+	forEachImplementation ([] (bool avx2) {
+		for (auto count : kCounts)
+		{
+			auto input = makePixels (count);
+			for (auto i = 0u; i < count; i += 3)
+				input[i] = 0xffffffff;
+			std::vector<uint32_t> output (count);
+			if (avx2)
+				replaceColorAVX2 (input.data (), output.data (), count, 0xffffffff, 0x12345678);
+			else
+				replaceColorSSE2 (input.data (), output.data (), count, 0xffffffff, 0x12345678);
+			for (auto i = 0u; i < count; ++i)
+				EXPECT_EQ (output[i], input[i] == 0xffffffff ? 0x12345678 : input[i]);
+		}
+	});
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BitmapFilterSIMDTest, Grayscale)
+{
+	struct Layout
+	{
+		int32_t red, green, blue;
+	};
+	// BGRA and RGBA in memory, the alpha byte is the last one for both
+	for (auto layout : {Layout {16, 8, 0}, Layout {0, 8, 16}})
+	{
+		forEachImplementation ([layout] (bool avx2) {
+			for (auto count : kCounts)
+			{
+				auto input = makePixels (count);
+				std::vector<uint32_t> output (count);
+				if (avx2)
+					grayscaleAVX2 (input.data (), output.data (), count, layout.red, layout.green,
+								   layout.blue, 0xff000000);
+				else
+					grayscaleSSE2 (input.data (), output.data (), count, layout.red, layout.green,
+								   layout.blue, 0xff000000);
+				for (auto i = 0u; i < count; ++i)
+				{
+					CColor color (static_cast<uint8_t> (input[i] >> layout.red),
+								  static_cast<uint8_t> (input[i] >> layout.green),
+								  static_cast<uint8_t> (input[i] >> layout.blue));
+					uint32_t luma = color.getLuma ();
+					auto expected = (input[i] & 0xff000000) | (luma << 16) | (luma << 8) | luma;
+					EXPECT_EQ (output[i], expected);
+				}
+			}
+		});
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BitmapFilterSIMDTest, ScaleBilinearRow)
+{
+	forEachImplementation ([] (bool avx2) {
+		constexpr uint32_t origWidth = 37;
+		auto row0 = makePixels (origWidth, 1);
+		auto row1 = makePixels (origWidth, 2);
+		for (auto count : kCounts)
+		{
+			// same positions and weights as the scalar filter
+			auto xRatio = static_cast<float> (origWidth - 1) / static_cast<float> (count);
+			std::vector<uint32_t> xIndex (count);
+			std::vector<float> xDiff (count);
+			for (auto j = 0u; j < count; ++j)
+			{
+				xIndex[j] = static_cast<uint32_t> (xRatio * j);
+				xDiff[j] = (xRatio * j) - xIndex[j];
+			}
+			for (auto yDiff : {0.f, 0.25f, 0.7f})
+			{
+				std::vector<uint32_t> output (count);
+				if (avx2)
+					scaleBilinearRowAVX2 (row0.data (), row1.data (), output.data (), count,
+										  xIndex.data (), xDiff.data (), yDiff);
+				else
+					scaleBilinearRowSSE2 (row0.data (), row1.data (), output.data (), count,
+										  xIndex.data (), xDiff.data (), yDiff);
+				for (auto j = 0u; j < count; ++j)
+				{
+					auto x = xIndex[j];
+					auto xd = xDiff[j];
+					uint32_t expected = 0;
+					for (auto c = 0; c < 4; ++c)
+					{
+						auto value = getByte (row0[x], c) * (1.f - xd) * (1.f - yDiff) +
+									 getByte (row0[x + 1], c) * xd * (1.f - yDiff) +
+									 getByte (row1[x], c) * yDiff * (1.f - xd) +
+									 getByte (row1[x + 1], c) * xd * yDiff;
+						expected |= static_cast<uint32_t> (static_cast<uint8_t> (value)) << (c * 8);
+					}
+					EXPECT_EQ (output[j], expected);
+				}
+			}
+		}
+	});
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (BitmapFilterSIMDTest, BoxBlur)
+{
+	for (auto writeMask : {0xffffffffu, 0xff000000u})
+	{
+		forEachImplementation ([writeMask] (bool avx2) {
+			constexpr int32_t width = 21;
+			constexpr int32_t height = 13;
+			constexpr int32_t radius = 3;
+			constexpr auto numPixels = static_cast<size_t> (width * height);
+			auto input = makePixels (numPixels);
+			std::vector<uint32_t> rows (numPixels);
+			auto output = makePixels (numPixels, 3);
+			auto original = output;
+			boxBlurRowsSSE2 (input.data (), rows.data (), width, 0, height, radius);
+			if (avx2)
+				boxBlurColumnsAVX2 (rows.data (), output.data (), width, height, 0, width, radius,
+									writeMask);
+			else
+				boxBlurColumnsSSE2 (rows.data (), output.data (), width, height, 0, width, radius,
+									writeMask);
+
+			// the average of the box for every byte, the pixels outside are clamped to the edges
+			auto clamp = [] (int32_t value, int32_t max) {
+				return std::min (std::max (value, 0), max - 1);
+			};
+			std::vector<uint32_t> expectedRows (numPixels);
+			for (auto y = 0; y < height; ++y)
+			{
+				for (auto x = 0; x < width; ++x)
+				{
+					uint32_t pixel = 0;
+					for (auto c = 0; c < 4; ++c)
+					{
+						uint32_t sum = 0;
+						for (auto i = -radius; i <= radius; ++i)
+							sum += getByte (input[y * width + clamp (x + i, width)], c);
+						pixel |= (sum / (radius + radius + 1)) << (c * 8);
+					}
+					expectedRows[y * width + x] = pixel;
+				}
+			}
+			EXPECT (rows == expectedRows);
+			for (auto y = 0; y < height; ++y)
+			{
+				for (auto x = 0; x < width; ++x)
+				{
+					uint32_t pixel = 0;
+					for (auto c = 0; c < 4; ++c)
+					{
+						uint32_t sum = 0;
+						for (auto i = -radius; i <= radius; ++i)
+							sum += getByte (expectedRows[clamp (y + i, height) * width + x], c);
+						pixel |= (sum / (radius + radius + 1)) << (c * 8);
+					}
+					auto index = y * width + x;
+					EXPECT_EQ (output[index], (pixel & writeMask) | (original[index] & ~writeMask));
+				}
+			}
+		});
+	}
+}
+
+} // VSTGUI
+
+#endif // VSTGUI_BITMAPFILTER_SIMD
@@ -2,8 +2,10 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
+#include "../../../lib/cbitmap.h"
 #include "../../../lib/ccolor.h"
 #include "../../../lib/cframe.h"
+#include "../../../lib/coffscreencontext.h"
 #include "../../../lib/events.h"
 #include "../unittests.h"
 #include "eventhelpers.h"
@@ -161,6 +163,45 @@ public:
 	}
 };
 
+class ColorView : public CView
+{
+public:
+	ColorView (const CRect& size, const CColor& color) : CView (size), color (color)
+	{
+		setThreadSafeDrawing (true);
+	}
+
+	void draw (CDrawContext* context) override
+	{
+		context->setFillColor (color);
+		context->drawRect (getViewSize (), kDrawFilled);
+	}
+
+	CColor color;
+};
+
+std::vector<uint32_t> drawFramePixels (CFrame* frame, const std::vector<CRect>& rects)
+{
+	std::vector<uint32_t> pixels;
+	auto offscreen = COffscreenContext::create (frame->getViewSize ().getSize ());
+	if (!offscreen)
+		return pixels;
+	offscreen->beginDraw ();
+	auto platformFrameCallback = dynamic_cast<IPlatformFrameCallback*> (frame);
+	platformFrameCallback->platformDrawRects (offscreen->getPlatformDeviceContext (), 1., rects);
+	offscreen->endDraw ();
+	auto accessor = owned (CBitmapPixelAccess::create (offscreen->getBitmap ()));
+	if (!accessor)
+		return pixels;
+	uint32_t value;
+	do
+	{
+		accessor->getValue (value);
+		pixels.emplace_back (value);
+	} while (++(*accessor));
+	return pixels;
+}
+
 } // anonymouse
 
 TEST_CASE (CFrameTest, SetZoom)
@@ -688,6 +729,43 @@ TEST_CASE (CFrameTest, SetPosition)
 	frame->close ();
 }
 
+TEST_CASE (CFrameTest, TiledDrawingMatchesUntiledDrawing)
+{
+	auto frame = new CFrame (CRect (0, 0, 600, 600), nullptr);
+	frame->setThreadSafeDrawing (true);
+	frame->addView (new ColorView (CRect (0, 0, 600, 600), CColor (40, 40, 40)));
+	// children crossing the tile borders in a container with a spatial index
+	auto grid = new CViewContainer (CRect (100, 100, 500, 300));
+	grid->setThreadSafeDrawing (true);
+	grid->setSpatialIndexEnabled (true);
+	for (auto i = 0; i < 40; ++i)
+	{
+		CRect r (0, 0, 30, 30);
+		r.offset ((i % 10) * 40., (i / 10) * 40.);
+		grid->addView (new ColorView (r, CColor (static_cast<uint8_t> (i * 6), 100, 200)));
+	}
+	frame->addView (grid);
+	// the tiles of a container caching as bitmap and of a view which does not draw thread safe
+	// fall back to drawing on the main thread, the other tiles are drawn concurrently
+	auto cached = new CViewContainer (CRect (280, 530, 590, 590));
+	cached->setThreadSafeDrawing (true);
+	cached->setCacheAsBitmap (true);
+	cached->addView (new ColorView (CRect (10, 10, 200, 50), CColor (200, 50, 50)));
+	frame->addView (cached);
+	auto notThreadSafe = new ColorView (CRect (20, 20, 60, 60), CColor (50, 200, 50));
+	notThreadSafe->setThreadSafeDrawing (false);
+	frame->addView (notThreadSafe);
+	frame->attached (frame);
+
+	std::vector<CRect> rects {CRect (0, 0, 600, 600), CRect (10, 20, 300, 290)};
+	auto untiled = drawFramePixels (frame, rects);
+	frame->setTiledDrawingEnabled (true);
+	auto tiled = drawFramePixels (frame, rects);
+	EXPECT_FALSE (untiled.empty ());
+	EXPECT (tiled == untiled);
+	frame->close ();
+}
+
 #if 0
 TEST_CASE (CFrameTest, CollectInvalidRectsOnMouseDown)
 {
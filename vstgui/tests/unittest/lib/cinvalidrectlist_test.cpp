@@ -47,4 +47,66 @@ TEST_CASE (CInvalidRectListTest, AddMulti)
 	EXPECT_EQ (list.data ().size (), 2u);
 }
 
+TEST_CASE (CInvalidRectListTest, AddEmbracingOne)
+{
+	CInvalidRectList list;
+	EXPECT_TRUE (list.add ({0, 0, 10, 10}));
+	EXPECT_TRUE (list.add ({20, 20, 30, 30}));
+	EXPECT_TRUE (list.add ({50, 50, 60, 60}));
+	EXPECT_TRUE (list.add ({0, 0, 40, 40}));
+	EXPECT_EQ (list.data ().size (), 2u);
+}
+
+TEST_CASE (CInvalidRectListTest, MaxRects)
+{
+	CInvalidRectList::MergePolicy policy;
+	policy.maxRects = 4;
+	CInvalidRectList list (policy);
+	for (auto i = 0; i < 10; ++i)
+	{
+		CCoord x = i * 20;
+		EXPECT_TRUE (list.add ({x, 0, x + 10, 10}));
+		EXPECT (list.data ().size () <= policy.maxRects);
+	}
+	CRect bounds;
+	for (const auto& r : list)
+	{
+		if (bounds.isEmpty ())
+			bounds = r;
+		else
+			bounds.unite (r);
+	}
+	EXPECT_EQ (bounds, CRect (0, 0, 190, 10));
+}
+
+TEST_CASE (CInvalidRectListTest, MaxOverdrawRatio)
+{
+	CInvalidRectList list;
+	EXPECT_TRUE (list.add ({0, 0, 10, 10}));
+	EXPECT_TRUE (list.add ({15, 0, 25, 10}));
+	EXPECT_EQ (list.data ().size (), 2u);
+
+	CInvalidRectList::MergePolicy policy;
+	policy.maxOverdrawRatio = 1.5;
+	list.setMergePolicy (policy);
+	list.clear ();
+	EXPECT_TRUE (list.add ({0, 0, 10, 10}));
+	EXPECT_TRUE (list.add ({15, 0, 25, 10}));
+	EXPECT_EQ (list.data ().size (), 1u);
+	EXPECT_EQ (list.data ().front (), CRect (0, 0, 25, 10));
+}
+
+TEST_CASE (CInvalidRectListTest, JoinNearbyRects)
+{
+	CInvalidRectList list;
+	EXPECT_TRUE (list.add ({0, 0, 10, 10}));
+	EXPECT_TRUE (list.add ({0, 20, 10, 30}));
+	EXPECT_TRUE (list.add ({0, 40, 10, 50}));
+	EXPECT_TRUE (list.add ({100, 100, 110, 110}));
+	EXPECT_EQ (list.data ().size (), 4u);
+	joinNearbyInvalidRects (list, 10.);
+	EXPECT_EQ (list.data ().size (), 2u);
+	EXPECT_EQ (list.data ().front (), CRect (0, 0, 10, 50));
+}
+
 } // VSTGUI
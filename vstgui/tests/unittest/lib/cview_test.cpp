@@ -27,6 +27,14 @@ public:
 	View () : CView (CRect (0, 0, 10, 10)) {}
 	void onIdle () override { onIdleCalled = true; }
 
+	enum
+	{
+		kFlagA = 1 << (kLastCViewFlag + 1),
+		kFlagB = 1 << (kLastCViewFlag + 2),
+	};
+	using CView::hasViewFlag;
+	using CView::setViewFlag;
+
 	bool onIdleCalled {false};
 };
 
@@ -116,6 +124,19 @@ TEST_CASE (CViewTest, AutosizeFlags)
 	EXPECT (v->getAutosizeFlags () == (kAutosizeLeft | kAutosizeTop));
 }
 
+TEST_CASE (CViewTest, SetViewFlagMask)
+{
+	auto v = owned (new View ());
+	v->setViewFlag (View::kFlagA, true);
+	v->setViewFlag (View::kFlagA | View::kFlagB, true);
+	EXPECT (v->hasViewFlag (View::kFlagA));
+	EXPECT (v->hasViewFlag (View::kFlagB));
+	v->setViewFlag (View::kFlagA, false);
+	v->setViewFlag (View::kFlagA | View::kFlagB, false);
+	EXPECT (v->hasViewFlag (View::kFlagA) == false);
+	EXPECT (v->hasViewFlag (View::kFlagB) == false);
+}
+
 TEST_CASE (CViewTest, Attributes)
 {
 	auto v = owned (new View ());
@@ -158,6 +179,36 @@ TEST_CASE (CViewTest, ResizeAttribute)
 	EXPECT (secondData == 32);
 }
 
+TEST_CASE (CViewTest, MultipleAttributes)
+{
+	auto v = owned (new View ());
+	uint32_t outSize;
+	float smallData = 0.5f;
+	CRect largeData (1, 2, 3, 4);
+	uint8_t bytes[100];
+	for (auto i = 0u; i < sizeof (bytes); ++i)
+		bytes[i] = static_cast<uint8_t> (i);
+	EXPECT (v->setAttribute ('smal', smallData));
+	EXPECT (v->setAttribute ('larg', largeData));
+	EXPECT (v->setAttribute ('byte', sizeof (bytes), bytes));
+	EXPECT (v->removeAttribute ('larg'));
+	EXPECT (v->getAttribute ('larg', largeData) == false);
+	smallData = 0.f;
+	EXPECT (v->getAttribute ('smal', smallData));
+	EXPECT (smallData == 0.5f);
+	uint8_t outBytes[100] {};
+	EXPECT (v->getAttribute ('byte', sizeof (outBytes), outBytes, outSize));
+	EXPECT (outSize == sizeof (bytes));
+	EXPECT (memcmp (bytes, outBytes, sizeof (bytes)) == 0);
+	// switch between data stored in the entry and on the heap
+	EXPECT (v->setAttribute ('byte', smallData));
+	EXPECT (v->getAttributeSize ('byte', outSize));
+	EXPECT (outSize == sizeof (smallData));
+	EXPECT (v->setAttribute ('byte', sizeof (bytes), bytes));
+	EXPECT (v->getAttribute ('byte', sizeof (outBytes), outBytes, outSize));
+	EXPECT (memcmp (bytes, outBytes, sizeof (bytes)) == 0);
+}
+
 TEST_CASE (CViewTest, ViewListener)
 {
 	ViewListener listener;
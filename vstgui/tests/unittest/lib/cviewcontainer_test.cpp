@@ -3,12 +3,14 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "../../../lib/cframe.h"
+#include "../../../lib/cdrawcontext.h"
 #include "../../../lib/iviewlistener.h"
 #include "../../../lib/ccolor.h"
 #include "../../../lib/dragging.h"
 #include "../../../lib/events.h"
 #include "../unittests.h"
 #include "eventhelpers.h"
+#include <algorithm>
 #include <vector>
 
 namespace VSTGUI {
@@ -109,6 +111,16 @@ public:
 	
  };
 
+class DrawCountView : public CView
+{
+public:
+	explicit DrawCountView (const CRect& r) : CView (r) {}
+
+	void drawRect (CDrawContext* context, const CRect& updateRect) override { ++numDraws; }
+
+	uint32_t numDraws {0};
+};
+
 } // anonymous
 
 TEST_SUITE_SETUP (CViewContainerTest)
@@ -233,6 +245,39 @@ TEST_CASE (CViewContainerTest, RemoveAllViews)
 	EXPECT (container->hasChildren () == false)
 }
 
+TEST_CASE (CViewContainerTest, RemoveAllNotifiesInOrder)
+{
+	auto& container = TEST_SUITE_GET_STORAGE (SharedPointer<CViewContainer>);
+
+	struct Listener : ViewContainerListenerAdapter
+	{
+		void viewContainerViewRemoved (CViewContainer* container, CView* view) override
+		{
+			removed.emplace_back (view);
+			numViews.emplace_back (container->getNbViews ());
+			stillChild = stillChild || container->isChild (view);
+		}
+		std::vector<CView*> removed;
+		std::vector<uint32_t> numViews;
+		bool stillChild {false};
+	} listener;
+
+	auto view = makeOwned<CView> (CRect (0, 0, 10, 10));
+	auto view2 = makeOwned<CView> (CRect (0, 0, 10, 10));
+	auto view3 = makeOwned<CView> (CRect (0, 0, 10, 10));
+	container->addView (view);
+	container->addView (view2);
+	container->addView (view3);
+	container->registerViewContainerListener (&listener);
+	container->removeAll (false);
+	container->unregisterViewContainerListener (&listener);
+
+	EXPECT (listener.removed == std::vector<CView*> ({view, view2, view3}))
+	EXPECT (listener.numViews == std::vector<uint32_t> ({2, 1, 0}))
+	EXPECT (listener.stillChild == false)
+	EXPECT (container->hasChildren () == false)
+}
+
 TEST_CASE (CViewContainerTest, AdvanceNextFocusView)
 {
 	auto& container = TEST_SUITE_GET_STORAGE (SharedPointer<CViewContainer>);
@@ -430,6 +475,86 @@ TEST_CASE (CViewContainerTest, ReverseIterator)
 	EXPECT (*it == nullptr);
 }
 
+TEST_CASE (CViewContainerTest, ChangeChildrenWhileIterating)
+{
+	auto& container = TEST_SUITE_GET_STORAGE (SharedPointer<CViewContainer>);
+
+	auto v1 = new TestView1 ();
+	auto v2 = new TestView2 ();
+	container->addView (v1);
+	container->addView (v2);
+	ViewIterator it (container);
+	++it;
+	// enough views to move the children to new memory
+	for (auto i = 0; i < 100; ++i)
+		container->addView (new CView (CRect (0, 0, 10, 10)));
+	EXPECT (*it == v2);
+
+	uint32_t numVisited = 0;
+	container->forEachChild ([&] (CView* view) {
+		++numVisited;
+		if (view == v1)
+			container->removeView (v2);
+	});
+	EXPECT_EQ (numVisited, 101u);
+	EXPECT_EQ (container->getNbViews (), 101u);
+}
+
+TEST_CASE (CViewContainerTest, RemoveEarlierSiblingWhileIterating)
+{
+	auto& container = TEST_SUITE_GET_STORAGE (SharedPointer<CViewContainer>);
+
+	CView* views[4];
+	for (auto& view : views)
+	{
+		view = new CView (CRect (0, 0, 10, 10));
+		container->addView (view);
+	}
+
+	std::vector<CView*> visited;
+	container->forEachChild ([&] (CView* view) {
+		visited.emplace_back (view);
+		if (view == views[1])
+			container->removeView (views[0]);
+		else if (view == views[2])
+			container->removeView (views[2], false);
+	});
+	EXPECT_EQ (visited.size (), 4u);
+	EXPECT (visited[3] == views[3]);
+	EXPECT_EQ (container->getNbViews (), 2u);
+	container->addView (views[2], views[3]);
+
+	// a view inserted before the current one is not visited and the current one not again
+	visited.clear ();
+	container->forEachChild ([&] (CView* view) {
+		visited.emplace_back (view);
+		if (view == views[2])
+			container->addView (new CView (CRect (0, 0, 10, 10)), views[1]);
+	});
+	EXPECT_EQ (visited.size (), 3u);
+	EXPECT (visited[0] == views[1]);
+	EXPECT (visited[1] == views[2]);
+	EXPECT (visited[2] == views[3]);
+
+	ViewIterator it (container);
+	++it;
+	container->removeView (container->getView (0));
+	EXPECT (*it == views[1]);
+	container->removeView (views[1], false);
+	++it;
+	EXPECT (*it == views[2]);
+
+	ReverseViewIterator rit (container);
+	EXPECT (*rit == views[3]);
+	container->removeView (views[3], false);
+	++rit;
+	EXPECT (*rit == views[2]);
+	++rit;
+	EXPECT (*rit == nullptr);
+	views[1]->forget ();
+	views[3]->forget ();
+}
+
 TEST_CASE (CViewContainerTest, MouseEventsInEmptyContainer)
 {
 	auto& container = TEST_SUITE_GET_STORAGE (SharedPointer<CViewContainer>);
@@ -638,4 +763,188 @@ TEST_CASE (CViewContainerTest, GetContainerAt)
 	EXPECT (res == c1);
 }
 
+TEST_CASE (CViewContainerTest, CacheAsBitmapFlag)
+{
+	auto& container = TEST_SUITE_GET_STORAGE (SharedPointer<CViewContainer>);
+	EXPECT_FALSE (container->getCacheAsBitmap ());
+	container->setCacheAsBitmap (true);
+	EXPECT_TRUE (container->getCacheAsBitmap ());
+	EXPECT_TRUE (container->getAutosizingEnabled ());
+	container->setAutosizingEnabled (false);
+	EXPECT_TRUE (container->getCacheAsBitmap ());
+	container->setCacheAsBitmap (false);
+	EXPECT_FALSE (container->getCacheAsBitmap ());
+	EXPECT_FALSE (container->getAutosizingEnabled ());
+}
+
+TEST_CASE (CViewContainerTest, CacheAsBitmapRendersChanges)
+{
+	auto& container = TEST_SUITE_GET_STORAGE (SharedPointer<CViewContainer>);
+
+	CFrame* frame = new CFrame (CRect (0, 0, 200, 200), nullptr);
+	auto a = new DrawCountView (CRect (0, 0, 50, 50));
+	auto b = new DrawCountView (CRect (60, 0, 110, 50));
+	container->addView (a);
+	container->addView (b);
+	frame->addView (container);
+	container->remember ();
+	frame->attached (frame);
+	container->setCacheAsBitmap (true);
+
+	auto drawContext = makeOwned<CDrawContext> (nullptr, container->getViewSize (), 1.);
+	auto draw = [&] (std::initializer_list<DrawCountView*> views) {
+		container->drawRect (drawContext, container->getViewSize ());
+		std::vector<uint32_t> numDraws;
+		for (auto view : views)
+		{
+			numDraws.emplace_back (view->numDraws);
+			view->numDraws = 0;
+		}
+		return numDraws;
+	};
+	using Draws = std::vector<uint32_t>;
+
+	// rendered into the cache once, afterwards drawn from the cache
+	EXPECT (draw ({a, b}) == Draws ({1, 1}));
+	EXPECT (draw ({a, b}) == Draws ({0, 0}));
+	// only the dirty parts are rendered again
+	a->invalid ();
+	EXPECT (draw ({a, b}) == Draws ({1, 0}));
+	b->setAlphaValue (0.5f);
+	EXPECT (draw ({a, b}) == Draws ({0, 1}));
+	a->setViewSize (CRect (0, 0, 70, 50));
+	container->invalidateDirtyViews ();
+	EXPECT (draw ({a, b}) == Draws ({1, 1}));
+	// a new size needs a new bitmap
+	container->setViewSize (CRect (0, 0, 150, 150));
+	EXPECT (draw ({a, b}) == Draws ({1, 1}));
+
+	// a view wanting idle is drawn on top of the cache, its invalidations don't affect the cache
+	// but the ones of the views below it do
+	auto c = new DrawCountView (CRect (10, 10, 40, 40));
+	c->setWantsIdle (true);
+	container->addView (c);
+	EXPECT (draw ({a, b, c}) == Draws ({1, 1, 1}));
+	c->invalid ();
+	EXPECT (draw ({a, b, c}) == Draws ({0, 0, 1}));
+	a->invalidRect (CRect (20, 20, 30, 30));
+	EXPECT (draw ({a, b, c}) == Draws ({1, 0, 1}));
+	// a view above a live view must be drawn after it, so it is drawn on top of the cache, too
+	auto d = new DrawCountView (CRect (30, 30, 60, 60));
+	container->addView (d);
+	EXPECT (draw ({a, b, c, d}) == Draws ({1, 1, 1, 1}));
+	EXPECT (draw ({a, b, c, d}) == Draws ({0, 0, 1, 1}));
+	c->setWantsIdle (false);
+	frame->close ();
+}
+
+TEST_CASE (CViewContainerTest, SpatialIndex)
+{
+	auto& container = TEST_SUITE_GET_STORAGE (SharedPointer<CViewContainer>);
+
+	CFrame* frame = new CFrame (CRect (0, 0, 200, 200), nullptr);
+	std::vector<CView*> views;
+	for (auto i = 0; i < 100; ++i)
+	{
+		CRect r (0, 0, 15, 15);
+		r.offset ((i % 10) * 20., (i / 10) * 20.);
+		views.emplace_back (new CView (r));
+		container->addView (views.back ());
+	}
+	auto background = new CView (CRect (0, 0, 200, 200));
+	container->addView (background, views.front ());
+	auto cover = new CView (CRect (30, 30, 50, 50));
+	container->addView (cover);
+	frame->addView (container);
+	container->remember ();
+	frame->attached (frame);
+	container->setSpatialIndexEnabled (true);
+	EXPECT_TRUE (container->getSpatialIndexEnabled ());
+
+	EXPECT (container->getViewAt (CPoint (5, 5)) == views[0]);
+	EXPECT (container->getViewAt (CPoint (17, 5)) == background);
+	EXPECT (container->getViewAt (CPoint (45, 45)) == cover);
+	EXPECT (container->getViewAt (CPoint (199, 199)) == background);
+	EXPECT (container->getViewAt (CPoint (300, 300)) == nullptr);
+	CViewContainer::ViewList result;
+	container->getViewsAt (CPoint (45, 45), result);
+	EXPECT (result.size () == 3);
+	EXPECT (result.front () == cover);
+
+	views[0]->setViewSize (CRect (150, 150, 300, 300));
+	EXPECT (container->getViewAt (CPoint (5, 5)) == background);
+	EXPECT (container->getViewAt (CPoint (250, 250)) == views[0]);
+	views[1]->setMouseableArea (CRect (0, 0, 10, 10));
+	EXPECT (container->getViewAt (CPoint (5, 5)) == views[1]);
+	EXPECT (container->getViewAt (CPoint (25, 5)) == background);
+	container->changeViewZOrder (cover, 0);
+	EXPECT (container->getViewAt (CPoint (45, 45)) == views[22]);
+	container->removeView (views[22]);
+	EXPECT (container->getViewAt (CPoint (45, 45)) == background);
+	views[33]->setVisible (false);
+	EXPECT (container->getViewAt (CPoint (65, 65)) == background);
+
+	container->setSpatialIndexEnabled (false);
+	EXPECT (container->getViewAt (CPoint (5, 5)) == views[1]);
+	EXPECT (container->getViewAt (CPoint (250, 250)) == views[0]);
+	frame->close ();
+}
+
+TEST_CASE (CViewContainerTest, DrawTraversal)
+{
+	auto& container = TEST_SUITE_GET_STORAGE (SharedPointer<CViewContainer>);
+
+	// a grid of views with gaps between them, redrawn in small rects
+	constexpr uint32_t numColumns = 16;
+	constexpr uint32_t numRows = 16;
+	CRect frameRect (0, 0, numColumns * 16, numRows * 16);
+	CFrame* frame = new CFrame (frameRect, nullptr);
+	container->setViewSize (frameRect);
+	std::vector<DrawCountView*> views;
+	for (auto i = 0u; i < numColumns * numRows; ++i)
+	{
+		CRect r (0, 0, 14, 14);
+		r.offset ((i % numColumns) * 16., (i / numColumns) * 16.);
+		views.emplace_back (new DrawCountView (r));
+		container->addView (views.back ());
+	}
+	frame->addView (container);
+	container->remember ();
+	frame->attached (frame);
+
+	std::vector<CRect> updateRects;
+	for (auto i = 0u; i < 100; ++i)
+	{
+		CRect r (0, 0, i % 10 ? 6. : 40., 6.);
+		updateRects.emplace_back (r.offset ((i * 37) % 240, (i * 53) % 240));
+	}
+	updateRects.emplace_back (frameRect);
+	// a view is drawn for every update rect it intersects
+	std::vector<uint32_t> expectedDraws;
+	for (auto view : views)
+	{
+		auto numDraws = std::count_if (
+			updateRects.begin (), updateRects.end (),
+			[&] (const CRect& r) { return r.rectOverlap (view->getViewSize ()); });
+		expectedDraws.emplace_back (static_cast<uint32_t> (numDraws));
+	}
+
+	auto drawContext = makeOwned<CDrawContext> (nullptr, frameRect, 1.);
+	auto draw = [&] () {
+		std::vector<uint32_t> numDraws;
+		for (const auto& r : updateRects)
+			container->drawRect (drawContext, r);
+		for (auto view : views)
+		{
+			numDraws.emplace_back (view->numDraws);
+			view->numDraws = 0;
+		}
+		return numDraws;
+	};
+	EXPECT (draw () == expectedDraws);
+	container->setSpatialIndexEnabled (true);
+	EXPECT (draw () == expectedDraws);
+	frame->close ();
+}
+
 } // namespaces
@@ -0,0 +1,88 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/parallelfor.h"
+#include "../unittests.h"
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace VSTGUI {
+
+TEST_CASE (ParallelForTest, CallsEveryIndexOnce)
+{
+	std::vector<std::atomic<uint32_t>> calls (1000);
+	parallelFor (calls.size (), [&] (size_t index) { ++calls[index]; });
+	for (auto& c : calls)
+		EXPECT_EQ (c.load (), 1u);
+}
+
+TEST_CASE (ParallelForTest, ZeroCount)
+{
+	bool called = false;
+	parallelFor (0, [&] (size_t) { called = true; });
+	EXPECT_FALSE (called);
+}
+
+TEST_CASE (ParallelForTest, NestedCallsRunSerially)
+{
+	std::atomic<uint32_t> numCalls {0};
+	parallelFor (8, [&] (size_t) { parallelFor (8, [&] (size_t) { ++numCalls; }); });
+	EXPECT_EQ (numCalls.load (), 64u);
+}
+
+TEST_CASE (ParallelForTest, RepeatedCalls)
+{
+	for (auto i = 0; i < 200; ++i)
+	{
+		std::atomic<size_t> sum {0};
+		parallelFor (17, [&] (size_t index) { sum += index; });
+		EXPECT_EQ (sum.load (), 136u);
+	}
+}
+
+TEST_CASE (ParallelForTest, Concurrency)
+{
+	EXPECT_TRUE (getParallelForConcurrency () >= 1u);
+}
+
+TEST_CASE (ParallelForTest, BackgroundTasksArePerformed)
+{
+	std::atomic<uint32_t> counter {0};
+	std::promise<void> done;
+	for (auto i = 0; i < 1000; ++i)
+	{
+		scheduleBackgroundTask ([&] () {
+			// tasks scheduled from a task must not get lost
+			scheduleBackgroundTask ([&] () {
+				if (++counter == 2000)
+					done.set_value ();
+			});
+			if (++counter == 2000)
+				done.set_value ();
+		});
+	}
+	done.get_future ().wait ();
+	EXPECT_EQ (counter.load (), 2000u);
+}
+
+TEST_CASE (ParallelForTest, CallWhileBackgroundTaskIsRunning)
+{
+	std::atomic<bool> released {false};
+	std::promise<void> done;
+	scheduleBackgroundTask ([&] () {
+		while (!released)
+			std::this_thread::yield ();
+		done.set_value ();
+	});
+	// the calling thread does the work if all worker threads are busy
+	std::atomic<size_t> sum {0};
+	parallelFor (17, [&] (size_t index) { sum += index; });
+	EXPECT_EQ (sum.load (), 136u);
+	released = true;
+	done.get_future ().wait ();
+}
+
+} // VSTGUI
@@ -0,0 +1,138 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/cairofont.h"
+#include "../../../../../lib/platform/linux/linuxstring.h"
+#include "../../../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+struct LayoutCacheTest
+{
+	LayoutCacheTest (size_t capacity = Cairo::Font::LayoutCacheStatistics {}.capacity)
+	{
+		Cairo::Font::setLayoutCacheCapacity (capacity);
+		Cairo::Font::clearLayoutCache ();
+		Cairo::Font::resetLayoutCacheStatistics ();
+	}
+
+	~LayoutCacheTest () noexcept
+	{
+		Cairo::Font::setLayoutCacheCapacity (Cairo::Font::LayoutCacheStatistics {}.capacity);
+		Cairo::Font::clearLayoutCache ();
+		Cairo::Font::resetLayoutCacheStatistics ();
+	}
+
+	CCoord measure (const Cairo::Font& font, UTF8StringPtr text)
+	{
+		auto string = makeOwned<LinuxString> (text);
+		return font.getStringWidth (nullptr, string);
+	}
+
+	Cairo::Font::LayoutCacheStatistics statistics () const
+	{
+		return Cairo::Font::getLayoutCacheStatistics ();
+	}
+};
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoFontTest, LayoutCacheHitsAndMisses)
+{
+	LayoutCacheTest test;
+	auto font = makeOwned<Cairo::Font> ("Sans", 12., kNormalFace);
+	auto width = test.measure (*font, "Hello");
+	EXPECT_EQ (test.statistics ().misses, 1u);
+	EXPECT_EQ (test.statistics ().hits, 0u);
+	EXPECT_EQ (test.statistics ().size, 1u);
+
+	EXPECT_EQ (test.measure (*font, "Hello"), width);
+	EXPECT_EQ (test.statistics ().misses, 1u);
+	EXPECT_EQ (test.statistics ().hits, 1u);
+	EXPECT_EQ (test.statistics ().size, 1u);
+
+	test.measure (*font, "World");
+	EXPECT_EQ (test.statistics ().misses, 2u);
+	EXPECT_EQ (test.statistics ().size, 2u);
+
+	// the style is part of the key
+	auto underlinedFont = makeOwned<Cairo::Font> ("Sans", 12., kUnderlineFace);
+	test.measure (*underlinedFont, "Hello");
+	EXPECT_EQ (test.statistics ().misses, 3u);
+	EXPECT_EQ (test.statistics ().hits, 1u);
+	EXPECT_EQ (test.statistics ().size, 3u);
+
+	Cairo::Font::resetLayoutCacheStatistics ();
+	EXPECT_EQ (test.statistics ().misses, 0u);
+	EXPECT_EQ (test.statistics ().hits, 0u);
+	EXPECT_EQ (test.statistics ().size, 3u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoFontTest, LayoutCacheEvictsLeastRecentlyUsed)
+{
+	LayoutCacheTest test (2);
+	auto font = makeOwned<Cairo::Font> ("Sans", 12., kNormalFace);
+	EXPECT_EQ (test.statistics ().capacity, 2u);
+	test.measure (*font, "a");
+	test.measure (*font, "b");
+	test.measure (*font, "a");
+	test.measure (*font, "c");
+	EXPECT_EQ (test.statistics ().size, 2u);
+	EXPECT_EQ (test.statistics ().misses, 3u);
+	EXPECT_EQ (test.statistics ().hits, 1u);
+
+	// "b" was used least recently and was removed for "c"
+	test.measure (*font, "a");
+	test.measure (*font, "c");
+	EXPECT_EQ (test.statistics ().hits, 3u);
+	test.measure (*font, "b");
+	EXPECT_EQ (test.statistics ().misses, 4u);
+	EXPECT_EQ (test.statistics ().size, 2u);
+
+	// reducing the capacity removes the entries which do not fit anymore
+	Cairo::Font::setLayoutCacheCapacity (1);
+	EXPECT_EQ (test.statistics ().size, 1u);
+	test.measure (*font, "b");
+	EXPECT_EQ (test.statistics ().hits, 4u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoFontTest, LayoutCacheWithoutCapacity)
+{
+	LayoutCacheTest test (0);
+	auto font = makeOwned<Cairo::Font> ("Sans", 12., kNormalFace);
+	auto width = test.measure (*font, "Hello");
+	EXPECT_EQ (test.measure (*font, "Hello"), width);
+	EXPECT_EQ (test.statistics ().size, 0u);
+	EXPECT_EQ (test.statistics ().misses, 2u);
+	EXPECT_EQ (test.statistics ().hits, 0u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoFontTest, ClearLayoutCache)
+{
+	LayoutCacheTest test;
+	auto font = makeOwned<Cairo::Font> ("Sans", 12., kNormalFace);
+	test.measure (*font, "a");
+	test.measure (*font, "b");
+	EXPECT_EQ (test.statistics ().size, 2u);
+
+	Cairo::Font::clearLayoutCache ();
+	EXPECT_EQ (test.statistics ().size, 0u);
+	// the statistics are kept
+	EXPECT_EQ (test.statistics ().misses, 2u);
+
+	test.measure (*font, "a");
+	EXPECT_EQ (test.statistics ().misses, 3u);
+	EXPECT_EQ (test.statistics ().hits, 0u);
+	EXPECT_EQ (test.statistics ().size, 1u);
+}
+
+} // VSTGUI
@@ -0,0 +1,117 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/cairoutils.h"
+#include "../../../unittests.h"
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+constexpr uint32_t makeTestPixel (int32_t x, int32_t y)
+{
+	return 0xFF000000 | (static_cast<uint32_t> (y) << 8) | static_cast<uint32_t> (x);
+}
+
+//------------------------------------------------------------------------
+Cairo::SurfaceHandle createTestSurface (int32_t width, int32_t height)
+{
+	Cairo::SurfaceHandle surface (cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height));
+	cairo_surface_flush (surface);
+	auto data = cairo_image_surface_get_data (surface);
+	auto stride = cairo_image_surface_get_stride (surface);
+	for (auto y = 0; y < height; ++y)
+	{
+		auto row = reinterpret_cast<uint32_t*> (data + y * stride);
+		for (auto x = 0; x < width; ++x)
+			row[x] = makeTestPixel (x, y);
+	}
+	cairo_surface_mark_dirty (surface);
+	return surface;
+}
+
+//------------------------------------------------------------------------
+uint32_t getPixel (cairo_surface_t* surface, int32_t x, int32_t y)
+{
+	cairo_surface_flush (surface);
+	auto data = cairo_image_surface_get_data (surface);
+	auto stride = cairo_image_surface_get_stride (surface);
+	return reinterpret_cast<uint32_t*> (data + y * stride)[x];
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoUtilsTest, ScrollSurfaceRectDown)
+{
+	auto surface = createTestSurface (100, 100);
+	Cairo::scrollSurfaceRect (surface, CRect (0, 0, 100, 90), CPoint (0, 10));
+	for (auto y = 0; y < 100; ++y)
+	{
+		for (auto x = 0; x < 100; x += 9)
+		{
+			auto expected = y < 10 ? makeTestPixel (x, y) : makeTestPixel (x, y - 10);
+			EXPECT_EQ (getPixel (surface, x, y), expected);
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoUtilsTest, ScrollSurfaceRectLeft)
+{
+	auto surface = createTestSurface (100, 100);
+	Cairo::scrollSurfaceRect (surface, CRect (20, 10, 80, 50), CPoint (-15, 0));
+	for (auto y = 0; y < 100; y += 7)
+	{
+		for (auto x = 0; x < 100; ++x)
+		{
+			bool inDest = y >= 10 && y < 50 && x >= 5 && x < 65;
+			auto expected = inDest ? makeTestPixel (x + 15, y) : makeTestPixel (x, y);
+			EXPECT_EQ (getPixel (surface, x, y), expected);
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoUtilsTest, ScrollSurfaceRectDiagonal)
+{
+	auto surface = createTestSurface (64, 64);
+	Cairo::scrollSurfaceRect (surface, CRect (0, 0, 60, 56), CPoint (4, 8));
+	EXPECT_EQ (getPixel (surface, 4, 8), makeTestPixel (0, 0));
+	EXPECT_EQ (getPixel (surface, 63, 63), makeTestPixel (59, 55));
+	EXPECT_EQ (getPixel (surface, 3, 63), makeTestPixel (3, 63));
+	EXPECT_EQ (getPixel (surface, 63, 7), makeTestPixel (63, 7));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoUtilsTest, ScrollExposedRects)
+{
+	std::vector<CRect> rects;
+	auto collect = [&] (const CRect& r) { rects.emplace_back (r); };
+
+	Cairo::forEachScrollExposedRect (CRect (0, 0, 100, 90), CPoint (0, 10), collect);
+	EXPECT_EQ (rects.size (), 1u);
+	EXPECT_EQ (rects[0], CRect (0, 0, 100, 10));
+
+	rects.clear ();
+	Cairo::forEachScrollExposedRect (CRect (0, 10, 100, 100), CPoint (0, -10), collect);
+	EXPECT_EQ (rects.size (), 1u);
+	EXPECT_EQ (rects[0], CRect (0, 90, 100, 100));
+
+	rects.clear ();
+	Cairo::forEachScrollExposedRect (CRect (20, 0, 100, 100), CPoint (-20, 0), collect);
+	EXPECT_EQ (rects.size (), 1u);
+	EXPECT_EQ (rects[0], CRect (80, 0, 100, 100));
+
+	rects.clear ();
+	Cairo::forEachScrollExposedRect (CRect (0, 0, 90, 80), CPoint (10, 20), collect);
+	EXPECT_EQ (rects.size (), 2u);
+	EXPECT_EQ (rects[0], CRect (0, 0, 10, 100));
+	EXPECT_EQ (rects[1], CRect (0, 0, 100, 20));
+}
+
+} // VSTGUI
@@ -0,0 +1,72 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/x11framescheduler.h"
+#include "../../../unittests.h"
+
+namespace VSTGUI {
+namespace X11 {
+
+using namespace std::chrono_literals;
+
+//------------------------------------------------------------------------
+TEST_CASE (X11FrameSchedulerTest, FirstFrameIsRenderedImmediately)
+{
+	FrameScheduler scheduler (60);
+	auto now = FrameScheduler::Clock::now ();
+	EXPECT_EQ (scheduler.getDelayUntilNextFrame (now), FrameScheduler::Duration::zero ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (X11FrameSchedulerTest, FrameRateIsLimited)
+{
+	FrameScheduler scheduler (100);
+	auto start = FrameScheduler::Clock::now ();
+	scheduler.onFrameRendered (start, start + 2ms);
+	EXPECT_EQ (scheduler.getDelayUntilNextFrame (start + 2ms), 8ms);
+	EXPECT_EQ (scheduler.getDelayUntilNextFrame (start + 10ms), FrameScheduler::Duration::zero ());
+	EXPECT_EQ (scheduler.getStatistics ().numFrames, 1u);
+	EXPECT_EQ (scheduler.getStatistics ().numSkippedFrames, 0u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (X11FrameSchedulerTest, FramesAreSkippedWhenDrawingOverruns)
+{
+	FrameScheduler scheduler (100);
+	auto start = FrameScheduler::Clock::now ();
+	scheduler.onFrameRendered (start, start + 25ms);
+	EXPECT_EQ (scheduler.getStatistics ().numSkippedFrames, 2u);
+	EXPECT_EQ (scheduler.getDelayUntilNextFrame (start + 25ms), 5ms);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (X11FrameSchedulerTest, Statistics)
+{
+	FrameScheduler scheduler (100);
+	auto start = FrameScheduler::Clock::now ();
+	scheduler.onFrameRendered (start, start + 2ms);
+	scheduler.onFrameRendered (start + 10ms, start + 16ms);
+	const auto& stats = scheduler.getStatistics ();
+	EXPECT_EQ (stats.numFrames, 2u);
+	EXPECT_EQ (stats.lastFrameDuration, 6.);
+	EXPECT_EQ (stats.maxFrameDuration, 6.);
+	EXPECT_EQ (stats.averageFrameDuration, 4.);
+	EXPECT_FALSE (stats.vsyncPaced);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (X11FrameSchedulerTest, WaitForVSync)
+{
+	FrameScheduler scheduler (100);
+	auto start = FrameScheduler::Clock::now ();
+	scheduler.onFrameRendered (start, start + 2ms, true);
+	EXPECT_TRUE (scheduler.isWaitingForVSync ());
+	EXPECT_TRUE (scheduler.getStatistics ().vsyncPaced);
+	scheduler.onVSync ();
+	EXPECT_FALSE (scheduler.isWaitingForVSync ());
+}
+
+//------------------------------------------------------------------------
+} // X11
+} // VSTGUI
@@ -0,0 +1,92 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../standalone/source/platform/gdk/gdkasync.h"
+#include "../../../unittests.h"
+#include <future>
+#include <vector>
+
+namespace VSTGUI {
+namespace Standalone {
+namespace Platform {
+namespace GDK {
+
+namespace {
+
+//------------------------------------------------------------------------
+void waitUntilDone (SerialTaskThread& thread)
+{
+	std::promise<void> promise;
+	auto future = promise.get_future ();
+	thread.schedule ([&] () { promise.set_value (); });
+	future.wait ();
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (GDKAsyncTest, SerialQueuePerformsTasksInOrder)
+{
+	std::vector<int> result;
+	SerialTaskThread thread ("VSTGUI Serial Queue Test");
+	for (auto i = 0; i < 1000; ++i)
+		thread.schedule ([&result, i] () { result.emplace_back (i); });
+	waitUntilDone (thread);
+	EXPECT_EQ (result.size (), 1000u);
+	for (auto i = 0; i < 1000; ++i)
+		EXPECT_EQ (result[i], i);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (GDKAsyncTest, SerialQueueKeepsOrderOfEachProducer)
+{
+	constexpr auto numProducers = 4;
+	constexpr auto numTasks = 500;
+	std::vector<std::pair<int, int>> result;
+	SerialTaskThread thread;
+	std::vector<std::thread> producers;
+	for (auto p = 0; p < numProducers; ++p)
+	{
+		producers.emplace_back ([&, p] () {
+			for (auto i = 0; i < numTasks; ++i)
+				thread.schedule ([&result, p, i] () { result.emplace_back (p, i); });
+		});
+	}
+	for (auto& producer : producers)
+		producer.join ();
+	waitUntilDone (thread);
+	EXPECT_EQ (result.size (), static_cast<size_t> (numProducers * numTasks));
+	std::vector<int> next (numProducers, 0);
+	for (const auto& entry : result)
+	{
+		EXPECT_EQ (entry.second, next[entry.first]);
+		++next[entry.first];
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (GDKAsyncTest, SerialQueueNeverRunsTasksConcurrently)
+{
+	std::atomic<int> running {0};
+	std::atomic<bool> overlapped {false};
+	SerialTaskThread thread;
+	for (auto i = 0; i < 200; ++i)
+	{
+		thread.schedule ([&] () {
+			if (++running != 1)
+				overlapped = true;
+			std::this_thread::yield ();
+			--running;
+		});
+	}
+	waitUntilDone (thread);
+	EXPECT_FALSE (overlapped);
+}
+
+//------------------------------------------------------------------------
+} // GDK
+} // Platform
+} // Standalone
+} // VSTGUI
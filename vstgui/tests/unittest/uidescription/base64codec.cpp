@@ -4,7 +4,9 @@
 
 #include "../../../uidescription/base64codec.h"
 #include "../unittests.h"
+#include <random>
 #include <string>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -72,4 +74,83 @@ TEST_CASE (Base64CodecTest, DecodeBinary)
 	EXPECT (ptr[5] == 0x0A);
 }
 
+static std::vector<uint8_t> randomData (size_t size)
+{
+	std::mt19937 rng (static_cast<uint32_t> (size));
+	std::vector<uint8_t> data (size);
+	for (auto& b : data)
+		b = static_cast<uint8_t> (rng ());
+	return data;
+}
+
+TEST_CASE (Base64CodecTest, ImplementationsMatchScalar)
+{
+	for (size_t size = 0; size < 300; ++size)
+	{
+		auto data = randomData (size);
+		auto reference =
+			Base64Codec::encode (data.data (), size, Base64Codec::Implementation::Scalar);
+		for (auto impl : {Base64Codec::Implementation::SSSE3, Base64Codec::Implementation::AVX2})
+		{
+			if (!Base64Codec::isSupported (impl))
+				continue;
+			auto encoded = Base64Codec::encode (data.data (), size, impl);
+			EXPECT (encoded.dataSize == reference.dataSize);
+			auto decoded = Base64Codec::decode (encoded.data.get (), encoded.dataSize, impl);
+			EXPECT (decoded.dataSize == size);
+			// an empty vector may have no data pointer, which memcmp must not get
+			if (size == 0)
+				continue;
+			EXPECT (memcmp (encoded.data.get (), reference.data.get (), reference.dataSize) == 0);
+			EXPECT (memcmp (decoded.data.get (), data.data (), size) == 0);
+		}
+	}
+}
+
+TEST_CASE (Base64CodecTest, DecodeStopsVectorizationAtPadding)
+{
+	// padding in the middle of the data is decoded like the scalar implementation does
+	std::string test ("QUJDRA==QUJDRA==QUJDRA==QUJDRA==QUJDRA==QUJDRA==QUJDRA==QUJDRA==");
+	auto reference = Base64Codec::decode (test.data (), test.size (),
+										  Base64Codec::Implementation::Scalar);
+	for (auto impl : {Base64Codec::Implementation::SSSE3, Base64Codec::Implementation::AVX2})
+	{
+		if (!Base64Codec::isSupported (impl))
+			continue;
+		auto result = Base64Codec::decode (test.data (), test.size (), impl);
+		EXPECT (result.dataSize == reference.dataSize);
+		EXPECT (memcmp (result.data.get (), reference.data.get (), reference.dataSize) == 0);
+	}
+}
+
+TEST_CASE (Base64CodecTest, StreamDecoder)
+{
+	auto data = randomData (10000);
+	auto encoded = Base64Codec::encode (data.data (), data.size ());
+	std::string input;
+	for (uint32_t i = 0; i < encoded.dataSize; ++i)
+	{
+		input += static_cast<char> (encoded.data.get ()[i]);
+		if (i % 76 == 75)
+			input += "\r\n";
+	}
+	for (size_t pieceSize : {1u, 3u, 100u, 4096u})
+	{
+		std::vector<uint8_t> output;
+		size_t numCalls = 0;
+		Base64Codec::StreamDecoder decoder (
+			[&] (const uint8_t* ptr, size_t size) {
+				output.insert (output.end (), ptr, ptr + size);
+				++numCalls;
+			},
+			1024);
+		for (size_t pos = 0; pos < input.size (); pos += pieceSize)
+			decoder.decode (input.data () + pos, std::min (pieceSize, input.size () - pos));
+		EXPECT (numCalls > 1);
+		decoder.finish ();
+		EXPECT (decoder.getDecodedSize () == data.size ());
+		EXPECT (output == data);
+	}
+}
+
 }
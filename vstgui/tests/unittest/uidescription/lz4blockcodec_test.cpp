@@ -0,0 +1,84 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../uidescription/detail/lz4blockcodec.h"
+#include "../unittests.h"
+#include <random>
+#include <string>
+#include <vector>
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+static bool roundTrip (const std::vector<uint8_t>& input)
+{
+	std::vector<uint8_t> compressed (Detail::LZ4Block::getMaxCompressedSize (input.size ()));
+	auto compressedSize = Detail::LZ4Block::compress (input.data (), input.size (),
+													  compressed.data (), compressed.size ());
+	if (compressedSize == 0)
+		return false;
+	std::vector<uint8_t> output (input.size ());
+	if (!Detail::LZ4Block::decompress (compressed.data (), compressedSize, output.data (),
+									   output.size ()))
+		return false;
+	return output == input;
+}
+
+TEST_CASE (LZ4BlockCodecTest, RoundTrip)
+{
+	EXPECT (roundTrip ({}));
+	EXPECT (roundTrip ({1, 2, 3}));
+
+	std::string text;
+	for (auto i = 0; i < 1000; ++i)
+		text += "<view class=\"CTextLabel\" origin=\"" + std::to_string (i) + ", 0\"/>\n";
+	std::vector<uint8_t> textData (text.begin (), text.end ());
+	EXPECT (roundTrip (textData));
+
+	std::vector<uint8_t> randomData (100000);
+	std::default_random_engine engine;
+	for (auto& value : randomData)
+		value = static_cast<uint8_t> (engine ());
+	EXPECT (roundTrip (randomData));
+
+	std::vector<uint8_t> repeated (100000, 'a');
+	EXPECT (roundTrip (repeated));
+}
+
+TEST_CASE (LZ4BlockCodecTest, Compresses)
+{
+	std::vector<uint8_t> repeated (100000, 'a');
+	std::vector<uint8_t> compressed (Detail::LZ4Block::getMaxCompressedSize (repeated.size ()));
+	auto compressedSize = Detail::LZ4Block::compress (repeated.data (), repeated.size (),
+													  compressed.data (), compressed.size ());
+	EXPECT (compressedSize > 0);
+	EXPECT (compressedSize < 1000);
+}
+
+TEST_CASE (LZ4BlockCodecTest, RejectsCorruptInput)
+{
+	std::vector<uint8_t> input (10000);
+	for (size_t i = 0; i < input.size (); ++i)
+		input[i] = static_cast<uint8_t> (i % 37);
+	std::vector<uint8_t> compressed (Detail::LZ4Block::getMaxCompressedSize (input.size ()));
+	auto compressedSize = Detail::LZ4Block::compress (input.data (), input.size (),
+													  compressed.data (), compressed.size ());
+	EXPECT (compressedSize > 0);
+
+	std::vector<uint8_t> output (input.size ());
+	// wrong output size
+	EXPECT (Detail::LZ4Block::decompress (compressed.data (), compressedSize, output.data (),
+										  output.size () - 1) == false);
+	// truncated input
+	EXPECT (Detail::LZ4Block::decompress (compressed.data (), compressedSize / 2, output.data (),
+										  output.size ()) == false);
+	// match offset pointing before the start of the output
+	uint8_t badOffset[] = {0x10, 'a', 0x10, 0x00};
+	EXPECT (Detail::LZ4Block::decompress (badOffset, sizeof (badOffset), output.data (), 5) ==
+			false);
+	// output buffer too small
+	EXPECT (Detail::LZ4Block::compress (input.data (), input.size (), compressed.data (), 10) == 0);
+}
+
+} // VSTGUI
@@ -7,6 +7,8 @@
 #include "../../../uidescription/cstream.h"
 #include "../../../uidescription/uiattributes.h"
 #include "../unittests.h"
+#include <thread>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -215,4 +217,158 @@ TEST_CASE (UIAttributesTest, StringArrayToStringWithEmptyStringArray)
 	EXPECT (s.empty ())
 }
 
+TEST_CASE (UIAttributesTest, InternedNames)
+{
+	UIAttributeName n1 ("Key");
+	UIAttributeName n2 (std::string ("Key"));
+	UIAttributeName n3 ("OtherKey");
+	EXPECT (n1.isValid ());
+	EXPECT (n1 == n2);
+	EXPECT (n1 != n3);
+	EXPECT (n1.getString () == "Key");
+	EXPECT (UIAttributeName ().isValid () == false);
+	EXPECT (n1.size () == 3);
+	EXPECT (std::string (n1.c_str ()) == "Key");
+	EXPECT (n1 + "-suffix" == "Key-suffix");
+	EXPECT ("prefix-" + n1 == "prefix-Key");
+	EXPECT (std::string ("prefix-") + n1 + std::string ("-suffix") == "prefix-Key-suffix");
+
+	UIAttributes a;
+	a.setAttribute (n1, "Value");
+	EXPECT (a.hasAttribute ("Key"));
+	EXPECT (*a.getAttributeValue (n2) == "Value");
+}
+
+TEST_CASE (UIAttributesTest, CachedValueUpdatesOnSet)
+{
+	UIAttributes a;
+	a.setAttribute ("Key", "1, 2, 3, 4");
+	CRect r;
+	EXPECT (a.getRectAttribute ("Key", r));
+	EXPECT (r == CRect (1, 2, 3, 4));
+	EXPECT (a.getRectAttribute ("Key", r));
+	EXPECT (r == CRect (1, 2, 3, 4));
+	a.setAttribute ("Key", "5, 6, 7, 8");
+	EXPECT (a.getRectAttribute ("Key", r));
+	EXPECT (r == CRect (5, 6, 7, 8));
+	CPoint p;
+	EXPECT (a.getPointAttribute ("Key", p) == false);
+	a.setAttribute ("Key", "invalid");
+	EXPECT (a.getRectAttribute ("Key", r) == false);
+}
+
+TEST_CASE (UIAttributesTest, PrefilledCachedValue)
+{
+	UIAttributes a;
+	UIAttributes::CachedValue cachedValue;
+	cachedValue.type = UIAttributes::CachedValue::Type::Double;
+	cachedValue.valid = true;
+	cachedValue.values[0] = 0.1;
+	a.setAttribute (UIAttributeName ("Key"), "0.1", cachedValue);
+	double value = 0.;
+	EXPECT (a.getDoubleAttribute ("Key", value));
+	EXPECT (value == 0.1);
+	EXPECT (*a.getAttributeValue ("Key") == "0.1");
+}
+
+TEST_CASE (UIAttributesTest, IterateSkipsRemoved)
+{
+	UIAttributes a;
+	a.setAttribute ("K1", "V1");
+	a.setAttribute ("K2", "V2");
+	a.setAttribute ("K3", "V3");
+	a.removeAttribute ("K2");
+	EXPECT (a.size () == 2);
+	std::string keys;
+	for (const auto& attr : a)
+		keys += attr.first;
+	EXPECT (keys == "K1K3");
+	a.setAttribute ("K2", "V4");
+	EXPECT (a.size () == 3);
+	EXPECT (*a.getAttributeValue ("K2") == "V4");
+	a.removeAll ();
+	EXPECT (a.empty ());
+	EXPECT (a.begin () == a.end ());
+}
+
+TEST_CASE (UIAttributesTest, CopyAttribute)
+{
+	UIAttributes a;
+	a.setIntegerAttribute ("Key", 42);
+	UIAttributes b;
+	b.copyAttribute (a.begin ());
+	int32_t value = 0;
+	EXPECT (b.getIntegerAttribute ("Key", value));
+	EXPECT (value == 42);
+	EXPECT (a.begin ().getName () == b.begin ().getName ());
+}
+
+TEST_CASE (UIAttributesTest, RemoveManyAttributes)
+{
+	UIAttributes a;
+	a.setAttribute ("Keep", "Value");
+	const auto* keptValue = a.getAttributeValue ("Keep");
+	for (auto i = 0; i < 100; ++i)
+	{
+		auto name = "Removed" + std::to_string (i);
+		a.setAttribute (name, "Value");
+		a.removeAttribute (name);
+	}
+	EXPECT (a.size () == 1);
+	EXPECT (std::distance (a.begin (), a.end ()) == 1);
+	EXPECT (a.getAttributeValue ("Keep") == keptValue);
+	EXPECT (a.hasAttribute ("Removed0") == false);
+	EXPECT (a.hasAttribute ("NeverUsedAttributeName") == false);
+	a.removeAttribute ("NeverUsedAttributeName");
+	EXPECT (a.size () == 1);
+}
+
+TEST_CASE (UIAttributesTest, InternManyNames)
+{
+	std::vector<UIAttributeName> names;
+	for (auto i = 0; i < 1000; ++i)
+		names.emplace_back ("InternManyNames" + std::to_string (i));
+	for (auto i = 0; i < 1000; ++i)
+	{
+		auto name = "InternManyNames" + std::to_string (i);
+		EXPECT (UIAttributeName::find (name) == names[i]);
+		EXPECT (names[i] == name);
+	}
+	EXPECT (UIAttributeName::find ("InternManyNames1000").isValid () == false);
+}
+
+TEST_CASE (UIAttributesTest, InternFromThreads)
+{
+	std::vector<std::thread> threads;
+	std::vector<std::vector<UIAttributeName>> names (4);
+	for (auto& threadNames : names)
+	{
+		threads.emplace_back ([&threadNames] () {
+			for (auto i = 0; i < 500; ++i)
+				threadNames.emplace_back ("InternFromThreads" + std::to_string (i));
+		});
+	}
+	for (auto& thread : threads)
+		thread.join ();
+	for (auto i = 0u; i < 500; ++i)
+	{
+		for (auto& threadNames : names)
+			EXPECT (threadNames[i] == names[0][i]);
+	}
+}
+
+TEST_CASE (UIAttributesTest, CopyConstructor)
+{
+	UIAttributes a (static_cast<size_t> (2));
+	a.setAttribute ("K1", "V1");
+	a.setIntegerAttribute ("K2", 2);
+	UIAttributes b (a);
+	a.setAttribute ("K1", "Changed");
+	EXPECT (b.size () == 2);
+	EXPECT (*b.getAttributeValue ("K1") == "V1");
+	int32_t value;
+	EXPECT (b.getIntegerAttribute ("K2", value));
+	EXPECT (value == 2);
+}
+
 } // VSTGUI
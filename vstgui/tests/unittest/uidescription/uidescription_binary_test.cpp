@@ -0,0 +1,217 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/ccolor.h"
+#include "../../../uidescription/cstream.h"
+#include "../../../uidescription/detail/uibinarypersistence.h"
+#include "../../../uidescription/uiattributes.h"
+#include "../../../uidescription/uicontentprovider.h"
+#include "uidescription_test_helper.h"
+
+namespace VSTGUI {
+using namespace UIDescriptionTesting;
+
+namespace {
+
+//------------------------------------------------------------------------
+constexpr auto allNodesUIDesc = R"({
+	"vstgui-ui-description": {
+		"version": "1",
+		"variables": {
+			"test": "10",
+			"test": "this is a string"
+		},
+		"bitmaps": {
+			"b1": {
+				"path": "b1.png",
+				"data": {
+					"encoding": "base64",
+					"data": "iVBORw0KGgoAAAANSUhEUgAAAAwAAAAMCAYAAABWdVznAAABe2lDQ1BJQ0MgUHJvZmlsZQAAKJF9kE0rRFEYx38zXjNkwcLC4jaG1RCjvGyUmYSaxTRGedvcueZFmXG7c4VsLJTtFCU23hZ8AjYWylopRUrKVyA20vUcQ+OlPHXO+Z3nPM+/5/zB7ddNc7a0HTJZ24oOBrWx8Qmt4gEX5XjQ8OpGzuyPRMJIfJ0/4+VaqiWuWpXW3/d/wzOdyBngqhTuM0zLFh4SblqwTcVKr96SoYRXFKcKvKE4XuCjj5pYNCR8KqwZaX1a+E7Yb6StDLiVvi/+rSb1jTOz88bnPOon1Yns6IicXlmN5IgySFC8GGaAEF100Ct7F60EaJMbdmLRVs2hOXPJmkmlba1fnEhow1mjza8F2ju6Qfn6269ibm4Xep6hJF/MxTfhZA0abos53w7UrsLxualb+keqRJY7mYTHQ6gZh7pLqJrMJTsDhR9VB6Hs3nGemqFiHd7yjvO65zhv+9IsHp1lCx59anFwA7FlCF/A1ja0iHbt1Dv7WWccXX/QZQAAAExJREFUKBVjZEAALSAzDMFFYa0C8q6BRJhQhBEcUSAThIkGDUCVIIwBcNmAoRAmMKoBFhL4aEagJLYYhkXaazTNq1jQBGBcdIUwcQYAOGIGVqwWW9EAAAAASUVORK5CYII="
+				}
+			},
+			"b1#2.0x": {
+				"path": "b1#2.0x.png",
+				"scale-factor": "2"
+			},
+			"dataBitmap": {
+				"path": "dataBitmap.png"
+			}
+		},
+		"fonts": {
+			"f1": {
+				"font-name": "Arial",
+				"size": "8"
+			},
+			"f2": {
+				"bold": "true",
+				"font-name": "Arial",
+				"size": "8"
+			}
+		},
+		"colors": {
+			"c1": "#000000ff",
+			"c2": "#ffffffff",
+			"c3": "#ff000064"
+		},
+		"gradients": {
+			"g1": [
+				{
+					"rgba": "#000000ff",
+					"start": "0"
+				},
+				{
+					"rgba": "#ff0000ff",
+					"start": "0.5"
+				},
+				{
+					"rgba": "#ffffffff",
+					"start": "1"
+				}
+			]
+		},
+		"control-tags": {
+			"t1": "1234",
+			"t2": "4321"
+		},
+		"templates": {
+			"view": {
+				"attributes": {
+					"background-color": "~ TransparentCColor",
+					"class": "CViewContainer",
+					"origin": "0, 0",
+					"size": "400, 235"
+				},
+				"children": {
+					"CView": {
+						"attributes": {
+							"class": "CView",
+							"origin": "4, 10",
+							"size": "392, 40"
+						}
+					}
+				}
+			}
+		}
+	}
+})";
+
+//------------------------------------------------------------------------
+bool saveAsBinary (const char* jsonDesc, CMemoryStream& outputStream)
+{
+	MemoryContentProvider provider (jsonDesc, static_cast<uint32_t> (strlen (jsonDesc)));
+	SaveUIDescription desc (&provider);
+	if (!desc.parse ())
+		return false;
+	return desc.saveToStream (outputStream,
+							  UIDescription::kWriteAsBinary |
+								  UIDescription::kWriteImagesIntoUIDescFile,
+							  nullptr);
+}
+
+//------------------------------------------------------------------------
+struct NotSeekableContentProvider : IContentProvider
+{
+	NotSeekableContentProvider (const void* data, uint32_t size)
+	: stream (static_cast<const int8_t*> (data), size, false)
+	{
+	}
+
+	uint32_t readRawData (int8_t* buffer, uint32_t size) override
+	{
+		return stream.readRaw (buffer, size);
+	}
+	void rewind () override {}
+
+	CMemoryStream stream;
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, Identifier)
+{
+	CMemoryStream outputStream (1024, 1024, true);
+	EXPECT (saveAsBinary (allNodesUIDesc, outputStream));
+	EXPECT (Detail::UIBinaryDescReader::isBinary (outputStream.getBuffer (), outputStream.tell ()));
+	EXPECT (Detail::UIBinaryDescReader::isBinary (allNodesUIDesc, strlen (allNodesUIDesc)) ==
+			false);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, Values)
+{
+	CMemoryStream outputStream (1024, 1024, true);
+	EXPECT (saveAsBinary (allNodesUIDesc, outputStream));
+	MemoryContentProvider provider (outputStream.getBuffer (),
+									static_cast<uint32_t> (outputStream.tell ()));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	CColor c;
+	EXPECT (desc.getColor ("c3", c));
+	EXPECT (c == CColor (255, 0, 0, 100));
+	EXPECT (desc.getTagForName ("t2") == 4321);
+	EXPECT (desc.getFont ("f2") != nullptr);
+	EXPECT (desc.getGradient ("g1") != nullptr);
+	EXPECT (desc.getBitmap ("b1") != nullptr);
+	std::list<const std::string*> names;
+	desc.collectTemplateViewNames (names);
+	EXPECT (names.size () == 1);
+	EXPECT (*names.front () == "view");
+	auto attributes = desc.getViewAttributes ("view");
+	EXPECT (attributes);
+	EXPECT (*attributes->getAttributeValue ("size") == "400, 235");
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, RoundTripToJSON)
+{
+	CMemoryStream binaryStream (1024, 1024, true);
+	EXPECT (saveAsBinary (allNodesUIDesc, binaryStream));
+	MemoryContentProvider provider (binaryStream.getBuffer (),
+									static_cast<uint32_t> (binaryStream.tell ()));
+	SaveUIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	CMemoryStream outputStream (1024, 1024, false);
+	EXPECT (desc.saveToStream (outputStream, UIDescription::kWriteImagesIntoUIDescFile, nullptr));
+	outputStream.end ();
+	std::string result (reinterpret_cast<const char*> (outputStream.getBuffer ()));
+	EXPECT (result == allNodesUIDesc);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, ParseNotSeekableContent)
+{
+	NotSeekableContentProvider jsonProvider (allNodesUIDesc,
+											 static_cast<uint32_t> (strlen (allNodesUIDesc)));
+	UIDescription jsonDesc (&jsonProvider);
+	EXPECT (jsonDesc.parse () == true);
+	EXPECT (jsonDesc.getTagForName ("t1") == 1234);
+
+	CMemoryStream binaryStream (1024, 1024, true);
+	EXPECT (saveAsBinary (allNodesUIDesc, binaryStream));
+	NotSeekableContentProvider binaryProvider (binaryStream.getBuffer (),
+											   static_cast<uint32_t> (binaryStream.tell ()));
+	UIDescription binaryDesc (&binaryProvider);
+	EXPECT (binaryDesc.parse () == true);
+	EXPECT (binaryDesc.getTagForName ("t1") == 1234);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, RejectTruncatedData)
+{
+	CMemoryStream outputStream (1024, 1024, true);
+	EXPECT (saveAsBinary (allNodesUIDesc, outputStream));
+	auto size = static_cast<size_t> (outputStream.tell ());
+	for (auto truncatedSize : {size_t (4), size_t (64), size / 2, size - 1})
+	{
+		std::vector<uint64_t> buffer (size / sizeof (uint64_t) + 1);
+		memcpy (buffer.data (), outputStream.getBuffer (), truncatedSize);
+		EXPECT (Detail::UIBinaryDescReader::read (buffer.data (), truncatedSize) == nullptr);
+	}
+	std::vector<uint64_t> buffer (size / sizeof (uint64_t) + 1);
+	memcpy (buffer.data (), outputStream.getBuffer (), size);
+	EXPECT (Detail::UIBinaryDescReader::read (buffer.data (), size) != nullptr);
+}
+
+} // VSTGUI
@@ -10,6 +10,7 @@
 #include "../../../uidescription/uiattributes.h"
 #include "../../../uidescription/uicontentprovider.h"
 #include "uidescription_test_helper.h"
+#include <atomic>
 
 namespace VSTGUI {
 using namespace UIDescriptionTesting;
@@ -1300,6 +1301,26 @@ TEST_CASE (UIDescriptionJSONTests, Bitmaps)
 	EXPECT (dynamic_cast<CNinePartTiledBitmap*> (bitmap) == nullptr);
 }
 
+TEST_CASE (UIDescriptionJSONTests, PreloadBitmaps)
+{
+	MemoryContentProvider provider (bitmapNodesUIDesc,
+	                                static_cast<uint32_t> (strlen (bitmapNodesUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+	UIBitmapPreloadStatistics statistics;
+	EXPECT (desc.getBitmapPreloadStatistics (statistics) == false);
+	std::atomic<uint32_t> numProgressCalls {0};
+	desc.preloadBitmaps ([&] (uint32_t numDone, uint32_t numTotal) { ++numProgressCalls; });
+	statistics = desc.waitForBitmapPreload ();
+	EXPECT (statistics.done);
+	EXPECT (statistics.numBitmaps == 2);
+	EXPECT (statistics.numDecoded + statistics.numFailed + statistics.numSkipped == 2);
+	EXPECT (numProgressCalls == 2);
+	auto bitmap = desc.getBitmap ("b1");
+	EXPECT (bitmap);
+	EXPECT (desc.lookupBitmapName (bitmap) == std::string ("b1"));
+}
+
 TEST_CASE (UIDescriptionJSONTests, Tags)
 {
 	MemoryContentProvider provider (tagNodesUIDesc,
@@ -1536,6 +1557,246 @@ TEST_CASE (UIDescriptionJSONTests, AddNewTemplate)
 	EXPECT (*names.back () == std::string ("addNewTemplate"));
 }
 
+TEST_CASE (UIDescriptionJSONTests, TemplateLookupFollowsTemplateChanges)
+{
+	MemoryContentProvider provider (createViewUIDesc,
+	                                static_cast<uint32_t> (strlen (createViewUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+
+	EXPECT (desc.getViewAttributes ("view"));
+	EXPECT (desc.getViewAttributes ("viewcopy") == nullptr);
+	EXPECT (desc.duplicateTemplate ("view", "viewcopy"));
+	EXPECT (desc.getViewAttributes ("viewcopy"));
+	EXPECT (desc.changeTemplateName ("viewcopy", "copyOfView"));
+	EXPECT (desc.getViewAttributes ("viewcopy") == nullptr);
+	EXPECT (desc.getViewAttributes ("copyOfView"));
+	EXPECT (desc.removeTemplate ("copyOfView"));
+	EXPECT (desc.getViewAttributes ("copyOfView") == nullptr);
+	EXPECT (desc.getViewAttributes ("view"));
+}
+
+TEST_CASE (UIDescriptionJSONTests, ReverseLookupFollowsResourceChanges)
+{
+	MemoryContentProvider provider (emptyUIDesc, static_cast<uint32_t> (strlen (emptyUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+
+	desc.changeColor ("red", CColor (200, 10, 20, 255));
+	desc.changeColor ("green", CColor (10, 200, 20, 255));
+	EXPECT (desc.lookupColorName (CColor (200, 10, 20, 255)) == std::string ("red"));
+	desc.changeColor ("red", CColor (100, 10, 20, 255));
+	EXPECT (desc.lookupColorName (CColor (200, 10, 20, 255)) == nullptr);
+	EXPECT (desc.lookupColorName (CColor (100, 10, 20, 255)) == std::string ("red"));
+	desc.changeColorName ("red", "darkred");
+	EXPECT (desc.lookupColorName (CColor (100, 10, 20, 255)) == std::string ("darkred"));
+	desc.removeColor ("darkred");
+	EXPECT (desc.lookupColorName (CColor (100, 10, 20, 255)) == nullptr);
+	EXPECT (desc.lookupColorName (CColor (10, 200, 20, 255)) == std::string ("green"));
+	desc.changeColor ("dark green", CColor (10, 100, 20, 255));
+	desc.changeColor ("dark green", CColor (10, 200, 20, 255));
+	EXPECT (desc.lookupColorName (CColor (10, 200, 20, 255)) == std::string ("dark green"));
+	desc.changeColor ("dark green", CColor (10, 100, 20, 255));
+	EXPECT (desc.lookupColorName (CColor (10, 200, 20, 255)) == std::string ("green"));
+
+	EXPECT (desc.changeControlTagString ("tag1", "1", true));
+	EXPECT (desc.changeControlTagString ("tag2", "tag.tag1 + 1", true));
+	EXPECT (desc.lookupControlTagName (2) == std::string ("tag2"));
+	EXPECT (desc.changeControlTagString ("tag1", "10", false));
+	EXPECT (desc.lookupControlTagName (1) == nullptr);
+	EXPECT (desc.lookupControlTagName (10) == std::string ("tag1"));
+	EXPECT (desc.lookupControlTagName (11) == std::string ("tag2"));
+	EXPECT (desc.lookupControlTagName (2) == nullptr);
+	desc.changeTagName ("tag1", "tagA");
+	EXPECT (desc.lookupControlTagName (10) == std::string ("tagA"));
+	desc.removeTag ("tagA");
+	EXPECT (desc.lookupControlTagName (10) == nullptr);
+}
+
+TEST_CASE (UIDescriptionJSONTests, ReverseLookupFindsFontsCreatedLater)
+{
+	MemoryContentProvider provider (fontNodesUIDesc,
+	                                static_cast<uint32_t> (strlen (fontNodesUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+
+	auto otherFont = makeOwned<CFontDesc> ("Arial", 8);
+	EXPECT (desc.lookupFontName (otherFont) == nullptr);
+	// the index was built before the font of f2 was created
+	auto font = desc.getFont ("f2");
+	EXPECT (font);
+	EXPECT (desc.lookupFontName (font) == std::string ("f2"));
+	EXPECT (desc.lookupFontName (otherFont) == nullptr);
+}
+
+TEST_CASE (UIDescriptionJSONTests, ReloadChangedResources)
+{
+	MemoryContentProvider provider (colorNodesUIDesc,
+	                                static_cast<uint32_t> (strlen (colorNodesUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+
+	constexpr auto changedColors = R"({
+		"vstgui-ui-description": {
+			"version": "1",
+			"colors": {
+				"c1": "#000000ff",
+				"c2": "#102030ff",
+				"c3": "#ff000064",
+				"c4": "#00ff0096",
+				"c6": "#0000ffff"
+			}
+		}
+	})";
+	DescriptionListenerMock listener (UIDescTestCase::ColorChanged);
+	desc.registerListener (&listener);
+	MemoryContentProvider newProvider (changedColors,
+	                                   static_cast<uint32_t> (strlen (changedColors)));
+	UIDescriptionReloadStatistics statistics;
+	EXPECT (desc.reload (nullptr, &newProvider, &statistics));
+	EXPECT (listener.callCount () == 1);
+	// c2 changed, c5 removed and c6 added
+	EXPECT (statistics.numChangedResources == 3);
+	EXPECT (statistics.numChangedTemplates == 0);
+	CColor color;
+	EXPECT (desc.getColor ("c2", color));
+	EXPECT (color == CColor (0x10, 0x20, 0x30, 0xff));
+	EXPECT (desc.getColor ("c5", color) == false);
+	EXPECT (desc.getColor ("c6", color));
+	EXPECT (color == CColor (0, 0, 0xff, 0xff));
+	EXPECT (desc.lookupColorName (CColor (0x10, 0x20, 0x30, 0xff)) == std::string ("c2"));
+
+	listener.setTestCase (UIDescTestCase::ColorChanged);
+	MemoryContentProvider sameProvider (changedColors,
+	                                    static_cast<uint32_t> (strlen (changedColors)));
+	EXPECT (desc.reload (nullptr, &sameProvider, &statistics));
+	EXPECT (listener.callCount () == 0);
+	EXPECT (statistics.numChangedResources == 0);
+	desc.unregisterListener (&listener);
+}
+
+TEST_CASE (UIDescriptionJSONTests, ReloadUpdatesViews)
+{
+	MemoryContentProvider provider (createViewUIDesc,
+	                                static_cast<uint32_t> (strlen (createViewUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+
+	Controller controller;
+	auto view = owned (desc.createView ("view", &controller));
+	auto container = view->asViewContainer ();
+	EXPECT (container && container->getNbViews () == 1);
+	auto child = container->getView (0);
+
+	constexpr auto changedView = R"({
+		"vstgui-ui-description": {
+			"version": "1",
+			"templates": {
+				"view": {
+					"attributes": {
+						"background-color": "~ TransparentCColor",
+						"background-color-draw-style": "filled and stroked",
+						"class": "CViewContainer",
+						"mouse-enabled": "true",
+						"opacity": "1",
+						"origin": "0, 0",
+						"size": "400, 235",
+						"transparent": "false"
+					},
+					"children": {
+						"CView": {
+							"attributes": {
+								"class": "CView",
+								"mouse-enabled": "true",
+								"opacity": "1",
+								"origin": "4, 20",
+								"size": "392, 40",
+								"transparent": "false"
+							}
+						},
+						"CViewContainer": {
+							"attributes": {
+								"class": "CViewContainer",
+								"origin": "4, 100",
+								"size": "392, 40"
+							}
+						}
+					}
+				}
+			}
+		}
+	})";
+	MemoryContentProvider newProvider (changedView, static_cast<uint32_t> (strlen (changedView)));
+	UIDescriptionReloadStatistics statistics;
+	EXPECT (desc.reload (view, &newProvider, &statistics));
+	EXPECT (statistics.numChangedTemplates == 1);
+	EXPECT (statistics.numUpdatedViews == 1);
+	EXPECT (statistics.numRecreatedViews == 1);
+	EXPECT (statistics.numRemovedViews == 0);
+	// the first child was updated in place and the second one was added
+	EXPECT (container->getNbViews () == 2);
+	EXPECT (container->getView (0) == child);
+	EXPECT (child->getViewSize () == CRect (4, 20, 396, 60));
+	EXPECT (container->getView (1)->asViewContainer ());
+	EXPECT (container->getView (1)->getViewSize () == CRect (4, 100, 396, 140));
+
+	// a changed class creates the view again, the reload of the same content changes nothing
+	MemoryContentProvider originalProvider (createViewUIDesc,
+	                                        static_cast<uint32_t> (strlen (createViewUIDesc)));
+	EXPECT (desc.reload (view, &originalProvider, &statistics));
+	EXPECT (container->getNbViews () == 1);
+	EXPECT (container->getView (0) == child);
+	EXPECT (child->getViewSize () == CRect (4, 10, 396, 50));
+	EXPECT (statistics.numRemovedViews == 1);
+	std::string classChanged (createViewUIDesc);
+	const std::string viewClass = "\"class\": \"CView\"";
+	classChanged.replace (classChanged.find (viewClass), viewClass.size (),
+	                      "\"class\": \"CViewContainer\"");
+	MemoryContentProvider classProvider (classChanged.data (),
+	                                     static_cast<uint32_t> (classChanged.size ()));
+	EXPECT (desc.reload (view, &classProvider, &statistics));
+	EXPECT (statistics.numRecreatedViews == 1);
+	EXPECT (statistics.numRemovedViews == 1);
+	EXPECT (container->getNbViews () == 1);
+	EXPECT (container->getView (0)->asViewContainer ());
+	MemoryContentProvider sameProvider (classChanged.data (),
+	                                    static_cast<uint32_t> (classChanged.size ()));
+	EXPECT (desc.reload (view, &sameProvider, &statistics));
+	EXPECT (statistics.numChangedTemplates == 0);
+	EXPECT (statistics.numUpdatedViews == 0);
+	EXPECT (statistics.numRecreatedViews == 0);
+}
+
+TEST_CASE (UIDescriptionJSONTests, ReloadRecreatesViewsWithRemovedAttributes)
+{
+	MemoryContentProvider provider (createViewUIDesc,
+	                                static_cast<uint32_t> (strlen (createViewUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse () == true);
+
+	Controller controller;
+	auto view = owned (desc.createView ("view", &controller));
+	auto container = view->asViewContainer ();
+	EXPECT (container && container->getNbViews () == 1);
+	SharedPointer<CView> child = container->getView (0);
+
+	// remove the last attribute of the child view
+	std::string attributeRemoved (createViewUIDesc);
+	const std::string attribute = "\"transparent\": \"false\"";
+	auto pos = attributeRemoved.rfind (attribute);
+	auto separator = attributeRemoved.rfind (',', pos);
+	attributeRemoved.erase (separator, pos + attribute.size () - separator);
+	MemoryContentProvider newProvider (attributeRemoved.data (),
+	                                   static_cast<uint32_t> (attributeRemoved.size ()));
+	UIDescriptionReloadStatistics statistics;
+	EXPECT (desc.reload (view, &newProvider, &statistics));
+	EXPECT (statistics.numUpdatedViews == 0);
+	EXPECT (statistics.numRecreatedViews == 1);
+	EXPECT (container->getNbViews () == 1);
+	EXPECT (container->getView (0) != child);
+	EXPECT (container->getView (0)->getViewSize () == CRect (4, 10, 396, 50));
+}
+
 TEST_CASE (UIDescriptionJSONTests, StoreRestoreViews)
 {
 	MemoryContentProvider provider (createViewUIDesc,
@@ -1763,6 +2024,46 @@ TEST_CASE (UIDescriptionJSONTests, SharedResources)
 	desc.setSharedResources (nullptr);
 }
 
+TEST_CASE (UIDescriptionJSONTests, ParseAsync)
+{
+	MemoryContentProvider provider (sharedResourcesUIDesc,
+	                                static_cast<uint32_t> (strlen (sharedResourcesUIDesc)));
+	UIDescription desc (&provider);
+	bool doneResult = false;
+	uint32_t numDoneCalls = 0;
+	EXPECT (desc.parseAsync (
+		[&] (bool success) {
+			doneResult = success;
+			++numDoneCalls;
+		},
+		0));
+	EXPECT (desc.parseAsync () == false);
+	EXPECT (desc.finishAsyncParse () == true);
+	EXPECT (numDoneCalls == 1);
+	EXPECT (doneResult == true);
+	EXPECT (desc.isAsyncParseDone () == false);
+	EXPECT (desc.parseAsync () == false);
+
+	CColor color;
+	EXPECT (desc.getColor ("c1", color) == true);
+	EXPECT (desc.getFont ("f1") != nullptr);
+	EXPECT (desc.getFont ("~ NormalFont") == kNormalFont);
+	EXPECT (desc.getGradient ("g1") != nullptr);
+	EXPECT (desc.getGradient ("g1")->getColorStops ().size () == 3);
+}
+
+TEST_CASE (UIDescriptionJSONTests, ParseAsyncFailure)
+{
+	constexpr auto invalidUIDesc = "{ \"vstgui-ui-description\": ";
+	MemoryContentProvider provider (invalidUIDesc, static_cast<uint32_t> (strlen (invalidUIDesc)));
+	UIDescription desc (&provider);
+	bool doneResult = true;
+	EXPECT (desc.parseAsync ([&] (bool success) { doneResult = success; }, 0));
+	EXPECT (desc.parse () == false);
+	EXPECT (doneResult == false);
+	EXPECT (desc.getFont ("~ NormalFont") == kNormalFont);
+}
+
 #if 0
 TEST_CASE (UIDescriptionJSONTests, CompleteExample)
 {
@@ -7,6 +7,7 @@
 #include "../../../lib/cgradient.h"
 #include "../../../lib/cviewcontainer.h"
 #include "../../../uidescription/detail/uiviewcreatorattributes.h"
+#include "../../../uidescription/detail/uixmlpersistence.h"
 #include "../../../uidescription/uiattributes.h"
 #include "../../../uidescription/uicontentprovider.h"
 #include "../../../uidescription/xmlparser.h"
@@ -285,10 +286,59 @@ constexpr auto sharedResourcesUIDesc = R"(<?xml version="1.0" encoding="UTF-8"?>
 </vstgui-ui-description>
 )";
 
+//------------------------------------------------------------------------
+bool equalNodes (Detail::UINode* n1, Detail::UINode* n2)
+{
+	if (n1->getName () != n2->getName () || n1->getData () != n2->getData ())
+		return false;
+	auto a1 = n1->getAttributes ();
+	auto a2 = n2->getAttributes ();
+	if (a1->size () != a2->size ())
+		return false;
+	for (const auto& attr : *a1)
+	{
+		auto value = a2->getAttributeValue (attr.first);
+		if (!value || *value != attr.second)
+			return false;
+	}
+	auto& c1 = n1->getChildren ();
+	auto& c2 = n2->getChildren ();
+	if (c1.size () != c2.size ())
+		return false;
+	for (auto it1 = c1.begin (), it2 = c2.begin (); it1 != c1.end (); ++it1, ++it2)
+	{
+		if (!equalNodes (*it1, *it2))
+			return false;
+	}
+	return true;
+}
+
 } // anonymous
 
 using StringPtrList = std::list<const std::string*>;
 
+TEST_CASE (UIDescriptionXMLTests, BufferedCharData)
+{
+	MemoryContentProvider provider (withAllNodesUIDesc,
+	                                static_cast<uint32_t> (strlen (withAllNodesUIDesc)));
+	Detail::UIXMLParser parser (false);
+	auto nodes = parser.parse (&provider);
+	EXPECT (nodes);
+	Detail::UIXMLParser bufferedParser (true);
+	auto bufferedNodes = bufferedParser.parse (&provider);
+	EXPECT (bufferedNodes);
+	EXPECT (equalNodes (nodes, bufferedNodes));
+
+	const auto& stats = parser.getStatistics ();
+	const auto& bufferedStats = bufferedParser.getStatistics ();
+	EXPECT (stats.numNodes == bufferedStats.numNodes);
+	EXPECT (stats.numAttributes == bufferedStats.numAttributes);
+	EXPECT (stats.numCharDataBytes == bufferedStats.numCharDataBytes);
+	EXPECT (stats.numCharDataBytes > 0);
+	EXPECT (bufferedStats.numCharDataAllocations == 1);
+	EXPECT (stats.numCharDataAllocations > bufferedStats.numCharDataAllocations);
+}
+
 TEST_CASE (UIDescriptionXMLTests, ParseEmpty)
 {
 	MemoryContentProvider provider (emptyUIDesc, static_cast<uint32_t> (strlen (emptyUIDesc)));
@@ -0,0 +1,174 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/vstguiinit.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+namespace {
+
+//------------------------------------------------------------------------
+/** a mixer with numStrips channel strips, every strip holds 32 controls */
+void addMixer (CViewContainer* parent, size_t numStrips)
+{
+	constexpr CCoord stripWidth = 64.;
+	for (size_t s = 0; s < numStrips; ++s)
+	{
+		auto strip = new CViewContainer (CRect (0, 0, stripWidth, 700).offset (s * stripWidth, 0.));
+		// inserts, sends and pans
+		for (auto i = 0; i < 24; ++i)
+			strip->addView (new CView (CRect (2, 2, 62, 18).offset (0, i * 18.)));
+		// mute, solo, record and monitor buttons
+		for (auto i = 0; i < 4; ++i)
+			strip->addView (new CView (CRect (2, 440, 31, 456).offset ((i % 2) * 31., (i / 2) * 18.)));
+		// fader, meter, level display and name
+		strip->addView (new CView (CRect (2, 480, 40, 660)));
+		auto meter = new CView (CRect (42, 480, 62, 660));
+		meter->setMouseEnabled (false);
+		strip->addView (meter);
+		strip->addView (new CView (CRect (2, 662, 62, 678)));
+		strip->addView (new CView (CRect (2, 680, 62, 698)));
+		parent->addView (strip);
+	}
+}
+
+//------------------------------------------------------------------------
+/** a step sequencer grid of numSteps x numRows buttons directly in one container */
+void addGrid (CViewContainer* parent, size_t numSteps, size_t numRows)
+{
+	for (size_t row = 0; row < numRows; ++row)
+	{
+		for (size_t step = 0; step < numSteps; ++step)
+			parent->addView (new CView (CRect (0, 0, 14, 14).offset (step * 16., row * 16.)));
+	}
+}
+
+//------------------------------------------------------------------------
+/** a mouse trace with a random velocity, bouncing at the borders of the frame */
+std::vector<CPoint> makeTrace (const CRect& bounds, size_t numEvents)
+{
+	std::default_random_engine engine;
+	std::normal_distribution<CCoord> acceleration (0., 1.5);
+	std::vector<CPoint> trace;
+	trace.reserve (numEvents);
+	CPoint pos (bounds.getCenter ());
+	CPoint velocity (4., 3.);
+	for (size_t i = 0; i < numEvents; ++i)
+	{
+		velocity.x = std::max (-25., std::min (25., velocity.x + acceleration (engine)));
+		velocity.y = std::max (-25., std::min (25., velocity.y + acceleration (engine)));
+		pos += velocity;
+		if (pos.x < bounds.left || pos.x >= bounds.right)
+			velocity.x = -velocity.x;
+		if (pos.y < bounds.top || pos.y >= bounds.bottom)
+			velocity.y = -velocity.y;
+		pos.x = std::max (bounds.left, std::min (bounds.right - 1., pos.x));
+		pos.y = std::max (bounds.top, std::min (bounds.bottom - 1., pos.y));
+		trace.emplace_back (pos);
+	}
+	return trace;
+}
+
+//------------------------------------------------------------------------
+void setSpatialIndexEnabled (CViewContainer* container, bool state)
+{
+	container->setSpatialIndexEnabled (state);
+	container->forEachChild ([state] (CView* view) {
+		if (auto childContainer = view->asViewContainer ())
+			setSpatialIndexEnabled (childContainer, state);
+	});
+}
+
+//------------------------------------------------------------------------
+/** replays the trace with the lookup of CFrame::checkMouseViews, returns ns per event */
+double replay (CFrame* frame, const std::vector<CPoint>& trace, std::vector<CView*>& result)
+{
+	using namespace std::chrono;
+
+	constexpr size_t numRuns = 5;
+	const auto options = GetViewOptions ().deep ().mouseEnabled ().includeViewContainer ();
+	double best = 0.;
+	for (size_t run = 0; run < numRuns; ++run)
+	{
+		result.clear ();
+		auto start = high_resolution_clock::now ();
+		for (const auto& pos : trace)
+			result.emplace_back (frame->getViewAt (pos, options));
+		auto ns = duration<double, std::nano> (high_resolution_clock::now () - start).count ();
+		if (run == 0 || ns < best)
+			best = ns;
+	}
+	return best / trace.size ();
+}
+
+//------------------------------------------------------------------------
+bool run (const char* name, CFrame* frame, size_t numViews)
+{
+	auto trace = makeTrace (frame->getViewSize (), 200000);
+
+	std::vector<CView*> linearResult;
+	std::vector<CView*> indexedResult;
+	setSpatialIndexEnabled (frame, false);
+	auto linear = replay (frame, trace, linearResult);
+	setSpatialIndexEnabled (frame, true);
+	auto indexed = replay (frame, trace, indexedResult);
+	setSpatialIndexEnabled (frame, false);
+	if (linearResult != indexedResult)
+	{
+		printf ("%s: the spatial index returned different views\n", name);
+		return false;
+	}
+	printf ("%-24s %5zu views: linear %8.1f ns/event, spatial index %8.1f ns/event\n", name,
+			numViews, linear, indexed);
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#elif LINUX
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	bool result = true;
+	for (auto numStrips : {32u, 96u})
+	{
+		auto frame = new CFrame (CRect (0, 0, numStrips * 64., 700), nullptr);
+		addMixer (frame, numStrips);
+		frame->attached (frame);
+		result &= run ("mixer", frame, numStrips * 33);
+		frame->close ();
+	}
+	for (auto numRows : {16u, 64u})
+	{
+		auto frame = new CFrame (CRect (0, 0, 64 * 16, numRows * 16.), nullptr);
+		addGrid (frame, 64, numRows);
+		frame->attached (frame);
+		result &= run ("sequencer grid", frame, numRows * 64);
+		frame->close ();
+	}
+	return result ? 0 : -1;
+}
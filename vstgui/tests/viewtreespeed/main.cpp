@@ -0,0 +1,226 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cdrawcontext.h"
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/vstguiinit.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+// count the heap memory in use, every block remembers its size in front of it
+static size_t gHeapSize = 0;
+
+void* operator new (size_t size)
+{
+	auto block = static_cast<size_t*> (std::malloc (size + sizeof (std::max_align_t)));
+	if (!block)
+		throw std::bad_alloc ();
+	*block = size;
+	gHeapSize += size;
+	return reinterpret_cast<char*> (block) + sizeof (std::max_align_t);
+}
+
+void operator delete (void* ptr) noexcept
+{
+	if (!ptr)
+		return;
+	auto block = reinterpret_cast<size_t*> (static_cast<char*> (ptr) - sizeof (std::max_align_t));
+	gHeapSize -= *block;
+	std::free (block);
+}
+
+void* operator new[] (size_t size) { return operator new (size); }
+void operator delete[] (void* ptr) noexcept { operator delete (ptr); }
+void operator delete (void* ptr, size_t) noexcept { operator delete (ptr); }
+void operator delete[] (void* ptr, size_t) noexcept { operator delete (ptr); }
+
+namespace {
+
+//------------------------------------------------------------------------
+static constexpr CViewAttributeID kTagAttribute = 'vtag';
+
+//------------------------------------------------------------------------
+/** numStrips containers with viewsPerStrip views each, like a large mixer. Every view has a small
+ *	attribute like a controller or tag, some have a mouseable area or an alpha value */
+CViewContainer* createTree (size_t numStrips, size_t viewsPerStrip)
+{
+	constexpr CCoord stripWidth = 64.;
+	constexpr CCoord viewHeight = 16.;
+	auto root = new CViewContainer (CRect (0, 0, numStrips * stripWidth, viewsPerStrip * viewHeight));
+	for (size_t s = 0; s < numStrips; ++s)
+	{
+		auto strip = new CViewContainer (
+			CRect (0, 0, stripWidth, viewsPerStrip * viewHeight).offset (s * stripWidth, 0.));
+		for (size_t i = 0; i < viewsPerStrip; ++i)
+		{
+			CRect r (2, 1, stripWidth - 2, viewHeight - 1);
+			r.offset (0., i * viewHeight);
+			auto view = new CView (r);
+			auto tag = static_cast<int32_t> (s * viewsPerStrip + i);
+			view->setAttribute (kTagAttribute, tag);
+			if (i % 4 == 0)
+				view->setMouseableArea (r.inset (2., 0.));
+			if (i % 8 == 1)
+				view->setAlphaValue (0.5f);
+			strip->addView (view);
+		}
+		root->addView (strip);
+	}
+	return root;
+}
+
+//------------------------------------------------------------------------
+/** best of numRuns in ns per item */
+template<typename Proc>
+double measure (size_t numItems, size_t numRuns, Proc proc)
+{
+	using namespace std::chrono;
+
+	double best = 0.;
+	for (size_t run = 0; run < numRuns; ++run)
+	{
+		auto start = high_resolution_clock::now ();
+		proc ();
+		auto ns = duration<double, std::nano> (high_resolution_clock::now () - start).count ();
+		if (run == 0 || ns < best)
+			best = ns;
+	}
+	return best / numItems;
+}
+
+//------------------------------------------------------------------------
+void visit (CViewContainer* container, int64_t& checksum)
+{
+	container->forEachChild ([&] (CView* view) {
+		if (view->isVisible ())
+			checksum += static_cast<int64_t> (view->getViewSize ().getWidth ());
+		if (auto child = view->asViewContainer ())
+			visit (child, checksum);
+	});
+}
+
+//------------------------------------------------------------------------
+/** a step sequencer grid, redrawn in small rects like by meter and LED updates. Returns the time
+ *	in ns per update rect for the linear traversal and with the spatial index */
+std::pair<double, double> measureGridUpdates (size_t numRuns)
+{
+	constexpr uint32_t numColumns = 64;
+	constexpr uint32_t numRows = 64;
+	CRect frameRect (0, 0, numColumns * 16, numRows * 16);
+	auto container = new CViewContainer (frameRect);
+	for (auto i = 0u; i < numColumns * numRows; ++i)
+	{
+		CRect r (0, 0, 14, 14);
+		r.offset ((i % numColumns) * 16., (i / numColumns) * 16.);
+		container->addView (new CView (r));
+	}
+	auto frame = new CFrame (frameRect, nullptr);
+	frame->addView (container);
+	frame->attached (frame);
+
+	std::default_random_engine engine;
+	std::uniform_real_distribution<CCoord> pos (0., frameRect.right - 20.);
+	std::vector<CRect> updateRects;
+	for (auto i = 0; i < 500; ++i)
+	{
+		CRect r (0, 0, i % 10 ? 8. : 80., 12.);
+		updateRects.emplace_back (r.offset (pos (engine), pos (engine)));
+	}
+
+	auto drawContext = makeOwned<CDrawContext> (nullptr, frameRect, 1.);
+	auto draw = [&] () {
+		for (const auto& r : updateRects)
+			container->drawRect (drawContext, r);
+	};
+	auto linearTime = measure (updateRects.size (), numRuns, draw);
+	container->setSpatialIndexEnabled (true);
+	auto culledTime = measure (updateRects.size (), numRuns, draw);
+	frame->close ();
+	return {linearTime, culledTime};
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+int main ()
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#elif LINUX
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	constexpr size_t numStrips = 100;
+	constexpr size_t viewsPerStrip = 99;
+	constexpr size_t numViews = numStrips * (viewsPerStrip + 1);
+	constexpr size_t numRuns = 20;
+
+	auto heapSize = gHeapSize;
+	auto root = createTree (numStrips, viewsPerStrip);
+	heapSize = gHeapSize - heapSize;
+	printf ("%zu views: %zu KB heap, %.1f bytes per view\n", numViews, heapSize / 1024,
+			static_cast<double> (heapSize) / numViews);
+
+	auto rootSize = root->getViewSize ();
+	auto frame = new CFrame (rootSize, nullptr);
+	frame->addView (root);
+	frame->attached (frame);
+
+	int64_t checksum = 0;
+	auto visitTime = measure (numViews, numRuns, [&] () { visit (root, checksum); });
+	auto drawContext = makeOwned<CDrawContext> (nullptr, rootSize, 1.);
+	auto drawTime = measure (numViews, numRuns, [&] () { root->drawRect (drawContext, rootSize); });
+	size_t numHits = 0;
+	auto hitTestTime = measure (numStrips * viewsPerStrip, numRuns, [&] () {
+		// one point per view, every lookup walks the children of the root and of one strip
+		for (CCoord x = 8.; x < rootSize.right; x += 64.)
+		{
+			for (CCoord y = 8.; y < rootSize.bottom; y += 16.)
+			{
+				if (frame->getViewAt (CPoint (x, y), GetViewOptions ().deep ().mouseEnabled ()))
+					++numHits;
+			}
+		}
+	});
+	auto attributeTime = measure (numViews, numRuns, [&] () {
+		root->forEachChild ([&] (CView* strip) {
+			strip->asViewContainer ()->forEachChild ([&] (CView* view) {
+				int32_t tag = 0;
+				if (view->getAttribute (kTagAttribute, tag))
+					checksum += tag;
+			});
+		});
+	});
+	printf ("visit %.2f ns/view, draw %.2f ns/view, hit test %.2f ns/lookup, attribute %.2f ns/view "
+			"(checksum %lld, %zu hits)\n",
+			visitTime, drawTime, hitTestTime, attributeTime, static_cast<long long> (checksum),
+			numHits);
+	frame->close ();
+
+	auto gridTimes = measureGridUpdates (numRuns);
+	printf ("grid of 4096 views: draw %.2f ns/update rect, with spatial index %.2f ns/update rect\n",
+			gridTimes.first, gridTimes.second);
+	return 0;
+}
@@ -45,7 +45,9 @@ int main (int argv, char* argc[])
 	std::string inputPath;
 	std::string outputPath;
 	bool noCompression = false;
+	bool binary = false;
 	uint32_t compressionLevel = 1;
+	uint32_t codec = CompressedUIDescription::kZLibCodec;
 	for (auto i = 0; i < argv; ++i)
 	{
 		UTF8StringView arg (argc[i]);
@@ -67,17 +69,33 @@ int main (int argv, char* argc[])
 				break;
 			compressionLevel = static_cast<uint32_t> (UTF8StringView (argc[i]).toInteger ());
 		}
+		else if (arg == "--codec")
+		{
+			if (++i >= argv)
+				break;
+			UTF8StringView codecName (argc[i]);
+			if (codecName == "zlib")
+				codec = CompressedUIDescription::kZLibCodec;
+			else if (codecName == "lz4")
+				codec = CompressedUIDescription::kLZ4Codec;
+			else
+				printAndTerminate ("Unknown codec, use zlib or lz4!");
+		}
 		else if (arg == "--nocompression")
 		{
 			noCompression = true;
 		}
+		else if (arg == "--binary")
+		{
+			binary = true;
+		}
 	}
 	if (inputPath.empty () || outputPath.empty ())
 	{
 		printAndTerminate ("No input or output path specified!");
 	}
 	printf ("Copy %s to %s%s\n", inputPath.data (), outputPath.data (),
-			noCompression ? " [uncompressed]" : "[compressed]");
+			binary ? " [binary]" : (noCompression ? " [uncompressed]" : "[compressed]"));
 
 	CompressedUIDescription uiDesc (CResourceDescription (inputPath.data ()));
 	if (!uiDesc.parse ())
@@ -85,7 +103,15 @@ int main (int argv, char* argc[])
 		printAndTerminate ("Parsing failed!");
 	}
 	int32_t flags = UIDescription::kWriteImagesIntoUIDescFile;
-	if (noCompression)
+	if (binary)
+	{
+		flags |= UIDescription::kWriteAsBinary;
+		if (!uiDesc.UIDescription::save (outputPath.data (), flags))
+		{
+			printAndTerminate ("saving failed");
+		}
+	}
+	else if (noCompression)
 	{
 		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == false)
 			return 0;
@@ -97,13 +123,15 @@ int main (int argv, char* argc[])
 	}
 	else
 	{
-		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == true)
+		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == true &&
+			uiDesc.getCodec () == codec)
 			return 0;
 
 		flags |= CompressedUIDescription::kNoPlainUIDescFileBackup |
 				 CompressedUIDescription::kForceWriteCompressedDesc |
 				 CompressedUIDescription::kDoNotVerifyImageData;
 		uiDesc.setCompressionLevel (compressionLevel);
+		uiDesc.setCodec (codec);
 		if (!uiDesc.save (outputPath.data (), flags))
 		{
 			printAndTerminate ("saving failed");
@@ -5,6 +5,10 @@
 #pragma once
 
 #include "../lib/malloc.h"
+#include "detail/base64simd.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
 
 namespace VSTGUI {
 
@@ -18,6 +22,30 @@ public:
 		uint32_t dataSize {0};
 	};
 
+	enum class Implementation
+	{
+		Scalar,
+		SSSE3,
+		AVX2
+	};
+
+	/** the fastest implementation supported by the CPU */
+	static inline Implementation getFastestImplementation ()
+	{
+#if VSTGUI_BASE64_SIMD
+		if (Detail::hasAVX2 ())
+			return Implementation::AVX2;
+		if (Detail::hasSSSE3 ())
+			return Implementation::SSSE3;
+#endif
+		return Implementation::Scalar;
+	}
+
+	static inline bool isSupported (Implementation impl)
+	{
+		return static_cast<int> (impl) <= static_cast<int> (getFastestImplementation ());
+	}
+
 	template<typename T>
 	static inline Result decode (const T& base64String)
 	{
@@ -25,51 +53,45 @@ public:
 	}
 
 	template <typename T>
-	static inline Result decode (const T* inBuffer, size_t inBufferSize)
+	static inline Result decode (const T* inBuffer, size_t inBufferSize,
+								 Implementation impl = getFastestImplementation ())
 	{
 		static_assert (sizeof (T) == 1, "T must be one byte type");
 		Result r;
 		r.data.allocate ((inBufferSize * 3 / 4) + 3);
+		if (inBufferSize == 0)
+			return r;
+		auto input = reinterpret_cast<const uint8_t*> (inBuffer);
+		// all but the last one to four characters are decoded without looking for padding
+		auto bodySize = ((inBufferSize - 1) / 4) * 4;
+		r.dataSize = static_cast<uint32_t> (decodeBody (input, bodySize, r.data.get (), impl));
 		uint8_t input1[4];
-		uint8_t input2[4];
-		auto input1Ptr = reinterpret_cast<uint32_t*>(&input1[0]);
-		auto input2Ptr = reinterpret_cast<uint32_t*>(&input2[0]);
-		auto buffer32Ptr = reinterpret_cast<const uint32_t*> (inBuffer);
-		while (inBufferSize > 8)
-		{
-			*input1Ptr = *buffer32Ptr++;
-			*input2Ptr = *buffer32Ptr++;
-			r.dataSize += decodeblock<false> (input1, r.data.get () + r.dataSize);
-			r.dataSize += decodeblock<false> (input2, r.data.get () + r.dataSize);
-			inBufferSize -= 8;
-		}
-		while (inBufferSize > 4)
-		{
-			*input1Ptr = *buffer32Ptr++;
-			r.dataSize += decodeblock<false> (input1, r.data.get () + r.dataSize);
-			inBufferSize -= 4;
-		}
-		if (inBufferSize > 0)
-		{
-			input1[0] = input1[1] = input1[2] = input1[3] = '=';
-			auto ptr = reinterpret_cast<const uint8_t*>(buffer32Ptr);
-			for (uint32_t j = 0; j < inBufferSize; j++)
-			{
-				input1[j] = *ptr++;
-			}
-			r.dataSize += decodeblock<true> (input1, r.data.get () + r.dataSize);
-		}
+		input1[0] = input1[1] = input1[2] = input1[3] = '=';
+		for (size_t j = 0; j < inBufferSize - bodySize; j++)
+			input1[j] = input[bodySize + j];
+		r.dataSize += decodeblock<true> (input1, r.data.get () + r.dataSize);
 		return r;
 	}
 
-	static inline Result encode (const void* binaryData, size_t binaryDataSize)
+	static inline Result encode (const void* binaryData, size_t binaryDataSize,
+								 Implementation impl = getFastestImplementation ())
 	{
 		Result r;
 		r.data.allocate ((binaryDataSize * 4) / 3 + 4);
 		auto ptr = reinterpret_cast<const uint8_t*> (binaryData);
+		size_t i = 0;
+#if VSTGUI_BASE64_SIMD
+		if (impl == Implementation::AVX2)
+			i = Detail::Base64SIMD::encodeAVX2 (ptr, binaryDataSize, r.data.get ());
+		else if (impl == Implementation::SSSE3)
+			i = Detail::Base64SIMD::encodeSSSE3 (ptr, binaryDataSize, r.data.get ());
+		r.dataSize = static_cast<uint32_t> (i / 3 * 4);
+		ptr += i;
+#else
+		(void)impl;
+#endif
 		uint8_t input[3];
-		uint32_t i;
-		for (i = 0; i < (binaryDataSize - 3); i += 3)
+		for (; i + 3 < binaryDataSize; i += 3)
 		{
 			input[0] = *ptr++;
 			input[1] = *ptr++;
@@ -91,7 +113,118 @@ public:
 		return r;
 	}
 
+	//-----------------------------------------------------------------------------
+	/** Decodes base64 data arriving in pieces, like from a file or network stream
+	 *
+	 *	The decoded data is passed to the output function in chunks of up to chunkSize bytes as
+	 *	soon as enough input arrived, so that the consumer (e.g. an image decoder) can start
+	 *	working before all the input is available. Whitespace in the input is skipped.
+	 */
+	class StreamDecoder
+	{
+	public:
+		using OutputFunc = std::function<void (const uint8_t* data, size_t size)>;
+
+		explicit StreamDecoder (OutputFunc&& func, size_t chunkSize = 16 * 1024,
+								Implementation implementation = getFastestImplementation ())
+		: outputFunc (std::move (func)), impl (implementation)
+		{
+			chunkSize = std::max<size_t> (chunkSize / 3, 2) * 3;
+			output.allocate (chunkSize);
+			pending.allocate (chunkSize / 3 * 4);
+		}
+
+		/** decode the next part of the input */
+		template <typename T>
+		void decode (const T* inBuffer, size_t inBufferSize)
+		{
+			static_assert (sizeof (T) == 1, "T must be one byte type");
+			auto input = reinterpret_cast<const uint8_t*> (inBuffer);
+			auto end = input + inBufferSize;
+			while (input != end)
+			{
+				auto dst = pending.get () + numPending;
+				auto dstEnd = pending.get () + pending.size ();
+				while (dst != dstEnd && input != end)
+				{
+					auto c = *input++;
+					if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+						*dst++ = c;
+				}
+				numPending = static_cast<size_t> (dst - pending.get ());
+				if (numPending == pending.size ())
+					flush (false);
+			}
+		}
+
+		/** decode the remaining input including the padding */
+		void finish ()
+		{
+			flush (true);
+		}
+
+		/** number of bytes passed to the output function */
+		uint64_t getDecodedSize () const { return decodedSize; }
+
+	private:
+		void flush (bool final)
+		{
+			if (numPending == 0)
+				return;
+			// the last characters may contain the padding, keep them until finish is called
+			auto bodySize = ((numPending - 1) / 4) * 4;
+			auto size = decodeBody (pending.get (), bodySize, output.get (), impl);
+			if (final)
+			{
+				uint8_t input[4];
+				input[0] = input[1] = input[2] = input[3] = '=';
+				for (size_t j = 0; j < numPending - bodySize; j++)
+					input[j] = pending.get ()[bodySize + j];
+				size += decodeblock<true> (input, output.get () + size);
+				bodySize = numPending;
+			}
+			numPending -= bodySize;
+			std::memmove (pending.get (), pending.get () + bodySize, numPending);
+			if (size)
+			{
+				decodedSize += size;
+				outputFunc (output.get (), size);
+			}
+		}
+
+		OutputFunc outputFunc;
+		Implementation impl;
+		Buffer<uint8_t> pending;
+		Buffer<uint8_t> output;
+		size_t numPending {0};
+		uint64_t decodedSize {0};
+	};
+
 private:
+	/** decodes complete blocks of four characters without looking for padding */
+	static inline size_t decodeBody (const uint8_t* input, size_t inputSize, uint8_t* output,
+									 Implementation impl)
+	{
+		size_t i = 0;
+		size_t outputSize = 0;
+#if VSTGUI_BASE64_SIMD
+		if (impl == Implementation::AVX2)
+			i = Detail::Base64SIMD::decodeAVX2 (input, inputSize, output);
+		else if (impl == Implementation::SSSE3)
+			i = Detail::Base64SIMD::decodeSSSE3 (input, inputSize, output);
+		outputSize = i / 4 * 3;
+#else
+		(void)impl;
+#endif
+		uint8_t input1[4];
+		for (; i < inputSize; i += 4)
+		{
+			std::memcpy (input1, input + i, 4);
+			outputSize += decodeblock<false> (input1, output + outputSize);
+		}
+		return outputSize;
+	}
+
 	template<bool finalBlock = true>
 	static inline uint32_t decodeblock (uint8_t input[4], uint8_t output[3])
 	{
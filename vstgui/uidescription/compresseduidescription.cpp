@@ -6,7 +6,11 @@
 #include "compresseduidescription.h"
 #include "cstream.h"
 #include "uicontentprovider.h"
-#include <array>
+#include "detail/lz4blockcodec.h"
+#include "detail/uinode.h"
+#include <algorithm>
+#include <mutex>
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -23,6 +27,9 @@ namespace {
 #if _MSC_VER
 #pragma warning(pop)
 #endif
+// the zlib compatible names would clash with IUIDescCompressionCodec
+#undef compress
+#undef uncompress
 
 using z_stream = mz_stream;
 };
@@ -42,7 +49,7 @@ public:
 protected:
 	std::unique_ptr<z_stream> zstream;
 	InputStream* stream {nullptr};
-	std::array<Bytef, 4096> internalBuffer;
+	std::vector<Bytef> internalBuffer;
 };
 
 //-----------------------------------------------------------------------------
@@ -64,7 +71,158 @@ public:
 protected:
 	std::unique_ptr<z_stream> zstream;
 	OutputStream* stream {nullptr};
-	std::array<Bytef, 4096> internalBuffer;
+	std::vector<Bytef> internalBuffer = std::vector<Bytef> (64 * 1024);
+};
+
+//-----------------------------------------------------------------------------
+/** Splits the data into blocks which are compressed with an IUIDescCompressionCodec
+ *
+ *	Format: codec identifier and block size as uint32, followed by the blocks, each with its
+ *	uncompressed and compressed size as uint32 before the data. A block with an uncompressed size of
+ *	zero ends the data. Blocks which do not compress are stored as they are, with the compressed
+ *	size equal to the uncompressed size.
+ */
+class BlockOutputStream : public OutputStream
+{
+public:
+	BlockOutputStream (OutputStream& stream, const IUIDescCompressionCodec& codec, uint32_t level,
+					   uint32_t blockSize = kDefaultBlockSize)
+	: OutputStream (kNativeByteOrder), stream (stream), codec (codec), level (level)
+	{
+		block.reserve (blockSize);
+		compressed.resize (codec.getMaxCompressedSize (blockSize));
+	}
+
+	static constexpr uint32_t kDefaultBlockSize = 1024 * 1024;
+
+	bool open ()
+	{
+		return (stream << codec.getIdentifier ()) &&
+			   (stream << static_cast<uint32_t> (block.capacity ()));
+	}
+
+	bool close ()
+	{
+		if (!block.empty () && !writeBlock ())
+			return false;
+		return stream << static_cast<uint32_t> (0);
+	}
+
+	bool operator<< (const std::string& str) override
+	{
+		return writeRaw (str.data (), static_cast<uint32_t> (str.size ())) == str.size ();
+	}
+
+	uint32_t writeRaw (const void* buffer, uint32_t size) override
+	{
+		auto ptr = static_cast<const uint8_t*> (buffer);
+		auto remaining = size;
+		while (remaining > 0)
+		{
+			auto numBytes = std::min<size_t> (remaining, block.capacity () - block.size ());
+			block.insert (block.end (), ptr, ptr + numBytes);
+			ptr += numBytes;
+			remaining -= static_cast<uint32_t> (numBytes);
+			if (block.size () == block.capacity () && !writeBlock ())
+				return kStreamIOError;
+		}
+		return size;
+	}
+
+private:
+	bool writeBlock ()
+	{
+		auto blockSize = static_cast<uint32_t> (block.size ());
+		auto compressedSize = codec.compress (block.data (), block.size (), compressed.data (),
+											  compressed.size (), level);
+		bool stored = compressedSize == 0 || compressedSize >= block.size ();
+		auto data = stored ? block.data () : compressed.data ();
+		auto dataSize = static_cast<uint32_t> (stored ? block.size () : compressedSize);
+		block.clear ();
+		return (stream << blockSize) && (stream << dataSize) &&
+			   stream.writeRaw (data, dataSize) == dataSize;
+	}
+
+	OutputStream& stream;
+	const IUIDescCompressionCodec& codec;
+	uint32_t level;
+	std::vector<uint8_t> block;
+	std::vector<uint8_t> compressed;
+};
+
+//------------------------------------------------------------------------
+class ZLibCodec : public IUIDescCompressionCodec
+{
+public:
+	uint32_t getIdentifier () const override { return CompressedUIDescription::kZLibCodec; }
+
+	size_t getMaxCompressedSize (size_t inputSize) const override
+	{
+		return mz_compressBound (static_cast<mz_ulong> (inputSize));
+	}
+
+	size_t compress (const uint8_t* input, size_t inputSize, uint8_t* output,
+					 size_t outputCapacity, uint32_t level) const override
+	{
+		auto outputSize = static_cast<mz_ulong> (outputCapacity);
+		if (mz_compress2 (output, &outputSize, input, static_cast<mz_ulong> (inputSize),
+						  static_cast<int> (level)) != MZ_OK)
+			return 0;
+		return outputSize;
+	}
+
+	bool decompress (const uint8_t* input, size_t inputSize, uint8_t* output,
+					 size_t outputSize) const override
+	{
+		auto size = static_cast<mz_ulong> (outputSize);
+		return mz_uncompress (output, &size, input, static_cast<mz_ulong> (inputSize)) == MZ_OK &&
+			   size == outputSize;
+	}
+};
+
+//------------------------------------------------------------------------
+class LZ4Codec : public IUIDescCompressionCodec
+{
+public:
+	uint32_t getIdentifier () const override { return CompressedUIDescription::kLZ4Codec; }
+
+	size_t getMaxCompressedSize (size_t inputSize) const override
+	{
+		return Detail::LZ4Block::getMaxCompressedSize (inputSize);
+	}
+
+	size_t compress (const uint8_t* input, size_t inputSize, uint8_t* output,
+					 size_t outputCapacity, uint32_t level) const override
+	{
+		return Detail::LZ4Block::compress (input, inputSize, output, outputCapacity);
+	}
+
+	bool decompress (const uint8_t* input, size_t inputSize, uint8_t* output,
+					 size_t outputSize) const override
+	{
+		return Detail::LZ4Block::decompress (input, inputSize, output, outputSize);
+	}
+};
+
+//------------------------------------------------------------------------
+/** the registered codecs. They are never removed or replaced, so that the pointers returned by
+ *	findCodec stay valid while descriptions are parsed on other threads */
+struct CodecRegistry
+{
+	std::mutex mutex;
+	std::vector<std::unique_ptr<IUIDescCompressionCodec>> codecs;
+
+	CodecRegistry ()
+	{
+		codecs.emplace_back (std::make_unique<ZLibCodec> ());
+		codecs.emplace_back (std::make_unique<LZ4Codec> ());
+	}
+
+	static CodecRegistry& instance ()
+	{
+		static CodecRegistry gInstance;
+		return gInstance;
+	}
 };
 
 //------------------------------------------------------------------------
@@ -106,6 +264,75 @@ public:
 
 //-----------------------------------------------------------------------------
 static constexpr int64_t kUIDescIdentifier = 0x7072637365646975LL; // 8 byte identifier
+static constexpr int64_t kUIDescBlocksIdentifier = 0x6b62637365646975LL; // 8 byte identifier
+static constexpr uint32_t kMaxBlockSize = 64 * 1024 * 1024;
+
+//-----------------------------------------------------------------------------
+/** the sum of the uncompressed sizes in the block headers, skips the compressed data and restores
+ *	the stream position. Returns 0 if the headers are invalid */
+static size_t getUncompressedSize (InputStream& stream, SeekableStream& seekStream,
+								   uint32_t blockSize, const IUIDescCompressionCodec& codec)
+{
+	auto start = seekStream.tell ();
+	auto end = seekStream.seek (0, SeekableStream::kSeekEnd);
+	if (start < 0 || end < start || seekStream.seek (start, SeekableStream::kSeekSet) != start)
+		return 0;
+	size_t result = 0;
+	while (true)
+	{
+		uint32_t uncompressedSize;
+		uint32_t compressedSize;
+		if (!(stream >> uncompressedSize))
+		{
+			result = 0;
+			break;
+		}
+		if (uncompressedSize == 0)
+			break;
+		if (!(stream >> compressedSize) || uncompressedSize > blockSize ||
+			compressedSize > codec.getMaxCompressedSize (blockSize))
+		{
+			result = 0;
+			break;
+		}
+		auto next = seekStream.seek (compressedSize, SeekableStream::kSeekCurrent);
+		if (next < 0 || next > end)
+		{
+			result = 0;
+			break;
+		}
+		result += uncompressedSize;
+	}
+	seekStream.seek (start, SeekableStream::kSeekSet);
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+bool CompressedUIDescription::registerCodec (std::unique_ptr<IUIDescCompressionCodec>&& codec)
+{
+	auto& registry = CodecRegistry::instance ();
+	std::lock_guard<std::mutex> guard (registry.mutex);
+	auto identifier = codec->getIdentifier ();
+	auto it = std::find_if (registry.codecs.begin (), registry.codecs.end (),
+							[&] (const auto& c) { return c->getIdentifier () == identifier; });
+	if (it != registry.codecs.end ())
+		return false;
+	registry.codecs.emplace_back (std::move (codec));
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+const IUIDescCompressionCodec* CompressedUIDescription::findCodec (uint32_t identifier)
+{
+	auto& registry = CodecRegistry::instance ();
+	std::lock_guard<std::mutex> guard (registry.mutex);
+	for (const auto& codec : registry.codecs)
+	{
+		if (codec->getIdentifier () == identifier)
+			return codec.get ();
+	}
+	return nullptr;
+}
 
 //-----------------------------------------------------------------------------
 CompressedUIDescription::CompressedUIDescription (const CResourceDescription& compressedUIDescFile)
@@ -114,9 +341,9 @@ CompressedUIDescription::CompressedUIDescription (const CResourceDescription& co
 }
 
 //-----------------------------------------------------------------------------
-bool CompressedUIDescription::parseWithStream (InputStream& stream)
+auto CompressedUIDescription::readWithStream (InputStream& stream) -> SharedPointer<Detail::UINode>
 {
-	bool result = false;
+	SharedPointer<Detail::UINode> nodes;
 	int64_t identifier;
 	stream >> identifier;
 	if (identifier == kUIDescIdentifier)
@@ -125,23 +352,88 @@ bool CompressedUIDescription::parseWithStream (InputStream& stream)
 		if (zin.open ())
 		{
 			setContentProvider (&zin);
-			result = UIDescription::parse ();
+			nodes = UIDescription::readNodes ();
 			setContentProvider (nullptr);
+			if (nodes)
+				codec = kZLibCodec;
 		}
 	}
-	return result;
+	else if (identifier == kUIDescBlocksIdentifier)
+	{
+		nodes = readBlocks (stream);
+	}
+	return nodes;
 }
 
 //-----------------------------------------------------------------------------
-bool CompressedUIDescription::parse ()
+auto CompressedUIDescription::readBlocks (InputStream& stream) -> SharedPointer<Detail::UINode>
 {
-	if (parsed ())
-		return true;
-	bool result = false;
+	uint32_t codecIdentifier;
+	uint32_t blockSize;
+	if (!(stream >> codecIdentifier) || !(stream >> blockSize) || blockSize > kMaxBlockSize)
+		return nullptr;
+	auto blockCodec = findCodec (codecIdentifier);
+	if (!blockCodec)
+		return nullptr;
+
+	std::vector<uint8_t> data;
+	std::vector<uint8_t> compressed;
+	if (auto seekStream = dynamic_cast<SeekableStream*> (&stream))
+		data.reserve (getUncompressedSize (stream, *seekStream, blockSize, *blockCodec));
+	while (true)
+	{
+		uint32_t uncompressedSize;
+		uint32_t compressedSize;
+		if (!(stream >> uncompressedSize))
+			return nullptr;
+		if (uncompressedSize == 0)
+			break;
+		if (!(stream >> compressedSize) || uncompressedSize > blockSize ||
+			compressedSize > blockCodec->getMaxCompressedSize (blockSize))
+			return nullptr;
+		auto offset = data.size ();
+		data.resize (offset + uncompressedSize);
+		if (compressedSize == uncompressedSize)
+		{
+			if (stream.readRaw (data.data () + offset, compressedSize) != compressedSize)
+				return nullptr;
+			continue;
+		}
+		compressed.resize (compressedSize);
+		if (stream.readRaw (compressed.data (), compressedSize) != compressedSize)
+			return nullptr;
+		if (!blockCodec->decompress (compressed.data (), compressedSize, data.data () + offset,
+									 uncompressedSize))
+			return nullptr;
+	}
+	MemoryContentProvider provider (data.data (), static_cast<uint32_t> (data.size ()));
+	setContentProvider (&provider);
+	auto nodes = UIDescription::readNodes ();
+	setContentProvider (nullptr);
+	if (nodes)
+		codec = codecIdentifier;
+	return nodes;
+}
+
+//-----------------------------------------------------------------------------
+bool CompressedUIDescription::saveBlocks (OutputStream& stream,
+										  const IUIDescCompressionCodec& blockCodec,
+										  int32_t flags, AttributeSaveFilterFunc func)
+{
+	BlockOutputStream blockStream (stream, blockCodec, compressionLevel);
+	if (!(stream << kUIDescBlocksIdentifier) || !blockStream.open ())
+		return false;
+	return saveToStream (blockStream, flags, func) && blockStream.close ();
+}
+
+//-----------------------------------------------------------------------------
+auto CompressedUIDescription::readNodes () -> SharedPointer<Detail::UINode>
+{
+	SharedPointer<Detail::UINode> nodes;
 	CResourceInputStream resStream (kLittleEndianByteOrder);
 	if (resStream.open (getUIDescFile ()))
 	{
-		result = parseWithStream (resStream);
+		nodes = readWithStream (resStream);
 	}
 	else if (getUIDescFile ().type == CResourceDescription::kStringType)
 	{
@@ -150,16 +442,16 @@ bool CompressedUIDescription::parse ()
 		                     CFileStream::kReadMode | CFileStream::kBinaryMode,
 		                     kLittleEndianByteOrder))
 		{
-			result = parseWithStream (fileStream);
+			nodes = readWithStream (fileStream);
 		}
 	}
-	if (!result)
+	if (!nodes)
 	{
 		// fallback, check if it is an uncompressed UIDescription file
-		return UIDescription::parse ();
+		return UIDescription::readNodes ();
 	}
 	originalIsCompressed = true;
-	return result;
+	return nodes;
 }
 
 //-----------------------------------------------------------------------------
@@ -175,13 +467,21 @@ bool CompressedUIDescription::save (UTF8StringPtr filename, int32_t flags,
 		                         CFileStream::kTruncateMode,
 		                     kLittleEndianByteOrder))
 		{
-			fileStream << kUIDescIdentifier;
-			ZLibOutputStream zout;
-			if (zout.open (fileStream, compressionLevel))
+			auto blockCodec = findCodec (codec);
+			if (codec != kZLibCodec && blockCodec)
+			{
+				result = saveBlocks (fileStream, *blockCodec, flags, func);
+			}
+			else
 			{
-				if (saveToStream (zout, flags, func))
+				fileStream << kUIDescIdentifier;
+				ZLibOutputStream zout;
+				if (zout.open (fileStream, compressionLevel))
 				{
-					result = zout.close ();
+					if (saveToStream (zout, flags, func))
+					{
+						result = zout.close ();
+					}
 				}
 			}
 		}
@@ -229,6 +529,19 @@ bool ZLibInputStream::open (InputStream& _stream)
 		return false;
 	stream = &_stream;
 
+	// read the whole compressed data at once if it is small, otherwise in pieces of up to 1 MB
+	size_t bufferSize = 64 * 1024;
+	if (auto seekStream = dynamic_cast<SeekableStream*> (stream))
+	{
+		auto pos = seekStream->tell ();
+		auto end = seekStream->seek (0, SeekableStream::kSeekEnd);
+		if (pos >= 0 && end > pos)
+			bufferSize = std::min<size_t> (std::max<size_t> (static_cast<size_t> (end - pos), 4096),
+										   1024 * 1024);
+		seekStream->seek (pos, SeekableStream::kSeekSet);
+	}
+	internalBuffer.resize (bufferSize);
+
 	auto read = stream->readRaw (internalBuffer.data (), static_cast<uint32_t> (internalBuffer.size ()));
 	if (read == 0 || read == kStreamIOError)
 		return false;
@@ -265,7 +578,7 @@ uint32_t ZLibInputStream::readRaw (void* buffer, uint32_t size)
 				zstream->avail_in = read;
 			}
 		}
-		auto zres = inflate (zstream.get (), Z_SYNC_FLUSH);
+		auto zres = inflate (zstream.get (), Z_NO_FLUSH);
 		if (zres == Z_STREAM_END)
 		{
 			return size - zstream->avail_out;
@@ -5,10 +5,34 @@
 #pragma once
 
 #include "uidescription.h"
+#include <memory>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
 
+//------------------------------------------------------------------------
+/** Compression codec of CompressedUIDescription files
+ *
+ *	Files store the identifier of the codec they were written with, so that a file is loaded with
+ *	the same codec. Additional codecs can be registered with CompressedUIDescription::registerCodec.
+ */
+class IUIDescCompressionCodec
+{
+public:
+	virtual ~IUIDescCompressionCodec () noexcept = default;
+
+	/** the identifier written into the file */
+	virtual uint32_t getIdentifier () const = 0;
+	/** the output buffer size compress needs in the worst case */
+	virtual size_t getMaxCompressedSize (size_t inputSize) const = 0;
+	/** returns the compressed size or 0 on failure */
+	virtual size_t compress (const uint8_t* input, size_t inputSize, uint8_t* output,
+							 size_t outputCapacity, uint32_t level) const = 0;
+	/** returns false if the input is corrupt or does not decompress to exactly outputSize bytes */
+	virtual bool decompress (const uint8_t* input, size_t inputSize, uint8_t* output,
+							 size_t outputSize) const = 0;
+};
+
 //------------------------------------------------------------------------
 class CompressedUIDescription : public UIDescription
 {
@@ -30,18 +54,38 @@ public:
 		kNoPlainXmlFileBackup [[deprecated("use kNoPlainUIDescFileBackup")]] = kNoPlainUIDescFileBackup,
 	};
 
-	bool parse () override;
 	bool save (UTF8StringPtr filename, int32_t flags = kWriteWindowsResourceFile,
 			   AttributeSaveFilterFunc func = nullptr) override;
 
 	bool getOriginalIsCompressed () const { return originalIsCompressed; }
 	void setCompressionLevel (uint32_t level) { compressionLevel = level; }
 
+	/** zlib, files are written in the original format readable by all versions */
+	static constexpr uint32_t kZLibCodec = 0x62696c7a;
+	/** LZ4 block format, larger files but several times faster to decompress */
+	static constexpr uint32_t kLZ4Codec = 0x20347a6c;
+
+	/** the codec used when saving, set to the codec of the file when it is parsed */
+	void setCodec (uint32_t identifier) { codec = identifier; }
+	uint32_t getCodec () const { return codec; }
+
+	/** make an additional codec available for loading and saving. Registered codecs are never
+	 *	removed, returns false and drops codec if a codec with its identifier is already registered */
+	static bool registerCodec (std::unique_ptr<IUIDescCompressionCodec>&& codec);
+	static const IUIDescCompressionCodec* findCodec (uint32_t identifier);
+
+protected:
+	SharedPointer<Detail::UINode> readNodes () override;
+
 private:
-	bool parseWithStream (InputStream& stream);
+	SharedPointer<Detail::UINode> readWithStream (InputStream& stream);
+	SharedPointer<Detail::UINode> readBlocks (InputStream& stream);
+	bool saveBlocks (OutputStream& stream, const IUIDescCompressionCodec& blockCodec, int32_t flags,
+					 AttributeSaveFilterFunc func);
 
 	bool originalIsCompressed {false};
 	uint32_t compressionLevel {1};
+	uint32_t codec {kZLibCodec};
 };
 
 //------------------------------------------------------------------------
@@ -0,0 +1,236 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../lib/detail/cpufeatures.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(VSTGUI_BASE64_SIMD)
+#define VSTGUI_BASE64_SIMD VSTGUI_X86_SIMD
+#endif
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+namespace Base64SIMD {
+
+//------------------------------------------------------------------------
+/** SSSE3 and AVX2 kernels for the Base64Codec
+ *
+ *	The kernels work on complete blocks only and return the number of input bytes they consumed,
+ *	the rest is left to the scalar code. The decoders stop at the first block with a character
+ *	outside of the base64 alphabet (including padding), so that the scalar code produces the same
+ *	result as before for it.
+ *	The encoding and decoding follows W. Mula and D. Lemire, "Faster Base64 Encoding and Decoding
+ *	using AVX2 Instructions".
+ */
+#if VSTGUI_BASE64_SIMD
+
+//------------------------------------------------------------------------
+/** 6 bit values to ASCII */
+VSTGUI_SIMD_TARGET ("ssse3")
+inline __m128i encodeLookup (__m128i values)
+{
+	// 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+	auto index = _mm_subs_epu8 (values, _mm_set1_epi8 (51));
+	auto less = _mm_cmpgt_epi8 (_mm_set1_epi8 (26), values);
+	index = _mm_or_si128 (index, _mm_and_si128 (less, _mm_set1_epi8 (13)));
+	const auto offsets =
+		_mm_setr_epi8 ('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+					   '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+	return _mm_add_epi8 (_mm_shuffle_epi8 (offsets, index), values);
+}
+
+//------------------------------------------------------------------------
+/** 3 bytes in each 32 bit word to four 6 bit values */
+VSTGUI_SIMD_TARGET ("ssse3")
+inline __m128i encodeSplit (__m128i input)
+{
+	input = _mm_shuffle_epi8 (input, _mm_set_epi8 (10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+	auto t0 = _mm_and_si128 (input, _mm_set1_epi32 (0x0fc0fc00));
+	auto t1 = _mm_mulhi_epu16 (t0, _mm_set1_epi32 (0x04000040));
+	auto t2 = _mm_and_si128 (input, _mm_set1_epi32 (0x003f03f0));
+	auto t3 = _mm_mullo_epi16 (t2, _mm_set1_epi32 (0x01000010));
+	return _mm_or_si128 (t1, t3);
+}
+
+//------------------------------------------------------------------------
+/** ASCII to 6 bit values, returns false if a character is not in the alphabet */
+VSTGUI_SIMD_TARGET ("ssse3")
+inline bool decodeLookup (__m128i input, __m128i& values)
+{
+	const auto shiftLUT = _mm_setr_epi8 (0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const auto maskLUT = _mm_setr_epi8 (
+		static_cast<char> (0xa8), static_cast<char> (0xf8), static_cast<char> (0xf8),
+		static_cast<char> (0xf8), static_cast<char> (0xf8), static_cast<char> (0xf8),
+		static_cast<char> (0xf8), static_cast<char> (0xf8), static_cast<char> (0xf8),
+		static_cast<char> (0xf8), static_cast<char> (0xf0), 0x54, 0x50, 0x50, 0x50, 0x54);
+	const auto bitPosLUT = _mm_setr_epi8 (0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40,
+										  static_cast<char> (0x80), 0, 0, 0, 0, 0, 0, 0, 0);
+	auto higherNibble = _mm_and_si128 (_mm_srli_epi32 (input, 4), _mm_set1_epi8 (0x0f));
+	auto lowerNibble = _mm_and_si128 (input, _mm_set1_epi8 (0x0f));
+	auto mask = _mm_shuffle_epi8 (maskLUT, lowerNibble);
+	auto bit = _mm_shuffle_epi8 (bitPosLUT, higherNibble);
+	auto invalid = _mm_cmpeq_epi8 (_mm_and_si128 (mask, bit), _mm_setzero_si128 ());
+	if (_mm_movemask_epi8 (invalid))
+		return false;
+	// '/' shares the higher nibble with '+' but needs a shift of 16 instead of 19
+	auto shift = _mm_shuffle_epi8 (shiftLUT, higherNibble);
+	auto isSlash = _mm_cmpeq_epi8 (input, _mm_set1_epi8 ('/'));
+	shift = _mm_sub_epi8 (shift, _mm_and_si128 (isSlash, _mm_set1_epi8 (3)));
+	values = _mm_add_epi8 (input, shift);
+	return true;
+}
+
+//------------------------------------------------------------------------
+/** four 6 bit values in each 32 bit word to 3 bytes, packed into the lower 12 bytes */
+VSTGUI_SIMD_TARGET ("ssse3")
+inline __m128i decodePack (__m128i values)
+{
+	auto mergedPairs = _mm_maddubs_epi16 (values, _mm_set1_epi32 (0x01400140));
+	auto merged = _mm_madd_epi16 (mergedPairs, _mm_set1_epi32 (0x00011000));
+	return _mm_shuffle_epi8 (merged,
+							 _mm_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("ssse3")
+inline void store12 (uint8_t* output, __m128i value)
+{
+	_mm_storel_epi64 (reinterpret_cast<__m128i*> (output), value);
+	auto upper = static_cast<uint32_t> (_mm_cvtsi128_si32 (_mm_srli_si128 (value, 8)));
+	std::memcpy (output + 8, &upper, 4);
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("ssse3")
+inline size_t encodeSSSE3 (const uint8_t* input, size_t inputSize, uint8_t* output)
+{
+	size_t consumed = 0;
+	// the 16 byte loads read 4 bytes beyond the 12 bytes encoded per iteration
+	while (inputSize - consumed >= 16)
+	{
+		auto in = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + consumed));
+		auto out = encodeLookup (encodeSplit (in));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (output), out);
+		output += 16;
+		consumed += 12;
+	}
+	return consumed;
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("ssse3")
+inline size_t decodeSSSE3 (const uint8_t* input, size_t inputSize, uint8_t* output)
+{
+	size_t consumed = 0;
+	while (inputSize - consumed >= 16)
+	{
+		auto in = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + consumed));
+		__m128i values;
+		if (!decodeLookup (in, values))
+			break;
+		store12 (output, decodePack (values));
+		output += 12;
+		consumed += 16;
+	}
+	return consumed;
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+inline size_t encodeAVX2 (const uint8_t* input, size_t inputSize, uint8_t* output)
+{
+	size_t consumed = 0;
+	// the second 16 byte load starts at offset 12 and reads 4 bytes beyond the 24 bytes encoded
+	while (inputSize - consumed >= 28)
+	{
+		auto lo = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + consumed));
+		auto hi = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (input + consumed + 12));
+		auto in = _mm256_inserti128_si256 (_mm256_castsi128_si256 (lo), hi, 1);
+		in = _mm256_shuffle_epi8 (in, _mm256_set_epi8 (10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1,
+													   2, 0, 1, 10, 11, 9, 10, 7, 8, 6, 7, 4, 5,
+													   3, 4, 1, 2, 0, 1));
+		auto t0 = _mm256_and_si256 (in, _mm256_set1_epi32 (0x0fc0fc00));
+		auto t1 = _mm256_mulhi_epu16 (t0, _mm256_set1_epi32 (0x04000040));
+		auto t2 = _mm256_and_si256 (in, _mm256_set1_epi32 (0x003f03f0));
+		auto t3 = _mm256_mullo_epi16 (t2, _mm256_set1_epi32 (0x01000010));
+		auto values = _mm256_or_si256 (t1, t3);
+
+		auto index = _mm256_subs_epu8 (values, _mm256_set1_epi8 (51));
+		auto less = _mm256_cmpgt_epi8 (_mm256_set1_epi8 (26), values);
+		index = _mm256_or_si256 (index, _mm256_and_si256 (less, _mm256_set1_epi8 (13)));
+		const auto offsets = _mm256_setr_epi8 (
+			'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0, 'a' - 26, '0' - 52,
+			'0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+			'0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+		auto out = _mm256_add_epi8 (_mm256_shuffle_epi8 (offsets, index), values);
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (output), out);
+		output += 32;
+		consumed += 24;
+	}
+	return consumed + encodeSSSE3 (input + consumed, inputSize - consumed, output);
+}
+
+//------------------------------------------------------------------------
+VSTGUI_SIMD_TARGET ("avx2")
+inline size_t decodeAVX2 (const uint8_t* input, size_t inputSize, uint8_t* output)
+{
+	const auto shiftLUT = _mm256_setr_epi8 (0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0,
+											0, 0, 0, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0,
+											0, 0);
+	const auto maskLUT = _mm256_setr_epi8 (
+		static_cast<char> (0xa8), static_cast<char> (0xf8), static_cast<char> (0xf8),
+		static_cast<char> (0xf8), static_cast<char> (0xf8), static_cast<char> (0xf8),
+		static_cast<char> (0xf8), static_cast<char> (0xf8), static_cast<char> (0xf8),
+		static_cast<char> (0xf8), static_cast<char> (0xf0), 0x54, 0x50, 0x50, 0x50, 0x54,
+		static_cast<char> (0xa8), static_cast<char> (0xf8), static_cast<char> (0xf8),
+		static_cast<char> (0xf8), static_cast<char> (0xf8), static_cast<char> (0xf8),
+		static_cast<char> (0xf8), static_cast<char> (0xf8), static_cast<char> (0xf8),
+		static_cast<char> (0xf8), static_cast<char> (0xf0), 0x54, 0x50, 0x50, 0x50, 0x54);
+	const auto bitPosLUT = _mm256_setr_epi8 (
+		0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char> (0x80), 0, 0, 0, 0, 0, 0, 0,
+		0, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, static_cast<char> (0x80), 0, 0, 0, 0, 0, 0,
+		0, 0);
+	const auto packShuffle =
+		_mm256_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5,
+						  4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+	size_t consumed = 0;
+	while (inputSize - consumed >= 32)
+	{
+		auto in = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (input + consumed));
+		auto higherNibble = _mm256_and_si256 (_mm256_srli_epi32 (in, 4), _mm256_set1_epi8 (0x0f));
+		auto lowerNibble = _mm256_and_si256 (in, _mm256_set1_epi8 (0x0f));
+		auto mask = _mm256_shuffle_epi8 (maskLUT, lowerNibble);
+		auto bit = _mm256_shuffle_epi8 (bitPosLUT, higherNibble);
+		auto invalid = _mm256_cmpeq_epi8 (_mm256_and_si256 (mask, bit), _mm256_setzero_si256 ());
+		if (_mm256_movemask_epi8 (invalid))
+			break;
+		auto shift = _mm256_shuffle_epi8 (shiftLUT, higherNibble);
+		auto isSlash = _mm256_cmpeq_epi8 (in, _mm256_set1_epi8 ('/'));
+		shift = _mm256_sub_epi8 (shift, _mm256_and_si256 (isSlash, _mm256_set1_epi8 (3)));
+		auto values = _mm256_add_epi8 (in, shift);
+
+		auto mergedPairs = _mm256_maddubs_epi16 (values, _mm256_set1_epi32 (0x01400140));
+		auto merged = _mm256_madd_epi16 (mergedPairs, _mm256_set1_epi32 (0x00011000));
+		auto packed = _mm256_shuffle_epi8 (merged, packShuffle);
+		store12 (output, _mm256_castsi256_si128 (packed));
+		store12 (output + 12, _mm256_extracti128_si256 (packed, 1));
+		output += 24;
+		consumed += 32;
+	}
+	return consumed + decodeSSSE3 (input + consumed, inputSize - consumed, output);
+}
+
+#endif // VSTGUI_BASE64_SIMD
+
+//------------------------------------------------------------------------
+} // Base64SIMD
+} // Detail
+} // VSTGUI
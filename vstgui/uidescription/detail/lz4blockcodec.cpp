@@ -0,0 +1,213 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "lz4blockcodec.h"
+#include <cstring>
+#include <memory>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+namespace LZ4Block {
+namespace {
+
+//------------------------------------------------------------------------
+constexpr size_t kMinMatch = 4;
+// the last match must start at least 12 bytes before the end and the last 5 bytes are literals
+constexpr size_t kMatchFindLimit = 12;
+constexpr size_t kLastLiterals = 5;
+constexpr size_t kMaxOffset = 65535;
+constexpr uint32_t kHashLog = 14;
+
+//------------------------------------------------------------------------
+inline uint32_t read32 (const uint8_t* ptr)
+{
+	uint32_t value;
+	std::memcpy (&value, ptr, sizeof (value));
+	return value;
+}
+
+//------------------------------------------------------------------------
+inline uint32_t hash (uint32_t sequence)
+{
+	return (sequence * 2654435761u) >> (32 - kHashLog);
+}
+
+//------------------------------------------------------------------------
+/** writes the extra bytes of a length not fitting into the 4 bits of the token */
+inline uint8_t* writeLength (uint8_t* output, size_t length)
+{
+	for (; length >= 255; length -= 255)
+		*output++ = 255;
+	*output++ = static_cast<uint8_t> (length);
+	return output;
+}
+
+//------------------------------------------------------------------------
+/** upper bound for the bytes a sequence needs in the output */
+inline size_t sequenceSize (size_t numLiterals)
+{
+	return 1 + numLiterals / 255 + 1 + numLiterals + 2;
+}
+
+//------------------------------------------------------------------------
+inline bool readLength (const uint8_t*& input, const uint8_t* inputEnd, size_t& length)
+{
+	uint8_t value;
+	do
+	{
+		if (input == inputEnd)
+			return false;
+		value = *input++;
+		length += value;
+	} while (value == 255);
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+size_t getMaxCompressedSize (size_t inputSize)
+{
+	return inputSize + inputSize / 255 + 16;
+}
+
+//------------------------------------------------------------------------
+size_t compress (const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputCapacity)
+{
+	auto outputStart = output;
+	auto outputEnd = output + outputCapacity;
+	auto anchor = input;
+	auto inputEnd = input + inputSize;
+
+	if (inputSize > kMatchFindLimit)
+	{
+		// positions of the last occurrence of a hashed 4 byte sequence, relative to input
+		std::unique_ptr<uint32_t[]> table (new uint32_t[1u << kHashLog] ());
+		auto matchFindLimit = inputEnd - kMatchFindLimit;
+		auto matchLimit = inputEnd - kLastLiterals;
+		auto ip = input + 1;
+		while (ip < matchFindLimit)
+		{
+			auto sequence = read32 (ip);
+			auto& entry = table[hash (sequence)];
+			auto ref = input + entry;
+			entry = static_cast<uint32_t> (ip - input);
+			if (ref >= ip || static_cast<size_t> (ip - ref) > kMaxOffset || read32 (ref) != sequence)
+			{
+				// skip faster through data which does not compress
+				ip += 1 + ((ip - anchor) >> 6);
+				continue;
+			}
+			while (ip > anchor && ref > input && ip[-1] == ref[-1])
+			{
+				--ip;
+				--ref;
+			}
+			auto matchLength = kMinMatch;
+			while (ip + matchLength < matchLimit && ip[matchLength] == ref[matchLength])
+				++matchLength;
+
+			auto numLiterals = static_cast<size_t> (ip - anchor);
+			if (static_cast<size_t> (outputEnd - output) <
+				sequenceSize (numLiterals) + (matchLength - kMinMatch) / 255 + 1)
+				return 0;
+			auto token = output++;
+			*token = static_cast<uint8_t> ((numLiterals < 15 ? numLiterals : 15) << 4);
+			if (numLiterals >= 15)
+				output = writeLength (output, numLiterals - 15);
+			std::memcpy (output, anchor, numLiterals);
+			output += numLiterals;
+			auto offset = static_cast<uint16_t> (ip - ref);
+			*output++ = static_cast<uint8_t> (offset & 0xff);
+			*output++ = static_cast<uint8_t> (offset >> 8);
+			auto extraLength = matchLength - kMinMatch;
+			*token |= static_cast<uint8_t> (extraLength < 15 ? extraLength : 15);
+			if (extraLength >= 15)
+				output = writeLength (output, extraLength - 15);
+
+			ip += matchLength;
+			anchor = ip;
+			if (ip < matchFindLimit)
+				table[hash (read32 (ip - 2))] = static_cast<uint32_t> (ip - 2 - input);
+		}
+	}
+
+	auto numLiterals = static_cast<size_t> (inputEnd - anchor);
+	if (static_cast<size_t> (outputEnd - output) < sequenceSize (numLiterals))
+		return 0;
+	*output++ = static_cast<uint8_t> ((numLiterals < 15 ? numLiterals : 15) << 4);
+	if (numLiterals >= 15)
+		output = writeLength (output, numLiterals - 15);
+	if (numLiterals)
+		std::memcpy (output, anchor, numLiterals);
+	output += numLiterals;
+	return static_cast<size_t> (output - outputStart);
+}
+
+//------------------------------------------------------------------------
+bool decompress (const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize)
+{
+	auto inputEnd = input + inputSize;
+	auto outputStart = output;
+	auto outputEnd = output + outputSize;
+	while (input < inputEnd)
+	{
+		auto token = *input++;
+		size_t numLiterals = token >> 4;
+		if (numLiterals == 15 && !readLength (input, inputEnd, numLiterals))
+			return false;
+		if (numLiterals > static_cast<size_t> (inputEnd - input) ||
+			numLiterals > static_cast<size_t> (outputEnd - output))
+			return false;
+		if (numLiterals)
+			std::memcpy (output, input, numLiterals);
+		input += numLiterals;
+		output += numLiterals;
+		// the last sequence has no match
+		if (input == inputEnd)
+			break;
+
+		if (inputEnd - input < 2)
+			return false;
+		size_t offset = input[0] | (input[1] << 8);
+		input += 2;
+		if (offset == 0 || offset > static_cast<size_t> (output - outputStart))
+			return false;
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !readLength (input, inputEnd, matchLength))
+			return false;
+		matchLength += kMinMatch;
+		if (matchLength > static_cast<size_t> (outputEnd - output))
+			return false;
+
+		auto match = output - offset;
+		if (offset >= matchLength)
+		{
+			std::memcpy (output, match, matchLength);
+			output += matchLength;
+		}
+		else if (offset >= 8)
+		{
+			// overlapping, but every 8 byte piece is already complete when it is copied
+			auto matchEnd = output + matchLength;
+			for (; matchEnd - output >= 8; output += 8, match += 8)
+				std::memcpy (output, match, 8);
+			while (output < matchEnd)
+				*output++ = *match++;
+		}
+		else
+		{
+			for (size_t i = 0; i < matchLength; ++i)
+				*output++ = *match++;
+		}
+	}
+	return output == outputEnd;
+}
+
+//------------------------------------------------------------------------
+} // LZ4Block
+} // Detail
+} // VSTGUI
@@ -0,0 +1,35 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+namespace LZ4Block {
+
+//------------------------------------------------------------------------
+/** Compressor and decompressor for the LZ4 block format
+ *
+ *	A small in-tree implementation of the block format only (no frame format), trading compression
+ *	ratio for decompression speed. The decompressor checks all bounds, so corrupt input fails
+ *	instead of reading or writing outside of the buffers.
+ */
+
+/** the output buffer size compress needs in the worst case */
+size_t getMaxCompressedSize (size_t inputSize);
+
+/** returns the compressed size or 0 if the output buffer is too small */
+size_t compress (const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputCapacity);
+
+/** returns false if the input is corrupt or does not decompress to exactly outputSize bytes */
+bool decompress (const uint8_t* input, size_t inputSize, uint8_t* output, size_t outputSize);
+
+//------------------------------------------------------------------------
+} // LZ4Block
+} // Detail
+} // VSTGUI
@@ -0,0 +1,130 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../lib/vstguibase.h"
+#include <cstddef>
+#include <string>
+
+#if WINDOWS
+struct IUnknown;
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+/** Read only memory mapping of a whole file */
+class MemoryMappedFile
+{
+public:
+	MemoryMappedFile () = default;
+	MemoryMappedFile (const MemoryMappedFile&) = delete;
+	MemoryMappedFile& operator= (const MemoryMappedFile&) = delete;
+	~MemoryMappedFile () noexcept { close (); }
+
+	bool open (UTF8StringPtr path);
+	void close ();
+
+	const void* data () const { return address; }
+	size_t size () const { return mappedSize; }
+
+private:
+	const void* address {nullptr};
+	size_t mappedSize {0};
+#if WINDOWS
+	HANDLE mapping {nullptr};
+#endif
+};
+
+#if WINDOWS
+//------------------------------------------------------------------------
+inline bool MemoryMappedFile::open (UTF8StringPtr path)
+{
+	close ();
+	auto numChars = MultiByteToWideChar (CP_UTF8, 0, path, -1, nullptr, 0);
+	if (numChars <= 0)
+		return false;
+	std::wstring widePath (static_cast<size_t> (numChars), 0);
+	MultiByteToWideChar (CP_UTF8, 0, path, -1, &widePath[0], numChars);
+	auto file = CreateFileW (widePath.data (), GENERIC_READ, FILE_SHARE_READ, nullptr,
+							 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER fileSize {};
+	if (GetFileSizeEx (file, &fileSize) && fileSize.QuadPart > 0)
+	{
+		mapping = CreateFileMappingW (file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping)
+		{
+			address = MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0);
+			if (address)
+				mappedSize = static_cast<size_t> (fileSize.QuadPart);
+			else
+			{
+				CloseHandle (mapping);
+				mapping = nullptr;
+			}
+		}
+	}
+	CloseHandle (file);
+	return address != nullptr;
+}
+
+//------------------------------------------------------------------------
+inline void MemoryMappedFile::close ()
+{
+	if (address)
+		UnmapViewOfFile (address);
+	if (mapping)
+		CloseHandle (mapping);
+	address = nullptr;
+	mapping = nullptr;
+	mappedSize = 0;
+}
+
+#else
+//------------------------------------------------------------------------
+inline bool MemoryMappedFile::open (UTF8StringPtr path)
+{
+	close ();
+	auto fd = ::open (path, O_RDONLY);
+	if (fd < 0)
+		return false;
+	struct stat fileStat {};
+	if (fstat (fd, &fileStat) == 0 && fileStat.st_size > 0)
+	{
+		auto size = static_cast<size_t> (fileStat.st_size);
+		auto ptr = mmap (nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (ptr != MAP_FAILED)
+		{
+			address = ptr;
+			mappedSize = size;
+		}
+	}
+	::close (fd);
+	return address != nullptr;
+}
+
+//------------------------------------------------------------------------
+inline void MemoryMappedFile::close ()
+{
+	if (address)
+		munmap (const_cast<void*> (address), mappedSize);
+	address = nullptr;
+	mappedSize = 0;
+}
+#endif
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
@@ -0,0 +1,482 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "uibinarypersistence.h"
+#include "../../lib/cpoint.h"
+#include "../../lib/crect.h"
+#include "../base64codec.h"
+#include "../uiattributes.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+using namespace UIBinaryDesc;
+
+static_assert (sizeof (Header) == 72, "unexpected header size");
+static_assert (sizeof (StringEntry) == 16, "unexpected string entry size");
+static_assert (sizeof (NodeEntry) == 24, "unexpected node entry size");
+static_assert (sizeof (AttributeEntry) == 48, "unexpected attribute entry size");
+static_assert (sizeof (BlobEntry) == 16, "unexpected blob entry size");
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescReader {
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+struct Reader
+{
+	const uint8_t* data;
+	const Header& header;
+	const StringEntry* strings;
+	const NodeEntry* nodes;
+	const AttributeEntry* attributes;
+	const BlobEntry* blobs;
+
+	bool validateStrings () const
+	{
+		for (auto i = 0u; i < header.numStrings; ++i)
+		{
+			const auto& entry = strings[i];
+			if (entry.offset >= header.fileSize || header.fileSize - entry.offset <= entry.size)
+				return false;
+			if (data[entry.offset + entry.size] != 0)
+				return false;
+		}
+		return true;
+	}
+
+	bool validateBlobs () const
+	{
+		for (auto i = 0u; i < header.numBlobs; ++i)
+		{
+			const auto& entry = blobs[i];
+			if (entry.offset > header.fileSize || header.fileSize - entry.offset < entry.size)
+				return false;
+		}
+		return true;
+	}
+
+	mutable std::vector<UIAttributeName> attributeNames;
+
+	bool isValidString (uint32_t index) const { return index < header.numStrings; }
+
+	UIAttributeName attributeName (uint32_t index) const
+	{
+		if (attributeNames.empty ())
+			attributeNames.resize (header.numStrings);
+		auto& name = attributeNames[index];
+		if (!name.isValid ())
+			name = UIAttributeName (string (index));
+		return name;
+	}
+
+	static UIAttributes::CachedValue cachedValue (const AttributeEntry& attribute)
+	{
+		using Type = UIAttributes::CachedValue::Type;
+		UIAttributes::CachedValue result;
+		switch (attribute.type)
+		{
+			case AttributeType::Number: result.type = Type::Double; break;
+			case AttributeType::Point: result.type = Type::Point; break;
+			case AttributeType::Rect: result.type = Type::Rect; break;
+			default: return result;
+		}
+		result.valid = true;
+		std::copy (std::begin (attribute.values), std::end (attribute.values), result.values);
+		return result;
+	}
+
+	std::string string (uint32_t index) const
+	{
+		const auto& entry = strings[index];
+		return {reinterpret_cast<const char*> (data + entry.offset), entry.size};
+	}
+
+	UINode* createNode (const NodeEntry& entry) const
+	{
+		if (!isValidString (entry.name) || entry.firstAttribute > header.numAttributes ||
+			header.numAttributes - entry.firstAttribute < entry.numAttributes)
+			return nullptr;
+
+		auto attrs = makeOwned<UIAttributes> (static_cast<size_t> (entry.numAttributes));
+		for (auto i = 0u; i < entry.numAttributes; ++i)
+		{
+			const auto& attribute = attributes[entry.firstAttribute + i];
+			if (!isValidString (attribute.key) || !isValidString (attribute.value))
+				return nullptr;
+			attrs->setAttribute (attributeName (attribute.key), string (attribute.value),
+								 cachedValue (attribute));
+		}
+
+		UINode::DataStorage nodeData;
+		if (entry.data != kInvalidIndex)
+		{
+			if (entry.flags & NodeEntry::kDataIsBlob)
+			{
+				if (entry.data >= header.numBlobs)
+					return nullptr;
+				const auto& blob = blobs[entry.data];
+				nodeData.assign (reinterpret_cast<const char*> (data + blob.offset),
+								 static_cast<size_t> (blob.size));
+			}
+			else if (isValidString (entry.data))
+				nodeData = string (entry.data);
+			else
+				return nullptr;
+		}
+
+		auto name = string (entry.name);
+		UINode* node = nullptr;
+		switch (entry.kind)
+		{
+			case NodeKind::Generic: node = new UINode (name, attrs); break;
+			case NodeKind::GenericFastLookup: node = new UINode (name, attrs, true); break;
+			case NodeKind::Bitmap: node = new UIBitmapNode (name, attrs); break;
+			case NodeKind::Font: node = new UIFontNode (name, attrs); break;
+			case NodeKind::Color: node = new UIColorNode (name, attrs); break;
+			case NodeKind::ControlTag: node = new UIControlTagNode (name, attrs); break;
+			case NodeKind::Variable: node = new UIVariableNode (name, attrs); break;
+			case NodeKind::Gradient: node = new UIGradientNode (name, attrs); break;
+			case NodeKind::Comment: return new UICommentNode (nodeData);
+			default: return nullptr;
+		}
+		if (!nodeData.empty ())
+			node->setData (std::move (nodeData));
+		return node;
+	}
+
+	SharedPointer<UINode> createTree () const
+	{
+		struct StackEntry
+		{
+			UINode* node;
+			uint32_t remainingChildren;
+		};
+		std::vector<StackEntry> stack;
+		SharedPointer<UINode> root;
+		for (auto i = 0u; i < header.numNodes; ++i)
+		{
+			if (i > 0 && stack.empty ())
+				return nullptr;
+			const auto& entry = nodes[i];
+			auto node = createNode (entry);
+			if (!node)
+				return nullptr;
+			if (stack.empty ())
+				root = owned (node);
+			else
+			{
+				stack.back ().node->getChildren ().add (node);
+				--stack.back ().remainingChildren;
+			}
+			if (entry.numChildren > 0)
+				stack.push_back ({node, entry.numChildren});
+			while (!stack.empty () && stack.back ().remainingChildren == 0)
+				stack.pop_back ();
+		}
+		if (!stack.empty ())
+			return nullptr;
+		return root;
+	}
+};
+
+//------------------------------------------------------------------------
+bool isValidTable (const Header& header, uint64_t offset, uint64_t count, uint64_t entrySize)
+{
+	if (offset % 8 != 0 || offset > header.fileSize)
+		return false;
+	return (header.fileSize - offset) / entrySize >= count;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+bool isBinary (const void* data, size_t size)
+{
+	if (size < sizeof (uint64_t))
+		return false;
+	uint64_t identifier;
+	memcpy (&identifier, data, sizeof (identifier));
+	return identifier == kIdentifier;
+}
+
+//------------------------------------------------------------------------
+SharedPointer<UINode> read (const void* data, size_t size)
+{
+	if (kNativeByteOrder != kLittleEndianByteOrder)
+		return nullptr;
+	if (size < sizeof (Header) || !isBinary (data, size) ||
+		reinterpret_cast<uintptr_t> (data) % alignof (Header) != 0)
+		return nullptr;
+	const auto& header = *reinterpret_cast<const Header*> (data);
+	if (header.version != kVersion || header.headerSize < sizeof (Header) ||
+		header.fileSize > size)
+		return nullptr;
+	if (!isValidTable (header, header.stringTableOffset, header.numStrings, sizeof (StringEntry)) ||
+		!isValidTable (header, header.nodeTableOffset, header.numNodes, sizeof (NodeEntry)) ||
+		!isValidTable (header, header.attributeTableOffset, header.numAttributes,
+					   sizeof (AttributeEntry)) ||
+		!isValidTable (header, header.blobTableOffset, header.numBlobs, sizeof (BlobEntry)))
+		return nullptr;
+
+	auto bytes = static_cast<const uint8_t*> (data);
+	Reader reader {bytes,
+				   header,
+				   reinterpret_cast<const StringEntry*> (bytes + header.stringTableOffset),
+				   reinterpret_cast<const NodeEntry*> (bytes + header.nodeTableOffset),
+				   reinterpret_cast<const AttributeEntry*> (bytes + header.attributeTableOffset),
+				   reinterpret_cast<const BlobEntry*> (bytes + header.blobTableOffset)};
+	if (!reader.validateStrings () || !reader.validateBlobs ())
+		return nullptr;
+	return reader.createTree ();
+}
+
+//------------------------------------------------------------------------
+SharedPointer<UINode> read (IContentProvider& contentProvider)
+{
+	uint64_t identifier = 0;
+	auto numRead = contentProvider.readRawData (reinterpret_cast<int8_t*> (&identifier),
+												sizeof (identifier));
+	if (numRead != sizeof (identifier) || identifier != kIdentifier)
+	{
+		contentProvider.rewind ();
+		return nullptr;
+	}
+	// uint64_t storage keeps the tables aligned
+	std::vector<uint64_t> buffer (1);
+	buffer[0] = identifier;
+	constexpr uint32_t kChunkSize = 64 * 1024;
+	size_t size = sizeof (identifier);
+	while (true)
+	{
+		buffer.resize ((size + kChunkSize) / sizeof (uint64_t) + 1);
+		numRead = contentProvider.readRawData (
+			reinterpret_cast<int8_t*> (buffer.data ()) + size, kChunkSize);
+		if (numRead == 0 || numRead == kStreamIOError)
+			break;
+		size += numRead;
+	}
+	return read (buffer.data (), size);
+}
+
+//------------------------------------------------------------------------
+} // UIBinaryDescReader
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescWriter {
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+struct Writer
+{
+	std::vector<StringEntry> strings;
+	std::vector<NodeEntry> nodes;
+	std::vector<AttributeEntry> attributes;
+	std::vector<BlobEntry> blobs;
+	std::string stringData;
+	std::string blobData;
+	std::unordered_map<std::string, uint32_t> stringIndices;
+
+	uint32_t intern (const std::string& str)
+	{
+		auto it = stringIndices.find (str);
+		if (it != stringIndices.end ())
+			return it->second;
+		auto index = static_cast<uint32_t> (strings.size ());
+		strings.push_back ({stringData.size (), static_cast<uint32_t> (str.size ()), 0});
+		stringData.append (str);
+		stringData.push_back (0);
+		stringIndices.emplace (str, index);
+		return index;
+	}
+
+	uint32_t addBlob (const void* data, size_t size)
+	{
+		auto index = static_cast<uint32_t> (blobs.size ());
+		blobs.push_back ({blobData.size (), size});
+		blobData.append (static_cast<const char*> (data), size);
+		blobData.resize ((blobData.size () + 7) & ~static_cast<size_t> (7));
+		return index;
+	}
+
+	static NodeKind nodeKind (UINode* node)
+	{
+		if (dynamic_cast<UIBitmapNode*> (node))
+			return NodeKind::Bitmap;
+		if (dynamic_cast<UIFontNode*> (node))
+			return NodeKind::Font;
+		if (dynamic_cast<UIColorNode*> (node))
+			return NodeKind::Color;
+		if (dynamic_cast<UIControlTagNode*> (node))
+			return NodeKind::ControlTag;
+		if (dynamic_cast<UIVariableNode*> (node))
+			return NodeKind::Variable;
+		if (dynamic_cast<UIGradientNode*> (node))
+			return NodeKind::Gradient;
+		if (dynamic_cast<UICommentNode*> (node))
+			return NodeKind::Comment;
+		if (dynamic_cast<UIDescListWithFastFindAttributeNameChild*> (&node->getChildren ()))
+			return NodeKind::GenericFastLookup;
+		return NodeKind::Generic;
+	}
+
+	void addAttribute (const std::string& key, const std::string& value)
+	{
+		// colors are not pre-parsed, they are resolved by name via the UI description
+		AttributeEntry entry {intern (key), intern (value), AttributeType::String, 0, {}};
+		CPoint point;
+		CRect rect;
+		if (UIAttributes::stringToDouble (value, entry.values[0]))
+			entry.type = AttributeType::Number;
+		else if (UIAttributes::stringToPoint (value, point))
+		{
+			entry.type = AttributeType::Point;
+			entry.values[0] = point.x;
+			entry.values[1] = point.y;
+		}
+		else if (UIAttributes::stringToRect (value, rect))
+		{
+			entry.type = AttributeType::Rect;
+			entry.values[0] = rect.left;
+			entry.values[1] = rect.top;
+			entry.values[2] = rect.right;
+			entry.values[3] = rect.bottom;
+		}
+		attributes.push_back (entry);
+	}
+
+	void addNode (UINode* node, NodeKind parentKind)
+	{
+		auto nodeIndex = nodes.size ();
+		nodes.push_back ({intern (node->getName ()), nodeKind (node), 0, 0, 0, 0, kInvalidIndex});
+
+		const auto& data = node->getData ();
+		auto isBitmapData = parentKind == NodeKind::Bitmap && node->getName () == "data";
+		auto encoding = node->getAttributes ()->getAttributeValue ("encoding");
+		auto firstAttribute = static_cast<uint32_t> (attributes.size ());
+		for (const auto& attr : *node->getAttributes ())
+		{
+			if (isBitmapData && attr.first == "encoding")
+				continue;
+			addAttribute (attr.first, attr.second);
+		}
+		if (isBitmapData && encoding && (*encoding == "base64" || *encoding == "binary"))
+		{
+			addAttribute ("encoding", "binary");
+			if (*encoding == "base64")
+			{
+				auto result = Base64Codec::decode (data);
+				nodes[nodeIndex].data = addBlob (result.data.get (), result.dataSize);
+			}
+			else
+				nodes[nodeIndex].data = addBlob (data.data (), data.size ());
+			nodes[nodeIndex].flags = NodeEntry::kDataIsBlob;
+		}
+		else
+		{
+			if (encoding && isBitmapData)
+				addAttribute ("encoding", *encoding);
+			if (!data.empty ())
+				nodes[nodeIndex].data = intern (data);
+		}
+		nodes[nodeIndex].firstAttribute = firstAttribute;
+		nodes[nodeIndex].numAttributes = static_cast<uint32_t> (attributes.size ()) - firstAttribute;
+
+		uint32_t numChildren = 0;
+		auto kind = nodes[nodeIndex].kind;
+		for (auto& child : node->getChildren ())
+		{
+			if (child->noExport ())
+				continue;
+			addNode (child, kind);
+			++numChildren;
+		}
+		nodes[nodeIndex].numChildren = numChildren;
+	}
+
+	template<typename T>
+	static bool writeTable (OutputStream& stream, const std::vector<T>& table)
+	{
+		return writeBytes (stream, table.data (), table.size () * sizeof (T));
+	}
+
+	static bool writeBytes (OutputStream& stream, const void* data, size_t size)
+	{
+		auto ptr = static_cast<const uint8_t*> (data);
+		while (size > 0)
+		{
+			auto chunk = static_cast<uint32_t> (std::min<size_t> (size, 0x40000000));
+			if (stream.writeRaw (ptr, chunk) != chunk)
+				return false;
+			ptr += chunk;
+			size -= chunk;
+		}
+		return true;
+	}
+
+	bool write (OutputStream& stream)
+	{
+		stringData.resize ((stringData.size () + 7) & ~static_cast<size_t> (7));
+
+		Header header {};
+		header.identifier = kIdentifier;
+		header.version = kVersion;
+		header.headerSize = sizeof (Header);
+		header.numStrings = static_cast<uint32_t> (strings.size ());
+		header.numNodes = static_cast<uint32_t> (nodes.size ());
+		header.numAttributes = static_cast<uint32_t> (attributes.size ());
+		header.numBlobs = static_cast<uint32_t> (blobs.size ());
+		header.stringTableOffset = sizeof (Header);
+		header.nodeTableOffset = header.stringTableOffset + strings.size () * sizeof (StringEntry);
+		header.attributeTableOffset = header.nodeTableOffset + nodes.size () * sizeof (NodeEntry);
+		header.blobTableOffset =
+			header.attributeTableOffset + attributes.size () * sizeof (AttributeEntry);
+		auto stringDataOffset = header.blobTableOffset + blobs.size () * sizeof (BlobEntry);
+		auto blobDataOffset = stringDataOffset + stringData.size ();
+		header.fileSize = blobDataOffset + blobData.size ();
+
+		for (auto& entry : strings)
+			entry.offset += stringDataOffset;
+		for (auto& entry : blobs)
+			entry.offset += blobDataOffset;
+
+		return writeBytes (stream, &header, sizeof (header)) && writeTable (stream, strings) &&
+			   writeTable (stream, nodes) && writeTable (stream, attributes) &&
+			   writeTable (stream, blobs) &&
+			   writeBytes (stream, stringData.data (), stringData.size ()) &&
+			   writeBytes (stream, blobData.data (), blobData.size ());
+	}
+};
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+bool write (OutputStream& stream, UINode* rootNode)
+{
+	if (kNativeByteOrder != kLittleEndianByteOrder || rootNode == nullptr)
+		return false;
+	Writer writer;
+	writer.addNode (rootNode, NodeKind::Generic);
+	return writer.write (stream);
+}
+
+//------------------------------------------------------------------------
+} // UIBinaryDescWriter
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
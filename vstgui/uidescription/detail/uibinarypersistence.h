@@ -0,0 +1,143 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../cstream.h"
+#include "../icontentprovider.h"
+#include "uinode.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+/** Precompiled binary UI description format
+ *
+ *	The node tree is stored as flat tables which can be used directly from a memory mapped file:
+ *	a string table of interned zero terminated strings, the nodes in pre-order, their attributes
+ *	with a pre-parsed numeric, point or rect value next to the string value, and raw
+ *	bitmap data blobs which are stored decoded instead of base64 encoded. The pre-parsed values are
+ *	handed to UIAttributes as cached values, so the view creators do not parse them again.
+ *	All values are stored in little endian byte order.
+ */
+namespace UIBinaryDesc {
+
+//------------------------------------------------------------------------
+static constexpr uint64_t kIdentifier = 0x6e62637365646975ULL; // "uidescbn"
+static constexpr uint32_t kVersion = 1;
+static constexpr uint32_t kInvalidIndex = 0xffffffff;
+
+//------------------------------------------------------------------------
+struct Header
+{
+	uint64_t identifier;
+	uint32_t version;
+	uint32_t headerSize;
+	uint32_t numStrings;
+	uint32_t numNodes;
+	uint32_t numAttributes;
+	uint32_t numBlobs;
+	uint64_t stringTableOffset;
+	uint64_t nodeTableOffset;
+	uint64_t attributeTableOffset;
+	uint64_t blobTableOffset;
+	uint64_t fileSize;
+};
+
+//------------------------------------------------------------------------
+struct StringEntry
+{
+	uint64_t offset;
+	uint32_t size; // without the terminating zero
+	uint32_t reserved;
+};
+
+//------------------------------------------------------------------------
+enum class NodeKind : uint16_t
+{
+	Generic,
+	GenericFastLookup,
+	Bitmap,
+	Font,
+	Color,
+	ControlTag,
+	Variable,
+	Gradient,
+	Comment,
+};
+
+//------------------------------------------------------------------------
+struct NodeEntry
+{
+	enum Flags : uint16_t
+	{
+		kDataIsBlob = 1 << 0,
+	};
+
+	uint32_t name;
+	NodeKind kind;
+	uint16_t flags;
+	uint32_t firstAttribute;
+	uint32_t numAttributes;
+	uint32_t numChildren;
+	uint32_t data; // string or blob index, kInvalidIndex if the node has no data
+};
+
+//------------------------------------------------------------------------
+enum class AttributeType : uint32_t
+{
+	String,
+	Number,
+	Point,
+	Rect,
+};
+
+//------------------------------------------------------------------------
+struct AttributeEntry
+{
+	uint32_t key;
+	uint32_t value;
+	AttributeType type;
+	uint32_t reserved;
+	double values[4]; // number: [0], point: x, y, rect: left, top, right, bottom
+};
+
+//------------------------------------------------------------------------
+struct BlobEntry
+{
+	uint64_t offset;
+	uint64_t size;
+};
+
+//------------------------------------------------------------------------
+} // UIBinaryDesc
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescReader {
+
+//------------------------------------------------------------------------
+/** check if data starts with a binary UI description header */
+bool isBinary (const void* data, size_t size);
+/** read a binary UI description from memory, returns nullptr if the data is not valid */
+SharedPointer<UINode> read (const void* data, size_t size);
+/** read a binary UI description from a content provider, the content provider is rewound if it
+ *	does not contain a binary UI description */
+SharedPointer<UINode> read (IContentProvider& contentProvider);
+
+//------------------------------------------------------------------------
+} // UIBinaryDescReader
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescWriter {
+
+//------------------------------------------------------------------------
+bool write (OutputStream& stream, UINode* rootNode);
+
+//------------------------------------------------------------------------
+} // UIBinaryDescWriter
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
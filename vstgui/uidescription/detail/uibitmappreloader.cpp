@@ -0,0 +1,189 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "uibitmappreloader.h"
+#include "../../lib/cresourcedescription.h"
+#include "../../lib/parallelfor.h"
+#include "../../lib/platform/iplatformbitmap.h"
+#include "../../lib/platform/platformfactory.h"
+#include "../base64codec.h"
+#include "../cstream.h"
+#include "../uiattributes.h"
+#include <algorithm>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+UIBitmapPreloader::UIBitmapPreloader (Requests&& requests, const std::string& pathHint,
+									  ProgressFunc&& progress)
+: pathHint (pathHint), progress (std::move (progress))
+{
+	entries.reserve (requests.size ());
+	for (auto& request : requests)
+	{
+		entries.emplace_back (std::unique_ptr<Entry> (new Entry));
+		entries.back ()->request = std::move (request);
+		entryMap.emplace (entries.back ()->request.node, entries.back ().get ());
+	}
+	startTime = Clock::now ();
+	if (entries.empty ())
+		return;
+	auto numTasks = std::min (getParallelForConcurrency (), entries.size ());
+	numRunningTasks = numTasks;
+	for (size_t i = 0; i < numTasks; ++i)
+	{
+		scheduleBackgroundTask ([this] () {
+			run ();
+			std::lock_guard<std::mutex> guard (mutex);
+			if (--numRunningTasks == 0)
+				doneCondition.notify_all ();
+		});
+	}
+}
+
+//------------------------------------------------------------------------
+UIBitmapPreloader::~UIBitmapPreloader () noexcept
+{
+	cancel = true;
+	wait ();
+}
+
+//------------------------------------------------------------------------
+void UIBitmapPreloader::wait ()
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	doneCondition.wait (lock, [this] () { return numRunningTasks == 0; });
+}
+
+//------------------------------------------------------------------------
+PlatformBitmapPtr UIBitmapPreloader::take (const UIBitmapNode* node, const std::string& path)
+{
+	auto it = entryMap.find (node);
+	if (it == entryMap.end ())
+		return nullptr;
+	auto& entry = *it->second;
+	uint32_t state = kReady;
+	if (entry.state.compare_exchange_strong (state, kTaken))
+	{
+		auto bitmap = std::move (entry.bitmap);
+		// the path was changed after the preload was started
+		if (entry.request.path != path)
+			return nullptr;
+		return bitmap;
+	}
+	if (state == kPending && entry.state.compare_exchange_strong (state, kTaken))
+		++numSkipped;
+	return nullptr;
+}
+
+//------------------------------------------------------------------------
+UIBitmapPreloadStatistics UIBitmapPreloader::getStatistics () const
+{
+	using Ms = std::chrono::duration<double, std::milli>;
+	UIBitmapPreloadStatistics statistics;
+	statistics.numBitmaps = static_cast<uint32_t> (entries.size ());
+	statistics.numDecoded = numDecoded;
+	statistics.numFailed = numFailed;
+	statistics.numSkipped = numSkipped;
+	statistics.decodeTime = Ms (Clock::duration (decodeTime.load ())).count ();
+	statistics.wallTime = Ms (Clock::duration (wallTime.load ())).count ();
+	statistics.done = numDone == entries.size ();
+	return statistics;
+}
+
+//------------------------------------------------------------------------
+PlatformBitmapPtr UIBitmapPreloader::decode (const Request& request) const
+{
+	// same order as UIBitmapNode::getBitmap
+	auto& factory = getPlatformFactory ();
+	auto bitmap = factory.createBitmap (CResourceDescription (request.path.data ()));
+	if (!bitmap && pathIsAbsolute (pathHint))
+	{
+		std::string absPath = pathHint;
+		if (removeLastPathComponent (absPath))
+		{
+			absPath += "/" + request.path;
+			bitmap = factory.createBitmapFromPath (absPath.data ());
+		}
+	}
+	if (!bitmap && !request.data.empty ())
+	{
+		if (request.dataIsBase64)
+		{
+			auto result = Base64Codec::decode (request.data);
+			bitmap = factory.createBitmapFromMemory (result.data.get (), result.dataSize);
+		}
+		else
+			bitmap = factory.createBitmapFromMemory (request.data.data (), request.data.size ());
+		if (bitmap)
+			bitmap->setScaleFactor (request.scaleFactor);
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+void UIBitmapPreloader::run ()
+{
+	size_t index;
+	while (!cancel && (index = nextEntry++) < entries.size ())
+	{
+		auto& entry = *entries[index];
+		uint32_t state = kPending;
+		if (entry.state.compare_exchange_strong (state, kDecoding))
+		{
+			auto start = Clock::now ();
+			auto bitmap = decode (entry.request);
+			decodeTime += (Clock::now () - start).count ();
+			if (bitmap)
+				++numDecoded;
+			else
+				++numFailed;
+			entry.bitmap = std::move (bitmap);
+			entry.state = kReady;
+		}
+		auto done = ++numDone;
+		if (done == entries.size ())
+			wallTime = (Clock::now () - startTime).count ();
+		if (progress)
+			progress (done, static_cast<uint32_t> (entries.size ()));
+	}
+}
+
+//------------------------------------------------------------------------
+auto UIBitmapPreloader::collectRequests (UINode* bitmapsNode) -> Requests
+{
+	Requests requests;
+	if (!bitmapsNode)
+		return requests;
+	for (auto& child : bitmapsNode->getChildren ())
+	{
+		auto bitmapNode = dynamic_cast<UIBitmapNode*> (child);
+		if (!bitmapNode || bitmapNode->hasBitmap ())
+			continue;
+		auto path = bitmapNode->getAttributes ()->getAttributeValue ("path");
+		if (!path)
+			continue;
+		Request request;
+		request.node = bitmapNode;
+		request.path = *path;
+		if (auto dataNode = bitmapNode->getChildren ().findChildNode ("data"))
+		{
+			auto encoding = dataNode->getAttributes ()->getAttributeValue ("encoding");
+			if (encoding && (*encoding == "base64" || *encoding == "binary"))
+			{
+				request.data = dataNode->getData ();
+				request.dataIsBase64 = *encoding == "base64";
+			}
+		}
+		bitmapNode->getAttributes ()->getDoubleAttribute ("scale-factor", request.scaleFactor);
+		requests.emplace_back (std::move (request));
+	}
+	return requests;
+}
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
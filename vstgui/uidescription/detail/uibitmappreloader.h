@@ -0,0 +1,94 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../uidescription.h"
+#include "uinode.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+/** Decodes bitmaps of bitmap nodes as background tasks on the worker threads of parallelFor
+ *
+ *	All inputs are copied when the preloader is created, so that the worker threads never touch the
+ *	node tree. The UI thread takes the decoded platform bitmaps out of the preloader, bitmaps which
+ *	are not yet decoded at that time are left to the lazy path.
+ */
+class UIBitmapPreloader
+{
+public:
+	struct Request
+	{
+		const UIBitmapNode* node {nullptr};
+		std::string path;
+		std::string data;
+		bool dataIsBase64 {true};
+		double scaleFactor {1.};
+	};
+	using Requests = std::vector<Request>;
+	using ProgressFunc = UIDescription::BitmapPreloadProgressFunc;
+
+	UIBitmapPreloader (Requests&& requests, const std::string& pathHint,
+					   ProgressFunc&& progress = nullptr);
+	~UIBitmapPreloader () noexcept;
+
+	/** returns the decoded bitmap for node if it was decoded from path, otherwise nullptr */
+	PlatformBitmapPtr take (const UIBitmapNode* node, const std::string& path);
+	/** blocks until all bitmaps are decoded, must not be called from a background task */
+	void wait ();
+	UIBitmapPreloadStatistics getStatistics () const;
+
+	static Requests collectRequests (UINode* bitmapsNode);
+
+private:
+	enum State : uint32_t
+	{
+		kPending,
+		kDecoding,
+		kReady,
+		kTaken,
+	};
+	struct Entry
+	{
+		Request request;
+		std::atomic<uint32_t> state {kPending};
+		PlatformBitmapPtr bitmap;
+	};
+	using Clock = std::chrono::steady_clock;
+
+	PlatformBitmapPtr decode (const Request& request) const;
+	void run ();
+
+	std::vector<std::unique_ptr<Entry>> entries;
+	std::unordered_map<const UIBitmapNode*, Entry*> entryMap;
+	std::mutex mutex;
+	std::condition_variable doneCondition;
+	size_t numRunningTasks {0};
+	std::string pathHint;
+	ProgressFunc progress;
+	Clock::time_point startTime;
+	std::atomic<size_t> nextEntry {0};
+	std::atomic<uint32_t> numDone {0};
+	std::atomic<uint32_t> numDecoded {0};
+	std::atomic<uint32_t> numFailed {0};
+	std::atomic<uint32_t> numSkipped {0};
+	std::atomic<int64_t> decodeTime {0};
+	std::atomic<int64_t> wallTime {0};
+	std::atomic<bool> cancel {false};
+};
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
@@ -115,9 +115,11 @@ void UIDescListWithFastFindAttributeNameChild::remove (UINode* obj)
 	const std::string* nameAttributeValue = obj->getAttributes ()->getAttributeValue ("name");
 	if (nameAttributeValue)
 	{
-		ChildMap::iterator it = childMap.find (*nameAttributeValue);
-		if (it != childMap.end ())
-			childMap.erase (it);
+		// the node is released by UIDescList::remove, keep a copy of its name
+		auto name = *nameAttributeValue;
+		UIDescList::remove (obj);
+		removeFromChildMap (name, obj);
+		return;
 	}
 	UIDescList::remove (obj);
 }
@@ -147,14 +149,32 @@ void UIDescListWithFastFindAttributeNameChild::nodeAttributeChanged (
 {
 	if (attributeName != "name")
 		return;
-	ChildMap::iterator it = childMap.find (oldAttributeValue);
-	if (it != childMap.end ())
-		childMap.erase (it);
+	removeFromChildMap (oldAttributeValue, node);
 	const std::string* nameAttributeValue = node->getAttributes ()->getAttributeValue ("name");
 	if (nameAttributeValue)
 		childMap.emplace (*nameAttributeValue, node);
 }
 
+//------------------------------------------------------------------------
+void UIDescListWithFastFindAttributeNameChild::removeFromChildMap (const std::string& name,
+                                                                  UINode* node)
+{
+	auto it = childMap.find (name);
+	if (it == childMap.end () || it->second != node)
+		return;
+	childMap.erase (it);
+	// another child with the same name becomes the one found by name
+	for (const auto& child : *this)
+	{
+		auto value = child->getAttributes ()->getAttributeValue ("name");
+		if (value && *value == name)
+		{
+			childMap.emplace (name, child);
+			break;
+		}
+	}
+}
+
 //------------------------------------------------------------------------
 } // Detail
 } // VSTGUI
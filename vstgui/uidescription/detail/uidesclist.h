@@ -69,6 +69,8 @@ public:
 	                           const std::string& oldAttributeValue) override;
 
 private:
+	void removeFromChildMap (const std::string& name, UINode* node);
+
 	ChildMap childMap;
 };
 
@@ -215,28 +215,23 @@ struct Handler
 					newState = State::InTemplateRootNode;
 					break;
 				}
-				auto needsFastChildNameAttributeLookup = false;
+				// all resource lists are looked up by name
+				auto needsFastChildNameAttributeLookup = true;
 				if (keyStr == MainNodeNames::kBitmap)
-				{
 					newState = State::InBitmapRootNode;
-					needsFastChildNameAttributeLookup = true;
-				}
 				else if (keyStr == MainNodeNames::kFont)
 					newState = State::InFontRootNode;
 				else if (keyStr == MainNodeNames::kColor)
-				{
 					newState = State::InColorRootNode;
-					needsFastChildNameAttributeLookup = true;
-				}
 				else if (keyStr == MainNodeNames::kGradient)
 					newState = State::InGradientRootNode;
 				else if (keyStr == MainNodeNames::kControlTag)
-				{
 					newState = State::InControlTagRootNode;
-					needsFastChildNameAttributeLookup = true;
-				}
 				else if (keyStr == MainNodeNames::kCustom)
+				{
 					newState = State::InCustomRootNode;
+					needsFastChildNameAttributeLookup = false;
+				}
 				else if (keyStr == MainNodeNames::kVariable)
 					newState = State::InVariableRootNode;
 				else
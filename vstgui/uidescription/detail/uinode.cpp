@@ -234,6 +234,7 @@ void UIBitmapNode::freePlatformResources ()
 	if (bitmap)
 		bitmap->forget ();
 	bitmap = nullptr;
+	preloadedPlatformBitmap = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -272,7 +273,15 @@ bool UIBitmapNode::imagesEqual (IPlatformBitmap* b1, IPlatformBitmap* b2)
 //-----------------------------------------------------------------------------
 bool UIBitmapNode::hasXMLData () const
 {
-	return getChildren ().findChildNode ("data") != nullptr;
+	auto node = getChildren ().findChildNode ("data");
+	return node != nullptr && !isBinaryDataNode (node);
+}
+
+//-----------------------------------------------------------------------------
+bool UIBitmapNode::isBinaryDataNode (const UINode* node)
+{
+	auto encoding = node->getAttributes ()->getAttributeValue ("encoding");
+	return encoding && *encoding == "binary";
 }
 
 //-----------------------------------------------------------------------------
@@ -286,6 +295,14 @@ void UIBitmapNode::createXMLData (const std::string& pathHint)
 			getChildren ().remove (node);
 			node = nullptr;
 		}
+		else if (isBinaryDataNode (node))
+		{
+			// data loaded from a binary description, the text formats need it base64 encoded
+			auto& data = node->getData ();
+			auto result = Base64Codec::encode (data.data (), static_cast<uint32_t> (data.size ()));
+			data.assign (reinterpret_cast<const char*> (result.data.get ()), result.dataSize);
+			node->getAttributes ()->setAttribute ("encoding", "base64");
+		}
 		else if (auto bm = getBitmap (pathHint))
 		{
 			if (auto platformBitmap = bm->getPlatformBitmap ())
@@ -333,9 +350,18 @@ void UIBitmapNode::removeXMLData ()
 }
 
 //-----------------------------------------------------------------------------
-CBitmap* UIBitmapNode::createBitmap (const std::string& str, const BitmapVariant& variant) const
+CBitmap* UIBitmapNode::createBitmap (const std::string& str, const BitmapVariant& variant,
+									  const PlatformBitmapPtr& platformBitmap) const
 {
-
+	if (platformBitmap)
+	{
+		CResourceDescription desc (str.data ());
+		if (auto partDesc = std::get_if<CNinePartTiledDescription> (&variant))
+			return new CNinePartTiledBitmap (desc, platformBitmap, *partDesc);
+		else if (auto multiFrameDesc = std::get_if<CMultiFrameBitmapDescription> (&variant))
+			return new CMultiFrameBitmap (desc, platformBitmap, *multiFrameDesc);
+		return new CBitmap (desc, platformBitmap);
+	}
 	if (auto partDesc = std::get_if<CNinePartTiledDescription> (&variant))
 		return new CNinePartTiledBitmap (CResourceDescription (str.data ()), *partDesc);
 	else if (auto multiFrameDesc = std::get_if<CMultiFrameBitmapDescription> (&variant))
@@ -343,6 +369,12 @@ CBitmap* UIBitmapNode::createBitmap (const std::string& str, const BitmapVariant
 	return new CBitmap (CResourceDescription (str.c_str ()));
 }
 
+//-----------------------------------------------------------------------------
+void UIBitmapNode::setPreloadedPlatformBitmap (const PlatformBitmapPtr& platformBitmap)
+{
+	preloadedPlatformBitmap = platformBitmap;
+}
+
 //------------------------------------------------------------------------
 UINode* UIBitmapNode::dataNode () const
 {
@@ -356,11 +388,22 @@ PlatformBitmapPtr UIBitmapNode::createBitmapFromDataNode () const
 	if (auto node = dataNode ())
 	{
 		auto codecStr = node->getAttributes ()->getAttributeValue ("encoding");
-		if (codecStr && *codecStr == "base64")
+		if (codecStr && (*codecStr == "base64" || *codecStr == "binary"))
 		{
-			auto result = Base64Codec::decode (node->getData ());
-			if (auto platformBitmap = getPlatformFactory ().createBitmapFromMemory (
-			        result.data.get (), result.dataSize))
+			PlatformBitmapPtr platformBitmap;
+			if (*codecStr == "binary")
+			{
+				const auto& data = node->getData ();
+				platformBitmap = getPlatformFactory ().createBitmapFromMemory (data.data (),
+																			   data.size ());
+			}
+			else
+			{
+				auto result = Base64Codec::decode (node->getData ());
+				platformBitmap =
+					getPlatformFactory ().createBitmapFromMemory (result.data.get (), result.dataSize);
+			}
+			if (platformBitmap)
 			{
 				double scaleFactor = 1.;
 				if (attributes->getDoubleAttribute ("scale-factor", scaleFactor))
@@ -397,7 +440,8 @@ CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
 				attributes->getPointAttribute ("multiframe-size", multiFrameDesc.frameSize);
 				bitmapVariant = multiFrameDesc;
 			}
-			bitmap = createBitmap (*path, bitmapVariant);
+			bitmap = createBitmap (*path, bitmapVariant, preloadedPlatformBitmap);
+			preloadedPlatformBitmap = nullptr;
 			if (bitmap->getPlatformBitmap () == nullptr && pathIsAbsolute (pathHint))
 			{
 				std::string absPath = pathHint;
@@ -692,26 +736,34 @@ void UIGradientNode::freePlatformResources ()
 }
 
 //-----------------------------------------------------------------------------
-CGradient* UIGradientNode::getGradient ()
+void UIGradientNode::prepareColorStops ()
 {
-	if (gradient == nullptr)
+	colorStops.clear ();
+	double start;
+	CColor color;
+	for (auto& colorNode : getChildren ())
 	{
-		GradientColorStopMap colorStops;
-		double start;
-		CColor color;
-		for (auto& colorNode : getChildren ())
+		if (colorNode->getName () == "color-stop")
 		{
-			if (colorNode->getName () == "color-stop")
-			{
-				const std::string* rgba = colorNode->getAttributes ()->getAttributeValue ("rgba");
-				if (rgba == nullptr ||
-				    colorNode->getAttributes ()->getDoubleAttribute ("start", start) == false)
-					continue;
-				if (parseColor (*rgba, color) == false)
-					continue;
-				colorStops.emplace (start, color);
-			}
+			const std::string* rgba = colorNode->getAttributes ()->getAttributeValue ("rgba");
+			if (rgba == nullptr ||
+			    colorNode->getAttributes ()->getDoubleAttribute ("start", start) == false)
+				continue;
+			if (parseColor (*rgba, color) == false)
+				continue;
+			colorStops.emplace (start, color);
 		}
+	}
+	colorStopsPrepared = true;
+}
+
+//-----------------------------------------------------------------------------
+CGradient* UIGradientNode::getGradient ()
+{
+	if (gradient == nullptr)
+	{
+		if (!colorStopsPrepared)
+			prepareColorStops ();
 		if (colorStops.size () > 1)
 			gradient = owned (CGradient::create (colorStops));
 	}
@@ -722,6 +774,7 @@ CGradient* UIGradientNode::getGradient ()
 void UIGradientNode::setGradient (CGradient* g)
 {
 	gradient = g;
+	colorStopsPrepared = false;
 	getChildren ().removeAll ();
 	if (gradient == nullptr)
 		return;
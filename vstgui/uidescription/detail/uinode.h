@@ -125,6 +125,9 @@ class UIBitmapNode : public UINode
 public:
 	UIBitmapNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	CBitmap* getBitmap (const std::string& pathHint);
+	bool hasBitmap () const { return bitmap != nullptr; }
+	/** use an already decoded platform bitmap the next time the bitmap is created */
+	void setPreloadedPlatformBitmap (const PlatformBitmapPtr& platformBitmap);
 	void setBitmap (UTF8StringPtr bitmapName);
 	void setMultiFrameDesc (const CMultiFrameBitmapDescription* desc);
 	void setNinePartTiledOffset (const CRect* offsets);
@@ -144,11 +147,14 @@ protected:
 	~UIBitmapNode () noexcept override;
 	using BitmapVariant =
 		std::variant<uint32_t, CNinePartTiledDescription, CMultiFrameBitmapDescription>;
-	CBitmap* createBitmap (const std::string& str, const BitmapVariant& variant) const;
+	CBitmap* createBitmap (const std::string& str, const BitmapVariant& variant,
+						   const PlatformBitmapPtr& platformBitmap) const;
 	PlatformBitmapPtr createBitmapFromDataNode () const;
 	static bool imagesEqual (IPlatformBitmap* b1, IPlatformBitmap* b2);
 	UINode* dataNode () const;
+	static bool isBinaryDataNode (const UINode* node);
 	CBitmap* bitmap;
+	PlatformBitmapPtr preloadedPlatformBitmap;
 	bool filterProcessed;
 	bool scaledBitmapsAdded;
 };
@@ -159,6 +165,7 @@ class UIFontNode : public UINode
 public:
 	UIFontNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	CFontRef getFont ();
+	bool hasFont () const { return font != nullptr; }
 	void setFont (CFontRef newFont);
 	void setAlternativeFontNames (UTF8StringPtr fontNames);
 	bool getAlternativeFontNames (std::string& fontNames);
@@ -189,11 +196,15 @@ public:
 	UIGradientNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	CGradient* getGradient ();
 	void setGradient (CGradient* g);
+	/** parse the color stops without creating the gradient, can be called on a worker thread */
+	void prepareColorStops ();
 
 	void freePlatformResources () override;
 
 protected:
 	SharedPointer<CGradient> gradient;
+	GradientColorStopMap colorStops;
+	bool colorStopsPrepared {false};
 };
 
 //------------------------------------------------------------------------
@@ -0,0 +1,120 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "uinodediff.h"
+#include "../uiattributes.h"
+#include "uinode.h"
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+bool isEqual (const UIAttributes& attributes1, const UIAttributes& attributes2)
+{
+	if (&attributes1 == &attributes2)
+		return true;
+	if (attributes1.size () != attributes2.size ())
+		return false;
+	for (auto it = attributes1.begin (), end = attributes1.end (); it != end; ++it)
+	{
+		auto value = attributes2.getAttributeValue (it.getName ());
+		if (!value || *value != it->second)
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool isEqual (const UINode& node1, const UINode& node2)
+{
+	if (&node1 == &node2)
+		return true;
+	if (node1.getName () != node2.getName () || node1.getData () != node2.getData ())
+		return false;
+	if (!isEqual (*node1.getAttributes (), *node2.getAttributes ()))
+		return false;
+	const auto& children1 = node1.getChildren ();
+	const auto& children2 = node2.getChildren ();
+	if (children1.size () != children2.size ())
+		return false;
+	for (auto it1 = children1.begin (), it2 = children2.begin (); it1 != children1.end ();
+		 ++it1, ++it2)
+	{
+		if (!isEqual (**it1, **it2))
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+size_t mergeResourceList (const UINode* oldList, UINode* newList, UINodeNameSet& changedNames)
+{
+	static const std::string kNameAttribute = "name";
+
+	size_t numChanged = 0;
+	auto insertName = [&] (const UINode* node) {
+		if (auto name = node->getAttributes ()->getAttributeValue (kNameAttribute))
+		{
+			changedNames.emplace (*name);
+			++numChanged;
+		}
+	};
+	if (!newList)
+	{
+		if (oldList)
+		{
+			for (const auto& node : oldList->getChildren ())
+				insertName (node);
+		}
+		return numChanged;
+	}
+
+	std::vector<SharedPointer<UINode>> merged;
+	merged.reserve (newList->getChildren ().size ());
+	bool reused = false;
+	for (const auto& node : newList->getChildren ())
+	{
+		auto name = node->getAttributes ()->getAttributeValue (kNameAttribute);
+		auto oldNode = (oldList && name) ? oldList->getChildren ().findChildNodeWithAttributeValue (
+											   kNameAttribute, *name)
+										 : nullptr;
+		if (oldNode && isEqual (*oldNode, *node))
+		{
+			merged.emplace_back (oldNode);
+			reused = true;
+		}
+		else
+		{
+			merged.emplace_back (node);
+			insertName (node);
+		}
+	}
+	if (oldList)
+	{
+		for (const auto& node : oldList->getChildren ())
+		{
+			auto name = node->getAttributes ()->getAttributeValue (kNameAttribute);
+			if (name &&
+				!newList->getChildren ().findChildNodeWithAttributeValue (kNameAttribute, *name))
+				insertName (node);
+		}
+	}
+	if (reused)
+	{
+		auto& children = newList->getChildren ();
+		children.removeAll ();
+		for (auto& node : merged)
+		{
+			node->remember ();
+			children.add (node);
+		}
+	}
+	return numChanged;
+}
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
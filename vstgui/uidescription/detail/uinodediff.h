@@ -0,0 +1,38 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../uidescriptionfwd.h"
+#include <string>
+#include <unordered_set>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+class UINode;
+
+using UINodeNameSet = std::unordered_set<std::string>;
+
+//------------------------------------------------------------------------
+/** compares the names and values of all attributes, independent of their order */
+bool isEqual (const UIAttributes& attributes1, const UIAttributes& attributes2);
+
+/** deep comparison of the names, attributes, data and children of two nodes */
+bool isEqual (const UINode& node1, const UINode& node2);
+
+/** merge the resources of oldList into newList
+ *
+ *	Resources are matched by their name attribute. Nodes of newList with an equal node in oldList
+ *	are replaced by the old node, which keeps its already created platform resources. The names of
+ *	added, removed and changed resources are inserted into changedNames. Either list may be nullptr.
+ *
+ *	@return the number of changed resources
+ */
+size_t mergeResourceList (const UINode* oldList, UINode* newList, UINodeNameSet& changedNames);
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../iuidescription.h"
+#include "../uiattributes.h"
 #include <cstring>
 
 namespace VSTGUI {
@@ -52,273 +53,273 @@ static const IdStringPtr kCAutoAnimation = "CAutoAnimation";
 //-----------------------------------------------------------------------------
 // attributes used in more than one view creator
 //-----------------------------------------------------------------------------
-static const std::string kAttrClass = "class";
-static const std::string kAttrTitle = "title";
-static const std::string kAttrFont = "font";
-static const std::string kAttrFontColor = "font-color";
-static const std::string kAttrFrameColor = "frame-color";
-static const std::string kAttrTextAlignment = "text-alignment";
-static const std::string kAttrRoundRectRadius = "round-rect-radius";
-static const std::string kAttrFrameWidth = "frame-width";
-static const std::string kAttrGradientStartColor = "gradient-start-color";
-static const std::string kAttrGradientEndColor = "gradient-end-color";
-static const std::string kAttrZoomFactor = "zoom-factor";
-static const std::string kAttrHandleBitmap = "handle-bitmap";
-static const std::string kAttrOrientation = "orientation";
-static const std::string kAttrAnimationTime = "animation-time";
-static const std::string kAttrGradient = "gradient";
+static const UIAttributeName kAttrClass {"class"};
+static const UIAttributeName kAttrTitle {"title"};
+static const UIAttributeName kAttrFont {"font"};
+static const UIAttributeName kAttrFontColor {"font-color"};
+static const UIAttributeName kAttrFrameColor {"frame-color"};
+static const UIAttributeName kAttrTextAlignment {"text-alignment"};
+static const UIAttributeName kAttrRoundRectRadius {"round-rect-radius"};
+static const UIAttributeName kAttrFrameWidth {"frame-width"};
+static const UIAttributeName kAttrGradientStartColor {"gradient-start-color"};
+static const UIAttributeName kAttrGradientEndColor {"gradient-end-color"};
+static const UIAttributeName kAttrZoomFactor {"zoom-factor"};
+static const UIAttributeName kAttrHandleBitmap {"handle-bitmap"};
+static const UIAttributeName kAttrOrientation {"orientation"};
+static const UIAttributeName kAttrAnimationTime {"animation-time"};
+static const UIAttributeName kAttrGradient {"gradient"};
 
 //-----------------------------------------------------------------------------
 // CViewCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrOrigin = "origin";
-static const std::string kAttrSize = "size";
-static const std::string kAttrTransparent = "transparent";
-static const std::string kAttrMouseEnabled = "mouse-enabled";
-static const std::string kAttrWantsFocus = "wants-focus";
-static const std::string kAttrBitmap = "bitmap";
-static const std::string kAttrDisabledBitmap = "disabled-bitmap";
-static const std::string kAttrAutosize = "autosize";
-static const std::string kAttrTooltip = "tooltip";
-static const std::string kAttrCustomViewName = IUIDescription::kCustomViewName;
-static const std::string kAttrSubController = "sub-controller";
-static const std::string kAttrUIDescLabel = "uidesc-label";
-static const std::string kAttrOpacity = "opacity";
+static const UIAttributeName kAttrOrigin {"origin"};
+static const UIAttributeName kAttrSize {"size"};
+static const UIAttributeName kAttrTransparent {"transparent"};
+static const UIAttributeName kAttrMouseEnabled {"mouse-enabled"};
+static const UIAttributeName kAttrWantsFocus {"wants-focus"};
+static const UIAttributeName kAttrBitmap {"bitmap"};
+static const UIAttributeName kAttrDisabledBitmap {"disabled-bitmap"};
+static const UIAttributeName kAttrAutosize {"autosize"};
+static const UIAttributeName kAttrTooltip {"tooltip"};
+static const UIAttributeName kAttrCustomViewName {IUIDescription::kCustomViewName};
+static const UIAttributeName kAttrSubController {"sub-controller"};
+static const UIAttributeName kAttrUIDescLabel {"uidesc-label"};
+static const UIAttributeName kAttrOpacity {"opacity"};
 
 //-----------------------------------------------------------------------------
 // CViewContainerCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrBackgroundColor = "background-color";
-static const std::string kAttrBackgroundColorDrawStyle = "background-color-draw-style";
+static const UIAttributeName kAttrBackgroundColor {"background-color"};
+static const UIAttributeName kAttrBackgroundColorDrawStyle {"background-color-draw-style"};
 
 //-----------------------------------------------------------------------------
 // CLayeredViewContainerCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrZIndex = "z-index";
+static const UIAttributeName kAttrZIndex {"z-index"};
 
 //-----------------------------------------------------------------------------
 // CRowColumnViewCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrRowStyle = "row-style";
-static const std::string kAttrSpacing = "spacing";
-static const std::string kAttrMargin = "margin";
-static const std::string kAttrAnimateViewResizing = "animate-view-resizing";
-static const std::string kAttrHideClippedSubviews = "hide-clipped-subviews";
-static const std::string kAttrEqualSizeLayout = "equal-size-layout";
-static const std::string kAttrViewResizeAnimationTime = "view-resize-animation-time";
+static const UIAttributeName kAttrRowStyle {"row-style"};
+static const UIAttributeName kAttrSpacing {"spacing"};
+static const UIAttributeName kAttrMargin {"margin"};
+static const UIAttributeName kAttrAnimateViewResizing {"animate-view-resizing"};
+static const UIAttributeName kAttrHideClippedSubviews {"hide-clipped-subviews"};
+static const UIAttributeName kAttrEqualSizeLayout {"equal-size-layout"};
+static const UIAttributeName kAttrViewResizeAnimationTime {"view-resize-animation-time"};
 
 //-----------------------------------------------------------------------------
 // CScrollViewCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrContainerSize = "container-size";
-static const std::string kAttrHorizontalScrollbar = "horizontal-scrollbar";
-static const std::string kAttrVerticalScrollbar = "vertical-scrollbar";
-static const std::string kAttrAutoDragScrolling = "auto-drag-scrolling";
-static const std::string kAttrBordered = "bordered";
-static const std::string kAttrOverlayScrollbars = "overlay-scrollbars";
-static const std::string kAttrFollowFocusView = "follow-focus-view";
-static const std::string kAttrAutoHideScrollbars = "auto-hide-scrollbars";
-static const std::string kAttrScrollbarBackgroundColor = "scrollbar-background-color";
-static const std::string kAttrScrollbarFrameColor = "scrollbar-frame-color";
-static const std::string kAttrScrollbarScrollerColor = "scrollbar-scroller-color";
-static const std::string kAttrScrollbarWidth = "scrollbar-width";
+static const UIAttributeName kAttrContainerSize {"container-size"};
+static const UIAttributeName kAttrHorizontalScrollbar {"horizontal-scrollbar"};
+static const UIAttributeName kAttrVerticalScrollbar {"vertical-scrollbar"};
+static const UIAttributeName kAttrAutoDragScrolling {"auto-drag-scrolling"};
+static const UIAttributeName kAttrBordered {"bordered"};
+static const UIAttributeName kAttrOverlayScrollbars {"overlay-scrollbars"};
+static const UIAttributeName kAttrFollowFocusView {"follow-focus-view"};
+static const UIAttributeName kAttrAutoHideScrollbars {"auto-hide-scrollbars"};
+static const UIAttributeName kAttrScrollbarBackgroundColor {"scrollbar-background-color"};
+static const UIAttributeName kAttrScrollbarFrameColor {"scrollbar-frame-color"};
+static const UIAttributeName kAttrScrollbarScrollerColor {"scrollbar-scroller-color"};
+static const UIAttributeName kAttrScrollbarWidth {"scrollbar-width"};
 
 //-----------------------------------------------------------------------------
 // CControlCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrControlTag = "control-tag";
-static const std::string kAttrDefaultValue = "default-value";
-static const std::string kAttrMinValue = "min-value";
-static const std::string kAttrMaxValue = "max-value";
-static const std::string kAttrWheelIncValue = "wheel-inc-value";
-static const std::string kAttrBackgroundOffset = "background-offset";
+static const UIAttributeName kAttrControlTag {"control-tag"};
+static const UIAttributeName kAttrDefaultValue {"default-value"};
+static const UIAttributeName kAttrMinValue {"min-value"};
+static const UIAttributeName kAttrMaxValue {"max-value"};
+static const UIAttributeName kAttrWheelIncValue {"wheel-inc-value"};
+static const UIAttributeName kAttrBackgroundOffset {"background-offset"};
 
 //-----------------------------------------------------------------------------
 // CCheckBoxCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrBoxframeColor = "boxframe-color";
-static const std::string kAttrBoxfillColor = "boxfill-color";
-static const std::string kAttrCheckmarkColor = "checkmark-color";
-static const std::string kAttrDrawCrossbox = "draw-crossbox";
-static const std::string kAttrAutosizeToFit = "autosize-to-fit";
+static const UIAttributeName kAttrBoxframeColor {"boxframe-color"};
+static const UIAttributeName kAttrBoxfillColor {"boxfill-color"};
+static const UIAttributeName kAttrCheckmarkColor {"checkmark-color"};
+static const UIAttributeName kAttrDrawCrossbox {"draw-crossbox"};
+static const UIAttributeName kAttrAutosizeToFit {"autosize-to-fit"};
 
 //-----------------------------------------------------------------------------
 // CParamDisplayCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrBackColor = "back-color";
-static const std::string kAttrShadowColor = "shadow-color";
-static const std::string kAttrFontAntialias = "font-antialias";
-static const std::string kAttrStyle3DIn = "style-3D-in";
-static const std::string kAttrStyle3DOut = "style-3D-out";
-static const std::string kAttrStyleNoFrame = "style-no-frame";
-static const std::string kAttrStyleNoText = "style-no-text";
-static const std::string kAttrStyleNoDraw = "style-no-draw";
-static const std::string kAttrStyleShadowText = "style-shadow-text";
-static const std::string kAttrStyleRoundRect = "style-round-rect";
-static const std::string kAttrTextInset = "text-inset";
-static const std::string kAttrValuePrecision = "value-precision";
-static const std::string kAttrTextRotation = "text-rotation";
-static const std::string kAttrTextShadowOffset = "text-shadow-offset";
+static const UIAttributeName kAttrBackColor {"back-color"};
+static const UIAttributeName kAttrShadowColor {"shadow-color"};
+static const UIAttributeName kAttrFontAntialias {"font-antialias"};
+static const UIAttributeName kAttrStyle3DIn {"style-3D-in"};
+static const UIAttributeName kAttrStyle3DOut {"style-3D-out"};
+static const UIAttributeName kAttrStyleNoFrame {"style-no-frame"};
+static const UIAttributeName kAttrStyleNoText {"style-no-text"};
+static const UIAttributeName kAttrStyleNoDraw {"style-no-draw"};
+static const UIAttributeName kAttrStyleShadowText {"style-shadow-text"};
+static const UIAttributeName kAttrStyleRoundRect {"style-round-rect"};
+static const UIAttributeName kAttrTextInset {"text-inset"};
+static const UIAttributeName kAttrValuePrecision {"value-precision"};
+static const UIAttributeName kAttrTextRotation {"text-rotation"};
+static const UIAttributeName kAttrTextShadowOffset {"text-shadow-offset"};
 
 //-----------------------------------------------------------------------------
 // COptionMenuCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrMenuPopupStyle = "menu-popup-style";
-static const std::string kAttrMenuCheckStyle = "menu-check-style";
+static const UIAttributeName kAttrMenuPopupStyle {"menu-popup-style"};
+static const UIAttributeName kAttrMenuCheckStyle {"menu-check-style"};
 
 //-----------------------------------------------------------------------------
 // CTextLabelCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrTruncateMode = "truncate-mode";
+static const UIAttributeName kAttrTruncateMode {"truncate-mode"};
 
 //-----------------------------------------------------------------------------
 // CMultiLineTextLabelCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrLineLayout = "line-layout";
-static const std::string kAttrAutoHeight = "auto-height";
-static const std::string kAttrVerticalCentered = "vertical-centered";
+static const UIAttributeName kAttrLineLayout {"line-layout"};
+static const UIAttributeName kAttrAutoHeight {"auto-height"};
+static const UIAttributeName kAttrVerticalCentered {"vertical-centered"};
 
 //-----------------------------------------------------------------------------
 // CTextEditCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrSecureStyle = "secure-style";
-static const std::string kAttrImmediateTextChange = "immediate-text-change";
-static const std::string kAttrStyleDoubleClick = "style-doubleclick";
-static const std::string kAttrPlaceholderTitle = "placeholder-title";
+static const UIAttributeName kAttrSecureStyle {"secure-style"};
+static const UIAttributeName kAttrImmediateTextChange {"immediate-text-change"};
+static const UIAttributeName kAttrStyleDoubleClick {"style-doubleclick"};
+static const UIAttributeName kAttrPlaceholderTitle {"placeholder-title"};
 
-static const std::string kAttrClearMarkInset = "clearmark-inset";
+static const UIAttributeName kAttrClearMarkInset {"clearmark-inset"};
 
 //-----------------------------------------------------------------------------
 // CTextButtonCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrTextColor = "text-color";
-static const std::string kAttrTextColorHighlighted = "text-color-highlighted";
-static const std::string kAttrGradientStartColorHighlighted = "gradient-start-color-highlighted";
-static const std::string kAttrGradientEndColorHighlighted = "gradient-end-color-highlighted";
-static const std::string kAttrFrameColorHighlighted = "frame-color-highlighted";
-static const std::string kAttrRoundRadius = "round-radius";
-static const std::string kAttrKickStyle = "kick-style";
-static const std::string kAttrIcon = "icon";
-static const std::string kAttrIconHighlighted = "icon-highlighted";
-static const std::string kAttrIconPosition = "icon-position";
-static const std::string kAttrIconTextMargin = "icon-text-margin";
-static const std::string kAttrGradientHighlighted = "gradient-highlighted";
+static const UIAttributeName kAttrTextColor {"text-color"};
+static const UIAttributeName kAttrTextColorHighlighted {"text-color-highlighted"};
+static const UIAttributeName kAttrGradientStartColorHighlighted {"gradient-start-color-highlighted"};
+static const UIAttributeName kAttrGradientEndColorHighlighted {"gradient-end-color-highlighted"};
+static const UIAttributeName kAttrFrameColorHighlighted {"frame-color-highlighted"};
+static const UIAttributeName kAttrRoundRadius {"round-radius"};
+static const UIAttributeName kAttrKickStyle {"kick-style"};
+static const UIAttributeName kAttrIcon {"icon"};
+static const UIAttributeName kAttrIconHighlighted {"icon-highlighted"};
+static const UIAttributeName kAttrIconPosition {"icon-position"};
+static const UIAttributeName kAttrIconTextMargin {"icon-text-margin"};
+static const UIAttributeName kAttrGradientHighlighted {"gradient-highlighted"};
 
 //-----------------------------------------------------------------------------
 // CSegmentButtonCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrStyle = "style";
-static const std::string kAttrSelectionMode = "selection-mode";
-static const std::string kAttrSegmentNames = "segment-names";
+static const UIAttributeName kAttrStyle {"style"};
+static const UIAttributeName kAttrSelectionMode {"selection-mode"};
+static const UIAttributeName kAttrSegmentNames {"segment-names"};
 
 //-----------------------------------------------------------------------------
 // CKnobCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrAngleStart = "angle-start";
-static const std::string kAttrAngleRange = "angle-range";
-static const std::string kAttrValueInset = "value-inset";
-static const std::string kAttrCoronaInset = "corona-inset";
-static const std::string kAttrCoronaColor = "corona-color";
-static const std::string kAttrCoronaDrawing = "corona-drawing";
-static const std::string kAttrCoronaOutline = "corona-outline";
-static const std::string kAttrCoronaInverted = "corona-inverted";
-static const std::string kAttrCoronaFromCenter = "corona-from-center";
-static const std::string kAttrCoronaDashDot = "corona-dash-dot";
-static const std::string kAttrCoronaDashDotLengths = "corona-dash-dot-lengths";
-static const std::string kAttrHandleColor = "handle-color";
-static const std::string kAttrHandleShadowColor = "handle-shadow-color";
-static const std::string kAttrHandleLineWidth = "handle-line-width";
-static const std::string kAttrCircleDrawing = "circle-drawing";
-static const std::string kAttrCoronaLineCapButt = "corona-line-cap-butt";
-static const std::string kAttrSkipHandleDrawing = "skip-handle-drawing";
-static const std::string kAttrCoronaOutlineWidthAdd = "corona-outline-width-add";
+static const UIAttributeName kAttrAngleStart {"angle-start"};
+static const UIAttributeName kAttrAngleRange {"angle-range"};
+static const UIAttributeName kAttrValueInset {"value-inset"};
+static const UIAttributeName kAttrCoronaInset {"corona-inset"};
+static const UIAttributeName kAttrCoronaColor {"corona-color"};
+static const UIAttributeName kAttrCoronaDrawing {"corona-drawing"};
+static const UIAttributeName kAttrCoronaOutline {"corona-outline"};
+static const UIAttributeName kAttrCoronaInverted {"corona-inverted"};
+static const UIAttributeName kAttrCoronaFromCenter {"corona-from-center"};
+static const UIAttributeName kAttrCoronaDashDot {"corona-dash-dot"};
+static const UIAttributeName kAttrCoronaDashDotLengths {"corona-dash-dot-lengths"};
+static const UIAttributeName kAttrHandleColor {"handle-color"};
+static const UIAttributeName kAttrHandleShadowColor {"handle-shadow-color"};
+static const UIAttributeName kAttrHandleLineWidth {"handle-line-width"};
+static const UIAttributeName kAttrCircleDrawing {"circle-drawing"};
+static const UIAttributeName kAttrCoronaLineCapButt {"corona-line-cap-butt"};
+static const UIAttributeName kAttrSkipHandleDrawing {"skip-handle-drawing"};
+static const UIAttributeName kAttrCoronaOutlineWidthAdd {"corona-outline-width-add"};
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
 //-----------------------------------------------------------------------------
 // IMultiBitmapControlCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrHeightOfOneImage = "height-of-one-image";
-static const std::string kAttrSubPixmaps = "sub-pixmaps";
+static const UIAttributeName kAttrHeightOfOneImage {"height-of-one-image"};
+static const UIAttributeName kAttrSubPixmaps {"sub-pixmaps"};
 #endif
 
 //-----------------------------------------------------------------------------
 // CAnimKnobCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrInverseBitmap = "inverse-bitmap";
+static const UIAttributeName kAttrInverseBitmap {"inverse-bitmap"};
 
 //-----------------------------------------------------------------------------
 // CSliderCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrMode = "mode";
-static const std::string kAttrHandleOffset = "handle-offset";
-static const std::string kAttrBitmapOffset = "bitmap-offset";
-static const std::string kAttrReverseOrientation = "reverse-orientation";
-static const std::string kAttrDrawFrame = "draw-frame";
-static const std::string kAttrDrawBack = "draw-back";
-static const std::string kAttrDrawValue = "draw-value";
-static const std::string kAttrDrawValueInverted = "draw-value-inverted";
-static const std::string kAttrDrawValueFromCenter = "draw-value-from-center";
-static const std::string kAttrDrawFrameColor = "draw-frame-color";
-static const std::string kAttrDrawBackColor = "draw-back-color";
-static const std::string kAttrDrawValueColor = "draw-value-color";
+static const UIAttributeName kAttrMode {"mode"};
+static const UIAttributeName kAttrHandleOffset {"handle-offset"};
+static const UIAttributeName kAttrBitmapOffset {"bitmap-offset"};
+static const UIAttributeName kAttrReverseOrientation {"reverse-orientation"};
+static const UIAttributeName kAttrDrawFrame {"draw-frame"};
+static const UIAttributeName kAttrDrawBack {"draw-back"};
+static const UIAttributeName kAttrDrawValue {"draw-value"};
+static const UIAttributeName kAttrDrawValueInverted {"draw-value-inverted"};
+static const UIAttributeName kAttrDrawValueFromCenter {"draw-value-from-center"};
+static const UIAttributeName kAttrDrawFrameColor {"draw-frame-color"};
+static const UIAttributeName kAttrDrawBackColor {"draw-back-color"};
+static const UIAttributeName kAttrDrawValueColor {"draw-value-color"};
 
 //-----------------------------------------------------------------------------
 // CVuMeterCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrOffBitmap = "off-bitmap";
-static const std::string kAttrNumLed = "num-led";
-static const std::string kAttrDecreaseStepValue = "decrease-step-value";
+static const UIAttributeName kAttrOffBitmap {"off-bitmap"};
+static const UIAttributeName kAttrNumLed {"num-led"};
+static const UIAttributeName kAttrDecreaseStepValue {"decrease-step-value"};
 
 //-----------------------------------------------------------------------------
 // CAnimationSplashScreenCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrSplashBitmap = "splash-bitmap";
-static const std::string kAttrSplashOrigin = "splash-origin";
-static const std::string kAttrSplashSize = "splash-size";
-static const std::string kAttrAnimationIndex = "animation-index";
+static const UIAttributeName kAttrSplashBitmap {"splash-bitmap"};
+static const UIAttributeName kAttrSplashOrigin {"splash-origin"};
+static const UIAttributeName kAttrSplashSize {"splash-size"};
+static const UIAttributeName kAttrAnimationIndex {"animation-index"};
 
 //-----------------------------------------------------------------------------
 // UIViewSwitchContainerCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrTemplateNames = "template-names";
-static const std::string kAttrTemplateSwitchControl = "template-switch-control";
-static const std::string kAttrAnimationStyle = "animation-style";
-static const std::string kAttrAnimationTimingFunction = "animation-timing-function";
+static const UIAttributeName kAttrTemplateNames {"template-names"};
+static const UIAttributeName kAttrTemplateSwitchControl {"template-switch-control"};
+static const UIAttributeName kAttrAnimationStyle {"animation-style"};
+static const UIAttributeName kAttrAnimationTimingFunction {"animation-timing-function"};
 
 //-----------------------------------------------------------------------------
 // CSplitViewCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrSeparatorWidth = "separator-width";
-static const std::string kAttrResizeMethod = "resize-method";
+static const UIAttributeName kAttrSeparatorWidth {"separator-width"};
+static const UIAttributeName kAttrResizeMethod {"resize-method"};
 
 //-----------------------------------------------------------------------------
 // CShadowViewContainerCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrShadowIntensity = "shadow-intensity";
-static const std::string kAttrShadowBlurSize = "shadow-blur-size";
-static const std::string kAttrShadowOffset = "shadow-offset";
+static const UIAttributeName kAttrShadowIntensity {"shadow-intensity"};
+static const UIAttributeName kAttrShadowBlurSize {"shadow-blur-size"};
+static const UIAttributeName kAttrShadowOffset {"shadow-offset"};
 
 //-----------------------------------------------------------------------------
 // CGradientViewCreator attributes
 //-----------------------------------------------------------------------------
-static const std::string kAttrGradientAngle = "gradient-angle";
-static const std::string kAttrGradientStyle = "gradient-style";
-static const std::string kAttrGradientStartColorOffset = "gradient-start-color-offset";
-static const std::string kAttrGradientEndColorOffset = "gradient-end-color-offset";
-static const std::string kAttrDrawAntialiased = "draw-antialiased";
-static const std::string kAttrRadialCenter = "radial-center";
-static const std::string kAttrRadialRadius = "radial-radius";
+static const UIAttributeName kAttrGradientAngle {"gradient-angle"};
+static const UIAttributeName kAttrGradientStyle {"gradient-style"};
+static const UIAttributeName kAttrGradientStartColorOffset {"gradient-start-color-offset"};
+static const UIAttributeName kAttrGradientEndColorOffset {"gradient-end-color-offset"};
+static const UIAttributeName kAttrDrawAntialiased {"draw-antialiased"};
+static const UIAttributeName kAttrRadialCenter {"radial-center"};
+static const UIAttributeName kAttrRadialRadius {"radial-radius"};
 
 //------------------------------------------------------------------------
 // StringListControlCreator attributes
 //------------------------------------------------------------------------
-static const std::string kAttrSelectedFontColor = "font-color-selected";
-static const std::string kAttrSelectedBackColor = "back-color-selected";
-static const std::string kAttrLineColor = "line-color";
-static const std::string kAttrLineWidth = "line-width";
-static const std::string kAttrHoverColor = "hover-color";
-static const std::string kAttrRowHeight = "row-height";
-static const std::string kAttrStyleHover = "style-hover";
+static const UIAttributeName kAttrSelectedFontColor {"font-color-selected"};
+static const UIAttributeName kAttrSelectedBackColor {"back-color-selected"};
+static const UIAttributeName kAttrLineColor {"line-color"};
+static const UIAttributeName kAttrLineWidth {"line-width"};
+static const UIAttributeName kAttrHoverColor {"hover-color"};
+static const UIAttributeName kAttrRowHeight {"row-height"};
+static const UIAttributeName kAttrStyleHover {"style-hover"};
 
 //------------------------------------------------------------------------
 // Some globally used strings
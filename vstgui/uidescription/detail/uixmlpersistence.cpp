@@ -8,6 +8,8 @@
 
 #include "../uiattributes.h"
 #include "../cstream.h"
+#include "../../lib/cstring.h"
+#include <chrono>
 #include <map>
 
 //------------------------------------------------------------------------
@@ -17,8 +19,15 @@ namespace Detail {
 //-----------------------------------------------------------------------------
 SharedPointer<UINode> UIXMLParser::parse (IContentProvider* provider)
 {
+	using namespace std::chrono;
+
+	statistics = {};
+	auto start = steady_clock::now ();
 	Xml::Parser parser;
-	if (parser.parse (provider, this))
+	auto result = parser.parse (provider, this);
+	flushCharData ();
+	statistics.parseTime = duration<double, std::milli> (steady_clock::now () - start).count ();
+	if (result)
 		return std::move (nodes);
 	return nullptr;
 }
@@ -26,7 +35,9 @@ SharedPointer<UINode> UIXMLParser::parse (IContentProvider* provider)
 //-----------------------------------------------------------------------------
 void UIXMLParser::startXmlElement (Xml::Parser* parser, IdStringPtr elementName, UTF8StringPtr* elementAttributes)
 {
-	std::string name (elementName);
+	UTF8StringView name (elementName);
+	for (auto attr = elementAttributes; attr && *attr && *(attr + 1); attr += 2)
+		++statistics.numAttributes;
 	if (nodes)
 	{
 		UINode* parent = nodeStack.back ();
@@ -37,83 +48,85 @@ void UIXMLParser::startXmlElement (Xml::Parser* parser, IdStringPtr elementName,
 			{
 				parser->stop ();
 			}
-			newNode = new UINode (name, makeOwned<UIAttributes> (elementAttributes));
+			newNode = new UINode (elementName, makeOwned<UIAttributes> (elementAttributes));
 		}
 		else
 		{
 			if (parent == nodes)
 			{
 				// only allowed second level elements
-				if (name == MainNodeNames::kControlTag || name == MainNodeNames::kColor || name == MainNodeNames::kBitmap)
-					newNode = new UINode (name, makeOwned<UIAttributes> (elementAttributes), true);
-				else if (name == MainNodeNames::kFont || name == MainNodeNames::kTemplate
-					  || name == MainNodeNames::kControlTag || name == MainNodeNames::kCustom
-					  || name == MainNodeNames::kVariable || name == MainNodeNames::kGradient)
-					newNode = new UINode (name, makeOwned<UIAttributes> (elementAttributes));
+				if (name == MainNodeNames::kControlTag || name == MainNodeNames::kColor || name == MainNodeNames::kBitmap
+				 || name == MainNodeNames::kFont || name == MainNodeNames::kVariable || name == MainNodeNames::kGradient)
+					newNode = new UINode (elementName, makeOwned<UIAttributes> (elementAttributes), true);
+				else if (name == MainNodeNames::kTemplate || name == MainNodeNames::kCustom)
+					newNode = new UINode (elementName, makeOwned<UIAttributes> (elementAttributes));
 				else
 					parser->stop ();
 			}
 			else if (parent->getName () == MainNodeNames::kBitmap)
 			{
 				if (name == "bitmap")
-					newNode = new UIBitmapNode (name, makeOwned<UIAttributes> (elementAttributes));
+					newNode = new UIBitmapNode (elementName, makeOwned<UIAttributes> (elementAttributes));
 				else
 					parser->stop ();
 			}
 			else if (parent->getName () == MainNodeNames::kFont)
 			{
 				if (name == "font")
-					newNode = new UIFontNode (name, makeOwned<UIAttributes> (elementAttributes));
+					newNode = new UIFontNode (elementName, makeOwned<UIAttributes> (elementAttributes));
 				else
 					parser->stop ();
 			}
 			else if (parent->getName () == MainNodeNames::kColor)
 			{
 				if (name == "color")
-					newNode = new UIColorNode (name, makeOwned<UIAttributes> (elementAttributes));
+					newNode = new UIColorNode (elementName, makeOwned<UIAttributes> (elementAttributes));
 				else
 					parser->stop ();
 			}
 			else if (parent->getName () == MainNodeNames::kControlTag)
 			{
 				if (name == "control-tag")
-					newNode = new UIControlTagNode (name, makeOwned<UIAttributes> (elementAttributes));
+					newNode = new UIControlTagNode (elementName, makeOwned<UIAttributes> (elementAttributes));
 				else
 					parser->stop ();
 			}
 			else if (parent->getName () == MainNodeNames::kVariable)
 			{
 				if (name == "var")
-					newNode = new UIVariableNode (name, makeOwned<UIAttributes> (elementAttributes));
+					newNode = new UIVariableNode (elementName, makeOwned<UIAttributes> (elementAttributes));
 				else
 					parser->stop ();
 			}
 			else if (parent->getName () == MainNodeNames::kGradient)
 			{
 				if (name == "gradient")
-					newNode = new UIGradientNode (name, makeOwned<UIAttributes> (elementAttributes));
+					newNode = new UIGradientNode (elementName, makeOwned<UIAttributes> (elementAttributes));
 				else
 					parser->stop ();
 			}
 			else
-				newNode = new UINode (name, makeOwned<UIAttributes> (elementAttributes));
+				newNode = new UINode (elementName, makeOwned<UIAttributes> (elementAttributes));
 		}
 		if (newNode)
 		{
 			parent->getChildren ().add (newNode);
 			nodeStack.emplace_back (newNode);
+			++statistics.numNodes;
 		}
 	}
 	else if (name == "vstgui-ui-description")
 	{
-		nodes = makeOwned<UINode> (name, makeOwned<UIAttributes> (elementAttributes));
+		nodes = makeOwned<UINode> (elementName, makeOwned<UIAttributes> (elementAttributes));
 		nodeStack.emplace_back (nodes);
+		++statistics.numNodes;
 	}
 	else if (name == "vstgui-ui-description-view-list")
 	{
 		vstgui_assert (nodes == nullptr);
-		nodes = makeOwned<UINode> (name, makeOwned<UIAttributes> (elementAttributes));
+		nodes = makeOwned<UINode> (elementName, makeOwned<UIAttributes> (elementAttributes));
 		nodeStack.emplace_back (nodes);
+		++statistics.numNodes;
 		restoreViewsMode = true;
 	}
 }
@@ -121,17 +134,17 @@ void UIXMLParser::startXmlElement (Xml::Parser* parser, IdStringPtr elementName,
 //-----------------------------------------------------------------------------
 void UIXMLParser::endXmlElement (Xml::Parser* parser, IdStringPtr name)
 {
+	if (charDataNode == nodeStack.back ())
+		flushCharData ();
 	if (nodeStack.back () == nodes)
 		restoreViewsMode = false;
 	nodeStack.pop_back ();
 }
 
 //-----------------------------------------------------------------------------
-void UIXMLParser::xmlCharData (Xml::Parser* parser, const int8_t* data, int32_t length)
+template <typename Proc>
+static void forEachNonWhitespaceRange (const int8_t* data, int32_t length, Proc proc)
 {
-	if (nodeStack.empty ())
-		return;
-	auto& nodeData = nodeStack.back ()->getData ();
 	const int8_t* dataStart = nullptr;
 	uint32_t validChars = 0;
 	for (int32_t i = 0; i < length; i++, ++data)
@@ -140,7 +153,7 @@ void UIXMLParser::xmlCharData (Xml::Parser* parser, const int8_t* data, int32_t
 		{
 			if (dataStart)
 			{
-				nodeData.append (reinterpret_cast<const char*> (dataStart), validChars);
+				proc (reinterpret_cast<const char*> (dataStart), validChars);
 				dataStart = nullptr;
 				validChars = 0;
 			}
@@ -151,7 +164,53 @@ void UIXMLParser::xmlCharData (Xml::Parser* parser, const int8_t* data, int32_t
 		++validChars;
 	}
 	if (dataStart && validChars > 0)
-		nodeData.append (reinterpret_cast<const char*> (dataStart), validChars);
+		proc (reinterpret_cast<const char*> (dataStart), validChars);
+}
+
+//-----------------------------------------------------------------------------
+void UIXMLParser::xmlCharData (Xml::Parser* parser, const int8_t* data, int32_t length)
+{
+	if (nodeStack.empty () || length <= 0)
+		return;
+	if (!bufferCharData)
+	{
+		auto& nodeData = nodeStack.back ()->getData ();
+		forEachNonWhitespaceRange (data, length, [&] (const char* range, size_t size) {
+			appendCharData (nodeData, range, size);
+		});
+		return;
+	}
+	if (charDataNode != nodeStack.back ())
+	{
+		flushCharData ();
+		charDataNode = nodeStack.back ();
+	}
+	// reserve space for the whole chunk at once, large base64 data mostly arrives in big chunks
+	// without white space
+	charData.reserve (charData.size () + static_cast<size_t> (length));
+	forEachNonWhitespaceRange (data, length,
+							   [&] (const char* range, size_t size) { charData.append (range, size); });
+}
+
+//-----------------------------------------------------------------------------
+void UIXMLParser::appendCharData (UINode::DataStorage& nodeData, const char* data, size_t size)
+{
+	auto capacity = nodeData.capacity ();
+	if (bufferCharData)
+		nodeData.reserve (nodeData.size () + size);
+	nodeData.append (data, size);
+	if (nodeData.capacity () != capacity)
+		++statistics.numCharDataAllocations;
+	statistics.numCharDataBytes += size;
+}
+
+//-----------------------------------------------------------------------------
+void UIXMLParser::flushCharData ()
+{
+	if (charDataNode && !charData.empty ())
+		appendCharData (charDataNode->getData (), charData.data (), charData.size ());
+	charDataNode = nullptr;
+	charData.clear ();
 }
 
 //-----------------------------------------------------------------------------
@@ -17,9 +17,31 @@ namespace VSTGUI {
 namespace Detail {
 
 //-----------------------------------------------------------------------------
+struct UIXMLParseStatistics
+{
+	/** time spent in parse () in milliseconds */
+	double parseTime {0.};
+	uint64_t numNodes {0};
+	uint64_t numAttributes {0};
+	/** bytes of character data stored in the nodes */
+	uint64_t numCharDataBytes {0};
+	/** heap allocations done for the character data of the nodes */
+	uint64_t numCharDataAllocations {0};
+};
+
+//-----------------------------------------------------------------------------
+/** Creates the node tree of an XML description
+ *
+ *	If bufferCharData is true the character data of an element is collected in a buffer owned by
+ *	the parser and copied into the node with a single allocation when the element ends, instead of
+ *	growing the node data with every chunk the XML parser delivers.
+ */
 struct UIXMLParser : public Xml::IHandler
 {
+	explicit UIXMLParser (bool bufferCharData = true) : bufferCharData (bufferCharData) {}
+
 	SharedPointer<UINode> parse (IContentProvider* provider);
+	const UIXMLParseStatistics& getStatistics () const { return statistics; }
 
 	void startXmlElement (Xml::Parser* parser, IdStringPtr elementName, UTF8StringPtr* elementAttributes) override;
 	void endXmlElement (Xml::Parser* parser, IdStringPtr name) override;
@@ -29,9 +51,18 @@ struct UIXMLParser : public Xml::IHandler
 	const SharedPointer<UINode> getNodes () const { return nodes; }
 
 private:
+	void appendCharData (UINode::DataStorage& nodeData, const char* data, size_t size);
+	void flushCharData ();
+
 	SharedPointer<UINode> nodes;
 	std::deque<UINode*> nodeStack;
 	bool restoreViewsMode {false};
+
+	bool bufferCharData;
+	UINode* charDataNode {nullptr};
+	// keeps its capacity between the elements
+	std::string charData;
+	UIXMLParseStatistics statistics;
 };
 
 //-----------------------------------------------------------------------------
@@ -9,6 +9,10 @@
 #include "../lib/cstring.h"
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string_view>
 
 namespace VSTGUI {
 namespace {
@@ -222,6 +226,123 @@ bool UIAttributes::stringToStringArray (const std::string& str, std::vector<std:
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+/** Interned names in an open addressing hash table, which is looked up without locking.
+ *
+ *	Names are never removed, so a reader only has to see the slots published before it. Inserting
+ *	is locked, a full table is replaced by a bigger one and kept alive for the readers which still
+ *	use it.
+ */
+struct AttributeNameTable
+{
+	const std::string* intern (std::string_view name)
+	{
+		auto hash = std::hash<std::string_view> {}(name);
+		if (auto str = find (*table.load (std::memory_order_acquire), name, hash))
+			return str;
+
+		std::lock_guard<std::mutex> guard (mutex);
+		auto current = table.load (std::memory_order_relaxed);
+		if (auto str = find (*current, name, hash))
+			return str;
+		if ((names.size () + 1) * 2 > current->size)
+			current = grow (*current);
+		names.emplace_back (name);
+		auto str = &names.back ();
+		insert (*current, str, hash);
+		return str;
+	}
+
+	const std::string* find (std::string_view name) const
+	{
+		return find (*table.load (std::memory_order_acquire), name,
+					 std::hash<std::string_view> {}(name));
+	}
+
+	static AttributeNameTable& instance ()
+	{
+		static AttributeNameTable gInstance;
+		return gInstance;
+	}
+
+private:
+	using Slot = std::atomic<const std::string*>;
+
+	struct Table
+	{
+		explicit Table (size_t size) : size (size), slots (new Slot[size] ()) {}
+
+		size_t size;
+		std::unique_ptr<Slot[]> slots;
+	};
+
+	AttributeNameTable ()
+	{
+		tables.emplace_back (new Table (256));
+		table.store (tables.back ().get ());
+	}
+
+	static const std::string* find (const Table& t, std::string_view name, size_t hash)
+	{
+		auto mask = t.size - 1;
+		for (auto index = hash & mask;; index = (index + 1) & mask)
+		{
+			auto str = t.slots[index].load (std::memory_order_acquire);
+			if (!str || *str == name)
+				return str;
+		}
+	}
+
+	static void insert (Table& t, const std::string* str, size_t hash)
+	{
+		auto mask = t.size - 1;
+		auto index = hash & mask;
+		while (t.slots[index].load (std::memory_order_relaxed))
+			index = (index + 1) & mask;
+		t.slots[index].store (str, std::memory_order_release);
+	}
+
+	Table* grow (const Table& old)
+	{
+		tables.emplace_back (new Table (old.size * 2));
+		auto t = tables.back ().get ();
+		for (const auto& name : names)
+			insert (*t, &name, std::hash<std::string_view> {}(name));
+		table.store (t, std::memory_order_release);
+		return t;
+	}
+
+	std::atomic<Table*> table;
+	std::mutex mutex;
+	std::deque<std::string> names;
+	std::vector<std::unique_ptr<Table>> tables;
+};
+
+} // anonymous
+
+//-----------------------------------------------------------------------------
+UIAttributeName::UIAttributeName (const std::string& name)
+: str (AttributeNameTable::instance ().intern (name))
+{
+}
+
+//-----------------------------------------------------------------------------
+UIAttributeName::UIAttributeName (UTF8StringPtr name)
+: str (AttributeNameTable::instance ().intern (name))
+{
+}
+
+//-----------------------------------------------------------------------------
+UIAttributeName UIAttributeName::find (const std::string& name)
+{
+	return UIAttributeName (AttributeNameTable::instance ().find (name));
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -229,80 +350,289 @@ UIAttributes::UIAttributes (UTF8StringPtr* attributes)
 {
 	if (attributes)
 	{
-		size_t count = 0;
-		while (attributes[count] != nullptr && attributes[count+1] != nullptr)
-			count += 2;
-		if (count)
-			UIAttributesMap::reserve (count / 2);
-		
 		int32_t i = 0;
 		while (attributes[i] != nullptr && attributes[i+1] != nullptr)
 		{
-			emplace (attributes[i], attributes[i+1]);
+			setAttribute (UIAttributeName (attributes[i]), attributes[i+1]);
 			i += 2;
 		}
 	}
 }
 
 //------------------------------------------------------------------------
-UIAttributes::UIAttributes (size_t reserve)
+UIAttributes::UIAttributes (size_t numAttributes)
 {
-	UIAttributesMap::reserve (reserve);
+	storage.reserve (numAttributes);
+}
+
+//------------------------------------------------------------------------
+UIAttributes::UIAttributes (const UIAttributes& other)
+: NonAtomicReferenceCounted (other)
+{
+	*this = other;
+}
+
+//------------------------------------------------------------------------
+UIAttributes& UIAttributes::operator= (const UIAttributes& other)
+{
+	if (this == &other)
+		return *this;
+	storage.clear ();
+	storage.reserve (other.storage.size ());
+	for (auto it = other.begin (); it != other.end (); ++it)
+		copyAttribute (it);
+	return *this;
+}
+
+//-----------------------------------------------------------------------------
+auto UIAttributes::findEntry (const std::string& name) const -> const Entry*
+{
+	// comparing the few names of the attributes is faster than looking up the interned name
+	for (const auto& slot : storage)
+	{
+		if (slot.name == name)
+			return slot.entry.get ();
+	}
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+auto UIAttributes::findEntry (UIAttributeName name) const -> const Entry*
+{
+	for (const auto& slot : storage)
+	{
+		if (slot.name == name)
+			return slot.entry.get ();
+	}
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+auto UIAttributes::findOrAddEntry (const std::string& name) -> Entry&
+{
+	return findOrAddEntry (UIAttributeName (name));
+}
+
+//-----------------------------------------------------------------------------
+auto UIAttributes::findOrAddEntry (UIAttributeName name) -> Entry&
+{
+	if (auto entry = findEntry (name))
+		return const_cast<Entry&> (*entry);
+	return addEntry (name, std::string ());
+}
+
+//-----------------------------------------------------------------------------
+auto UIAttributes::addEntry (UIAttributeName name, std::string&& value) -> Entry&
+{
+	storage.push_back ({name, std::make_unique<Entry> (name, std::move (value))});
+	return *storage.back ().entry;
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::setEntryValue (Entry& entry, const std::string& value)
+{
+	entry.second = value;
+	entry.cachedValue = {};
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::setEntryValue (Entry& entry, std::string&& value)
+{
+	entry.second = std::move (value);
+	entry.cachedValue = {};
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::hasAttribute (const std::string& name) const
 {
-	if (getAttributeValue (name) != nullptr)
-		return true;
-	return false;
+	return findEntry (name) != nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::hasAttribute (UIAttributeName name) const
+{
+	return findEntry (name) != nullptr;
 }
 
 //-----------------------------------------------------------------------------
 const std::string* UIAttributes::getAttributeValue (const std::string& name) const
 {
-	const_iterator iter = find (name);
-	if (iter != end ())
-		return &iter->second;
+	if (auto entry = findEntry (name))
+		return &entry->second;
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+const std::string* UIAttributes::getAttributeValue (UIAttributeName name) const
+{
+	if (auto entry = findEntry (name))
+		return &entry->second;
 	return nullptr;
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, const std::string& value)
 {
-	iterator iter = find (name);
-	if (iter != end ())
-		iter->second = value;
-	else
-		emplace (name, value);
+	setEntryValue (findOrAddEntry (name), value);
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, std::string&& value)
 {
-	iterator iter = find (name);
-	if (iter != end ())
-		iter->second = std::move (value);
-	else
-		emplace (name, std::move (value));
+	setEntryValue (findOrAddEntry (name), std::move (value));
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (std::string&& name, std::string&& value)
 {
-	iterator iter = find (name);
-	if (iter != end ())
-		iter->second = std::move (value);
-	else
-		emplace (std::move (name), std::move (value));
+	setEntryValue (findOrAddEntry (name), std::move (value));
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::setAttribute (UIAttributeName name, const std::string& value)
+{
+	setEntryValue (findOrAddEntry (name), value);
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::setAttribute (UIAttributeName name, std::string&& value)
+{
+	setEntryValue (findOrAddEntry (name), std::move (value));
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::setAttribute (UIAttributeName name, std::string&& value,
+                                 const CachedValue& cachedValue)
+{
+	auto& entry = findOrAddEntry (name);
+	entry.second = std::move (value);
+	entry.cachedValue = cachedValue;
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::copyAttribute (const const_iterator& position)
+{
+	const auto& source = *position.it->entry;
+	auto& entry = findOrAddEntry (position.it->name);
+	entry.second = source.second;
+	entry.cachedValue = source.cachedValue;
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::removeAttribute (const std::string& name)
 {
-	iterator iter = find (name);
-	if (iter != end ())
-		erase (iter);
+	auto it = std::find_if (storage.begin (), storage.end (),
+							[&] (const Slot& slot) { return slot.name == name; });
+	if (it != storage.end ())
+		storage.erase (it);
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::removeAll ()
+{
+	storage.clear ();
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getBoolean (const Entry* entry, bool& value)
+{
+	if (!entry)
+		return false;
+	auto& cache = entry->cachedValue;
+	if (cache.type != CachedValue::Type::Boolean)
+	{
+		cache.type = CachedValue::Type::Boolean;
+		if ((cache.valid = stringToBool (entry->second, value)))
+			cache.values[0] = value ? 1. : 0.;
+		return cache.valid;
+	}
+	if (cache.valid)
+		value = cache.values[0] != 0.;
+	return cache.valid;
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getInteger (const Entry* entry, int32_t& value)
+{
+	if (!entry)
+		return false;
+	auto& cache = entry->cachedValue;
+	if (cache.type != CachedValue::Type::Integer)
+	{
+		cache.type = CachedValue::Type::Integer;
+		if ((cache.valid = stringToInteger (entry->second, value)))
+			cache.values[0] = value;
+		return cache.valid;
+	}
+	if (cache.valid)
+		value = static_cast<int32_t> (cache.values[0]);
+	return cache.valid;
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getDouble (const Entry* entry, double& value)
+{
+	if (!entry)
+		return false;
+	auto& cache = entry->cachedValue;
+	if (cache.type != CachedValue::Type::Double)
+	{
+		cache.type = CachedValue::Type::Double;
+		if ((cache.valid = stringToDouble (entry->second, value)))
+			cache.values[0] = value;
+		return cache.valid;
+	}
+	if (cache.valid)
+		value = cache.values[0];
+	return cache.valid;
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getPoint (const Entry* entry, CPoint& p)
+{
+	if (!entry)
+		return false;
+	auto& cache = entry->cachedValue;
+	if (cache.type != CachedValue::Type::Point)
+	{
+		cache.type = CachedValue::Type::Point;
+		CPoint result;
+		if ((cache.valid = stringToPoint (entry->second, result)))
+		{
+			p = result;
+			cache.values[0] = p.x;
+			cache.values[1] = p.y;
+		}
+		return cache.valid;
+	}
+	if (cache.valid)
+		p = CPoint (cache.values[0], cache.values[1]);
+	return cache.valid;
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getRect (const Entry* entry, CRect& r)
+{
+	if (!entry)
+		return false;
+	auto& cache = entry->cachedValue;
+	if (cache.type != CachedValue::Type::Rect)
+	{
+		cache.type = CachedValue::Type::Rect;
+		CRect result;
+		if ((cache.valid = stringToRect (entry->second, result)))
+		{
+			r = result;
+			cache.values[0] = r.left;
+			cache.values[1] = r.top;
+			cache.values[2] = r.right;
+			cache.values[3] = r.bottom;
+		}
+		return cache.valid;
+	}
+	if (cache.valid)
+		r = CRect (cache.values[0], cache.values[1], cache.values[2], cache.values[3]);
+	return cache.valid;
 }
 
 //-----------------------------------------------------------------------------
@@ -314,37 +644,53 @@ void UIAttributes::setDoubleAttribute (const std::string& name, double value)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getDoubleAttribute (const std::string& name, double& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToDouble (*str, value);
-	return false;
+	return getDouble (findEntry (name), value);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getDoubleAttribute (UIAttributeName name, double& value) const
+{
+	return getDouble (findEntry (name), value);
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setBooleanAttribute (const std::string& name, bool value)
 {
-	setAttribute (name, boolToString (value));
+	auto& entry = findOrAddEntry (name);
+	setEntryValue (entry, boolToString (value));
+	entry.cachedValue = {CachedValue::Type::Boolean, true, {value ? 1. : 0.}};
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::getBooleanAttribute (const std::string& name, bool& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToBool (*str, value);
-	return false;
+	return getBoolean (findEntry (name), value);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getBooleanAttribute (UIAttributeName name, bool& value) const
+{
+	return getBoolean (findEntry (name), value);
 }
 
 //-----------------------------------------------------------------------------
 void UIAttributes::setIntegerAttribute (const std::string& name, int32_t value)
 {
-	setAttribute (name, integerToString (value));
+	auto& entry = findOrAddEntry (name);
+	setEntryValue (entry, integerToString (value));
+	entry.cachedValue = {CachedValue::Type::Integer, true, {static_cast<double> (value)}};
 }
 
 //-----------------------------------------------------------------------------
 bool UIAttributes::getIntegerAttribute (const std::string& name, int32_t& value) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToInteger(*str, value);
-	return false;
+	return getInteger (findEntry (name), value);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getIntegerAttribute (UIAttributeName name, int32_t& value) const
+{
+	return getInteger (findEntry (name), value);
 }
 
 //-----------------------------------------------------------------------------
@@ -356,9 +702,13 @@ void UIAttributes::setPointAttribute (const std::string& name, const CPoint& p)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getPointAttribute (const std::string& name, CPoint& p) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToPoint (*str, p);
-	return false;
+	return getPoint (findEntry (name), p);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getPointAttribute (UIAttributeName name, CPoint& p) const
+{
+	return getPoint (findEntry (name), p);
 }
 
 //-----------------------------------------------------------------------------
@@ -370,9 +720,13 @@ void UIAttributes::setRectAttribute (const std::string& name, const CRect& r)
 //-----------------------------------------------------------------------------
 bool UIAttributes::getRectAttribute (const std::string& name, CRect& r) const
 {
-	if (auto str = getAttributeValue (name))
-		return stringToRect (*str, r);
-	return false;
+	return getRect (findEntry (name), r);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::getRectAttribute (UIAttributeName name, CRect& r) const
+{
+	return getRect (findEntry (name), r);
 }
 
 //-----------------------------------------------------------------------------
@@ -389,17 +743,23 @@ bool UIAttributes::getStringArrayAttribute (const std::string& name, StringArray
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+bool UIAttributes::getStringArrayAttribute (UIAttributeName name, StringArray& values) const
+{
+	if (auto str = getAttributeValue (name))
+		return stringToStringArray (*str, values);
+	return false;
+}
+
 //-----------------------------------------------------------------------------
 bool UIAttributes::store (OutputStream& stream) const
 {
 	if (!(stream << (int32_t)'UIAT')) return false;
 	if (!(stream << (uint32_t)size ())) return false;
-	const_iterator it = begin ();
-	while (it != end ())
+	for (const auto& attr : *this)
 	{
-		if (!(stream << (*it).first)) return false;
-		if (!(stream << (*it).second)) return false;
-		++it;
+		if (!(stream << attr.first)) return false;
+		if (!(stream << attr.second)) return false;
 	}
 	return true;
 }
@@ -7,6 +7,9 @@
 #include "../lib/vstguifwd.h"
 #include "../lib/cstring.h"
 
+#include <iterator>
+#include <memory>
+#include <utility>
 #include <vector>
 #include "../lib/platform/std_unorderedmap.h"
 
@@ -14,51 +17,232 @@ namespace VSTGUI {
 class OutputStream;
 class InputStream;
 
+/** UIAttributes was derived from this map before version 4.13, it is kept for source
+ *	compatibility. See @ref code_changes_4_12_to_4_13 */
 using UIAttributesMap = std::unordered_map<std::string,std::string>;
 
 //-----------------------------------------------------------------------------
-class UIAttributes : public NonAtomicReferenceCounted, private UIAttributesMap
+/** Interned attribute name
+ *
+ *	All names with equal characters share one string, so comparing two names only compares
+ *	pointers. Looking up an already interned name does not lock.
+ *
+ *	For source compatibility with the std::string names used before version 4.13 it forwards the
+ *	read-only string methods and can be concatenated with strings.
+ */
+class UIAttributeName
 {
 public:
+	UIAttributeName () = default;
+	explicit UIAttributeName (const std::string& name);
+	explicit UIAttributeName (UTF8StringPtr name);
+
+	/** the interned name with the characters of name, or an invalid name if no such name was
+	 *	interned yet. Does not intern name */
+	static UIAttributeName find (const std::string& name);
+
+	const std::string& getString () const { return *str; }
+	bool isValid () const { return str != nullptr; }
+
+	operator const std::string& () const { return *str; }
+
+	const char* c_str () const { return str->c_str (); }
+	const char* data () const { return str->data (); }
+	size_t size () const { return str->size (); }
+	size_t length () const { return str->length (); }
+	bool empty () const { return str->empty (); }
+	std::string::const_iterator begin () const { return str->begin (); }
+	std::string::const_iterator end () const { return str->end (); }
+
+	friend std::string operator+ (const UIAttributeName& name, const std::string& s)
+	{
+		return *name.str + s;
+	}
+	friend std::string operator+ (const std::string& s, const UIAttributeName& name)
+	{
+		return s + *name.str;
+	}
+	friend std::string operator+ (const UIAttributeName& name, const char* s)
+	{
+		return *name.str + s;
+	}
+	friend std::string operator+ (const char* s, const UIAttributeName& name)
+	{
+		return s + *name.str;
+	}
+
+	bool operator== (const UIAttributeName& other) const { return str == other.str; }
+	bool operator!= (const UIAttributeName& other) const { return str != other.str; }
+
+	friend bool operator== (const UIAttributeName& name, const std::string& str)
+	{
+		return *name.str == str;
+	}
+	friend bool operator== (const std::string& str, const UIAttributeName& name)
+	{
+		return *name.str == str;
+	}
+	friend bool operator!= (const UIAttributeName& name, const std::string& str)
+	{
+		return *name.str != str;
+	}
+	friend bool operator!= (const std::string& str, const UIAttributeName& name)
+	{
+		return *name.str != str;
+	}
+
+private:
+	explicit UIAttributeName (const std::string* str) : str (str) {}
+
+	const std::string* str {nullptr};
+};
+
+//-----------------------------------------------------------------------------
+/** Attributes of a view or node as name-value string pairs
+ *
+ *	The names are interned and the values of the typed getters are parsed only once per value,
+ *	the parsed result is cached until the string value changes.
+ *
+ *	The typed getters write the cache, so one UIAttributes object must not be read on multiple
+ *	threads at the same time, even via its const methods.
+ */
+class UIAttributes : public NonAtomicReferenceCounted
+{
+public:
+	//-----------------------------------------------------------------------------
+	/** pre-parsed value of an attribute */
+	struct CachedValue
+	{
+		enum class Type : uint8_t
+		{
+			None,
+			Double,
+			Integer,
+			Boolean,
+			Point,
+			Rect,
+		};
+
+		Type type {Type::None};
+		bool valid {false};
+		double values[4] {};
+	};
+
 	using StringArray = std::vector<std::string>;
-	
+	/** the interned name and the value of an attribute. Before version 4.13 this was
+	 *	std::pair<const std::string, std::string>, see @ref code_changes_4_12_to_4_13 */
+	using value_type = std::pair<const std::string&, std::string>;
+
+private:
+	struct Entry : value_type
+	{
+		Entry (UIAttributeName name, std::string&& value)
+		: value_type (name.getString (), std::move (value))
+		{
+		}
+
+		mutable CachedValue cachedValue;
+	};
+	struct Slot
+	{
+		UIAttributeName name;
+		std::unique_ptr<Entry> entry;
+	};
+	using Storage = std::vector<Slot>;
+
+public:
+	//-----------------------------------------------------------------------------
+	/** iterates over the attributes. The values can only be changed via setAttribute, which also
+	 *	resets the cached value */
+	class const_iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = UIAttributes::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const value_type*;
+		using reference = const value_type&;
+
+		reference operator* () const { return *it->entry; }
+		pointer operator-> () const { return it->entry.get (); }
+		const_iterator& operator++ ()
+		{
+			++it;
+			return *this;
+		}
+		const_iterator operator++ (int)
+		{
+			auto old = *this;
+			++*this;
+			return old;
+		}
+		bool operator== (const const_iterator& other) const { return it == other.it; }
+		bool operator!= (const const_iterator& other) const { return it != other.it; }
+
+		UIAttributeName getName () const { return it->name; }
+
+	private:
+		friend class UIAttributes;
+		const_iterator (Storage::const_iterator it) : it (it) {}
+
+		Storage::const_iterator it;
+	};
+	/** the attributes can only be iterated read-only since version 4.13 */
+	using iterator = const_iterator;
+
 	explicit UIAttributes (UTF8StringPtr* attributes = nullptr);
-	explicit UIAttributes (size_t reserve);
+	/** reserve space for numAttributes attributes */
+	explicit UIAttributes (size_t numAttributes);
+	UIAttributes (const UIAttributes& other);
+	UIAttributes& operator= (const UIAttributes& other);
 	~UIAttributes () noexcept override = default;
 
-	using UIAttributesMap::empty;
+	bool empty () const { return storage.empty (); }
+	size_t size () const { return storage.size (); }
 
-	using UIAttributesMap::begin;
-	using UIAttributesMap::end;
-	using UIAttributesMap::iterator;
-	using UIAttributesMap::const_iterator;
+	const_iterator begin () const { return {storage.begin ()}; }
+	const_iterator end () const { return {storage.end ()}; }
 
 	bool hasAttribute (const std::string& name) const;
+	bool hasAttribute (UIAttributeName name) const;
 	const std::string* getAttributeValue (const std::string& name) const;
+	const std::string* getAttributeValue (UIAttributeName name) const;
 	void setAttribute (const std::string& name, const std::string& value);
 	void setAttribute (const std::string& name, std::string&& value);
 	void setAttribute (std::string&& name, std::string&& value);
+	void setAttribute (UIAttributeName name, const std::string& value);
+	void setAttribute (UIAttributeName name, std::string&& value);
+	/** set the attribute and the result of parsing value, which must match the typed getters */
+	void setAttribute (UIAttributeName name, std::string&& value, const CachedValue& cachedValue);
+	/** copy the attribute at position including its cached value */
+	void copyAttribute (const const_iterator& position);
 	void removeAttribute (const std::string& name);
 
 	void setBooleanAttribute (const std::string& name, bool value);
 	bool getBooleanAttribute (const std::string& name, bool& value) const;
+	bool getBooleanAttribute (UIAttributeName name, bool& value) const;
 
 	void setIntegerAttribute (const std::string& name, int32_t value);
 	bool getIntegerAttribute (const std::string& name, int32_t& value) const;
+	bool getIntegerAttribute (UIAttributeName name, int32_t& value) const;
 
 	void setDoubleAttribute (const std::string& name, double value);
 	bool getDoubleAttribute (const std::string& name, double& value) const;
+	bool getDoubleAttribute (UIAttributeName name, double& value) const;
 	
 	void setPointAttribute (const std::string& name, const CPoint& p);
 	bool getPointAttribute (const std::string& name, CPoint& p) const;
+	bool getPointAttribute (UIAttributeName name, CPoint& p) const;
 	
 	void setRectAttribute (const std::string& name, const CRect& r);
 	bool getRectAttribute (const std::string& name, CRect& r) const;
+	bool getRectAttribute (UIAttributeName name, CRect& r) const;
 
 	void setStringArrayAttribute (const std::string& name, const StringArray& values);
 	bool getStringArrayAttribute (const std::string& name, StringArray& values) const;
+	bool getStringArrayAttribute (UIAttributeName name, StringArray& values) const;
 	
-	void removeAll () { clear (); }
+	void removeAll ();
 
 	bool store (OutputStream& stream) const;
 	bool restore (InputStream& stream);
@@ -75,7 +259,25 @@ public:
 	static bool stringToRect (const std::string& str, CRect& r);
 	static std::string stringArrayToString (const StringArray& values);
 	static bool stringToStringArray (const std::string& str, StringArray& values);
-	
+
+private:
+	const Entry* findEntry (const std::string& name) const;
+	const Entry* findEntry (UIAttributeName name) const;
+	Entry& findOrAddEntry (const std::string& name);
+	Entry& findOrAddEntry (UIAttributeName name);
+	Entry& addEntry (UIAttributeName name, std::string&& value);
+	static void setEntryValue (Entry& entry, const std::string& value);
+	static void setEntryValue (Entry& entry, std::string&& value);
+
+	static bool getBoolean (const Entry* entry, bool& value);
+	static bool getInteger (const Entry* entry, int32_t& value);
+	static bool getDouble (const Entry* entry, double& value);
+	static bool getPoint (const Entry* entry, CPoint& p);
+	static bool getRect (const Entry* entry, CRect& r);
+
+	// the names are searched in a flat vector, the entries are allocated one by one, so that
+	// pointers to the values stay valid until their attribute is removed
+	Storage storage;
 };
 
 } // VSTGUI
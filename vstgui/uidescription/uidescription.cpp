@@ -21,6 +21,7 @@
 #include "../lib/cgraphicspath.h"
 #include "../lib/cbitmap.h"
 #include "../lib/cbitmapfilter.h"
+#include "../lib/cvstguitimer.h"
 #include "../lib/dispatchlist.h"
 #include "../lib/platform/std_unorderedmap.h"
 #include "../lib/platform/iplatformbitmap.h"
@@ -28,16 +29,23 @@
 #include "detail/locale.h"
 #include "detail/parsecolor.h"
 #include "detail/scalefactorutils.h"
+#include "detail/memorymappedfile.h"
+#include "detail/uibinarypersistence.h"
+#include "detail/uibitmappreloader.h"
 #include "detail/uidesclist.h"
 #include "detail/uijsonpersistence.h"
 #include "detail/uinode.h"
+#include "detail/uinodediff.h"
 #include "detail/uiviewcreatorattributes.h"
 #include "detail/uixmlpersistence.h"
 #include <sstream>
+#include <cstring>
 #include <fstream>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <deque>
+#include <thread>
 
 namespace VSTGUI {
 
@@ -65,6 +73,100 @@ protected:
 	T* oldObject;
 };
 
+//-----------------------------------------------------------------------------
+/** maps resource values to the first resource node having it, built on first use
+ *
+ *	UIDescription updates or invalidates the index whenever it changes, adds or removes a resource
+ *	node or creates the font or bitmap of a node, so a value not in the index is not in the nodes.
+ */
+template <typename Key, typename NodeType> struct ResourceReverseIndex
+{
+	std::unordered_map<Key, NodeType*> map;
+	const Detail::UINode* baseNode {nullptr};
+	size_t numNodes {0};
+	bool valid {false};
+
+	void invalidate ()
+	{
+		map.clear ();
+		valid = false;
+	}
+
+	/** nodeKey (node, key) returns false for nodes not (yet) having a value */
+	template <typename NodeKeyFunc>
+	NodeType* find (const Detail::UINode* node, const Key& key, NodeKeyFunc nodeKey)
+	{
+		if (!node)
+			return nullptr;
+		// nodes may have been added or removed without going through UIDescription
+		if (!valid || baseNode != node || numNodes != node->getChildren ().size ())
+			build (node, nodeKey);
+		auto it = map.find (key);
+		if (it == map.end ())
+			return nullptr;
+		Key nodeValue;
+		if (nodeKey (it->second, nodeValue) && nodeValue == key)
+			return it->second;
+		// the node had the value before it was changed, update () does not remove old values as
+		// another node may have the value, too
+		build (node, nodeKey);
+		it = map.find (key);
+		return it == map.end () ? nullptr : it->second;
+	}
+
+	/** add the current value of resNode after it was changed or added, instead of a rebuild */
+	template <typename NodeKeyFunc>
+	void update (const Detail::UINode* node, NodeType* resNode, bool added, NodeKeyFunc nodeKey)
+	{
+		if (!valid)
+			return;
+		if (baseNode != node || numNodes + (added ? 1 : 0) != node->getChildren ().size ())
+			return invalidate ();
+		numNodes = node->getChildren ().size ();
+		Key nodeValue;
+		if (!nodeKey (resNode, nodeValue))
+			return;
+		auto it = map.find (nodeValue);
+		if (it == map.end ())
+		{
+			map.emplace (nodeValue, resNode);
+			return;
+		}
+		if (it->second == resNode)
+			return;
+		Key otherValue;
+		if (!nodeKey (it->second, otherValue) || !(otherValue == nodeValue))
+			return invalidate (); // an earlier node may have the value, too
+		// the first node wins, as before
+		for (const auto& child : node->getChildren ())
+		{
+			if (child == it->second)
+				break;
+			if (child == resNode)
+			{
+				it->second = resNode;
+				break;
+			}
+		}
+	}
+
+	template <typename NodeKeyFunc>
+	void build (const Detail::UINode* node, NodeKeyFunc nodeKey)
+	{
+		map.clear ();
+		baseNode = node;
+		numNodes = node->getChildren ().size ();
+		valid = true;
+		for (const auto& child : node->getChildren ())
+		{
+			auto* resNode = dynamic_cast<NodeType*> (child);
+			Key nodeValue;
+			if (resNode && nodeKey (resNode, nodeValue))
+				map.emplace (nodeValue, resNode); // the first node wins, as before
+		}
+	}
+};
+
 
 /// @endcond
 
@@ -94,11 +196,31 @@ struct UIDescription::Impl : ListenerProvider<Impl, UIDescriptionListener>
 
 	SharedPointer<UINode> nodes;
 	SharedPointer<UIDescription> sharedResources;
+	std::unique_ptr<Detail::UIBitmapPreloader> bitmapPreloader;
 	
 	mutable std::deque<IController*> subControllerStack;
 	
 	Optional<UINode*> variableBaseNode;
 
+	/** template nodes by name, built on first use and reset when templates change */
+	std::unordered_map<std::string, SharedPointer<UINode>> templateIndex;
+	size_t templateIndexNodeCount {0};
+	bool templateIndexValid {false};
+
+	/** parse the nodes from the content provider or the description file */
+	SharedPointer<UINode> readNodes () const;
+
+	struct AsyncParse
+	{
+		std::thread thread;
+		std::atomic<bool> done {false};
+		/** written by the worker thread before done is set */
+		SharedPointer<UINode> nodes;
+		AsyncParseDoneFunc doneFunc;
+		SharedPointer<CVSTGUITimer> timer;
+	};
+	std::unique_ptr<AsyncParse> asyncParse;
+
 	UINode* getVariableBaseNode ()
 	{
 		if (!variableBaseNode)
@@ -108,6 +230,99 @@ struct UIDescription::Impl : ListenerProvider<Impl, UIDescriptionListener>
 		}
 		return *variableBaseNode;
 	}
+
+	/** resource nodes by value for the reverse name lookups. The change methods and the lazy
+	 *	creation of fonts and bitmaps add the new value, all other changes invalidate them */
+	ResourceReverseIndex<uint32_t, Detail::UIColorNode> colorIndex;
+	ResourceReverseIndex<const CFontDesc*, Detail::UIFontNode> fontIndex;
+	ResourceReverseIndex<int32_t, Detail::UIControlTagNode> controlTagIndex;
+	ResourceReverseIndex<const CBitmap*, Detail::UIBitmapNode> bitmapIndex;
+
+	void invalidateResourceIndices ()
+	{
+		colorIndex.invalidate ();
+		fontIndex.invalidate ();
+		controlTagIndex.invalidate ();
+		bitmapIndex.invalidate ();
+	}
+
+	static uint32_t colorKey (const CColor& color)
+	{
+		return (static_cast<uint32_t> (color.red) << 24) |
+		       (static_cast<uint32_t> (color.green) << 16) |
+		       (static_cast<uint32_t> (color.blue) << 8) | color.alpha;
+	}
+
+	static bool colorNodeKey (Detail::UIColorNode* node, uint32_t& key)
+	{
+		key = colorKey (node->getColor ());
+		return true;
+	}
+
+	/** only fonts already created are used, a font which is created later cannot be the same */
+	static bool fontNodeKey (Detail::UIFontNode* node, const CFontDesc*& key)
+	{
+		if (!node->hasFont ())
+			return false;
+		key = node->getFont ();
+		return true;
+	}
+
+	/** only the bitmaps already loaded are used, like the fonts */
+	auto bitmapNodeKey ()
+	{
+		return [this] (Detail::UIBitmapNode* node, const CBitmap*& key) {
+			if (!node->hasBitmap ())
+				return false;
+			key = node->getBitmap (filePath);
+			return true;
+		};
+	}
+
+	void buildTemplateIndex ()
+	{
+		templateIndex.clear ();
+		templateIndexValid = true;
+		if (!nodes)
+			return;
+		templateIndexNodeCount = nodes->getChildren ().size ();
+		for (const auto& node : nodes->getChildren ())
+		{
+			if (node->getName () != Detail::MainNodeNames::kTemplate)
+				continue;
+			if (const auto* name = node->getAttributes ()->getAttributeValue ("name"))
+				templateIndex.emplace (*name, node); // the first template wins, as before
+		}
+	}
+
+	void invalidateTemplateIndex ()
+	{
+		templateIndex.clear ();
+		templateIndexValid = false;
+	}
+
+	UINode* findTemplateNode (UTF8StringPtr name)
+	{
+		if (!templateIndexValid)
+			buildTemplateIndex ();
+		auto it = templateIndex.find (name);
+		if (it == templateIndex.end ())
+		{
+			// nodes may have been added to the root node directly
+			if (!nodes || nodes->getChildren ().size () == templateIndexNodeCount)
+				return nullptr;
+		}
+		else
+		{
+			// the name attribute of a template node may have been changed directly
+			const auto* nodeName = it->second->getAttributes ()->getAttributeValue ("name");
+			if (nodeName && *nodeName == name)
+				return it->second;
+		}
+		buildTemplateIndex ();
+		it = templateIndex.find (name);
+		return it == templateIndex.end () ? nullptr : it->second.get ();
+	}
 };
 
 //-----------------------------------------------------------------------------
@@ -242,65 +457,584 @@ void UIDescription::setContentProvider (IContentProvider* provider)
 	impl->contentProvider = provider;
 }
 
+//-----------------------------------------------------------------------------
+namespace {
+
+//-----------------------------------------------------------------------------
+/** keeps the first bytes of a content provider, so that they can be read again after probing the
+ *	format even if the provider cannot be rewound */
+class PeekContentProvider : public IContentProvider
+{
+public:
+	explicit PeekContentProvider (IContentProvider& provider) : provider (provider)
+	{
+		auto numRead = provider.readRawData (peekBuffer, sizeof (peekBuffer));
+		peekSize = numRead == kStreamIOError ? 0 : numRead;
+	}
+
+	uint32_t readRawData (int8_t* buffer, uint32_t size) override
+	{
+		uint32_t numCopied = 0;
+		if (peekPos < peekSize)
+		{
+			numCopied = std::min (size, peekSize - peekPos);
+			memcpy (buffer, peekBuffer + peekPos, numCopied);
+			peekPos += numCopied;
+			if (numCopied == size)
+				return numCopied;
+		}
+		auto numRead = provider.readRawData (buffer + numCopied, size - numCopied);
+		readPastPeek = true;
+		if (numRead == kStreamIOError)
+			return numCopied ? numCopied : kStreamIOError;
+		return numCopied + numRead;
+	}
+
+	void rewind () override
+	{
+		if (readPastPeek)
+		{
+			// the provider itself starts at the beginning again after rewinding
+			provider.rewind ();
+			readPastPeek = false;
+			peekPos = peekSize = 0;
+		}
+		else
+			peekPos = 0;
+	}
+
+private:
+	IContentProvider& provider;
+	int8_t peekBuffer[sizeof (Detail::UIBinaryDesc::kIdentifier)];
+	uint32_t peekSize {0};
+	uint32_t peekPos {0};
+	bool readPastPeek {false};
+};
+
+//-----------------------------------------------------------------------------
+} // anonymous
+
+//-----------------------------------------------------------------------------
+static SharedPointer<Detail::UINode> parseUIDesc (IContentProvider* contentProvider)
+{
+	// probing for the binary format must not consume the data of the text formats, as the content
+	// provider of a stream which is not seekable cannot be rewound
+	PeekContentProvider peekProvider (*contentProvider);
+	contentProvider = &peekProvider;
+	if (auto nodes = Detail::UIBinaryDescReader::read (*contentProvider))
+		return nodes;
+	if (auto nodes = Detail::UIJsonDescReader::read (*contentProvider))
+		return nodes;
+#if VSTGUI_ENABLE_XML_PARSER
+	Detail::UIXMLParser parser;
+	if (auto nodes = parser.parse (contentProvider))
+		return nodes;
+#endif
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+auto UIDescription::Impl::readNodes () const -> SharedPointer<UINode>
+{
+	if (contentProvider)
+		return parseUIDesc (contentProvider);
+
+	CResourceInputStream resInputStream;
+	if (resInputStream.open (uidescFile))
+	{
+		InputStreamContentProvider inputStreamProvider (resInputStream);
+		return parseUIDesc (&inputStreamProvider);
+	}
+	if (uidescFile.type == CResourceDescription::kStringType)
+	{
+		Detail::MemoryMappedFile mappedFile;
+		if (mappedFile.open (uidescFile.u.name) &&
+			Detail::UIBinaryDescReader::isBinary (mappedFile.data (), mappedFile.size ()))
+		{
+			if (auto nodes = Detail::UIBinaryDescReader::read (mappedFile.data (), mappedFile.size ()))
+				return nodes;
+		}
+		mappedFile.close ();
+		CFileStream fileStream;
+		if (fileStream.open (uidescFile.u.name, CFileStream::kReadMode))
+		{
+			InputStreamContentProvider fileStreamProvider (fileStream);
+			return parseUIDesc (&fileStreamProvider);
+		}
+	}
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+SharedPointer<Detail::UINode> UIDescription::readNodes ()
+{
+	return impl->readNodes ();
+}
+
 //-----------------------------------------------------------------------------
 bool UIDescription::parse ()
 {
+	if (impl->asyncParse)
+		return finishAsyncParse ();
 	if (parsed ())
 		return true;
-		
-	static auto parseUIDesc = [] (IContentProvider* contentProvider) -> SharedPointer<UINode> {
-		if (auto nodes = Detail::UIJsonDescReader::read (*contentProvider))
-			return nodes;
-#if VSTGUI_ENABLE_XML_PARSER
-		Detail::UIXMLParser parser;
-		if (auto nodes = parser.parse (contentProvider))
-			return nodes;
-#endif
-		return nullptr;
-	};
 
-	if (impl->contentProvider)
+	impl->invalidateTemplateIndex ();
+	impl->invalidateResourceIndices ();
+	if ((impl->nodes = readNodes ()))
 	{
-		if ((impl->nodes = parseUIDesc (impl->contentProvider)))
+		addDefaultNodes ();
+		return true;
+	}
+	impl->nodes = makeOwned<UINode> ("vstgui-ui-description");
+	addDefaultNodes ();
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+/** resolves what does not need the platform, called on the worker thread of parseAsync */
+static void prepareResources (Detail::UINode* nodes)
+{
+	if (auto fontsNode = nodes->getChildren ().findChildNode (Detail::MainNodeNames::kFont))
+	{
+		for (auto child : fontsNode->getChildren ())
 		{
-			addDefaultNodes ();
-			return true;
+			// alternative font names are checked against the platform font families
+			auto fontNode = dynamic_cast<Detail::UIFontNode*> (child);
+			if (fontNode && !fontNode->getAttributes ()->hasAttribute ("alternative-font-names"))
+				fontNode->getFont ();
 		}
 	}
-	else
+	if (auto gradientsNode = nodes->getChildren ().findChildNode (Detail::MainNodeNames::kGradient))
 	{
-		CResourceInputStream resInputStream;
-		if (resInputStream.open (impl->uidescFile))
+		for (auto child : gradientsNode->getChildren ())
 		{
-			InputStreamContentProvider contentProvider (resInputStream);
-			if ((impl->nodes = parseUIDesc (&contentProvider)))
-			{
-				addDefaultNodes ();
-				return true;
-			}
+			if (auto gradientNode = dynamic_cast<Detail::UIGradientNode*> (child))
+				gradientNode->prepareColorStops ();
 		}
-		else if (impl->uidescFile.type == CResourceDescription::kStringType)
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::parseAsync (AsyncParseDoneFunc&& doneFunc, uint32_t pollInterval)
+{
+	if (impl->asyncParse || parsed ())
+		return false;
+
+	// the worker thread uses this object until finishAsyncParse
+	remember ();
+	impl->asyncParse = std::unique_ptr<Impl::AsyncParse> (new Impl::AsyncParse);
+	auto asyncParse = impl->asyncParse.get ();
+	asyncParse->doneFunc = std::move (doneFunc);
+	asyncParse->thread = std::thread ([this, asyncParse] () {
+		if ((asyncParse->nodes = readNodes ()))
+			prepareResources (asyncParse->nodes);
+		asyncParse->done = true;
+	});
+	if (pollInterval)
+	{
+		asyncParse->timer = makeOwned<CVSTGUITimer> (
+			[this] (CVSTGUITimer*) {
+				if (isAsyncParseDone ())
+					finishAsyncParse ();
+			},
+			pollInterval);
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::isAsyncParseDone () const
+{
+	return impl->asyncParse && impl->asyncParse->done;
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::finishAsyncParse ()
+{
+	if (!impl->asyncParse)
+		return parse ();
+
+	auto asyncParse = std::move (impl->asyncParse);
+	if (asyncParse->timer)
+		asyncParse->timer->stop ();
+	asyncParse->thread.join ();
+
+	impl->invalidateTemplateIndex ();
+	impl->invalidateResourceIndices ();
+	auto result = asyncParse->nodes != nullptr;
+	impl->nodes = result ? asyncParse->nodes : makeOwned<UINode> ("vstgui-ui-description");
+	// the default fonts are shared objects and must only be referenced on the main thread
+	addDefaultNodes ();
+	if (auto fontsNode = getBaseNode (Detail::MainNodeNames::kFont))
+	{
+		for (auto child : fontsNode->getChildren ())
 		{
-			CFileStream fileStream;
-			if (fileStream.open (impl->uidescFile.u.name, CFileStream::kReadMode))
-			{
-				InputStreamContentProvider contentProvider (fileStream);
-				if ((impl->nodes = parseUIDesc (&contentProvider)))
-				{
-					addDefaultNodes ();
-					return true;
-				}
-			}
+			if (auto fontNode = dynamic_cast<Detail::UIFontNode*> (child))
+				fontNode->getFont ();
 		}
 	}
-	if (!impl->nodes)
+	if (auto gradientsNode = getBaseNode (Detail::MainNodeNames::kGradient))
 	{
-		impl->nodes = makeOwned<UINode> ("vstgui-ui-description");
-		addDefaultNodes ();
+		for (auto child : gradientsNode->getChildren ())
+		{
+			if (auto gradientNode = dynamic_cast<Detail::UIGradientNode*> (child))
+				gradientNode->getGradient ();
+		}
+	}
+	if (asyncParse->doneFunc)
+		asyncParse->doneFunc (result);
+	forget ();
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+struct UIDescription::ReloadContext
+{
+	/** old and new node of the changed templates, the old node is nullptr for new templates */
+	std::unordered_map<std::string, std::pair<UINode*, UINode*>> changedTemplates;
+	Detail::UINodeNameSet changedResources;
+	/** variables may be used by any attribute value */
+	bool variablesChanged {false};
+	UIDescriptionReloadStatistics statistics;
+
+	bool usesChangedResource (const UIAttributes& attributes) const
+	{
+		if (variablesChanged)
+			return true;
+		if (changedResources.empty ())
+			return false;
+		for (const auto& attr : attributes)
+		{
+			if (changedResources.find (attr.second) != changedResources.end ())
+				return true;
+		}
+		return false;
+	}
+};
+
+//-----------------------------------------------------------------------------
+/** views of the node's children are created in the order of the view nodes */
+static void collectViewNodes (Detail::UINode* node, std::vector<Detail::UINode*>& viewNodes)
+{
+	for (const auto& child : node->getChildren ())
+	{
+		if (child->getName () == "view")
+			viewNodes.emplace_back (child);
+	}
+}
+
+//-----------------------------------------------------------------------------
+/** a view can only be updated in place if it would be created the same way */
+static bool isSameViewKind (const Detail::UINode* node1, const Detail::UINode* node2)
+{
+	static const std::string names[] = {UIViewCreator::kAttrClass,
+										UIViewCreator::kAttrSubController,
+										Detail::MainNodeNames::kTemplate,
+										IUIDescription::kCustomViewName};
+	if (node1 == node2)
+		return true;
+	for (const auto& name : names)
+	{
+		const auto* value1 = node1->getAttributes ()->getAttributeValue (name);
+		const auto* value2 = node2->getAttributes ()->getAttributeValue (name);
+		if ((value1 == nullptr) != (value2 == nullptr) || (value1 && *value1 != *value2))
+			return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+/** the view creators only apply the attributes which are present */
+static bool hasRemovedAttributes (const Detail::UINode* oldNode, const Detail::UINode* newNode)
+{
+	const auto& newAttributes = *newNode->getAttributes ();
+	const auto& oldAttributes = *oldNode->getAttributes ();
+	for (auto it = oldAttributes.begin (), end = oldAttributes.end (); it != end; ++it)
+	{
+		if (!newAttributes.hasAttribute (it.getName ()))
+			return true;
 	}
 	return false;
 }
 
+//-----------------------------------------------------------------------------
+bool UIDescription::reload (CView* rootView, IContentProvider* contentProvider,
+							UIDescriptionReloadStatistics* statistics)
+{
+	// parse also waits for a pending parseAsync, which would replace the reloaded nodes
+	if (!parsed () && !parse ())
+		return false;
+
+	auto newNodes = contentProvider ? parseUIDesc (contentProvider) : readNodes ();
+	if (!newNodes)
+		return false;
+
+	auto oldNodes = impl->nodes;
+	impl->nodes = newNodes;
+	impl->variableBaseNode.reset ();
+	impl->invalidateTemplateIndex ();
+	impl->invalidateResourceIndices ();
+	addDefaultNodes ();
+
+	ReloadContext context;
+	auto findNode = [] (UINode* parent, IdStringPtr name) {
+		return parent->getChildren ().findChildNode (name);
+	};
+
+	// resources, unchanged ones are taken over from the old nodes
+	using Notification = void (UIDescriptionListener::*) (UIDescription*);
+	std::vector<Notification> notifications;
+	struct ResourceType
+	{
+		IdStringPtr name;
+		Notification notification;
+	};
+	static const ResourceType resourceTypes[] = {
+		{Detail::MainNodeNames::kBitmap, &UIDescriptionListener::onUIDescBitmapChanged},
+		{Detail::MainNodeNames::kFont, &UIDescriptionListener::onUIDescFontChanged},
+		{Detail::MainNodeNames::kColor, &UIDescriptionListener::onUIDescColorChanged},
+		{Detail::MainNodeNames::kGradient, &UIDescriptionListener::onUIDescGradientChanged},
+		{Detail::MainNodeNames::kControlTag, &UIDescriptionListener::onUIDescTagChanged},
+	};
+	for (const auto& type : resourceTypes)
+	{
+		auto numChanged = Detail::mergeResourceList (findNode (oldNodes, type.name),
+													 findNode (newNodes, type.name),
+													 context.changedResources);
+		if (numChanged == 0)
+			continue;
+		context.statistics.numChangedResources += static_cast<uint32_t> (numChanged);
+		notifications.emplace_back (type.notification);
+		if (type.name == Detail::MainNodeNames::kBitmap)
+			impl->bitmapPreloader = nullptr;
+	}
+	auto oldVariables = findNode (oldNodes, Detail::MainNodeNames::kVariable);
+	auto newVariables = findNode (newNodes, Detail::MainNodeNames::kVariable);
+	if (oldVariables && newVariables)
+		context.variablesChanged = !Detail::isEqual (*oldVariables, *newVariables);
+	else
+		context.variablesChanged = oldVariables != newVariables;
+
+	// templates
+	std::unordered_map<std::string, UINode*> oldTemplates;
+	for (const auto& node : oldNodes->getChildren ())
+	{
+		if (node->getName () != Detail::MainNodeNames::kTemplate)
+			continue;
+		if (const auto* name = node->getAttributes ()->getAttributeValue ("name"))
+			oldTemplates.emplace (*name, node);
+	}
+	for (const auto& node : newNodes->getChildren ())
+	{
+		if (node->getName () != Detail::MainNodeNames::kTemplate)
+			continue;
+		const auto* name = node->getAttributes ()->getAttributeValue ("name");
+		if (!name)
+			continue;
+		auto it = oldTemplates.find (*name);
+		if (it == oldTemplates.end ())
+		{
+			context.changedTemplates.emplace (*name, std::make_pair (nullptr, node));
+			continue;
+		}
+		if (!Detail::isEqual (*it->second, *node))
+			context.changedTemplates.emplace (*name, std::make_pair (it->second, node));
+		oldTemplates.erase (it);
+	}
+	context.statistics.numChangedTemplates =
+		static_cast<uint32_t> (context.changedTemplates.size () + oldTemplates.size ());
+	if (context.statistics.numChangedTemplates)
+		notifications.emplace_back (&UIDescriptionListener::onUIDescTemplateChanged);
+
+	// only the views of changed templates or using changed resources are touched
+	if (rootView && (!context.changedTemplates.empty () || !context.changedResources.empty () ||
+					 context.variablesChanged))
+		reloadViewTree (rootView, context);
+
+	for (auto notification : notifications)
+	{
+		impl->forEachListener (
+			[this, notification] (UIDescriptionListener* l) { (l->*notification) (this); });
+	}
+	impl->forEachListener ([this, &context] (UIDescriptionListener* l) {
+		l->onUIDescReloaded (this, context.statistics);
+	});
+	if (statistics)
+		*statistics = context.statistics;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void UIDescription::reloadViewTree (CView* view, ReloadContext& context)
+{
+	std::string templateName;
+	if (getTemplateNameFromView (view, templateName))
+	{
+		CView* templateView = view;
+		reloadTemplateView (templateView, templateName, context);
+		return;
+	}
+	if (auto container = view->asViewContainer ())
+	{
+		// keep the children alive, reloading may replace them
+		std::vector<SharedPointer<CView>> children;
+		container->forEachChild ([&] (CView* child) { children.emplace_back (child); });
+		for (auto& child : children)
+			reloadViewTree (child, context);
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::reloadTemplateView (CView*& view, const std::string& templateName,
+										ReloadContext& context)
+{
+	UINode* oldNode = nullptr;
+	UINode* newNode = nullptr;
+	auto it = context.changedTemplates.find (templateName);
+	if (it != context.changedTemplates.end ())
+	{
+		oldNode = it->second.first;
+		newNode = it->second.second;
+	}
+	else
+	{
+		// unchanged, but nested templates or resources may have changed
+		oldNode = newNode = impl->findTemplateNode (templateName.data ());
+	}
+	if (!oldNode || !newNode)
+		return false;
+	if (isSameViewKind (oldNode, newNode))
+		return reloadView (view, oldNode, newNode, context);
+	return recreateView (view, newNode, context);
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::recreateView (CView*& view, UINode* node, ReloadContext& context)
+{
+	auto parent = view->getParentView () ? view->getParentView ()->asViewContainer () : nullptr;
+	if (!parent)
+		return false;
+	ScopePointer<IController> sp (&impl->controller, getViewController (parent, true));
+	CView* newView = nullptr;
+	if (node->getName () == Detail::MainNodeNames::kTemplate)
+	{
+		if (const auto* templateName = node->getAttributes ()->getAttributeValue ("name"))
+			newView = createView (templateName->data (), impl->controller);
+	}
+	else
+		newView = createViewFromNode (node);
+	if (!newView)
+		return false;
+	if (!parent->addView (newView, view))
+	{
+		newView->forget ();
+		return false;
+	}
+	parent->removeView (view);
+	view = newView;
+	++context.statistics.numRecreatedViews;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool UIDescription::reloadView (CView*& view, UINode* oldNode, UINode* newNode,
+								ReloadContext& context)
+{
+	// a removed attribute would keep its value when applying the new ones, so the view is created
+	// again. Views without a parent are updated in place
+	if (oldNode != newNode && hasRemovedAttributes (oldNode, newNode) &&
+		recreateView (view, newNode, context))
+		return true;
+
+	bool updated = false;
+	const auto* templateName =
+		newNode->getAttributes ()->getAttributeValue (Detail::MainNodeNames::kTemplate);
+	if (templateName)
+	{
+		// the root attributes of the template are overridden by the attributes of this node
+		updated = reloadTemplateView (view, *templateName, context);
+	}
+	if (updated || (oldNode != newNode &&
+					!Detail::isEqual (*oldNode->getAttributes (), *newNode->getAttributes ())) ||
+		context.usesChangedResource (*newNode->getAttributes ()))
+	{
+		impl->viewFactory->applyAttributeValues (view, *newNode->getAttributes (), this);
+		++context.statistics.numUpdatedViews;
+		updated = true;
+	}
+	if (!templateName)
+	{
+		if (auto container = view->asViewContainer ())
+			reloadChildViews (container, oldNode, newNode, context);
+	}
+	return updated;
+}
+
+//-----------------------------------------------------------------------------
+void UIDescription::reloadChildViews (CViewContainer* container, UINode* oldNode, UINode* newNode,
+									  ReloadContext& context)
+{
+	std::vector<UINode*> oldViewNodes;
+	std::vector<UINode*> newViewNodes;
+	collectViewNodes (oldNode, oldViewNodes);
+	collectViewNodes (newNode, newViewNodes);
+	std::vector<SharedPointer<CView>> children;
+	children.reserve (container->getNbViews ());
+	container->forEachChild ([&] (CView* child) { children.emplace_back (child); });
+	if (children.size () != oldViewNodes.size ())
+	{
+		// the views were not created from these nodes one by one (e.g. a controller added views)
+		for (auto& child : children)
+			reloadViewTree (child, context);
+		return;
+	}
+
+	// views which can be updated in place at the start and at the end of the list
+	size_t numViews = std::min (oldViewNodes.size (), newViewNodes.size ());
+	size_t prefix = 0;
+	while (prefix < numViews && isSameViewKind (oldViewNodes[prefix], newViewNodes[prefix]))
+		++prefix;
+	size_t suffix = 0;
+	while (suffix < numViews - prefix &&
+		   isSameViewKind (oldViewNodes[oldViewNodes.size () - 1 - suffix],
+						   newViewNodes[newViewNodes.size () - 1 - suffix]))
+		++suffix;
+
+	for (size_t i = 0; i < prefix; ++i)
+	{
+		CView* view = children[i];
+		reloadView (view, oldViewNodes[i], newViewNodes[i], context);
+	}
+	for (size_t i = 0; i < suffix; ++i)
+	{
+		CView* view = children[children.size () - 1 - i];
+		reloadView (view, oldViewNodes[oldViewNodes.size () - 1 - i],
+					newViewNodes[newViewNodes.size () - 1 - i], context);
+	}
+
+	// the views in between are replaced
+	CView* insertBefore = suffix ? children[children.size () - suffix].get () : nullptr;
+	for (size_t i = prefix; i < children.size () - suffix; ++i)
+	{
+		container->removeView (children[i]);
+		++context.statistics.numRemovedViews;
+	}
+	if (prefix + suffix == newViewNodes.size ())
+		return;
+	ScopePointer<IController> sp (&impl->controller, getViewController (container, true));
+	for (size_t i = prefix; i < newViewNodes.size () - suffix; ++i)
+	{
+		if (auto view = createViewFromNode (newViewNodes[i]))
+		{
+			if (!container->addView (view, insertBefore))
+				view->forget ();
+			else
+				++context.statistics.numRecreatedViews;
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 void UIDescription::setController (IController* inController) const
 {
@@ -356,10 +1090,40 @@ static void FreeNodePlatformResources (Detail::UINode* node)
 //-----------------------------------------------------------------------------
 void UIDescription::freePlatformResources ()
 {
+	impl->invalidateResourceIndices ();
+	impl->bitmapPreloader = nullptr;
 	if (impl->nodes)
 		FreeNodePlatformResources (impl->nodes);
 }
 
+//------------------------------------------------------------------------
+void UIDescription::preloadBitmaps (BitmapPreloadProgressFunc&& progress)
+{
+	impl->bitmapPreloader = nullptr;
+	auto requests =
+		Detail::UIBitmapPreloader::collectRequests (getBaseNode (Detail::MainNodeNames::kBitmap));
+	impl->bitmapPreloader = std::unique_ptr<Detail::UIBitmapPreloader> (
+		new Detail::UIBitmapPreloader (std::move (requests), impl->filePath, std::move (progress)));
+}
+
+//------------------------------------------------------------------------
+UIBitmapPreloadStatistics UIDescription::waitForBitmapPreload ()
+{
+	if (!impl->bitmapPreloader)
+		return {};
+	impl->bitmapPreloader->wait ();
+	return impl->bitmapPreloader->getStatistics ();
+}
+
+//------------------------------------------------------------------------
+bool UIDescription::getBitmapPreloadStatistics (UIBitmapPreloadStatistics& statistics) const
+{
+	if (!impl->bitmapPreloader)
+		return false;
+	statistics = impl->bitmapPreloader->getStatistics ();
+	return true;
+}
+
 //------------------------------------------------------------------------
 auto UIDescription::getRootNode () const -> SharedPointer<UINode>
 {
@@ -420,7 +1184,10 @@ bool UIDescription::save (UTF8StringPtr filename, int32_t flags, AttributeSaveFi
 	std::string oldName = moveOldFile (filename);
 	bool result = false;
 	CFileStream stream;
-	if (stream.open (filename, CFileStream::kWriteMode|CFileStream::kTruncateMode))
+	int32_t mode = CFileStream::kWriteMode|CFileStream::kTruncateMode;
+	if (flags & kWriteAsBinary)
+		mode |= CFileStream::kBinaryMode;
+	if (stream.open (filename, mode))
 	{
 		result = saveToStream (stream, flags, func);
 	}
@@ -461,7 +1228,14 @@ bool UIDescription::saveToStream (OutputStream& stream, int32_t flags, Attribute
 					if (flags & kWriteImagesIntoUIDescFile)
 					{
 						if (!(flags & kDoNotVerifyImageData) || !bitmapNode->hasXMLData ())
+						{
+							// creates the bitmap if it was not used yet
+							auto hadBitmap = bitmapNode->hasBitmap ();
 							bitmapNode->createXMLData (impl->filePath);
+							if (!hadBitmap)
+								impl->bitmapIndex.update (bitmapNodes, bitmapNode, false,
+								                          impl->bitmapNodeKey ());
+						}
 					}
 					else
 						bitmapNode->removeXMLData ();
@@ -472,6 +1246,8 @@ bool UIDescription::saveToStream (OutputStream& stream, int32_t flags, Attribute
 	impl->nodes->getAttributes ()->setAttribute ("version", "1");
 	
 	BufferedOutputStream bufferedStream (stream);
+	if (flags & kWriteAsBinary)
+		return Detail::UIBinaryDescWriter::write (bufferedStream, impl->nodes);
 	if (flags & kWriteAsXML)
 	{
 #if VSTGUI_ENABLE_XML_PARSER
@@ -748,22 +1524,12 @@ CViewAttributeID UIDescription::kTemplateNameAttributeID = 'uitl';
 CView* UIDescription::createView (UTF8StringPtr name, IController* _controller) const
 {
 	ScopePointer<IController> sp (&impl->controller, _controller);
-	if (impl->nodes)
+	if (auto templateNode = impl->findTemplateNode (name))
 	{
-		for (const auto& itNode : impl->nodes->getChildren ())
-		{
-			if (itNode->getName () == Detail::MainNodeNames::kTemplate)
-			{
-				const std::string* nodeName = itNode->getAttributes ()->getAttributeValue ("name");
-				if (nodeName && *nodeName == name)
-				{
-					CView* view = createViewFromNode (itNode);
-					if (view)
-						view->setAttribute (kTemplateNameAttributeID, static_cast<uint32_t> (strlen (name) + 1), name);
-					return view;
-				}
-			}
-		}
+		CView* view = createViewFromNode (templateNode);
+		if (view)
+			view->setAttribute (kTemplateNameAttributeID, static_cast<uint32_t> (strlen (name) + 1), name);
+		return view;
 	}
 	return nullptr;
 }
@@ -789,18 +1555,8 @@ bool UIDescription::getTemplateNameFromView (CView* view, std::string& templateN
 //-----------------------------------------------------------------------------
 const UIAttributes* UIDescription::getViewAttributes (UTF8StringPtr name) const
 {
-	if (impl->nodes)
-	{
-		for (const auto& itNode : impl->nodes->getChildren ())
-		{
-			if (itNode->getName () == Detail::MainNodeNames::kTemplate)
-			{
-				const std::string* nodeName = itNode->getAttributes ()->getAttributeValue ("name");
-				if (nodeName && *nodeName == name)
-					return itNode->getAttributes ();
-			}
-		}
-	}
+	if (auto templateNode = impl->findTemplateNode (name))
+		return templateNode->getAttributes ();
 	return nullptr;
 }
 
@@ -822,7 +1578,8 @@ Detail::UINode* UIDescription::getBaseNode (UTF8StringPtr name) const
 		if (node)
 			return node;
 
-		node = new UINode (name);
+		// resource lists are looked up by name
+		node = new UINode (name, nullptr, nameView != Detail::MainNodeNames::kCustom);
 		impl->nodes->getChildren ().add (node);
 		return node;
 	}
@@ -909,10 +1666,22 @@ IControlListener* UIDescription::getControlListener (UTF8StringPtr name) const
 //-----------------------------------------------------------------------------
 CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 {
-	auto* bitmapNode = dynamic_cast<Detail::UIBitmapNode*> (findChildNodeByNameAttribute (getBaseNode (Detail::MainNodeNames::kBitmap), name));
+	UINode* bitmapsNode = getBaseNode (Detail::MainNodeNames::kBitmap);
+	auto* bitmapNode = dynamic_cast<Detail::UIBitmapNode*> (findChildNodeByNameAttribute (bitmapsNode, name));
 	if (bitmapNode)
 	{
+		auto hadBitmap = bitmapNode->hasBitmap ();
+		if (impl->bitmapPreloader && !hadBitmap)
+		{
+			if (auto path = bitmapNode->getAttributes ()->getAttributeValue ("path"))
+			{
+				if (auto platformBitmap = impl->bitmapPreloader->take (bitmapNode, *path))
+					bitmapNode->setPreloadedPlatformBitmap (platformBitmap);
+			}
+		}
 		CBitmap* bitmap = bitmapNode->getBitmap (impl->filePath);
+		if (!hadBitmap)
+			impl->bitmapIndex.update (bitmapsNode, bitmapNode, false, impl->bitmapNodeKey ());
 		if (impl->bitmapCreator && bitmap && bitmap->getPlatformBitmap () == nullptr)
 		{
 			auto platformBitmap = impl->bitmapCreator->createBitmap (*bitmapNode->getAttributes ());
@@ -1063,9 +1832,16 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 //-----------------------------------------------------------------------------
 CFontRef UIDescription::getFont (UTF8StringPtr name) const
 {
-	auto* fontNode = dynamic_cast<Detail::UIFontNode*> (findChildNodeByNameAttribute (getBaseNode (Detail::MainNodeNames::kFont), name));
+	UINode* fontsNode = getBaseNode (Detail::MainNodeNames::kFont);
+	auto* fontNode = dynamic_cast<Detail::UIFontNode*> (findChildNodeByNameAttribute (fontsNode, name));
 	if (fontNode)
-		return fontNode->getFont ();
+	{
+		if (fontNode->hasFont ())
+			return fontNode->getFont ();
+		auto font = fontNode->getFont ();
+		impl->fontIndex.update (fontsNode, fontNode, false, Impl::fontNodeKey);
+		return font;
+	}
 	return nullptr;
 }
 
@@ -1112,28 +1888,45 @@ template<typename NodeType, typename ObjType, typename CompareFunction> UTF8Stri
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+static UTF8StringPtr getNameAttribute (const Detail::UINode* node)
+{
+	if (!node)
+		return nullptr;
+	const std::string* name = node->getAttributes ()->getAttributeValue ("name");
+	return name ? name->c_str () : nullptr;
+}
+
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupColorName (const CColor& color) const
 {
-	return lookupName<Detail::UIColorNode> (color, Detail::MainNodeNames::kColor, [] (const UIDescription* desc, Detail::UIColorNode* node, const CColor& color) {
-		return node->getColor() == color;
-	});
+	if (impl->sharedResources)
+		return impl->sharedResources->lookupColorName (color);
+	auto node = impl->colorIndex.find (getBaseNode (Detail::MainNodeNames::kColor),
+	                                   Impl::colorKey (color), Impl::colorNodeKey);
+	return getNameAttribute (node);
 }
 
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupFontName (const CFontRef font) const
 {
-	return font ? lookupName<Detail::UIFontNode> (font, Detail::MainNodeNames::kFont, [] (const UIDescription* desc, Detail::UIFontNode* node, const CFontRef& font) {
-		return node->getFont () && node->getFont () == font;
-	}) : nullptr;
+	if (!font)
+		return nullptr;
+	if (impl->sharedResources)
+		return impl->sharedResources->lookupFontName (font);
+	auto node = impl->fontIndex.find (getBaseNode (Detail::MainNodeNames::kFont), font,
+	                                  Impl::fontNodeKey);
+	return getNameAttribute (node);
 }
 
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupBitmapName (const CBitmap* bitmap) const
 {
-	return bitmap ? lookupName<Detail::UIBitmapNode> (bitmap, Detail::MainNodeNames::kBitmap, [] (const UIDescription* desc, Detail::UIBitmapNode* node, const CBitmap* bitmap) {
-		return node->getBitmap (desc->impl->filePath) == bitmap;
-	}) : nullptr;
+	if (!bitmap)
+		return nullptr;
+	auto node = impl->bitmapIndex.find (getBaseNode (Detail::MainNodeNames::kBitmap), bitmap,
+	                                    impl->bitmapNodeKey ());
+	return getNameAttribute (node);
 }
 
 //-----------------------------------------------------------------------------
@@ -1147,22 +1940,26 @@ UTF8StringPtr UIDescription::lookupGradientName (const CGradient* gradient) cons
 //-----------------------------------------------------------------------------
 UTF8StringPtr UIDescription::lookupControlTagName (const int32_t tag) const
 {
-	return lookupName<Detail::UIControlTagNode> (tag, Detail::MainNodeNames::kControlTag, [] (const UIDescription* desc, Detail::UIControlTagNode* node, const int32_t tag) {
-		int32_t nodeTag = node->getTag ();
-		if (nodeTag == -1 && node->getTagString ())
-		{
-			double v;
-			if (desc->calculateStringValue (node->getTagString ()->c_str (), v))
-				nodeTag = (int32_t)v;
-		}
-		return nodeTag == tag;
-	});
+	auto node = impl->controlTagIndex.find (
+	    getBaseNode (Detail::MainNodeNames::kControlTag), tag,
+	    [this] (Detail::UIControlTagNode* node, int32_t& key) {
+		    key = node->getTag ();
+		    if (key == -1 && node->getTagString ())
+		    {
+			    double v;
+			    if (calculateStringValue (node->getTagString ()->c_str (), v))
+				    key = (int32_t)v;
+		    }
+		    return true;
+	    });
+	return getNameAttribute (node);
 }
 
 //-----------------------------------------------------------------------------
 template<typename NodeType>
 void UIDescription::changeNodeName (UTF8StringPtr oldName, UTF8StringPtr newName, IdStringPtr mainNodeName)
 {
+	impl->invalidateResourceIndices ();
 	UINode* mainNode = getBaseNode (mainNodeName);
 	auto* node = dynamic_cast<NodeType*> (findChildNodeByNameAttribute(mainNode, oldName));
 	if (node)
@@ -1228,6 +2025,7 @@ void UIDescription::changeColor (UTF8StringPtr name, const CColor& newColor)
 		if (!node->noExport ())
 		{
 			node->setColor (newColor);
+			impl->colorIndex.update (colorsNode, node, false, Impl::colorNodeKey);
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescColorChanged (this);
 			});
@@ -1245,6 +2043,7 @@ void UIDescription::changeColor (UTF8StringPtr name, const CColor& newColor)
 			auto* newNode = new Detail::UIColorNode ("color", attr);
 			colorsNode->getChildren ().add (newNode);
 			colorsNode->sortChildren ();
+			impl->colorIndex.update (colorsNode, newNode, true, Impl::colorNodeKey);
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescColorChanged (this);
 			});
@@ -1262,6 +2061,7 @@ void UIDescription::changeFont (UTF8StringPtr name, CFontRef newFont)
 		if (!node->noExport ())
 		{
 			node->setFont (newFont);
+			impl->fontIndex.update (fontsNode, node, false, Impl::fontNodeKey);
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescFontChanged (this);
 			});
@@ -1277,6 +2077,7 @@ void UIDescription::changeFont (UTF8StringPtr name, CFontRef newFont)
 			newNode->setFont (newFont);
 			fontsNode->getChildren ().add (newNode);
 			fontsNode->sortChildren ();
+			impl->fontIndex.update (fontsNode, newNode, true, Impl::fontNodeKey);
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescFontChanged (this);
 			});
@@ -1319,6 +2120,7 @@ void UIDescription::changeGradient (UTF8StringPtr name, CGradient* newGradient)
 //-----------------------------------------------------------------------------
 void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, const CRect* nineparttiledOffset)
 {
+	impl->bitmapIndex.invalidate ();
 	UINode* bitmapsNode = getBaseNode (Detail::MainNodeNames::kBitmap);
 	auto* node = dynamic_cast<Detail::UIBitmapNode*> (findChildNodeByNameAttribute (bitmapsNode, name));
 	if (node)
@@ -1354,6 +2156,7 @@ void UIDescription::changeBitmap (UTF8StringPtr name, UTF8StringPtr newName, con
 void UIDescription::changeMultiFrameBitmap (UTF8StringPtr name, UTF8StringPtr newName,
 											const CMultiFrameBitmapDescription* desc)
 {
+	impl->bitmapIndex.invalidate ();
 	UINode* bitmapsNode = getBaseNode (Detail::MainNodeNames::kBitmap);
 	auto* node =
 		dynamic_cast<Detail::UIBitmapNode*> (findChildNodeByNameAttribute (bitmapsNode, name));
@@ -1389,6 +2192,7 @@ void UIDescription::changeMultiFrameBitmap (UTF8StringPtr name, UTF8StringPtr ne
 //-----------------------------------------------------------------------------
 void UIDescription::changeBitmapFilters (UTF8StringPtr bitmapName, const std::list<SharedPointer<UIAttributes> >& filters)
 {
+	impl->bitmapIndex.invalidate ();
 	auto* bitmapNode = dynamic_cast<Detail::UIBitmapNode*> (findChildNodeByNameAttribute (getBaseNode (Detail::MainNodeNames::kBitmap), bitmapName));
 	if (bitmapNode)
 	{
@@ -1470,6 +2274,7 @@ static void removeChildNode (Detail::UINode* baseNode, UTF8StringPtr nodeName)
 //-----------------------------------------------------------------------------
 void UIDescription::removeNode (UTF8StringPtr name, IdStringPtr mainNodeName)
 {
+	impl->invalidateResourceIndices ();
 	UINode* node = getBaseNode (mainNodeName);
 	if (node)
 	{
@@ -1525,6 +2330,7 @@ void UIDescription::removeGradient (UTF8StringPtr name)
 //-----------------------------------------------------------------------------
 void UIDescription::changeAlternativeFontNames (UTF8StringPtr name, UTF8StringPtr alternativeFonts)
 {
+	impl->fontIndex.invalidate ();
 	auto* node = dynamic_cast<Detail::UIFontNode*> (findChildNodeByNameAttribute (getBaseNode (Detail::MainNodeNames::kFont), name));
 	if (node)
 	{
@@ -1735,6 +2541,7 @@ bool UIDescription::addNewTemplate (UTF8StringPtr name, const SharedPointer<UIAt
 		auto* newNode = new UINode (Detail::MainNodeNames::kTemplate, attr);
 		attr->setAttribute ("name", name);
 		impl->nodes->getChildren ().add (newNode);
+		impl->invalidateTemplateIndex ();
 		impl->forEachListener ([this] (UIDescriptionListener* l) {
 			l->onUIDescTemplateChanged (this);
 		});
@@ -1752,6 +2559,7 @@ bool UIDescription::removeTemplate (UTF8StringPtr name)
 	if (templateNode)
 	{
 		impl->nodes->getChildren ().remove (templateNode);
+		impl->invalidateTemplateIndex ();
 		impl->forEachListener ([this] (UIDescriptionListener* l) {
 			l->onUIDescTemplateChanged (this);
 		});
@@ -1769,6 +2577,7 @@ bool UIDescription::changeTemplateName (UTF8StringPtr name, UTF8StringPtr newNam
 	if (templateNode)
 	{
 		templateNode->getAttributes()->setAttribute ("name", newName);
+		impl->invalidateTemplateIndex ();
 		impl->forEachListener ([this] (UIDescriptionListener* l) {
 			l->onUIDescTemplateChanged (this);
 		});
@@ -1791,6 +2600,7 @@ bool UIDescription::duplicateTemplate (UTF8StringPtr name, UTF8StringPtr duplica
 		{
 			duplicate->getAttributes()->setAttribute ("name", duplicateName);
 			impl->nodes->getChildren ().add (duplicate);
+			impl->invalidateTemplateIndex ();
 			impl->forEachListener ([this] (UIDescriptionListener* l) {
 				l->onUIDescTemplateChanged (this);
 			});
@@ -1884,6 +2694,7 @@ bool UIDescription::getControlTagString (UTF8StringPtr tagName, std::string& tag
 //-----------------------------------------------------------------------------
 bool UIDescription::changeControlTagString  (UTF8StringPtr tagName, const std::string& newTagString, bool create)
 {
+	impl->controlTagIndex.invalidate ();
 	UINode* tagsNode = getBaseNode (Detail::MainNodeNames::kControlTag);
 	if (auto* controlTagNode =
 			dynamic_cast<Detail::UIControlTagNode*> (findChildNodeByNameAttribute (tagsNode, tagName)))
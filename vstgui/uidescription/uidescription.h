@@ -6,6 +6,7 @@
 
 #include "iuidescription.h"
 #include "uidescriptionfwd.h"
+#include <functional>
 #include <list>
 #include <string>
 #include <memory>
@@ -13,6 +14,37 @@
 namespace VSTGUI {
 namespace Detail { class UINode; }
 
+//-----------------------------------------------------------------------------
+/** Statistics of UIDescription::preloadBitmaps */
+struct UIBitmapPreloadStatistics
+{
+	uint32_t numBitmaps {0};
+	uint32_t numDecoded {0};
+	uint32_t numFailed {0};
+	/** bitmaps which were requested before they were decoded and therefore loaded lazily */
+	uint32_t numSkipped {0};
+	/** sum of the decode times of all bitmaps in milliseconds */
+	double decodeTime {0.};
+	/** time from the start of the preload until the last bitmap was decoded in milliseconds */
+	double wallTime {0.};
+	bool done {false};
+};
+
+//-----------------------------------------------------------------------------
+/** Statistics of UIDescription::reload */
+struct UIDescriptionReloadStatistics
+{
+	/** added, removed and changed bitmaps, fonts, colors, gradients and control tags */
+	uint32_t numChangedResources {0};
+	/** added, removed and changed templates */
+	uint32_t numChangedTemplates {0};
+	/** views which got their attributes applied again */
+	uint32_t numUpdatedViews {0};
+	/** views which were created again, because their class or their sibling views changed */
+	uint32_t numRecreatedViews {0};
+	uint32_t numRemovedViews {0};
+};
+
 //-----------------------------------------------------------------------------
 /// @brief XML description parser and view creator
 /// @ingroup new_in_4_0
@@ -28,6 +60,7 @@ protected:
 		WriteImagesIntoUIDescFileBit,
 		DoNotVerifyImageDataBit,
 		WriteAsXmlBit,
+		WriteAsBinaryBit,
 		LastSaveFlagBit,
 	};
 public:
@@ -37,12 +70,51 @@ public:
 
 	virtual bool parse ();
 
+	using AsyncParseDoneFunc = std::function<void (bool success)>;
+	/** parse the description on a worker thread
+	 *
+	 *	The nodes are read and the fonts and gradient color stops are prepared on the worker
+	 *	thread. The platform dependent parts are finished on the main thread, either from a timer
+	 *	polling every pollInterval milliseconds or by calling finishAsyncParse. A pollInterval of
+	 *	zero does not start the timer. The done function is called on the main thread; until then
+	 *	the caller may show a placeholder view. Calling parse waits for the worker thread.
+	 *
+	 *	@return false if the description is already parsed or being parsed
+	 */
+	bool parseAsync (AsyncParseDoneFunc&& doneFunc = nullptr, uint32_t pollInterval = 10);
+	/** returns true if the worker thread of parseAsync has finished */
+	bool isAsyncParseDone () const;
+	/** wait for the worker thread of parseAsync and finish the parse on the main thread
+	 *
+	 *	@return the result of the parse
+	 */
+	bool finishAsyncParse ();
+
+	/** parse the description again and update the views below rootView to the differences
+	 *
+	 *	The new nodes are compared to the current ones: views of changed template nodes get their
+	 *	attributes applied again, child views whose class changed or which were added or removed
+	 *	are created or removed, and views using a changed resource are updated. Views whose node lost
+	 *	an attribute are created again, so that the attribute gets its default value. Unchanged resources
+	 *	keep their platform resources. The listeners get the change notifications of the changed
+	 *	resource types and onUIDescReloaded.
+	 *
+	 *	@param rootView views created from templates are searched below this view, may be nullptr
+	 *	@param contentProvider the new content, if nullptr it is read from the original source
+	 *	@param statistics optional, filled with the number of changes
+	 *	@return false if the current or the new content could not be parsed, nothing is changed then
+	 */
+	bool reload (CView* rootView, IContentProvider* contentProvider = nullptr,
+				 UIDescriptionReloadStatistics* statistics = nullptr);
+
 	using AttributeSaveFilterFunc = bool (*) (CView* view, const std::string& name);
 	enum SaveFlags {
 		kWriteWindowsResourceFile	= 1 << WriteWindowsResourceFileBit,
 		kWriteImagesIntoUIDescFile	= 1 << WriteImagesIntoUIDescFileBit,
 		kDoNotVerifyImageData	= 1 << DoNotVerifyImageDataBit,
 		kWriteAsXML = 1 << WriteAsXmlBit,
+		/** write the precompiled binary format, which is faster to load than XML or JSON */
+		kWriteAsBinary = 1 << WriteAsBinaryBit,
 		
 		kWriteImagesIntoXMLFile [[deprecated("use kWriteImagesIntoUIDescFile")]] = kWriteImagesIntoUIDescFile,
 		kDoNotVerifyImageXMLData [[deprecated("use kDoNotVerifyImageData")]] = kDoNotVerifyImageData,
@@ -144,6 +216,18 @@ public:
 	void setBitmapCreator (IBitmapCreator* bitmapCreator);
 	void setBitmapCreator2 (IBitmapCreator2* bitmapCreator);
 
+	using BitmapPreloadProgressFunc = std::function<void (uint32_t numDone, uint32_t numTotal)>;
+	/** start decoding all bitmaps concurrently on worker threads
+	 *
+	 *	Call after parse (). Bitmaps which are requested before they are decoded are loaded the
+	 *	normal way. The progress function is called on the worker threads.
+	 */
+	void preloadBitmaps (BitmapPreloadProgressFunc&& progress = nullptr);
+	/** wait for the bitmap preload to finish and return its statistics */
+	UIBitmapPreloadStatistics waitForBitmapPreload ();
+	/** get the statistics of the bitmap preload, returns false if no preload was started */
+	bool getBitmapPreloadStatistics (UIBitmapPreloadStatistics& statistics) const;
+
 	using FocusDrawing = FocusDrawingSettings;
 	FocusDrawing getFocusDrawingSettings () const;
 	void setFocusDrawingSettings (const FocusDrawing& fd);
@@ -154,6 +238,12 @@ public:
 
 	SharedPointer<UINode> getRootNode () const; // for testing
 protected:
+	/** read the nodes of the description, called from parse, parseAsync and reload
+	 *
+	 *	May be called on a worker thread, so overrides must not touch the views or the listeners.
+	 */
+	virtual SharedPointer<UINode> readNodes ();
+
 	void addDefaultNodes ();
 
 	bool saveToStream (OutputStream& stream, int32_t flags, AttributeSaveFilterFunc func);
@@ -169,6 +259,13 @@ private:
 	UINode* findNodeForView (CView* view) const;
 	bool updateAttributesForView (UINode* node, CView* view, bool deep = true);
 	void removeNode (UTF8StringPtr name, IdStringPtr mainNodeName);
+	struct ReloadContext;
+	void reloadViewTree (CView* view, ReloadContext& context);
+	bool reloadTemplateView (CView*& view, const std::string& templateName, ReloadContext& context);
+	bool reloadView (CView*& view, UINode* oldNode, UINode* newNode, ReloadContext& context);
+	bool recreateView (CView*& view, UINode* node, ReloadContext& context);
+	void reloadChildViews (CViewContainer* container, UINode* oldNode, UINode* newNode,
+						   ReloadContext& context);
 	template<typename NodeType, typename ObjType, typename CompareFunction> UTF8StringPtr lookupName (const ObjType& obj, IdStringPtr mainNodeName, CompareFunction compare) const;
 	template<typename NodeType> void changeNodeName (UTF8StringPtr oldName, UTF8StringPtr newName, IdStringPtr mainNodeName);
 	template<typename NodeType> void collectNamesFromNode (IdStringPtr mainNodeName, std::list<const std::string*>& names) const;
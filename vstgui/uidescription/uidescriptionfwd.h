@@ -12,6 +12,7 @@ class IUIDescription;
 class UIDescription;
 class UIDescriptionListener;
 class UIDescriptionListenerAdapter;
+struct UIDescriptionReloadStatistics;
 class IViewFactory;
 class InputStream;
 class OutputStream;
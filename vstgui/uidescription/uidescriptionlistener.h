@@ -23,6 +23,11 @@ public:
 	virtual void onUIDescTemplateChanged (UIDescription* desc) = 0;
 	virtual void onUIDescGradientChanged (UIDescription* desc) = 0;
 	virtual void beforeUIDescSave (UIDescription* desc) = 0;
+	/** called after UIDescription::reload updated the views and sent the change notifications */
+	virtual void onUIDescReloaded (UIDescription* desc,
+								   const UIDescriptionReloadStatistics& statistics)
+	{
+	}
 };
 
 //-----------------------------------------------------------------------------
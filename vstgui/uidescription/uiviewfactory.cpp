@@ -100,8 +100,12 @@ public:
 		return end ();
 	}
 
+	/** changes whenever a view creator is added or removed */
+	uint32_t getVersion () const { return version; }
+
 	void add (IdStringPtr name, const IViewCreator* viewCreator)
 	{
+		++version;
 #if DEBUG
 		if (find (viewCreator->getViewName ()) != end ())
 		{
@@ -118,7 +122,11 @@ public:
 		if (it == end ())
 			return;
 		erase (it);
+		++version;
 	}
+
+private:
+	uint32_t version {1};
 };
 
 //-----------------------------------------------------------------------------
@@ -137,25 +145,57 @@ UIViewFactory::UIViewFactory ()
 }
 
 //-----------------------------------------------------------------------------
-CView* UIViewFactory::createViewByName (const std::string* className, const UIAttributes& attributes, const IUIDescription* description) const
+auto UIViewFactory::getCreatorChain (const std::string& viewName) const -> const CreatorChain*
 {
 	auto& registry = getCreatorRegistry ();
-	auto iter = registry.find (className->c_str ());
-	if (iter != registry.end ())
+	if (creatorChainsRegistryVersion != registry.getVersion ())
+	{
+		creatorChains.clear ();
+		creatorChainsRegistryVersion = registry.getVersion ();
+	}
+	auto it = creatorChains.find (viewName);
+	if (it != creatorChains.end ())
+		return &it->second;
+
+	auto iter = registry.find (viewName.c_str ());
+	if (iter == registry.end ())
+		return nullptr;
+	CreatorChain chain;
+	while (iter != registry.end ())
+	{
+		chain.emplace_back (iter->second);
+		if (chain.back ()->getBaseViewName () == nullptr)
+			break;
+		iter = registry.find (chain.back ()->getBaseViewName ());
+	}
+	return &creatorChains.emplace (viewName, std::move (chain)).first->second;
+}
+
+//-----------------------------------------------------------------------------
+bool UIViewFactory::applyCreatorChain (const CreatorChain& chain, CView* view, const UIAttributes& attributes, const IUIDescription* desc) const
+{
+	bool result = false;
+	for (auto creator : chain)
+	{
+		if (!(result = creator->apply (view, attributes, desc)))
+			break;
+	}
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+CView* UIViewFactory::createViewByName (const std::string* className, const UIAttributes& attributes, const IUIDescription* description) const
+{
+	if (auto chain = getCreatorChain (*className))
 	{
-		CView* view = (*iter).second->create (attributes, description);
+		CView* view = chain->front ()->create (attributes, description);
 		if (view)
 		{
-			IdStringPtr viewName = (*iter).second->getViewName ();
+			IdStringPtr viewName = chain->front ()->getViewName ();
 			view->setAttribute (kViewNameAttribute, viewName);
 			UIAttributes evaluatedAttributes;
-			evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, description);
-			while (iter != registry.end () && (*iter).second->apply (view, evaluatedAttributes, description))
-			{
-				if ((*iter).second->getBaseViewName () == nullptr)
-					break;
-				iter = registry.find ((*iter).second->getBaseViewName ());
-			}
+			const auto& viewAttributes = evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, description);
+			applyCreatorChain (*chain, view, viewAttributes, description);
 			return view;
 		}
 	}
@@ -174,45 +214,34 @@ CView* UIViewFactory::createView (const UIAttributes& attributes, const IUIDescr
 	const std::string* className = attributes.getAttributeValue (UIViewCreator::kAttrClass);
 	if (className)
 		return createViewByName (className, attributes, description);
-	std::string viewContainerName ("CViewContainer");
+	static const std::string viewContainerName ("CViewContainer");
 	return createViewByName (&viewContainerName, attributes, description);
 }
 
 //-----------------------------------------------------------------------------
 bool UIViewFactory::applyAttributeValues (CView* view, const UIAttributes& attributes, const IUIDescription* desc) const
 {
-	bool result = false;
-	auto& registry = getCreatorRegistry ();
-	auto iter = registry.find (getViewName (view));
+	auto viewName = getViewName (view);
+	auto chain = viewName ? getCreatorChain (viewName) : nullptr;
 
 	UIAttributes evaluatedAttributes;
-	evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, desc);
-	
-	while (iter != registry.end () && (result = (*iter).second->apply (view, evaluatedAttributes, desc)) && (*iter).second->getBaseViewName ())
-	{
-		iter = registry.find ((*iter).second->getBaseViewName ());
-	}
-	return result;
+	const auto& viewAttributes = evaluateAttributesAndRemember (view, attributes, evaluatedAttributes, desc);
+
+	return chain ? applyCreatorChain (*chain, view, viewAttributes, desc) : false;
 }
 
 //-----------------------------------------------------------------------------
 bool UIViewFactory::applyCustomViewAttributeValues (CView* customView, IdStringPtr baseViewName, const UIAttributes& attributes, const IUIDescription* desc) const
 {
-	bool result = false;
-	auto& registry = getCreatorRegistry ();
-	auto iter = registry.find (baseViewName);
-	if (iter != registry.end ())
+	auto chain = baseViewName ? getCreatorChain (baseViewName) : nullptr;
+	if (chain)
 	{
-		IdStringPtr viewName = (*iter).second->getViewName ();
+		IdStringPtr viewName = chain->front ()->getViewName ();
 		customView->setAttribute (kViewNameAttribute, viewName);
 	}
 	UIAttributes evaluatedAttributes;
-	evaluateAttributesAndRemember (customView, attributes, evaluatedAttributes, desc);
-	while (iter != registry.end () && (result = (*iter).second->apply (customView, evaluatedAttributes, desc)) && (*iter).second->getBaseViewName ())
-	{
-		iter = registry.find ((*iter).second->getBaseViewName ());
-	}
-	return result;
+	const auto& viewAttributes = evaluateAttributesAndRemember (customView, attributes, evaluatedAttributes, desc);
+	return chain ? applyCreatorChain (*chain, customView, viewAttributes, desc) : false;
 }
 
 //-----------------------------------------------------------------------------
@@ -225,18 +254,28 @@ IdStringPtr UIViewFactory::getViewName (CView* view)
 }
 
 //-----------------------------------------------------------------------------
-void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
+const UIAttributes& UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
 {
+	// the attributes are only copied when a variable needs to be replaced, otherwise the view
+	// creators use the original attributes and their parsed values are cached for the next view
+	bool evaluated = false;
 	std::string evaluatedValue;
-	for (const auto& attr : attributes)
+	for (auto it = attributes.begin (), end = attributes.end (); it != end; ++it)
 	{
+		const auto& attr = *it;
 		const std::string& value = attr.second;
 		if (description && description->getVariable (value.c_str (), evaluatedValue))
 		{
 		#if VSTGUI_LIVE_EDITING
 			rememberAttribute (view, attr.first.c_str (), value.c_str ());
 		#endif
-			evaluatedAttributes.setAttribute (attr.first, evaluatedValue);
+			if (!evaluated)
+			{
+				for (auto prev = attributes.begin (); prev != it; ++prev)
+					evaluatedAttributes.copyAttribute (prev);
+				evaluated = true;
+			}
+			evaluatedAttributes.setAttribute (it.getName (), evaluatedValue);
 		}
 		else
 		{
@@ -254,9 +293,11 @@ void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttribut
 					break;
 			}
 		#endif
-			evaluatedAttributes.setAttribute (attr.first, value);
+			if (evaluated)
+				evaluatedAttributes.copyAttribute (it);
 		}
 	}
+	return evaluated ? evaluatedAttributes : attributes;
 }
 
 #if VSTGUI_LIVE_EDITING
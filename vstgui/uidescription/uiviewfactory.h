@@ -8,6 +8,9 @@
 #include "iuidescription.h"
 #include "iviewfactory.h"
 #include "iviewcreator.h"
+#include "../lib/platform/std_unorderedmap.h"
+#include <string>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -54,7 +57,8 @@ public:
 #endif
 
 protected:
-	void evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const;
+	/** returns attributes if none of them is a variable, otherwise evaluatedAttributes */
+	const UIAttributes& evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const;
 	CView* createViewByName (const std::string* className, const UIAttributes& attributes, const IUIDescription* description) const;
 
 #if VSTGUI_LIVE_EDITING
@@ -62,6 +66,16 @@ protected:
 	void rememberAttribute (CView* view, IdStringPtr attrName, const std::string& value) const;
 	bool getRememberedAttribute (CView* view, IdStringPtr attrName, std::string& value) const;
 #endif
+
+private:
+	using CreatorChain = std::vector<const IViewCreator*>;
+
+	/** returns the creator of the view class followed by the creators of its base classes */
+	const CreatorChain* getCreatorChain (const std::string& viewName) const;
+	bool applyCreatorChain (const CreatorChain& chain, CView* view, const UIAttributes& attributes, const IUIDescription* desc) const;
+
+	mutable std::unordered_map<std::string, CreatorChain> creatorChains;
+	mutable uint32_t creatorChainsRegistryVersion {0};
 };
 
 } // VSTGUI
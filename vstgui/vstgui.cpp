@@ -35,6 +35,7 @@
 #include "lib/cvstguitimer.cpp"
 #include "lib/events.cpp"
 #include "lib/genericstringlistdatabrowsersource.cpp"
+#include "lib/parallelfor.cpp"
 #include "lib/pixelbuffer.cpp"
 #include "lib/vstguidebug.cpp"
 #include "lib/vstguiinit.cpp"
@@ -72,9 +72,13 @@
 #include "uidescription/viewcreator/vumetercreator.cpp"
 #include "uidescription/viewcreator/xypadcreator.cpp"
 
+#include "uidescription/detail/lz4blockcodec.cpp"
+#include "uidescription/detail/uibinarypersistence.cpp"
+#include "uidescription/detail/uibitmappreloader.cpp"
 #include "uidescription/detail/uidesclist.cpp"
 #include "uidescription/detail/uijsonpersistence.cpp"
 #include "uidescription/detail/uinode.cpp"
+#include "uidescription/detail/uinodediff.cpp"
 #include "uidescription/detail/uixmlpersistence.cpp"
 
 #include "uidescription/xmlparser.cpp" // needs to be last